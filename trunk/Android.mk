@@ -12,11 +12,13 @@ LOCAL_SRC_FILES := \
     source/compare_gcc.cc       \
     source/convert.cc           \
     source/convert_argb.cc      \
+    source/convert_bayer.cc     \
     source/convert_from.cc      \
     source/convert_from_argb.cc \
     source/convert_to_argb.cc   \
     source/convert_to_i420.cc   \
     source/cpu_id.cc            \
+    source/perf_counters.cc     \
     source/planar_functions.cc  \
     source/rotate.cc            \
     source/rotate_argb.cc       \
@@ -24,6 +26,7 @@ LOCAL_SRC_FILES := \
     source/rotate_neon64.cc     \
     source/row_any.cc           \
     source/row_common.cc        \
+    source/row_dispatch.cc      \
     source/row_mips.cc          \
     source/row_neon64.cc        \
     source/row_gcc.cc	        \
@@ -38,7 +41,9 @@ LOCAL_SRC_FILES := \
 
 # TODO(fbarchard): Enable mjpeg encoder.
 #   source/mjpeg_decoder.cc
+#   source/mjpeg_encoder.cc
 #   source/convert_jpeg.cc
+#   source/convert_to_jpeg.cc
 #   source/mjpeg_validate.cc
 
 ifeq ($(TARGET_ARCH_ABI),armeabi-v7a)
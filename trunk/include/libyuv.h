@@ -19,6 +19,8 @@
 #include "libyuv/convert_from_argb.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/mjpeg_decoder.h"
+#include "libyuv/mjpeg_encoder.h"
+#include "libyuv/perf_counters.h"
 #include "libyuv/planar_functions.h"
 #include "libyuv/rotate.h"
 #include "libyuv/rotate_argb.h"
@@ -27,6 +27,74 @@ uint32 HashDjb2(const uint8* src, uint64 count, uint32 seed);
 LIBYUV_API
 uint32 ARGBDetect(const uint8* argb, int stride_argb, int width, int height);
 
+// Flags returned by ARGBDetectAlpha.  Alpha is byte 3 of ARGB and ABGR
+// pixels in memory, and byte 0 of BGRA and RGBA pixels.
+static const int kAlphaByte0Opaque = 0x1;  // Byte 0 is always 255.
+static const int kAlphaByte3Opaque = 0x2;  // Byte 3 is always 255.
+static const int kAlphaByte0Zero = 0x4;    // Byte 0 is always 0, ie unused X.
+static const int kAlphaByte3Zero = 0x8;    // Byte 3 is always 0.
+
+// Scan an argb image and return which of bytes 0 and 3 of every pixel are
+// 255 or 0.  An opaque image can skip ARGBAttenuate or blending, and a zero
+// byte is an unused X channel rather than alpha.
+// Returns a combination of the flags above, or -1 on error.
+LIBYUV_API
+int ARGBDetectAlpha(const uint8* argb, int stride_argb, int width, int height);
+
+// Sum, sum of squares, minimum and maximum of a plane, ie for exposure and
+// black frame checks.  The mean is sum / (width * height) and the variance
+// is sum_sq / (width * height) - mean * mean.  Outputs may be NULL.
+LIBYUV_API
+int PlaneStats(const uint8* src_y, int src_stride_y, int width, int height,
+               uint64* sum, uint64* sum_sq, int* min, int* max);
+
+// Stats of each block of a plane.  block_size is 8, 16, 32 or 64 and the
+// block map is laid out as for ComputeBlockSumSquareError, with dst_stride
+// values between rows of blocks in each output.  Outputs may be NULL.
+LIBYUV_API
+int PlaneBlockStats(const uint8* src_y, int src_stride_y,
+                    int width, int height, int block_size,
+                    uint32* dst_sum, uint32* dst_sum_sq,
+                    uint8* dst_min, uint8* dst_max, int dst_stride);
+
+// Count each value of a plane into dst_hist[256].
+LIBYUV_API
+int PlaneHistogram(const uint8* src_y, int src_stride_y, int width, int height,
+                   uint32* dst_hist);
+
+// Histogram of each block of a plane.  block_size is 8, 16, 32 or 64 and
+// the blocks are laid out as for PlaneBlockStats, with 256 counts per block
+// and dst_stride blocks between rows of blocks.
+LIBYUV_API
+int PlaneBlockHistogram(const uint8* src_y, int src_stride_y,
+                        int width, int height, int block_size,
+                        uint32* dst_hist, int dst_stride);
+
+// Count each channel of an ARGB image into dst_hist[1024], 256 values per
+// byte in memory order, ie B, G, R then A.
+LIBYUV_API
+int ARGBHistogram(const uint8* src_argb, int src_stride_argb,
+                  int width, int height, uint32* dst_hist);
+
+// Compare 2 planes tile by tile, ie for the changed regions of screen
+// content.  dst_dirty receives one byte per tile, 1 if any byte of the tile
+// differs and 0 if not, with (width + tile_width - 1) / tile_width tiles per
+// row and dst_stride bytes between rows of tiles.  Tiles on the right and
+// bottom edges are clipped.  Identical planes are read once.
+// Returns the number of dirty tiles, or -1 on error.
+LIBYUV_API
+int PlaneDirtyRects(const uint8* src_a, int stride_a,
+                    const uint8* src_b, int stride_b,
+                    int width, int height, int tile_width, int tile_height,
+                    uint8* dst_dirty, int dst_stride);
+
+// Compare 2 ARGB images tile by tile.  Tile sizes are in pixels.
+LIBYUV_API
+int ARGBDirtyRects(const uint8* src_argb_a, int stride_argb_a,
+                   const uint8* src_argb_b, int stride_argb_b,
+                   int width, int height, int tile_width, int tile_height,
+                   uint8* dst_dirty, int dst_stride);
+
 // Sum Square Error - used to compute Mean Square Error or PSNR.
 LIBYUV_API
 uint64 ComputeSumSquareError(const uint8* src_a,
@@ -37,6 +105,59 @@ uint64 ComputeSumSquareErrorPlane(const uint8* src_a, int stride_a,
                                   const uint8* src_b, int stride_b,
                                   int width, int height);
 
+// Sum Square Error of 16 bit values, ie 10 or 12 bit planes, accumulated
+// in 64 bits.  Strides are in values.
+LIBYUV_API
+uint64 ComputeSumSquareError_16(const uint16* src_a,
+                                const uint16* src_b, int count);
+
+LIBYUV_API
+uint64 ComputeSumSquareErrorPlane_16(const uint16* src_a, int stride_a,
+                                     const uint16* src_b, int stride_b,
+                                     int width, int height);
+
+// Sum of Absolute Differences of a block, ie 4x4 to 64x64.
+LIBYUV_API
+uint32 ComputeSad(const uint8* src_a, int stride_a,
+                  const uint8* src_b, int stride_b,
+                  int width, int height);
+
+// Sum of Absolute Differences of a block against num_candidates blocks of a
+// reference plane, for motion search.  positions holds an x, y pair for
+// each candidate, relative to ref.  dst_sad receives one SAD per candidate.
+LIBYUV_API
+int ComputeSadCandidates(const uint8* src, int src_stride,
+                         const uint8* ref, int ref_stride,
+                         const int* positions, int num_candidates,
+                         int width, int height, uint32* dst_sad);
+
+// Sum of Absolute Transformed Differences of a block: the absolute values of
+// the 4x4 Hadamard transforms of the differences, summed and halved.
+// width and height are multiples of 4.  Returns 0 for invalid arguments.
+LIBYUV_API
+uint32 ComputeSatd(const uint8* src_a, int stride_a,
+                   const uint8* src_b, int stride_b,
+                   int width, int height);
+
+// Compute Sum Square Error of each block of a plane.
+// block_size is 8, 16, 32 or 64.  dst_sse receives one value per block,
+// (width + block_size - 1) / block_size values per row of blocks and
+// (height + block_size - 1) / block_size rows, with dst_stride values
+// between rows.  Blocks on the right and bottom edges are clipped.
+LIBYUV_API
+int ComputeBlockSumSquareError(const uint8* src_a, int stride_a,
+                               const uint8* src_b, int stride_b,
+                               int width, int height, int block_size,
+                               uint32* dst_sse, int dst_stride);
+
+// Compute Sum of Absolute Differences of each block of a plane.
+// The block map is laid out as for ComputeBlockSumSquareError.
+LIBYUV_API
+int ComputeBlockSumAbsDiff(const uint8* src_a, int stride_a,
+                           const uint8* src_b, int stride_b,
+                           int width, int height, int block_size,
+                           uint32* dst_sad, int dst_stride);
+
 static const int kMaxPsnr = 128;
 
 LIBYUV_API
@@ -56,11 +177,46 @@ double I420Psnr(const uint8* src_y_a, int stride_y_a,
                 const uint8* src_v_b, int stride_v_b,
                 int width, int height);
 
+// PSNR for values of the given number of bits, ie 10 for a peak of 1023.
+LIBYUV_API
+double SumSquareErrorToPsnr_16(uint64 sse, uint64 count, int bits);
+
+LIBYUV_API
+double CalcFramePsnr_16(const uint16* src_a, int stride_a,
+                        const uint16* src_b, int stride_b,
+                        int width, int height, int bits);
+
+LIBYUV_API
+double I010Psnr(const uint16* src_y_a, int stride_y_a,
+                const uint16* src_u_a, int stride_u_a,
+                const uint16* src_v_a, int stride_v_a,
+                const uint16* src_y_b, int stride_y_b,
+                const uint16* src_u_b, int stride_u_b,
+                const uint16* src_v_b, int stride_v_b,
+                int width, int height);
+
 LIBYUV_API
 double CalcFrameSsim(const uint8* src_a, int stride_a,
                      const uint8* src_b, int stride_b,
                      int width, int height);
 
+// SSIM with constants for values of the given number of bits.
+LIBYUV_API
+double CalcFrameSsim_16(const uint16* src_a, int stride_a,
+                        const uint16* src_b, int stride_b,
+                        int width, int height, int bits);
+
+// Compute SSIM of each block of a plane, averaging the 8x8 windows of
+// CalcFrameSsim that start within the block, so the frame SSIM is the mean
+// of the blocks weighted by their windows.  Edge blocks with no window use
+// the last windows of the plane.  Requires a plane larger than 8x8.
+// The block map is laid out as for ComputeBlockSumSquareError.
+LIBYUV_API
+int CalcBlockSsim(const uint8* src_a, int stride_a,
+                  const uint8* src_b, int stride_b,
+                  int width, int height, int block_size,
+                  double* dst_ssim, int dst_stride);
+
 LIBYUV_API
 double I420Ssim(const uint8* src_y_a, int stride_y_a,
                 const uint8* src_u_a, int stride_u_a,
@@ -70,6 +226,31 @@ double I420Ssim(const uint8* src_y_a, int stride_y_a,
                 const uint8* src_v_b, int stride_v_b,
                 int width, int height);
 
+LIBYUV_API
+double I010Ssim(const uint16* src_y_a, int stride_y_a,
+                const uint16* src_u_a, int stride_u_a,
+                const uint16* src_v_a, int stride_v_a,
+                const uint16* src_y_b, int stride_y_b,
+                const uint16* src_u_b, int stride_u_b,
+                const uint16* src_v_b, int stride_v_b,
+                int width, int height);
+
+// Multi-scale SSIM of up to 5 levels of 2x2 box filtered planes, built
+// internally while each level is scored.  Requires a plane larger than 8x8.
+LIBYUV_API
+double CalcFrameMsSsim(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b,
+                       int width, int height);
+
+LIBYUV_API
+double I420MsSsim(const uint8* src_y_a, int stride_y_a,
+                  const uint8* src_u_a, int stride_u_a,
+                  const uint8* src_v_a, int stride_v_a,
+                  const uint8* src_y_b, int stride_y_b,
+                  const uint8* src_u_b, int stride_u_b,
+                  const uint8* src_v_b, int stride_v_b,
+                  int width, int height);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -187,6 +187,14 @@ int ARGB4444ToI420(const uint8* src_frame, int src_stride_frame,
                    uint8* dst_v, int dst_stride_v,
                    int width, int height);
 
+// Bayer RGGB, BGGR, GRBG or GBRG (fourcc) to I420 with bilinear demosaic.
+LIBYUV_API
+int BayerToI420(const uint8* src_bayer, int src_stride_bayer,
+                uint8* dst_y, int dst_stride_y,
+                uint8* dst_u, int dst_stride_u,
+                uint8* dst_v, int dst_stride_v,
+                int width, int height, uint32 fourcc);
+
 #ifdef HAVE_JPEG
 // src_width/height provided by capture.
 // dst_width/height for clipping determine final size.
@@ -182,6 +182,18 @@ int ARGB4444ToARGB(const uint8* src_frame, int src_stride_frame,
                    uint8* dst_argb, int dst_stride_argb,
                    int width, int height);
 
+// AR30 (2:10:10:10 little endian) to ARGB.
+LIBYUV_API
+int AR30ToARGB(const uint8* src_ar30, int src_stride_ar30,
+               uint8* dst_argb, int dst_stride_argb,
+               int width, int height);
+
+// Bayer RGGB, BGGR, GRBG or GBRG (fourcc) to ARGB with bilinear demosaic.
+LIBYUV_API
+int BayerToARGB(const uint8* src_bayer, int src_stride_bayer,
+                uint8* dst_argb, int dst_stride_argb,
+                int width, int height, uint32 fourcc);
+
 #ifdef HAVE_JPEG
 // src_width/height provided by capture
 // dst_width/height for clipping determine final size.
@@ -162,6 +162,51 @@ int I420ToARGB4444(const uint8* src_y, int src_stride_y,
                    uint8* dst_frame, int dst_stride_frame,
                    int width, int height);
 
+// Convert I420 To AR30 (2:10:10:10 little endian).
+LIBYUV_API
+int I420ToAR30(const uint8* src_y, int src_stride_y,
+               const uint8* src_u, int src_stride_u,
+               const uint8* src_v, int src_stride_v,
+               uint8* dst_ar30, int dst_stride_ar30,
+               int width, int height);
+
+// Convert 10 bit I010 To AR30 with BT.601 limited range.  Y, U and V keep
+// 10 bits through the conversion.  Source strides are in uint16 elements.
+LIBYUV_API
+int I010ToAR30(const uint16* src_y, int src_stride_y,
+               const uint16* src_u, int src_stride_u,
+               const uint16* src_v, int src_stride_v,
+               uint8* dst_ar30, int dst_stride_ar30,
+               int width, int height);
+
+#ifdef HAVE_JPEG
+// Compress I420 to MJPG (baseline 4:2:0 JPEG).
+// "quality" is 1 to 100.
+// "dst_size" is the capacity of dst_mjpg in bytes on input, and the size of
+//   the compressed frame on output.
+LIBYUV_API
+int I420ToMJPG(const uint8* src_y, int src_stride_y,
+               const uint8* src_u, int src_stride_u,
+               const uint8* src_v, int src_stride_v,
+               int width, int height, int quality,
+               uint8* dst_mjpg, size_t* dst_size);
+
+// Compress I422 to MJPG (baseline 4:2:2 JPEG).
+LIBYUV_API
+int I422ToMJPG(const uint8* src_y, int src_stride_y,
+               const uint8* src_u, int src_stride_u,
+               const uint8* src_v, int src_stride_v,
+               int width, int height, int quality,
+               uint8* dst_mjpg, size_t* dst_size);
+
+// Compress NV12 to MJPG (baseline 4:2:0 JPEG).
+LIBYUV_API
+int NV12ToMJPG(const uint8* src_y, int src_stride_y,
+               const uint8* src_uv, int src_stride_uv,
+               int width, int height, int quality,
+               uint8* dst_mjpg, size_t* dst_size);
+#endif
+
 // Convert I420 to specified format.
 // "dst_sample_stride" is bytes in a row for the destination. Pass 0 if the
 //    buffer has contiguous rows. Can be negative. A multiple of 16 is optimal.
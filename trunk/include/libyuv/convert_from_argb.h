@@ -83,6 +83,12 @@ int ARGBToARGB4444(const uint8* src_argb, int src_stride_argb,
                    uint8* dst_argb4444, int dst_stride_argb4444,
                    int width, int height);
 
+// Convert ARGB To AR30 (2:10:10:10 little endian).
+LIBYUV_API
+int ARGBToAR30(const uint8* src_argb, int src_stride_argb,
+               uint8* dst_ar30, int dst_stride_ar30,
+               int width, int height);
+
 // Convert ARGB To I444.
 LIBYUV_API
 int ARGBToI444(const uint8* src_argb, int src_stride_argb,
@@ -182,6 +188,16 @@ int ARGBToUYVY(const uint8* src_argb, int src_stride_argb,
                uint8* dst_uyvy, int dst_stride_uyvy,
                int width, int height);
 
+#ifdef HAVE_JPEG
+// Compress ARGB to MJPG (baseline 4:2:0 JPEG).
+// "dst_size" is the capacity of dst_mjpg in bytes on input, and the size of
+//   the compressed frame on output.
+LIBYUV_API
+int ARGBToMJPG(const uint8* src_argb, int src_stride_argb,
+               int width, int height, int quality,
+               uint8* dst_mjpg, size_t* dst_size);
+#endif
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -25,7 +25,7 @@ extern "C" {
 // These flags are only valid on ARM processors.
 static const int kCpuHasARM = 0x2;
 static const int kCpuHasNEON = 0x4;
-// 0x8 reserved for future ARM flag.
+static const int kCpuHasNEON_DOTPROD = 0x8;  // ARMv8.2 udot/sdot.
 
 // These flags are only valid on x86 processors.
 static const int kCpuHasX86 = 0x10;
@@ -37,7 +37,10 @@ static const int kCpuHasAVX = 0x200;
 static const int kCpuHasAVX2 = 0x400;
 static const int kCpuHasERMS = 0x800;
 static const int kCpuHasFMA3 = 0x1000;
-// 0x2000, 0x4000, 0x8000 reserved for future X86 flags.
+static const int kCpuHasAVX512BW = 0x2000;
+static const int kCpuHasAVX512VL = 0x4000;
+static const int kCpuHasAVX512VNNI = 0x8000;
+static const int kCpuHasF16C = 0x80000;  // vcvtps2ph and vcvtph2ps.
 
 // These flags are only valid on MIPS processors.
 static const int kCpuHasMIPS = 0x10000;
@@ -67,6 +70,19 @@ static __inline int TestCpuFlag(int test_flag) {
 LIBYUV_API
 void MaskCpuFlags(int enable_flags);
 
+// Cache sizes in bytes of the first cpu.  Sizes that are unknown are 0.
+// X86 uses cpuid, other Linux cpus use /sys/devices/system/cpu.
+// Returns 0 on success or -1 if no cache size is known.
+LIBYUV_API
+int GetCpuCacheInfo(int* l1_data_size, int* l2_size, int* l3_size,
+                    int* line_size);
+
+// Number of logical cores online and physical cores, which is less than
+// logical cores when cores run 2 or more threads (hyperthreading).
+// Returns 0 on success or -1 if the number of cores is unknown.
+LIBYUV_API
+int GetCpuTopology(int* logical_cores, int* physical_cores);
+
 // Low level cpuid for X86. Returns zeros on other CPUs.
 // eax is the info type that you want.
 // ecx is typically the cpu number, and should normally be zero.
@@ -28,6 +28,12 @@ extern "C" {
 
 LIBYUV_BOOL ValidateJpeg(const uint8* sample, size_t sample_size);
 
+// Returns the offset of the first JPEG marker (0xff followed by a marker code)
+// in sample, or sample_size if there is none.  Stuffed bytes (0xff00), fill
+// bytes (0xffff) and restart markers (0xffd0 to 0xffd7) are skipped.
+LIBYUV_API
+size_t ScanJpegMarker(const uint8* sample, size_t sample_size);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -56,6 +62,60 @@ struct BufferVector {
 
 struct SetJmpErrorMgr;
 
+// Finds JPEG frame boundaries in an MJPEG byte stream, such as a multipart
+// HTTP body or UVC bulk payloads, that arrives in chunks of any size.
+// Markers split across chunks are handled, and no data is copied.
+// Typical use:
+//   while (size > 0) {
+//     size_t consumed;
+//     MJpegFrameSplitter::Result result = splitter.Scan(data, size, &consumed);
+//     data += consumed;
+//     size -= consumed;
+//     if (result == MJpegFrameSplitter::kFrameEnd) {
+//       // The last GetFrameSize() bytes before data are the frame.
+//     }
+//   }
+class LIBYUV_API MJpegFrameSplitter {
+ public:
+  enum Result {
+    kNeedMoreData,  // All of data was consumed without a frame boundary.
+    kFrameStart,    // Start Of Image marker ends at data + *consumed.
+    kFrameEnd       // End Of Image marker ends at data + *consumed.
+  };
+
+  MJpegFrameSplitter();
+
+  // Scans data up to and including the next frame boundary. *consumed is set
+  // to the number of bytes scanned. Call again with the rest of data.
+  // A frame with a corrupt header is dropped and the next SOI is searched for.
+  Result Scan(const uint8* data, size_t size, size_t* consumed);
+
+  // Returns the number of bytes of the current frame scanned so far,
+  // starting at the SOI marker. After kFrameEnd this is the frame size.
+  size_t GetFrameSize() const { return frame_size_; }
+
+  // Discards any partial frame and searches for the next SOI marker.
+  void Reset();
+
+ private:
+  enum State {
+    kStateSearchSoi,  // Looking for SOI.
+    kStateMarker,     // Expecting a marker between segments.
+    kStateLength,     // Reading the 2 byte segment length.
+    kStateSegment,    // Skipping segment payload.
+    kStateEntropy     // Scanning entropy coded data after SOS.
+  };
+
+  Result OnMarker(uint8 code);
+
+  State state_;
+  LIBYUV_BOOL pending_ff_;  // Last byte scanned was a 0xff.
+  uint8 marker_;
+  int length_bytes_;
+  size_t segment_remaining_;
+  size_t frame_size_;
+};
+
 // MJPEG ("Motion JPEG") is a pseudo-standard video codec where the frames are
 // simply independent JPEG images with a fixed huffman table (which is omitted).
 // It is rarely used in video transmission, but is common as a camera capture
@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_MJPEG_ENCODER_H_  // NOLINT
+#define INCLUDE_LIBYUV_MJPEG_ENCODER_H_
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+// NOTE: For a simplified public API use convert_from.h I420ToMJPG().
+
+struct jpeg_compress_struct;
+struct jpeg_destination_mgr;
+
+namespace libyuv {
+
+struct SetJmpErrorMgr;
+
+// Encodes YUV frames as baseline JPEG images, the counterpart of MJpegDecoder.
+// Planes are fed to libjpeg as raw downsampled data, so no color conversion
+// or resampling is done by libjpeg. Rows are passed in place when the plane
+// widths are a multiple of the DCT block size; otherwise edge blocks are
+// padded by replicating the last pixel into an internal buffer.
+// The encoder can be reused for any number of frames. Internal buffers are
+// kept between frames and only grow when the frame width grows.
+class LIBYUV_API MJpegEncoder {
+ public:
+  static const int kDefaultQuality = 90;
+
+  MJpegEncoder();
+  ~MJpegEncoder();
+
+  // Sets the JPEG quality, 1 to 100, used by subsequent Encode calls.
+  void SetQuality(int quality);
+
+  // Returns a size in bytes that is large enough for any frame of the
+  // specified dimensions at any quality.
+  static size_t MaxEncodedSize(int width, int height);
+
+  // Encodes an I420 frame into dst. dst_size is the capacity of dst.
+  // Returns the number of bytes written, or 0 on failure, including when
+  // dst_size is too small for the compressed frame.
+  size_t EncodeI420(const uint8* src_y, int src_stride_y,
+                    const uint8* src_u, int src_stride_u,
+                    const uint8* src_v, int src_stride_v,
+                    int width, int height,
+                    uint8* dst, size_t dst_size);
+
+  // Encodes an I422 frame into dst as a 4:2:2 JPEG.
+  size_t EncodeI422(const uint8* src_y, int src_stride_y,
+                    const uint8* src_u, int src_stride_u,
+                    const uint8* src_v, int src_stride_v,
+                    int width, int height,
+                    uint8* dst, size_t dst_size);
+
+  // Encodes an NV12 frame into dst as a 4:2:0 JPEG.
+  // The UV plane is deinterleaved one iMCU row at a time.
+  size_t EncodeNV12(const uint8* src_y, int src_stride_y,
+                    const uint8* src_uv, int src_stride_uv,
+                    int width, int height,
+                    uint8* dst, size_t dst_size);
+
+  // Encodes an ARGB frame into dst as a 4:2:0 JPEG.
+  // The ARGB is converted to I420 one iMCU row at a time.
+  size_t EncodeARGB(const uint8* src_argb, int src_stride_argb,
+                    int width, int height,
+                    uint8* dst, size_t dst_size);
+
+ private:
+  LIBYUV_BOOL StartEncode(int width, int height, int subsample_y,
+                          uint8* dst, size_t dst_size);
+  LIBYUV_BOOL FinishEncode();
+
+  // Compresses one iMCU row. planes point to the first row of the iMCU row
+  // and rows is the number of image rows remaining. Planes that are
+  // already in databuf_ are padded in place.
+  LIBYUV_BOOL WriteImcuRow(const uint8* const* planes, const int* strides,
+                           int rows);
+
+  int GetImageScanlinesPerImcuRow();
+  int GetComponentScanlinesPerImcuRow(int component);
+  int GetComponentWidth(int component);
+  int GetComponentStride(int component);
+
+  jpeg_compress_struct* compress_struct_;
+  jpeg_destination_mgr* dest_mgr_;
+  SetJmpErrorMgr* error_mgr_;
+
+  int quality_;
+
+  // Scanline pointers for one iMCU row of each component. 16 is the most
+  // scanlines in an iMCU row, for 4:2:0.
+  uint8* scanline_rows_[3][16];
+  uint8** scanlines_[3];
+
+  // Buffer holding one iMCU row of each component, padded to a multiple of
+  // DCTSIZE. Used for edge padding and as the conversion target for NV12
+  // and ARGB.
+  uint8* databuf_;
+  int databuf_size_;
+  uint8* databuf_planes_[3];
+  int databuf_strides_[3];
+};
+
+}  // namespace libyuv
+
+#endif  //  __cplusplus
+#endif  // INCLUDE_LIBYUV_MJPEG_ENCODER_H_  NOLINT
@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_PERF_COUNTERS_H_  // NOLINT
+#define INCLUDE_LIBYUV_PERF_COUNTERS_H_
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Counters of calls, pixels and time for the most used functions.
+// Counting is compiled in with LIBYUV_PERF_COUNTERS defined and then enabled
+// at runtime with SetPerfCountersEnabled.  Without LIBYUV_PERF_COUNTERS the
+// functions are not instrumented and the counters stay 0.
+// Time includes functions called by a function, ie ConvertToI420 includes
+// the I420Copy it calls, which is also counted.
+// cpu_flags is the highest kCpuHas flag of the row functions the last call
+// dispatched to, ie kCpuHasAVX2 when AVX2 row functions ran, or 0 when only
+// C ran.  Like time it includes the functions called.
+
+enum PerfCounterId {
+  kPerfI420ToARGB = 0,
+  kPerfI422ToARGB,
+  kPerfNV12ToARGB,
+  kPerfARGBToI420,
+  kPerfI420Copy,
+  kPerfCopyPlane,
+  kPerfConvertToI420,
+  kPerfConvertToARGB,
+  kPerfScalePlane,
+  kPerfI420Scale,
+  kPerfARGBScale,
+  kPerfI420Rotate,
+  kPerfCounterCount
+};
+
+struct PerfCounter {
+  const char* name;  // Function name, ie "I420ToARGB".
+  uint64 calls;
+  uint64 pixels;  // Source pixels.
+  uint64 nanoseconds;
+  int cpu_flags;  // Row function flag of the last call, ie kCpuHasAVX2.
+};
+
+// Enable (1) or disable (0) counting.  Disabled by default.
+LIBYUV_API
+void SetPerfCountersEnabled(int enable);
+
+// Copy up to count counters, in PerfCounterId order.
+// Returns the number of counters copied.
+LIBYUV_API
+int GetPerfCounters(struct PerfCounter* counters, int count);
+
+// Set all counters to 0.
+LIBYUV_API
+void ResetPerfCounters(void);
+
+#if defined(LIBYUV_PERF_COUNTERS)
+extern int perf_counters_enabled_;
+
+// Internal.  Nanoseconds from a monotonic clock.
+int64 PerfCounterTime(void);
+// Internal.  Records that the call being counted on this thread dispatched
+// to a row function for cpu_flag.
+void AddPerfCounterCpuFlag(int cpu_flag);
+// Internal.  Starts recording the flags of a call and returns the flags of
+// the call it is nested in.
+int BeginPerfCounterCpuFlags(void);
+// Internal.  Returns the flags of the call and adds them to the flags of the
+// call it is nested in.
+int EndPerfCounterCpuFlags(int outer_cpu_flags);
+// Internal.  Adds a call to a counter.
+void AddPerfCounter(int counter_id, int64 pixels, int64 nanoseconds,
+                    int cpu_flags);
+#endif
+
+#ifdef __cplusplus
+}  // extern "C"
+
+#if defined(LIBYUV_PERF_COUNTERS)
+// Counts the call of the function it is declared in.
+class PerfCounterScope {
+ public:
+  PerfCounterScope(int counter_id, int width, int height)
+      : counter_id_(counter_id),
+        pixels_((int64)(width < 0 ? -width : width) *
+                (height < 0 ? -height : height)),
+        start_(perf_counters_enabled_ ? PerfCounterTime() : -1),
+        outer_cpu_flags_(start_ >= 0 ? BeginPerfCounterCpuFlags() : 0) {
+  }
+  ~PerfCounterScope() {
+    if (start_ >= 0) {
+      AddPerfCounter(counter_id_, pixels_, PerfCounterTime() - start_,
+                     EndPerfCounterCpuFlags(outer_cpu_flags_));
+    }
+  }
+
+ private:
+  int counter_id_;
+  int64 pixels_;
+  int64 start_;
+  int outer_cpu_flags_;
+};
+
+#define PERF_COUNTER(counter_id, width, height)                                \
+    PerfCounterScope perf_counter_scope(counter_id, width, height)
+
+// Records the flag of a row function chosen by a TestCpuFlag ladder.
+#define PERF_COUNTER_CPU_FLAG(cpu_flag)                                        \
+    do {                                                                       \
+      if (perf_counters_enabled_) {                                            \
+        AddPerfCounterCpuFlag(cpu_flag);                                       \
+      }                                                                        \
+    } while (0)
+#endif  // defined(LIBYUV_PERF_COUNTERS)
+}  // namespace libyuv
+#endif  // __cplusplus
+
+#if !defined(PERF_COUNTER)
+#define PERF_COUNTER(counter_id, width, height)
+#endif
+#if !defined(PERF_COUNTER_CPU_FLAG)
+#define PERF_COUNTER_CPU_FLAG(cpu_flag)
+#endif
+
+#endif  // INCLUDE_LIBYUV_PERF_COUNTERS_H_  NOLINT
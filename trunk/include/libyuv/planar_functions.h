@@ -436,6 +436,69 @@ int ARGBSobelXY(const uint8* src_argb, int src_stride_argb,
                 uint8* dst_argb, int dst_stride_argb,
                 int width, int height);
 
+// Convert ARGB to planes of float R, G and B, as fed to neural networks.
+// Each channel is value * scale + bias, with scale and bias 3 floats in
+// R, G, B order.  NULL scale is 1 and NULL bias is 0.
+// Float strides are in floats.
+LIBYUV_API
+int ARGBToPlanarFloat(const uint8* src_argb, int src_stride_argb,
+                      float* dst_r, int dst_stride_r,
+                      float* dst_g, int dst_stride_g,
+                      float* dst_b, int dst_stride_b,
+                      const float* scale, const float* bias,
+                      int width, int height);
+
+// Convert NV12 to planes of float R, G and B.  As ARGBToPlanarFloat.
+LIBYUV_API
+int NV12ToPlanarRGBFloat(const uint8* src_y, int src_stride_y,
+                         const uint8* src_uv, int src_stride_uv,
+                         float* dst_r, int dst_stride_r,
+                         float* dst_g, int dst_stride_g,
+                         float* dst_b, int dst_stride_b,
+                         const float* scale, const float* bias,
+                         int width, int height);
+
+// Convert a plane of float to IEEE half float, value * scale + bias,
+// rounded to nearest even.  Strides are in elements.
+LIBYUV_API
+int HalfFloatPlane(const float* src, int src_stride,
+                   uint16* dst, int dst_stride,
+                   float scale, float bias,
+                   int width, int height);
+
+// Split packed RGB (RAW byte order, R first) into separate R, G and B planes.
+LIBYUV_API
+int SplitRGBPlane(const uint8* src_rgb, int src_stride_rgb,
+                  uint8* dst_r, int dst_stride_r,
+                  uint8* dst_g, int dst_stride_g,
+                  uint8* dst_b, int dst_stride_b,
+                  int width, int height);
+
+// Merge separate R, G and B planes into packed RGB (RAW byte order).
+LIBYUV_API
+int MergeRGBPlane(const uint8* src_r, int src_stride_r,
+                  const uint8* src_g, int src_stride_g,
+                  const uint8* src_b, int src_stride_b,
+                  uint8* dst_rgb, int dst_stride_rgb,
+                  int width, int height);
+
+// Convert ARGB to planar GBR (GBRP, 4:4:4 RGB as coded by H.264 and HEVC).
+// Alpha is dropped.
+LIBYUV_API
+int ARGBToGBRP(const uint8* src_argb, int src_stride_argb,
+               uint8* dst_g, int dst_stride_g,
+               uint8* dst_b, int dst_stride_b,
+               uint8* dst_r, int dst_stride_r,
+               int width, int height);
+
+// Convert planar GBR to ARGB with alpha of 255.
+LIBYUV_API
+int GBRPToARGB(const uint8* src_g, int src_stride_g,
+               const uint8* src_b, int src_stride_b,
+               const uint8* src_r, int src_stride_r,
+               uint8* dst_argb, int dst_stride_argb,
+               int width, int height);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -178,6 +178,21 @@ extern "C" {
 #endif  // clang >= 3.4
 #endif  // __clang__
 
+// GCC >= 5 required for AVX512.
+#if defined(__GNUC__) && !defined(__clang__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#if (__GNUC__ >= 5)
+#define GCC_HAS_AVX512 1
+#endif  // GNUC >= 5
+#endif  // __GNUC__
+
+// clang >= 3.9.0 required for AVX512.
+#if defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#if (__clang_major__ > 3) || (__clang_major__ == 3 && (__clang_minor__ >= 9))
+#define CLANG_HAS_AVX512 1
+#endif  // clang >= 3.9
+#endif  // __clang__
+
 // Visual C 2012 required for AVX2.
 #if defined(_M_IX86) && !defined(__clang__) && \
     defined(_MSC_VER) && _MSC_VER >= 1700
@@ -258,6 +273,51 @@ extern "C" {
 #define HAS_MIRRORROW_SSE2
 #endif
 
+// The following are available for GCC x86 platforms.  Visual C uses C.
+#if !defined(LIBYUV_DISABLE_X86) && (defined(__x86_64__) || defined(__i386__))
+#define HAS_AR30TOARGBROW_SSE2
+#define HAS_ARGBTOAR30ROW_SSSE3
+#define HAS_ARGBTOPLANARFLOATROW_SSE2
+#define HAS_BAYERTOARGBROW_SSE2
+#define HAS_COPYROW_NT_SSE2
+#define HAS_I210TOAR30ROW_SSSE3
+#define HAS_I422TOAR30ROW_SSSE3
+#define HAS_MERGERGBROW_SSSE3
+#define HAS_MERGEXRGBROW_SSE2
+#define HAS_SCANJPEGMARKERROW_SSE2
+#define HAS_SPLITRGBROW_SSSE3
+#define HAS_SPLITXRGBROW_SSSE3
+#define HAS_STOREFENCE_SSE2
+#endif
+
+// The following are available for AVX2 GCC x86 platforms.  Visual C uses C.
+#if !defined(LIBYUV_DISABLE_X86) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+#define HAS_AR30TOARGBROW_AVX2
+#define HAS_ARGBTOAR30ROW_AVX2
+#define HAS_ARGBTOPLANARFLOATROW_AVX2
+#define HAS_COPYROW_NT_AVX
+#define HAS_HALFFLOATROW_F16C
+#define HAS_I422TOAR30ROW_AVX2
+#define HAS_I422TOARGBROW_NT_AVX2
+#define HAS_MERGEXRGBROW_AVX2
+#define HAS_SCANJPEGMARKERROW_AVX2
+#define HAS_SPLITXRGBROW_AVX2
+#endif
+
+// The following are available for AVX512 GCC x86 platforms.
+#if !defined(LIBYUV_DISABLE_X86) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512))
+#define HAS_ARGBBLENDROW_AVX512BW
+#define HAS_ARGBTOUVROW_AVX512BW
+#define HAS_ARGBTOYROW_AVX512BW
+#define HAS_I422TOARGBROW_AVX512BW
+#define HAS_INTERPOLATEROW_AVX512BW
+#define HAS_NV12TOARGBROW_AVX512BW
+#define HAS_UYVYTOYROW_AVX512BW
+#define HAS_YUY2TOYROW_AVX512BW
+#endif
+
 // The following are available on Neon platforms:
 #if !defined(LIBYUV_DISABLE_NEON) && \
     (defined(__aarch64__) || defined(__ARM_NEON__) || defined(LIBYUV_NEON))
@@ -298,7 +358,9 @@ extern "C" {
 #define HAS_I422TOUYVYROW_NEON
 #define HAS_I422TOYUY2ROW_NEON
 #define HAS_I444TOARGBROW_NEON
+#define HAS_MERGERGBROW_NEON
 #define HAS_MERGEUVROW_NEON
+#define HAS_MERGEXRGBROW_NEON
 #define HAS_MIRRORROW_NEON
 #define HAS_MIRRORUVROW_NEON
 #define HAS_NV12TOARGBROW_NEON
@@ -318,7 +380,9 @@ extern "C" {
 #define HAS_RGBATOYROW_NEON
 #define HAS_SETROW_NEON
 #define HAS_ARGBSETROW_NEON
+#define HAS_SPLITRGBROW_NEON
 #define HAS_SPLITUVROW_NEON
+#define HAS_SPLITXRGBROW_NEON
 #define HAS_UYVYTOARGBROW_NEON
 #define HAS_UYVYTOUV422ROW_NEON
 #define HAS_UYVYTOUVROW_NEON
@@ -349,6 +413,15 @@ extern "C" {
 #define HAS_SOBELYROW_NEON
 #define HAS_ARGBCOLORMATRIXROW_NEON
 #define HAS_ARGBSHUFFLEROW_NEON
+#define HAS_BAYERTOARGBROW_NEON
+#define HAS_SCANJPEGMARKERROW_NEON
+#endif
+
+// The following are available on Neon 64 bit platforms:
+#if !defined(LIBYUV_DISABLE_NEON) && defined(__aarch64__)
+#define HAS_ARGBTOPLANARFLOATROW_NEON
+#define HAS_COPYROW_NT_NEON
+#define HAS_HALFFLOATROW_NEON
 #endif
 
 // The following are available on Mips platforms:
@@ -579,6 +652,8 @@ void UYVYToARGBRow_NEON(const uint8* src_uyvy,
 
 void ARGBToYRow_AVX2(const uint8* src_argb, uint8* dst_y, int pix);
 void ARGBToYRow_Any_AVX2(const uint8* src_argb, uint8* dst_y, int pix);
+void ARGBToYRow_AVX512BW(const uint8* src_argb, uint8* dst_y, int pix);
+void ARGBToYRow_Any_AVX512BW(const uint8* src_argb, uint8* dst_y, int pix);
 void ARGBToYRow_SSSE3(const uint8* src_argb, uint8* dst_y, int pix);
 void ARGBToYJRow_AVX2(const uint8* src_argb, uint8* dst_y, int pix);
 void ARGBToYJRow_Any_AVX2(const uint8* src_argb, uint8* dst_y, int pix);
@@ -656,6 +731,10 @@ void ARGBToUVRow_AVX2(const uint8* src_argb, int src_stride_argb,
                       uint8* dst_u, uint8* dst_v, int width);
 void ARGBToUVRow_Any_AVX2(const uint8* src_argb, int src_stride_argb,
                           uint8* dst_u, uint8* dst_v, int width);
+void ARGBToUVRow_AVX512BW(const uint8* src_argb, int src_stride_argb,
+                          uint8* dst_u, uint8* dst_v, int width);
+void ARGBToUVRow_Any_AVX512BW(const uint8* src_argb, int src_stride_argb,
+                              uint8* dst_u, uint8* dst_v, int width);
 void ARGBToUVRow_SSSE3(const uint8* src_argb, int src_stride_argb,
                        uint8* dst_u, uint8* dst_v, int width);
 void ARGBToUVJRow_SSSE3(const uint8* src_argb, int src_stride_argb,
@@ -802,6 +881,58 @@ void MergeUVRow_Any_AVX2(const uint8* src_u, const uint8* src_v, uint8* dst_uv,
 void MergeUVRow_Any_NEON(const uint8* src_u, const uint8* src_v, uint8* dst_uv,
                          int width);
 
+void SplitRGBRow_C(const uint8* src_rgb, uint8* dst_r,
+                   uint8* dst_g, uint8* dst_b, int width);
+void SplitRGBRow_SSSE3(const uint8* src_rgb, uint8* dst_r,
+                       uint8* dst_g, uint8* dst_b, int width);
+void SplitRGBRow_NEON(const uint8* src_rgb, uint8* dst_r,
+                      uint8* dst_g, uint8* dst_b, int width);
+void SplitRGBRow_Any_SSSE3(const uint8* src_rgb, uint8* dst_r,
+                           uint8* dst_g, uint8* dst_b, int width);
+void SplitRGBRow_Any_NEON(const uint8* src_rgb, uint8* dst_r,
+                          uint8* dst_g, uint8* dst_b, int width);
+
+void SplitXRGBRow_C(const uint8* src_argb, uint8* dst_r,
+                    uint8* dst_g, uint8* dst_b, int width);
+void SplitXRGBRow_SSSE3(const uint8* src_argb, uint8* dst_r,
+                        uint8* dst_g, uint8* dst_b, int width);
+void SplitXRGBRow_AVX2(const uint8* src_argb, uint8* dst_r,
+                       uint8* dst_g, uint8* dst_b, int width);
+void SplitXRGBRow_NEON(const uint8* src_argb, uint8* dst_r,
+                       uint8* dst_g, uint8* dst_b, int width);
+void SplitXRGBRow_Any_SSSE3(const uint8* src_argb, uint8* dst_r,
+                            uint8* dst_g, uint8* dst_b, int width);
+void SplitXRGBRow_Any_AVX2(const uint8* src_argb, uint8* dst_r,
+                           uint8* dst_g, uint8* dst_b, int width);
+void SplitXRGBRow_Any_NEON(const uint8* src_argb, uint8* dst_r,
+                           uint8* dst_g, uint8* dst_b, int width);
+
+void MergeRGBRow_C(const uint8* src_r, const uint8* src_g,
+                   const uint8* src_b, uint8* dst_rgb, int width);
+void MergeRGBRow_SSSE3(const uint8* src_r, const uint8* src_g,
+                       const uint8* src_b, uint8* dst_rgb, int width);
+void MergeRGBRow_NEON(const uint8* src_r, const uint8* src_g,
+                      const uint8* src_b, uint8* dst_rgb, int width);
+void MergeRGBRow_Any_SSSE3(const uint8* src_r, const uint8* src_g,
+                           const uint8* src_b, uint8* dst_rgb, int width);
+void MergeRGBRow_Any_NEON(const uint8* src_r, const uint8* src_g,
+                          const uint8* src_b, uint8* dst_rgb, int width);
+
+void MergeXRGBRow_C(const uint8* src_r, const uint8* src_g,
+                    const uint8* src_b, uint8* dst_argb, int width);
+void MergeXRGBRow_SSE2(const uint8* src_r, const uint8* src_g,
+                       const uint8* src_b, uint8* dst_argb, int width);
+void MergeXRGBRow_AVX2(const uint8* src_r, const uint8* src_g,
+                       const uint8* src_b, uint8* dst_argb, int width);
+void MergeXRGBRow_NEON(const uint8* src_r, const uint8* src_g,
+                       const uint8* src_b, uint8* dst_argb, int width);
+void MergeXRGBRow_Any_SSE2(const uint8* src_r, const uint8* src_g,
+                           const uint8* src_b, uint8* dst_argb, int width);
+void MergeXRGBRow_Any_AVX2(const uint8* src_r, const uint8* src_g,
+                           const uint8* src_b, uint8* dst_argb, int width);
+void MergeXRGBRow_Any_NEON(const uint8* src_r, const uint8* src_g,
+                           const uint8* src_b, uint8* dst_argb, int width);
+
 void CopyRow_SSE2(const uint8* src, uint8* dst, int count);
 void CopyRow_AVX(const uint8* src, uint8* dst, int count);
 void CopyRow_ERMS(const uint8* src, uint8* dst, int count);
@@ -812,6 +943,14 @@ void CopyRow_Any_SSE2(const uint8* src, uint8* dst, int count);
 void CopyRow_Any_AVX(const uint8* src, uint8* dst, int count);
 void CopyRow_Any_NEON(const uint8* src, uint8* dst, int count);
 
+// Non-temporal (streaming) stores that write around the caches.  The
+// destination must be aligned to the store width and count a multiple of
+// the pixels per loop.  x86 needs StoreFence_SSE2 after the last store.
+void CopyRow_NT_SSE2(const uint8* src, uint8* dst, int count);
+void CopyRow_NT_AVX(const uint8* src, uint8* dst, int count);
+void CopyRow_NT_NEON(const uint8* src, uint8* dst, int count);
+void StoreFence_SSE2(void);
+
 void CopyRow_16_C(const uint16* src, uint16* dst, int count);
 
 void ARGBCopyAlphaRow_C(const uint8* src_argb, uint8* dst_argb, int width);
@@ -879,6 +1018,7 @@ void RAWToARGBRow_C(const uint8* src_raw, uint8* dst_argb, int pix);
 void RGB565ToARGBRow_C(const uint8* src_rgb, uint8* dst_argb, int pix);
 void ARGB1555ToARGBRow_C(const uint8* src_argb, uint8* dst_argb, int pix);
 void ARGB4444ToARGBRow_C(const uint8* src_argb, uint8* dst_argb, int pix);
+void AR30ToARGBRow_C(const uint8* src_ar30, uint8* dst_argb, int pix);
 void RGB24ToARGBRow_Any_SSSE3(const uint8* src_rgb24, uint8* dst_argb, int pix);
 void RAWToARGBRow_Any_SSSE3(const uint8* src_raw, uint8* dst_argb, int pix);
 
@@ -894,6 +1034,10 @@ void ARGB1555ToARGBRow_Any_AVX2(const uint8* src_argb1555, uint8* dst_argb,
                                 int pix);
 void ARGB4444ToARGBRow_Any_AVX2(const uint8* src_argb4444, uint8* dst_argb,
                                 int pix);
+void AR30ToARGBRow_SSE2(const uint8* src_ar30, uint8* dst_argb, int pix);
+void AR30ToARGBRow_AVX2(const uint8* src_ar30, uint8* dst_argb, int pix);
+void AR30ToARGBRow_Any_SSE2(const uint8* src_ar30, uint8* dst_argb, int pix);
+void AR30ToARGBRow_Any_AVX2(const uint8* src_ar30, uint8* dst_argb, int pix);
 
 void RGB24ToARGBRow_Any_NEON(const uint8* src_rgb24, uint8* dst_argb, int pix);
 void RAWToARGBRow_Any_NEON(const uint8* src_raw, uint8* dst_argb, int pix);
@@ -935,6 +1079,44 @@ void ARGBToRAWRow_C(const uint8* src_argb, uint8* dst_rgb, int pix);
 void ARGBToRGB565Row_C(const uint8* src_argb, uint8* dst_rgb, int pix);
 void ARGBToARGB1555Row_C(const uint8* src_argb, uint8* dst_rgb, int pix);
 void ARGBToARGB4444Row_C(const uint8* src_argb, uint8* dst_rgb, int pix);
+void ARGBToAR30Row_C(const uint8* src_argb, uint8* dst_ar30, int pix);
+void ARGBToAR30Row_SSSE3(const uint8* src_argb, uint8* dst_ar30, int pix);
+void ARGBToAR30Row_AVX2(const uint8* src_argb, uint8* dst_ar30, int pix);
+void ARGBToAR30Row_Any_SSSE3(const uint8* src_argb, uint8* dst_ar30, int pix);
+void ARGBToAR30Row_Any_AVX2(const uint8* src_argb, uint8* dst_ar30, int pix);
+
+void ARGBToPlanarFloatRow_C(const uint8* src_argb,
+                            float* dst_r, float* dst_g, float* dst_b,
+                            const float* scale_bias, int width);
+void ARGBToPlanarFloatRow_SSE2(const uint8* src_argb,
+                               float* dst_r, float* dst_g, float* dst_b,
+                               const float* scale_bias, int width);
+void ARGBToPlanarFloatRow_AVX2(const uint8* src_argb,
+                               float* dst_r, float* dst_g, float* dst_b,
+                               const float* scale_bias, int width);
+void ARGBToPlanarFloatRow_NEON(const uint8* src_argb,
+                               float* dst_r, float* dst_g, float* dst_b,
+                               const float* scale_bias, int width);
+void ARGBToPlanarFloatRow_Any_SSE2(const uint8* src_argb,
+                                   float* dst_r, float* dst_g, float* dst_b,
+                                   const float* scale_bias, int width);
+void ARGBToPlanarFloatRow_Any_AVX2(const uint8* src_argb,
+                                   float* dst_r, float* dst_g, float* dst_b,
+                                   const float* scale_bias, int width);
+void ARGBToPlanarFloatRow_Any_NEON(const uint8* src_argb,
+                                   float* dst_r, float* dst_g, float* dst_b,
+                                   const float* scale_bias, int width);
+
+void HalfFloatRow_C(const float* src, uint16* dst, float scale, float bias,
+                    int width);
+void HalfFloatRow_F16C(const float* src, uint16* dst, float scale, float bias,
+                       int width);
+void HalfFloatRow_NEON(const float* src, uint16* dst, float scale, float bias,
+                       int width);
+void HalfFloatRow_Any_F16C(const float* src, uint16* dst,
+                           float scale, float bias, int width);
+void HalfFloatRow_Any_NEON(const float* src, uint16* dst,
+                           float scale, float bias, int width);
 
 void J400ToARGBRow_SSE2(const uint8* src_y, uint8* dst_argb, int pix);
 void J400ToARGBRow_AVX2(const uint8* src_y, uint8* dst_argb, int pix);
@@ -1031,6 +1213,16 @@ void I422ToARGBRow_AVX2(const uint8* src_y,
                         const uint8* src_v,
                         uint8* dst_argb,
                         int width);
+void I422ToARGBRow_NT_AVX2(const uint8* src_y,
+                           const uint8* src_u,
+                           const uint8* src_v,
+                           uint8* dst_argb,
+                           int width);
+void I422ToARGBRow_AVX512BW(const uint8* src_y,
+                            const uint8* src_u,
+                            const uint8* src_v,
+                            uint8* dst_argb,
+                            int width);
 void I422ToBGRARow_AVX2(const uint8* src_y,
                         const uint8* src_u,
                         const uint8* src_v,
@@ -1083,6 +1275,10 @@ void NV12ToARGBRow_AVX2(const uint8* src_y,
                         const uint8* src_uv,
                         uint8* dst_argb,
                         int width);
+void NV12ToARGBRow_AVX512BW(const uint8* src_y,
+                            const uint8* src_uv,
+                            uint8* dst_argb,
+                            int width);
 void NV21ToARGBRow_AVX2(const uint8* src_y,
                         const uint8* src_vu,
                         uint8* dst_argb,
@@ -1195,6 +1391,51 @@ void I422ToARGBRow_Any_AVX2(const uint8* src_y,
                             const uint8* src_v,
                             uint8* dst_argb,
                             int width);
+void I422ToARGBRow_Any_AVX512BW(const uint8* src_y,
+                                const uint8* src_u,
+                                const uint8* src_v,
+                                uint8* dst_argb,
+                                int width);
+void I422ToAR30Row_C(const uint8* src_y,
+                     const uint8* src_u,
+                     const uint8* src_v,
+                     uint8* dst_ar30,
+                     int width);
+void I422ToAR30Row_SSSE3(const uint8* src_y,
+                         const uint8* src_u,
+                         const uint8* src_v,
+                         uint8* dst_ar30,
+                         int width);
+void I422ToAR30Row_AVX2(const uint8* src_y,
+                        const uint8* src_u,
+                        const uint8* src_v,
+                        uint8* dst_ar30,
+                        int width);
+void I422ToAR30Row_Any_SSSE3(const uint8* src_y,
+                             const uint8* src_u,
+                             const uint8* src_v,
+                             uint8* dst_ar30,
+                             int width);
+void I422ToAR30Row_Any_AVX2(const uint8* src_y,
+                            const uint8* src_u,
+                            const uint8* src_v,
+                            uint8* dst_ar30,
+                            int width);
+void I210ToAR30Row_C(const uint16* src_y,
+                     const uint16* src_u,
+                     const uint16* src_v,
+                     uint8* dst_ar30,
+                     int width);
+void I210ToAR30Row_SSSE3(const uint16* src_y,
+                         const uint16* src_u,
+                         const uint16* src_v,
+                         uint8* dst_ar30,
+                         int width);
+void I210ToAR30Row_Any_SSSE3(const uint16* src_y,
+                             const uint16* src_u,
+                             const uint16* src_v,
+                             uint8* dst_ar30,
+                             int width);
 void I422ToBGRARow_Any_AVX2(const uint8* src_y,
                             const uint8* src_u,
                             const uint8* src_v,
@@ -1247,6 +1488,10 @@ void NV12ToARGBRow_Any_AVX2(const uint8* src_y,
                             const uint8* src_uv,
                             uint8* dst_argb,
                             int width);
+void NV12ToARGBRow_Any_AVX512BW(const uint8* src_y,
+                                const uint8* src_uv,
+                                uint8* dst_argb,
+                                int width);
 void NV21ToARGBRow_Any_AVX2(const uint8* src_y,
                             const uint8* src_vu,
                             uint8* dst_argb,
@@ -1364,6 +1609,8 @@ void I400ToARGBRow_Any_AVX2(const uint8* src_y, uint8* dst_argb, int width);
 void I400ToARGBRow_Any_NEON(const uint8* src_y, uint8* dst_argb, int width);
 
 // ARGB preattenuated alpha blend.
+void ARGBBlendRow_AVX512BW(const uint8* src_argb, const uint8* src_argb1,
+                           uint8* dst_argb, int width);
 void ARGBBlendRow_SSSE3(const uint8* src_argb, const uint8* src_argb1,
                         uint8* dst_argb, int width);
 void ARGBBlendRow_SSE2(const uint8* src_argb, const uint8* src_argb1,
@@ -1559,6 +1806,11 @@ void YUY2ToUVRow_AVX2(const uint8* src_yuy2, int stride_yuy2,
                       uint8* dst_u, uint8* dst_v, int pix);
 void YUY2ToUV422Row_AVX2(const uint8* src_yuy2,
                          uint8* dst_u, uint8* dst_v, int pix);
+void YUY2ToYRow_AVX512BW(const uint8* src_yuy2, uint8* dst_y, int pix);
+void YUY2ToUVRow_AVX512BW(const uint8* src_yuy2, int stride_yuy2,
+                          uint8* dst_u, uint8* dst_v, int pix);
+void YUY2ToUV422Row_AVX512BW(const uint8* src_yuy2,
+                             uint8* dst_u, uint8* dst_v, int pix);
 void YUY2ToYRow_SSE2(const uint8* src_yuy2, uint8* dst_y, int pix);
 void YUY2ToUVRow_SSE2(const uint8* src_yuy2, int stride_yuy2,
                       uint8* dst_u, uint8* dst_v, int pix);
@@ -1579,6 +1831,11 @@ void YUY2ToUVRow_Any_AVX2(const uint8* src_yuy2, int stride_yuy2,
                           uint8* dst_u, uint8* dst_v, int pix);
 void YUY2ToUV422Row_Any_AVX2(const uint8* src_yuy2,
                              uint8* dst_u, uint8* dst_v, int pix);
+void YUY2ToYRow_Any_AVX512BW(const uint8* src_yuy2, uint8* dst_y, int pix);
+void YUY2ToUVRow_Any_AVX512BW(const uint8* src_yuy2, int stride_yuy2,
+                              uint8* dst_u, uint8* dst_v, int pix);
+void YUY2ToUV422Row_Any_AVX512BW(const uint8* src_yuy2,
+                                 uint8* dst_u, uint8* dst_v, int pix);
 void YUY2ToYRow_Any_SSE2(const uint8* src_yuy2, uint8* dst_y, int pix);
 void YUY2ToUVRow_Any_SSE2(const uint8* src_yuy2, int stride_yuy2,
                           uint8* dst_u, uint8* dst_v, int pix);
@@ -1604,6 +1861,11 @@ void UYVYToUVRow_AVX2(const uint8* src_uyvy, int stride_uyvy,
                       uint8* dst_u, uint8* dst_v, int pix);
 void UYVYToUV422Row_AVX2(const uint8* src_uyvy,
                          uint8* dst_u, uint8* dst_v, int pix);
+void UYVYToYRow_AVX512BW(const uint8* src_uyvy, uint8* dst_y, int pix);
+void UYVYToUVRow_AVX512BW(const uint8* src_uyvy, int stride_uyvy,
+                          uint8* dst_u, uint8* dst_v, int pix);
+void UYVYToUV422Row_AVX512BW(const uint8* src_uyvy,
+                             uint8* dst_u, uint8* dst_v, int pix);
 void UYVYToYRow_NEON(const uint8* src_uyvy, uint8* dst_y, int pix);
 void UYVYToUVRow_NEON(const uint8* src_uyvy, int stride_uyvy,
                       uint8* dst_u, uint8* dst_v, int pix);
@@ -1620,6 +1882,11 @@ void UYVYToUVRow_Any_AVX2(const uint8* src_uyvy, int stride_uyvy,
                           uint8* dst_u, uint8* dst_v, int pix);
 void UYVYToUV422Row_Any_AVX2(const uint8* src_uyvy,
                              uint8* dst_u, uint8* dst_v, int pix);
+void UYVYToYRow_Any_AVX512BW(const uint8* src_uyvy, uint8* dst_y, int pix);
+void UYVYToUVRow_Any_AVX512BW(const uint8* src_uyvy, int stride_uyvy,
+                              uint8* dst_u, uint8* dst_v, int pix);
+void UYVYToUV422Row_Any_AVX512BW(const uint8* src_uyvy,
+                                 uint8* dst_u, uint8* dst_v, int pix);
 void UYVYToYRow_Any_SSE2(const uint8* src_uyvy, uint8* dst_y, int pix);
 void UYVYToUVRow_Any_SSE2(const uint8* src_uyvy, int stride_uyvy,
                           uint8* dst_u, uint8* dst_v, int pix);
@@ -1763,6 +2030,9 @@ void InterpolateRow_SSSE3(uint8* dst_ptr, const uint8* src_ptr,
 void InterpolateRow_AVX2(uint8* dst_ptr, const uint8* src_ptr,
                          ptrdiff_t src_stride_ptr, int width,
                          int source_y_fraction);
+void InterpolateRow_AVX512BW(uint8* dst_ptr, const uint8* src_ptr,
+                             ptrdiff_t src_stride_ptr, int width,
+                             int source_y_fraction);
 void InterpolateRow_NEON(uint8* dst_ptr, const uint8* src_ptr,
                          ptrdiff_t src_stride_ptr, int width,
                          int source_y_fraction);
@@ -1781,6 +2051,9 @@ void InterpolateRow_Any_SSSE3(uint8* dst_ptr, const uint8* src_ptr,
 void InterpolateRow_Any_AVX2(uint8* dst_ptr, const uint8* src_ptr,
                              ptrdiff_t src_stride_ptr, int width,
                              int source_y_fraction);
+void InterpolateRow_Any_AVX512BW(uint8* dst_ptr, const uint8* src_ptr,
+                                 ptrdiff_t src_stride_ptr, int width,
+                                 int source_y_fraction);
 void InterpolateRow_Any_MIPS_DSPR2(uint8* dst_ptr, const uint8* src_ptr,
                                    ptrdiff_t src_stride_ptr, int width,
                                    int source_y_fraction);
@@ -1849,6 +2122,36 @@ void ARGBLumaColorTableRow_SSSE3(const uint8* src_argb, uint8* dst_argb,
                                  int width,
                                  const uint8* luma, uint32 lumacoeff);
 
+// Bilinear demosaic of src_bayer1, with the rows above and below, to ARGB.
+// pattern bit 0 is set when the red or blue pixels of src_bayer1 are at odd
+// x; bit 1 is set when they are red.  Reads 1 pixel left and right of each
+// row.
+void BayerToARGBRow_C(const uint8* src_bayer0, const uint8* src_bayer1,
+                      const uint8* src_bayer2, uint8* dst_argb,
+                      int pattern, int width);
+void BayerToARGBRow_SSE2(const uint8* src_bayer0, const uint8* src_bayer1,
+                         const uint8* src_bayer2, uint8* dst_argb,
+                         int pattern, int width);
+void BayerToARGBRow_NEON(const uint8* src_bayer0, const uint8* src_bayer1,
+                         const uint8* src_bayer2, uint8* dst_argb,
+                         int pattern, int width);
+void BayerToARGBRow_Any_SSE2(const uint8* src_bayer0, const uint8* src_bayer1,
+                             const uint8* src_bayer2, uint8* dst_argb,
+                             int pattern, int width);
+void BayerToARGBRow_Any_NEON(const uint8* src_bayer0, const uint8* src_bayer1,
+                             const uint8* src_bayer2, uint8* dst_argb,
+                             int pattern, int width);
+
+// Returns the offset of the first JPEG marker in src, or count if none.
+// A marker is 0xff followed by a byte other than 0x00 (stuffing), 0xff (fill)
+// or 0xd0 to 0xd7 (restart).  Reads src[count] for the byte following the
+// last position.  SIMD versions require count to be a multiple of 16, or 32
+// for AVX2.
+int ScanJpegMarkerRow_C(const uint8* src, int count);
+int ScanJpegMarkerRow_SSE2(const uint8* src, int count);
+int ScanJpegMarkerRow_AVX2(const uint8* src, int count);
+int ScanJpegMarkerRow_NEON(const uint8* src, int count);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
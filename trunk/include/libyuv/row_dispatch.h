@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_ROW_DISPATCH_H_  // NOLINT
+#define INCLUDE_LIBYUV_ROW_DISPATCH_H_
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Table of row functions for the most used conversions, resolved once for
+// the current cpu flags instead of on every call.  The table is resolved
+// again when MaskCpuFlags changes the flags.  Resolved tables are published
+// whole, so conversions may run on several threads.
+
+// Row functions in the table.
+enum RowFunctionId {
+  kRowI422ToARGB = 0,
+  kRowARGBToY,
+  kRowARGBToUV,
+  kRowCopy,
+  kRowFunctionCount
+};
+
+// Generic row function pointer.  Cast to the type of the row function.
+typedef void (*RowFunction)(void);
+
+typedef void (*I422ToARGBRowFunction)(const uint8* src_y,
+                                      const uint8* src_u,
+                                      const uint8* src_v,
+                                      uint8* dst_argb,
+                                      int width);
+typedef void (*ARGBToYRowFunction)(const uint8* src_argb, uint8* dst_y,
+                                   int pix);
+typedef void (*ARGBToUVRowFunction)(const uint8* src_argb, int src_stride_argb,
+                                    uint8* dst_u, uint8* dst_v, int width);
+typedef void (*CopyRowFunction)(const uint8* src, uint8* dst, int count);
+
+// Returns the row function for a width.  Widths that are a multiple of the
+// SIMD width use the full SIMD function and others use the _Any_ version.
+LIBYUV_API
+RowFunction GetRowFunction(int function_id, int width);
+
+// Returns the name of the row function GetRowFunction returns for a width,
+// ie "I422ToARGBRow_AVX2", or "override" for a function set by
+// SetRowFunction.  Returns NULL for an invalid function_id.
+// Set the LIBYUV_TRACE environment variable before the first conversion to
+// print the row function chosen by each conversion to stderr whenever it
+// changes.  It is read once.
+LIBYUV_API
+const char* GetRowFunctionName(int function_id, int width);
+
+// Returns the kCpuHas flag of the row functions GetRowFunction returns, ie
+// kCpuHasAVX2, or 0 for C, an override or an invalid function_id.
+LIBYUV_API
+int GetRowFunctionCpuFlag(int function_id);
+
+// Override a row function, ie to test one implementation.  any_function
+// handles every width and function is used when width is a multiple of
+// width_mask + 1.  Pass NULL for any_function to restore the resolved
+// function.  Returns 0 on success or -1 on an invalid function_id.
+// Not thread safe: call it while no conversions are running.
+LIBYUV_API
+int SetRowFunction(int function_id, RowFunction any_function,
+                   RowFunction function, int width_mask);
+
+// Returns the width of the column strips that a conversion processes its
+// rows in, so that the rows of one loop, which touch bytes_per_pixel bytes
+// per pixel, stay in the L1 cache from one row function to the next.
+// Returns width when the whole rows fit.  Strips are a multiple of 64 pixels
+// so the row function chosen for width works for every strip.
+LIBYUV_API
+int GetRowStripWidth(int width, int bytes_per_pixel);
+
+// Override the bytes of cache a strip may use, ie to test strips on small
+// images.  Pass 0 to restore the size from GetCpuCacheInfo.
+LIBYUV_API
+void SetRowStripBytes(int strip_bytes);
+
+// Streaming (non-temporal) stores write the destination around the caches,
+// for frames handed straight to an encoder or GPU upload that would
+// otherwise evict its working set from the last level cache.
+enum StreamingStoreMode {
+  kStreamingStoresOff = 0,  // Default.
+  kStreamingStoresLarge,    // Destinations larger than the last level cache.
+  kStreamingStoresOn,       // All destinations.
+};
+
+// Set the streaming store mode of I420ToARGB, I422ToARGB and CopyPlane,
+// which includes I420Copy and ScalePlane when it does not scale.
+// Streaming stores are used when the destination and its stride are aligned
+// to 32 bytes (16 bytes for SSE2), and are fenced before the function
+// returns.  Other destinations use the normal row functions.
+LIBYUV_API
+void SetStreamingStores(int mode);
+
+// Returns 1 if a destination of size bytes is written with streaming stores
+// in the current mode.
+LIBYUV_API
+int UseStreamingStores(int64 size);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_ROW_DISPATCH_H_  NOLINT
@@ -117,6 +117,7 @@
       'sources': [
         # sources
         'util/convert.cc',
+        'util/y4m.cc',
       ],
       'conditions': [
         ['OS=="linux"', {
@@ -135,6 +136,7 @@
         'util/psnr_main.cc',
         'util/psnr.cc',
         'util/ssim.cc',
+        'util/y4m.cc',
       ],
       'dependencies': [
         'libyuv.gyp:libyuv',
@@ -11,17 +11,20 @@ LOCAL_OBJ_FILES := \
     source/compare_gcc.o       \
     source/convert.o           \
     source/convert_argb.o      \
+    source/convert_bayer.o     \
     source/convert_from.o      \
     source/convert_from_argb.o \
     source/convert_to_argb.o   \
     source/convert_to_i420.o   \
     source/cpu_id.o            \
+    source/perf_counters.o     \
     source/planar_functions.o  \
     source/rotate.o            \
     source/rotate_argb.o       \
     source/rotate_mips.o       \
     source/row_any.o           \
     source/row_common.o        \
+    source/row_dispatch.o      \
     source/row_mips.o          \
     source/row_gcc.o           \
     source/scale.o             \
@@ -35,15 +38,24 @@ LOCAL_OBJ_FILES := \
 .cc.o:
 	$(CXX) -c $(CXXFLAGS) $*.cc -o $*.o
 
-all: libyuv.a convert
+all: libyuv.a convert libyuv_benchmark psnr
 
 libyuv.a: $(LOCAL_OBJ_FILES)
 	$(AR) $(ARFLAGS) $@ $(LOCAL_OBJ_FILES)
 
 # A test utility that uses libyuv conversion.
-convert: util/convert.cc libyuv.a
-	$(CXX) $(CXXFLAGS) -Iutil/ -o $@ util/convert.cc libyuv.a
+convert: util/convert.cc util/y4m.cc libyuv.a
+	$(CXX) $(CXXFLAGS) -Iutil/ -o $@ util/convert.cc util/y4m.cc libyuv.a
+
+# Micro benchmark of row kernels and public functions.
+libyuv_benchmark: util/benchmark.cc libyuv.a
+	$(CXX) $(CXXFLAGS) -Iutil/ -o $@ util/benchmark.cc libyuv.a
+
+# A PSNR and SSIM tool that uses libyuv for the sum square error.
+psnr: util/psnr_main.cc util/psnr.cc util/ssim.cc util/y4m.cc libyuv.a
+	$(CXX) $(CXXFLAGS) -Iutil/ -o $@ util/psnr_main.cc util/psnr.cc \
+	    util/ssim.cc util/y4m.cc libyuv.a
 
 clean:
-	/bin/rm -f source/*.o *.ii *.s libyuv.a convert
+	/bin/rm -f source/*.o *.ii *.s libyuv.a convert libyuv_benchmark psnr
 
@@ -12,6 +12,7 @@
 
 #include <float.h>
 #include <math.h>
+#include <string.h>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -19,6 +20,7 @@
 #include "libyuv/basic_types.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/row.h"
+#include "libyuv/scale_row.h"
 #include "libyuv/video_common.h"
 
 #ifdef __cplusplus
@@ -37,11 +39,17 @@ uint32 HashDjb2_C(const uint8* src, int count, uint32 seed);
 #define HAS_HASHDJB2_SSE41
 uint32 HashDjb2_SSE41(const uint8* src, int count, uint32 seed);
 
-#ifdef VISUALC_HAS_AVX2
+#if defined(VISUALC_HAS_AVX2) || defined(CLANG_HAS_AVX2) || \
+    defined(GCC_HAS_AVX2)
 #define HAS_HASHDJB2_AVX2
 uint32 HashDjb2_AVX2(const uint8* src, int count, uint32 seed);
 #endif
 
+#if defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512)
+#define HAS_HASHDJB2_AVX512BW
+uint32 HashDjb2_AVX512BW(const uint8* src, int count, uint32 seed);
+#endif
+
 #endif  // HAS_HASHDJB2_SSE41
 
 // hash seed of 5381 recommended.
@@ -49,6 +57,7 @@ LIBYUV_API
 uint32 HashDjb2(const uint8* src, uint64 count, uint32 seed) {
   const int kBlockSize = 1 << 15;  // 32768;
   int remainder;
+  int simd_mask = 15;
   uint32 (*HashDjb2_SSE)(const uint8* src, int count, uint32 seed) = HashDjb2_C;
 #if defined(HAS_HASHDJB2_SSE41)
   if (TestCpuFlag(kCpuHasSSE41)) {
@@ -58,6 +67,13 @@ uint32 HashDjb2(const uint8* src, uint64 count, uint32 seed) {
 #if defined(HAS_HASHDJB2_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
     HashDjb2_SSE = HashDjb2_AVX2;
+    simd_mask = 63;
+  }
+#endif
+#if defined(HAS_HASHDJB2_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    HashDjb2_SSE = HashDjb2_AVX512BW;
+    simd_mask = 127;
   }
 #endif
 
@@ -66,13 +82,13 @@ uint32 HashDjb2(const uint8* src, uint64 count, uint32 seed) {
     src += kBlockSize;
     count -= kBlockSize;
   }
-  remainder = (int)(count) & ~15;
+  remainder = (int)(count) & ~simd_mask;
   if (remainder) {
     seed = HashDjb2_SSE(src, remainder, seed);
     src += remainder;
     count -= remainder;
   }
-  remainder = (int)(count) & 15;
+  remainder = (int)(count) & simd_mask;
   if (remainder) {
     seed = HashDjb2_C(src, remainder, seed);
   }
@@ -107,12 +123,53 @@ static uint32 ARGBDetectRow_C(const uint8* argb, int width) {
   return 0;
 }
 
+// SIMD row functions return the number of leading pixels with alpha of 255
+// in both bytes 0 and 3, leaving the pixel that decides to ARGBDetectRow_C.
+void ARGBMinMaxRow_C(const uint8* src_argb, uint8* dst_minmax, int width);
+#if !defined(LIBYUV_DISABLE_NEON) && \
+    (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
+#define HAS_ARGBDETECTROW_NEON
+int ARGBDetectRow_NEON(const uint8* src_argb, int width);
+void ARGBMinMaxRow_NEON(const uint8* src_argb, uint8* dst_minmax, int width);
+#endif
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define HAS_ARGBDETECTROW_SSE2
+int ARGBDetectRow_SSE2(const uint8* src_argb, int width);
+void ARGBMinMaxRow_SSE2(const uint8* src_argb, uint8* dst_minmax, int width);
+#if defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2)
+#define HAS_ARGBDETECTROW_AVX2
+int ARGBDetectRow_AVX2(const uint8* src_argb, int width);
+void ARGBMinMaxRow_AVX2(const uint8* src_argb, uint8* dst_minmax, int width);
+#endif
+#endif
+
 // Scan an opaque argb image and return fourcc based on alpha offset.
 // Returns FOURCC_ARGB, FOURCC_BGRA, or 0 if unknown.
 LIBYUV_API
 uint32 ARGBDetect(const uint8* argb, int stride_argb, int width, int height) {
   uint32 fourcc = 0;
   int h;
+  int (*ARGBDetectRow)(const uint8* src_argb, int width) = NULL;
+  int simd_mask = 0;
+#if defined(HAS_ARGBDETECTROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ARGBDetectRow = ARGBDetectRow_NEON;
+    simd_mask = 15;
+  }
+#endif
+#if defined(HAS_ARGBDETECTROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ARGBDetectRow = ARGBDetectRow_SSE2;
+    simd_mask = 15;
+  }
+#endif
+#if defined(HAS_ARGBDETECTROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBDetectRow = ARGBDetectRow_AVX2;
+    simd_mask = 31;
+  }
+#endif
 
   // Coalesce rows.
   if (stride_argb == width * 4) {
@@ -121,12 +178,240 @@ uint32 ARGBDetect(const uint8* argb, int stride_argb, int width, int height) {
     stride_argb = 0;
   }
   for (h = 0; h < height && fourcc == 0; ++h) {
-    fourcc = ARGBDetectRow_C(argb, width);
+    int x = 0;
+    if (ARGBDetectRow && (width & ~simd_mask)) {
+      x = ARGBDetectRow(argb, width & ~simd_mask);
+    }
+    fourcc = ARGBDetectRow_C(argb + x * 4, width - x);
     argb += stride_argb;
   }
   return fourcc;
 }
 
+static int ARGBAlphaFlags(const uint8* minmax) {
+  int flags = 0;
+  if (minmax[0] == 255) {
+    flags |= kAlphaByte0Opaque;
+  }
+  if (minmax[3] == 255) {
+    flags |= kAlphaByte3Opaque;
+  }
+  if (minmax[4] == 0) {
+    flags |= kAlphaByte0Zero;
+  }
+  if (minmax[7] == 0) {
+    flags |= kAlphaByte3Zero;
+  }
+  return flags;
+}
+
+// Scan an argb image for bytes 0 and 3 that are always 255 or always 0.
+// Stops at the first row that rules out every layout.
+LIBYUV_API
+int ARGBDetectAlpha(const uint8* argb, int stride_argb, int width, int height) {
+  uint8 minmax[8] = { 255, 255, 255, 255, 0, 0, 0, 0 };
+  int flags = kAlphaByte0Opaque | kAlphaByte3Opaque |
+              kAlphaByte0Zero | kAlphaByte3Zero;
+  int h;
+  void (*ARGBMinMaxRow)(const uint8* src_argb, uint8* dst_minmax,
+                        int width) = ARGBMinMaxRow_C;
+  int simd_mask = 0;
+  if (!argb || width <= 0 || height == 0) {
+    return -1;
+  }
+  if (height < 0) {
+    height = -height;
+  }
+#if defined(HAS_ARGBDETECTROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ARGBMinMaxRow = ARGBMinMaxRow_NEON;
+#if defined(__aarch64__)
+    simd_mask = 15;
+#else
+    simd_mask = 7;
+#endif
+  }
+#endif
+#if defined(HAS_ARGBDETECTROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ARGBMinMaxRow = ARGBMinMaxRow_SSE2;
+    simd_mask = 7;
+  }
+#endif
+#if defined(HAS_ARGBDETECTROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBMinMaxRow = ARGBMinMaxRow_AVX2;
+    simd_mask = 15;
+  }
+#endif
+
+  // Coalesce rows.
+  if (stride_argb == width * 4) {
+    width *= height;
+    height = 1;
+    stride_argb = 0;
+  }
+  for (h = 0; h < height && flags != 0; ++h) {
+    int simd_width = width & ~simd_mask;
+    if (simd_width) {
+      ARGBMinMaxRow(argb, minmax, simd_width);
+    }
+    if (width > simd_width) {
+      ARGBMinMaxRow_C(argb + simd_width * 4, minmax, width - simd_width);
+    }
+    flags = ARGBAlphaFlags(minmax);
+    argb += stride_argb;
+  }
+  return flags;
+}
+
+int FindFirstDiff_C(const uint8* src_a, const uint8* src_b, int count);
+#if !defined(LIBYUV_DISABLE_NEON) && \
+    (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
+#define HAS_FINDFIRSTDIFF_NEON
+int FindFirstDiff_NEON(const uint8* src_a, const uint8* src_b, int count);
+#endif
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define HAS_FINDFIRSTDIFF_SSE2
+int FindFirstDiff_SSE2(const uint8* src_a, const uint8* src_b, int count);
+#if defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2)
+#define HAS_FINDFIRSTDIFF_AVX2
+int FindFirstDiff_AVX2(const uint8* src_a, const uint8* src_b, int count);
+#endif
+#endif
+
+// Returns the offset of the first byte that differs, or count if none do.
+// The SIMD function compares multiples of simd_mask + 1 bytes.
+static int FirstDiff(const uint8* src_a, const uint8* src_b, int count,
+                     int (*FindFirstDiff)(const uint8* src_a,
+                                          const uint8* src_b, int count),
+                     int simd_mask) {
+  int simd_count = count & ~simd_mask;
+  if (simd_count) {
+    int i = FindFirstDiff(src_a, src_b, simd_count);
+    if (i < simd_count) {
+      return i;
+    }
+  }
+  return simd_count + FindFirstDiff_C(src_a + simd_count, src_b + simd_count,
+                                      count - simd_count);
+}
+
+// Marks the dirty tiles of one row of tiles.  Each row is compared as runs
+// of consecutive clean tiles, so an unchanged row is a single compare, and
+// a tile is skipped for the remaining rows once a difference is found.
+static int DirtyTileRow(const uint8* src_a, int stride_a,
+                        const uint8* src_b, int stride_b,
+                        int width, int height, int tile_width,
+                        uint8* dst_dirty,
+                        int (*FindFirstDiff)(const uint8* src_a,
+                                             const uint8* src_b, int count),
+                        int simd_mask) {
+  const int num_tiles = (width + tile_width - 1) / tile_width;
+  int num_clean = num_tiles;
+  int y;
+  memset(dst_dirty, 0, num_tiles);
+  // Coalesce rows of a single column of tiles.
+  if (num_tiles == 1 && stride_a == width && stride_b == width) {
+    width *= height;
+    height = 1;
+    tile_width = width;
+  }
+  for (y = 0; y < height && num_clean > 0; ++y) {
+    int x = 0;
+    while (x < width) {
+      int tile = x / tile_width;
+      int end = (tile + 1) * tile_width;
+      int i;
+      if (dst_dirty[tile]) {
+        x = end;
+        continue;
+      }
+      while (end < width && !dst_dirty[end / tile_width]) {
+        end += tile_width;
+      }
+      if (end > width) {
+        end = width;
+      }
+      i = FirstDiff(src_a + x, src_b + x, end - x, FindFirstDiff, simd_mask);
+      if (i == end - x) {
+        x = end;
+        continue;
+      }
+      tile = (x + i) / tile_width;
+      dst_dirty[tile] = 1;
+      --num_clean;
+      x = (tile + 1) * tile_width;
+    }
+    src_a += stride_a;
+    src_b += stride_b;
+  }
+  return num_tiles - num_clean;
+}
+
+// Compare 2 planes tile by tile and mark the tiles that differ.
+LIBYUV_API
+int PlaneDirtyRects(const uint8* src_a, int stride_a,
+                    const uint8* src_b, int stride_b,
+                    int width, int height, int tile_width, int tile_height,
+                    uint8* dst_dirty, int dst_stride) {
+  int num_dirty = 0;
+  int y;
+  int (*FindFirstDiff)(const uint8* src_a, const uint8* src_b, int count) =
+      FindFirstDiff_C;
+  int simd_mask = 0;
+  if (!src_a || !src_b || !dst_dirty || width <= 0 || height <= 0 ||
+      tile_width <= 0 || tile_height <= 0) {
+    return -1;
+  }
+  if (tile_width > width) {
+    tile_width = width;
+  }
+#if defined(HAS_FINDFIRSTDIFF_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    FindFirstDiff = FindFirstDiff_NEON;
+    simd_mask = 15;
+  }
+#endif
+#if defined(HAS_FINDFIRSTDIFF_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    FindFirstDiff = FindFirstDiff_SSE2;
+    simd_mask = 15;
+  }
+#endif
+#if defined(HAS_FINDFIRSTDIFF_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    FindFirstDiff = FindFirstDiff_AVX2;
+    simd_mask = 31;
+  }
+#endif
+  for (y = 0; y < height; y += tile_height) {
+    int rows = height - y < tile_height ? height - y : tile_height;
+    num_dirty += DirtyTileRow(src_a, stride_a, src_b, stride_b,
+                              width, rows, tile_width, dst_dirty,
+                              FindFirstDiff, simd_mask);
+    src_a += stride_a * rows;
+    src_b += stride_b * rows;
+    dst_dirty += dst_stride;
+  }
+  return num_dirty;
+}
+
+// Compare 2 ARGB images tile by tile and mark the tiles that differ.
+LIBYUV_API
+int ARGBDirtyRects(const uint8* src_argb_a, int stride_argb_a,
+                   const uint8* src_argb_b, int stride_argb_b,
+                   int width, int height, int tile_width, int tile_height,
+                   uint8* dst_dirty, int dst_stride) {
+  if (width <= 0 || tile_width <= 0) {
+    return -1;
+  }
+  return PlaneDirtyRects(src_argb_a, stride_argb_a, src_argb_b, stride_argb_b,
+                         width * 4, height, tile_width * 4, tile_height,
+                         dst_dirty, dst_stride);
+}
+
 uint32 SumSquareError_C(const uint8* src_a, const uint8* src_b, int count);
 #if !defined(LIBYUV_DISABLE_NEON) && \
     (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
@@ -139,10 +424,97 @@ uint32 SumSquareError_NEON(const uint8* src_a, const uint8* src_b, int count);
 uint32 SumSquareError_SSE2(const uint8* src_a, const uint8* src_b, int count);
 #endif
 
-#ifdef VISUALC_HAS_AVX2
+#if !defined(LIBYUV_DISABLE_X86) && (defined(VISUALC_HAS_AVX2) || \
+    ((defined(__x86_64__) || defined(__i386__)) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))))
 #define HAS_SUMSQUAREERROR_AVX2
 uint32 SumSquareError_AVX2(const uint8* src_a, const uint8* src_b, int count);
 #endif
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512))
+#define HAS_SUMSQUAREERROR_AVX512BW
+uint32 SumSquareError_AVX512BW(const uint8* src_a, const uint8* src_b,
+                               int count);
+#endif
+
+uint64 SumSquareError_16_C(const uint16* src_a, const uint16* src_b,
+                           int count);
+#if !defined(LIBYUV_DISABLE_NEON) && \
+    (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
+#define HAS_SUMSQUAREERROR_16_NEON
+uint64 SumSquareError_16_NEON(const uint16* src_a, const uint16* src_b,
+                              int count);
+#endif
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define HAS_SUMSQUAREERROR_16_SSE2
+uint64 SumSquareError_16_SSE2(const uint16* src_a, const uint16* src_b,
+                              int count);
+#if defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2)
+#define HAS_SUMSQUAREERROR_16_AVX2
+uint64 SumSquareError_16_AVX2(const uint16* src_a, const uint16* src_b,
+                              int count);
+#endif
+#endif
+
+// Block kernels add the error of each group of 8 values into an array.
+void SumSquareErrorBlock8_C(const uint8* src_a, const uint8* src_b,
+                            uint32* dst_sse, int count);
+void SumAbsDiffBlock8_C(const uint8* src_a, const uint8* src_b,
+                        uint32* dst_sad, int count);
+#if !defined(LIBYUV_DISABLE_NEON) && \
+    (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
+#define HAS_SUMSQUAREERRORBLOCK8_NEON
+void SumSquareErrorBlock8_NEON(const uint8* src_a, const uint8* src_b,
+                               uint32* dst_sse, int count);
+void SumAbsDiffBlock8_NEON(const uint8* src_a, const uint8* src_b,
+                           uint32* dst_sad, int count);
+#endif
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define HAS_SUMSQUAREERRORBLOCK8_SSE2
+void SumSquareErrorBlock8_SSE2(const uint8* src_a, const uint8* src_b,
+                               uint32* dst_sse, int count);
+void SumAbsDiffBlock8_SSE2(const uint8* src_a, const uint8* src_b,
+                           uint32* dst_sad, int count);
+#endif
+
+uint32 SadBlock_C(const uint8* src_a, int stride_a,
+                  const uint8* src_b, int stride_b,
+                  int width, int height);
+uint32 SatdBlock_C(const uint8* src_a, int stride_a,
+                   const uint8* src_b, int stride_b,
+                   int width, int height);
+#if !defined(LIBYUV_DISABLE_NEON) && \
+    (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
+#define HAS_SADBLOCK_NEON
+uint32 SadBlock16_NEON(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height);
+uint32 SadBlock8_NEON(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, int height);
+uint32 SatdBlock8_NEON(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height);
+#endif
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define HAS_SADBLOCK_SSE2
+uint32 SadBlock16_SSE2(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height);
+uint32 SadBlock8_SSE2(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, int height);
+uint32 SadBlock4_SSE2(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, int height);
+uint32 SatdBlock8_SSE2(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height);
+#if defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2)
+#define HAS_SADBLOCK_AVX2
+uint32 SadBlock32_AVX2(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height);
+uint32 SatdBlock16_AVX2(const uint8* src_a, int stride_a,
+                        const uint8* src_b, int stride_b, int height);
+#endif
+#endif
 
 // TODO(fbarchard): Refactor into row function.
 LIBYUV_API
@@ -152,7 +524,8 @@ uint64 ComputeSumSquareError(const uint8* src_a, const uint8* src_b,
   // Up to 65536 of those can be summed and remain within a uint32.
   // After each block of 65536 pixels, accumulate into a uint64.
   const int kBlockSize = 65536;
-  int remainder = count & (kBlockSize - 1) & ~31;
+  int simd_mask = 31;
+  int remainder;
   uint64 sse = 0;
   int i;
   uint32 (*SumSquareError)(const uint8* src_a, const uint8* src_b, int count) =
@@ -174,6 +547,14 @@ uint64 ComputeSumSquareError(const uint8* src_a, const uint8* src_b,
     SumSquareError = SumSquareError_AVX2;
   }
 #endif
+#if defined(HAS_SUMSQUAREERROR_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    // Note only used for multiples of 64 so count is not checked.
+    SumSquareError = SumSquareError_AVX512BW;
+    simd_mask = 63;
+  }
+#endif
+  remainder = count & (kBlockSize - 1) & ~simd_mask;
 #ifdef _OPENMP
 #pragma omp parallel for reduction(+: sse)
 #endif
@@ -187,7 +568,7 @@ uint64 ComputeSumSquareError(const uint8* src_a, const uint8* src_b,
     src_a += remainder;
     src_b += remainder;
   }
-  remainder = count & 31;
+  remainder = count & simd_mask;
   if (remainder) {
     sse += SumSquareError_C(src_a, src_b, remainder);
   }
@@ -215,6 +596,543 @@ uint64 ComputeSumSquareErrorPlane(const uint8* src_a, int stride_a,
   return sse;
 }
 
+LIBYUV_API
+uint64 ComputeSumSquareError_16(const uint16* src_a, const uint16* src_b,
+                                int count) {
+  int simd_count;
+  int simd_mask = 0;
+  uint64 sse = 0;
+  uint64 (*SumSquareError_16)(const uint16* src_a, const uint16* src_b,
+                              int count) = SumSquareError_16_C;
+#if defined(HAS_SUMSQUAREERROR_16_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SumSquareError_16 = SumSquareError_16_NEON;
+    simd_mask = 7;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERROR_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    SumSquareError_16 = SumSquareError_16_SSE2;
+    simd_mask = 7;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERROR_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SumSquareError_16 = SumSquareError_16_AVX2;
+    simd_mask = 15;
+  }
+#endif
+  simd_count = count & ~simd_mask;
+  if (simd_count) {
+    sse += SumSquareError_16(src_a, src_b, simd_count);
+  }
+  if (count > simd_count) {
+    sse += SumSquareError_16_C(src_a + simd_count, src_b + simd_count,
+                               count - simd_count);
+  }
+  return sse;
+}
+
+LIBYUV_API
+uint64 ComputeSumSquareErrorPlane_16(const uint16* src_a, int stride_a,
+                                     const uint16* src_b, int stride_b,
+                                     int width, int height) {
+  uint64 sse = 0;
+  int h;
+  // Coalesce rows.
+  if (stride_a == width &&
+      stride_b == width) {
+    width *= height;
+    height = 1;
+    stride_a = stride_b = 0;
+  }
+  for (h = 0; h < height; ++h) {
+    sse += ComputeSumSquareError_16(src_a, src_b, width);
+    src_a += stride_a;
+    src_b += stride_b;
+  }
+  return sse;
+}
+
+// Sums SadStrip over strips of a block, or uses C if there is no SadStrip.
+static uint32 SadBlock(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b,
+                       int width, int height,
+                       uint32 (*SadStrip)(const uint8* src_a, int stride_a,
+                           const uint8* src_b, int stride_b, int height),
+                       int strip_width) {
+  uint32 sad = 0u;
+  int x;
+  if (!SadStrip) {
+    return SadBlock_C(src_a, stride_a, src_b, stride_b, width, height);
+  }
+  for (x = 0; x < width; x += strip_width) {
+    sad += SadStrip(src_a + x, stride_a, src_b + x, stride_b, height);
+  }
+  return sad;
+}
+
+LIBYUV_API
+int ComputeSadCandidates(const uint8* src, int src_stride,
+                         const uint8* ref, int ref_stride,
+                         const int* positions, int num_candidates,
+                         int width, int height, uint32* dst_sad) {
+  uint32 (*SadStrip)(const uint8* src_a, int stride_a,
+      const uint8* src_b, int stride_b, int height) = NULL;
+  int strip_width = width;
+  int i;
+  if (!src || !ref || !positions || !dst_sad ||
+      width <= 0 || height <= 0 || num_candidates < 0) {
+    return -1;
+  }
+#if defined(HAS_SADBLOCK_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    if (IS_ALIGNED(width, 16)) {
+      SadStrip = SadBlock16_SSE2;
+      strip_width = 16;
+    } else if (width == 8 && IS_ALIGNED(height, 2)) {
+      SadStrip = SadBlock8_SSE2;
+    } else if (width == 4 && IS_ALIGNED(height, 4)) {
+      SadStrip = SadBlock4_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_SADBLOCK_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2) && IS_ALIGNED(width, 32)) {
+    SadStrip = SadBlock32_AVX2;
+    strip_width = 32;
+  }
+#endif
+#if defined(HAS_SADBLOCK_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    if (IS_ALIGNED(width, 16)) {
+      SadStrip = SadBlock16_NEON;
+      strip_width = 16;
+    } else if (width == 8) {
+      SadStrip = SadBlock8_NEON;
+    }
+  }
+#endif
+  for (i = 0; i < num_candidates; ++i) {
+    const uint8* ref_block =
+        ref + positions[i * 2 + 1] * ref_stride + positions[i * 2];
+    dst_sad[i] = SadBlock(src, src_stride, ref_block, ref_stride,
+                          width, height, SadStrip, strip_width);
+  }
+  return 0;
+}
+
+LIBYUV_API
+uint32 ComputeSad(const uint8* src_a, int stride_a,
+                  const uint8* src_b, int stride_b,
+                  int width, int height) {
+  static const int kPosition[2] = { 0, 0 };
+  uint32 sad = 0u;
+  ComputeSadCandidates(src_a, stride_a, src_b, stride_b, kPosition, 1,
+                       width, height, &sad);
+  return sad;
+}
+
+LIBYUV_API
+uint32 ComputeSatd(const uint8* src_a, int stride_a,
+                   const uint8* src_b, int stride_b,
+                   int width, int height) {
+  uint32 (*SatdStrip)(const uint8* src_a, int stride_a,
+      const uint8* src_b, int stride_b, int height) = NULL;
+  int strip_width = 8;
+  uint32 satd = 0u;
+  int x;
+  if (!src_a || !src_b || width <= 0 || height <= 0 ||
+      !IS_ALIGNED(width, 4) || !IS_ALIGNED(height, 4)) {
+    return 0u;
+  }
+#if defined(HAS_SADBLOCK_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(width, 8)) {
+    SatdStrip = SatdBlock8_SSE2;
+  }
+#endif
+#if defined(HAS_SADBLOCK_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2) && IS_ALIGNED(width, 16)) {
+    SatdStrip = SatdBlock16_AVX2;
+    strip_width = 16;
+  }
+#endif
+#if defined(HAS_SADBLOCK_NEON)
+  if (TestCpuFlag(kCpuHasNEON) && IS_ALIGNED(width, 8)) {
+    SatdStrip = SatdBlock8_NEON;
+  }
+#endif
+  if (!SatdStrip) {
+    return SatdBlock_C(src_a, stride_a, src_b, stride_b, width, height) >> 1;
+  }
+  for (x = 0; x < width; x += strip_width) {
+    satd += SatdStrip(src_a + x, stride_a, src_b + x, stride_b, height);
+  }
+  return satd >> 1;
+}
+
+static int IsValidBlockSize(int block_size) {
+  return block_size == 8 || block_size == 16 ||
+         block_size == 32 || block_size == 64;
+}
+
+// Rows are accumulated into sums of 8 pixels in one pass over the plane,
+// and the sums of a row of blocks are then added into blocks.
+// A 64x64 block of squared errors is at most 4096 * 65025, within a uint32.
+static int ComputeBlockError(const uint8* src_a, int stride_a,
+                             const uint8* src_b, int stride_b,
+                             int width, int height, int block_size,
+                             uint32* dst, int dst_stride,
+                             void (*ErrorBlock8)(const uint8* src_a,
+                                 const uint8* src_b, uint32* dst, int count),
+                             void (*ErrorBlock8_C)(const uint8* src_a,
+                                 const uint8* src_b, uint32* dst, int count),
+                             int simd_mask) {
+  const int num_sums = (width + 7) >> 3;
+  const int sums_per_block = block_size >> 3;
+  const int simd_width = width & ~simd_mask;
+  int x, y;
+  align_buffer_64(row_sums, num_sums * 4);
+  uint32* sums = (uint32*)(row_sums);
+  for (y = 0; y < height; y += block_size) {
+    int rows = height - y < block_size ? height - y : block_size;
+    memset(sums, 0, num_sums * 4);
+    while (rows--) {
+      if (simd_width) {
+        ErrorBlock8(src_a, src_b, sums, simd_width);
+      }
+      if (width > simd_width) {
+        ErrorBlock8_C(src_a + simd_width, src_b + simd_width,
+                      sums + (simd_width >> 3), width - simd_width);
+      }
+      src_a += stride_a;
+      src_b += stride_b;
+    }
+    for (x = 0; x < num_sums; x += sums_per_block) {
+      int n = num_sums - x < sums_per_block ? num_sums - x : sums_per_block;
+      uint32 block = 0u;
+      while (n--) {
+        block += sums[x + n];
+      }
+      dst[x / sums_per_block] = block;
+    }
+    dst += dst_stride;
+  }
+  free_aligned_buffer_64(row_sums);
+  return 0;
+}
+
+LIBYUV_API
+int ComputeBlockSumSquareError(const uint8* src_a, int stride_a,
+                               const uint8* src_b, int stride_b,
+                               int width, int height, int block_size,
+                               uint32* dst_sse, int dst_stride) {
+  void (*SumSquareErrorBlock8)(const uint8* src_a, const uint8* src_b,
+      uint32* dst_sse, int count) = SumSquareErrorBlock8_C;
+  int simd_mask = 0;
+  if (!src_a || !src_b || !dst_sse || width <= 0 || height <= 0 ||
+      !IsValidBlockSize(block_size)) {
+    return -1;
+  }
+#if defined(HAS_SUMSQUAREERRORBLOCK8_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    SumSquareErrorBlock8 = SumSquareErrorBlock8_SSE2;
+    simd_mask = 15;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERRORBLOCK8_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SumSquareErrorBlock8 = SumSquareErrorBlock8_NEON;
+    simd_mask = 15;
+  }
+#endif
+  return ComputeBlockError(src_a, stride_a, src_b, stride_b,
+                           width, height, block_size, dst_sse, dst_stride,
+                           SumSquareErrorBlock8, SumSquareErrorBlock8_C,
+                           simd_mask);
+}
+
+LIBYUV_API
+int ComputeBlockSumAbsDiff(const uint8* src_a, int stride_a,
+                           const uint8* src_b, int stride_b,
+                           int width, int height, int block_size,
+                           uint32* dst_sad, int dst_stride) {
+  void (*SumAbsDiffBlock8)(const uint8* src_a, const uint8* src_b,
+      uint32* dst_sad, int count) = SumAbsDiffBlock8_C;
+  int simd_mask = 0;
+  if (!src_a || !src_b || !dst_sad || width <= 0 || height <= 0 ||
+      !IsValidBlockSize(block_size)) {
+    return -1;
+  }
+#if defined(HAS_SUMSQUAREERRORBLOCK8_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    SumAbsDiffBlock8 = SumAbsDiffBlock8_SSE2;
+    simd_mask = 15;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERRORBLOCK8_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SumAbsDiffBlock8 = SumAbsDiffBlock8_NEON;
+    simd_mask = 15;
+  }
+#endif
+  return ComputeBlockError(src_a, stride_a, src_b, stride_b,
+                           width, height, block_size, dst_sad, dst_stride,
+                           SumAbsDiffBlock8, SumAbsDiffBlock8_C,
+                           simd_mask);
+}
+
+void PlaneStatsRow_C(const uint8* src, uint32* dst_stats, int count);
+void HistogramRow_C(const uint8* src, uint32* dst_hist, int count);
+#if !defined(LIBYUV_DISABLE_NEON) && \
+    (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
+#define HAS_PLANESTATSROW_NEON
+void PlaneStatsRow_NEON(const uint8* src, uint32* dst_stats, int count);
+#endif
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define HAS_PLANESTATSROW_SSE2
+void PlaneStatsRow_SSE2(const uint8* src, uint32* dst_stats, int count);
+#if defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2)
+#define HAS_PLANESTATSROW_AVX2
+void PlaneStatsRow_AVX2(const uint8* src, uint32* dst_stats, int count);
+#endif
+#endif
+
+// Adds the sum and sum of squares of row stats to 64 bit stats and updates
+// the minimum and maximum.
+static void AccumulateStats(uint64* stats, const uint32* row_stats) {
+  stats[0] += row_stats[0];
+  stats[1] += row_stats[1];
+  if (row_stats[2] < stats[2]) {
+    stats[2] = row_stats[2];
+  }
+  if (row_stats[3] > stats[3]) {
+    stats[3] = row_stats[3];
+  }
+}
+
+// Row functions take at most 65536 values so the sum of squares fits in 32
+// bits.
+static void AddPlaneStats(const uint8* src, int count, uint64* stats,
+                          void (*PlaneStatsRow)(const uint8* src,
+                              uint32* dst_stats, int count),
+                          int simd_mask) {
+  uint32 row_stats[4];
+  while (count > 0) {
+    int n = count < 65536 ? count : 65536;
+    int simd_count = n & ~simd_mask;
+    if (simd_count) {
+      PlaneStatsRow(src, row_stats, simd_count);
+      AccumulateStats(stats, row_stats);
+    }
+    if (n > simd_count) {
+      PlaneStatsRow_C(src + simd_count, row_stats, n - simd_count);
+      AccumulateStats(stats, row_stats);
+    }
+    src += n;
+    count -= n;
+  }
+}
+
+static int GetPlaneStatsRow(void (**PlaneStatsRow)(const uint8* src,
+                                uint32* dst_stats, int count)) {
+  int simd_mask = 0;
+  *PlaneStatsRow = PlaneStatsRow_C;
+#if defined(HAS_PLANESTATSROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    *PlaneStatsRow = PlaneStatsRow_NEON;
+    simd_mask = 15;
+  }
+#endif
+#if defined(HAS_PLANESTATSROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    *PlaneStatsRow = PlaneStatsRow_SSE2;
+    simd_mask = 15;
+  }
+#endif
+#if defined(HAS_PLANESTATSROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    *PlaneStatsRow = PlaneStatsRow_AVX2;
+    simd_mask = 31;
+  }
+#endif
+  return simd_mask;
+}
+
+LIBYUV_API
+int PlaneStats(const uint8* src_y, int src_stride_y, int width, int height,
+               uint64* sum, uint64* sum_sq, int* min, int* max) {
+  uint64 stats[4] = { 0u, 0u, 255u, 0u };
+  int y;
+  void (*PlaneStatsRow)(const uint8* src, uint32* dst_stats, int count);
+  int simd_mask = GetPlaneStatsRow(&PlaneStatsRow);
+  if (!src_y || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height inverts the image, which does not change the stats,
+  // so the rows are read top down.
+  if (height < 0) {
+    height = -height;
+  }
+  // Coalesce rows.
+  if (src_stride_y == width) {
+    width *= height;
+    height = 1;
+    src_stride_y = 0;
+  }
+  for (y = 0; y < height; ++y) {
+    AddPlaneStats(src_y, width, stats, PlaneStatsRow, simd_mask);
+    src_y += src_stride_y;
+  }
+  if (sum) {
+    *sum = stats[0];
+  }
+  if (sum_sq) {
+    *sum_sq = stats[1];
+  }
+  if (min) {
+    *min = (int)(stats[2]);
+  }
+  if (max) {
+    *max = (int)(stats[3]);
+  }
+  return 0;
+}
+
+LIBYUV_API
+int PlaneBlockStats(const uint8* src_y, int src_stride_y,
+                    int width, int height, int block_size,
+                    uint32* dst_sum, uint32* dst_sum_sq,
+                    uint8* dst_min, uint8* dst_max, int dst_stride) {
+  int x, y, i;
+  void (*PlaneStatsRow)(const uint8* src, uint32* dst_stats, int count);
+  int simd_mask = GetPlaneStatsRow(&PlaneStatsRow);
+  if (!src_y || width <= 0 || height <= 0 ||
+      !IsValidBlockSize(block_size)) {
+    return -1;
+  }
+  for (y = 0; y < height; y += block_size) {
+    int rows = height - y < block_size ? height - y : block_size;
+    for (x = 0; x < width; x += block_size) {
+      int block_width = width - x < block_size ? width - x : block_size;
+      int block = x / block_size;
+      uint64 stats[4] = { 0u, 0u, 255u, 0u };
+      for (i = 0; i < rows; ++i) {
+        AddPlaneStats(src_y + i * src_stride_y + x, block_width, stats,
+                      PlaneStatsRow, simd_mask);
+      }
+      if (dst_sum) {
+        dst_sum[block] = (uint32)(stats[0]);
+      }
+      if (dst_sum_sq) {
+        dst_sum_sq[block] = (uint32)(stats[1]);
+      }
+      if (dst_min) {
+        dst_min[block] = (uint8)(stats[2]);
+      }
+      if (dst_max) {
+        dst_max[block] = (uint8)(stats[3]);
+      }
+    }
+    src_y += src_stride_y * block_size;
+    if (dst_sum) {
+      dst_sum += dst_stride;
+    }
+    if (dst_sum_sq) {
+      dst_sum_sq += dst_stride;
+    }
+    if (dst_min) {
+      dst_min += dst_stride;
+    }
+    if (dst_max) {
+      dst_max += dst_stride;
+    }
+  }
+  return 0;
+}
+
+LIBYUV_API
+int PlaneHistogram(const uint8* src_y, int src_stride_y, int width, int height,
+                   uint32* dst_hist) {
+  uint32 hist[256 * 4];
+  int i;
+  if (!src_y || !dst_hist || width <= 0 || height == 0) {
+    return -1;
+  }
+  if (height < 0) {
+    height = -height;
+  }
+  // Coalesce rows.
+  if (src_stride_y == width) {
+    width *= height;
+    height = 1;
+    src_stride_y = 0;
+  }
+  memset(hist, 0, sizeof(hist));
+  for (i = 0; i < height; ++i) {
+    HistogramRow_C(src_y, hist, width);
+    src_y += src_stride_y;
+  }
+  for (i = 0; i < 256; ++i) {
+    dst_hist[i] = hist[i] + hist[256 + i] + hist[512 + i] + hist[768 + i];
+  }
+  return 0;
+}
+
+LIBYUV_API
+int PlaneBlockHistogram(const uint8* src_y, int src_stride_y,
+                        int width, int height, int block_size,
+                        uint32* dst_hist, int dst_stride) {
+  int x, y, i, j;
+  if (!src_y || !dst_hist || width <= 0 || height <= 0 ||
+      !IsValidBlockSize(block_size)) {
+    return -1;
+  }
+  for (y = 0; y < height; y += block_size) {
+    int rows = height - y < block_size ? height - y : block_size;
+    for (x = 0; x < width; x += block_size) {
+      int block_width = width - x < block_size ? width - x : block_size;
+      uint32* hist = dst_hist + (x / block_size) * 256;
+      const uint8* src = src_y + x;
+      memset(hist, 0, 256 * 4);
+      for (i = 0; i < rows; ++i) {
+        for (j = 0; j < block_width; ++j) {
+          ++hist[src[j]];
+        }
+        src += src_stride_y;
+      }
+    }
+    src_y += src_stride_y * block_size;
+    dst_hist += dst_stride * 256;
+  }
+  return 0;
+}
+
+LIBYUV_API
+int ARGBHistogram(const uint8* src_argb, int src_stride_argb,
+                  int width, int height, uint32* dst_hist) {
+  int y;
+  if (!src_argb || !dst_hist || width <= 0 || height == 0) {
+    return -1;
+  }
+  if (height < 0) {
+    height = -height;
+  }
+  // Coalesce rows.
+  if (src_stride_argb == width * 4) {
+    width *= height;
+    height = 1;
+    src_stride_argb = 0;
+  }
+  memset(dst_hist, 0, 256 * 4 * 4);
+  for (y = 0; y < height; ++y) {
+    HistogramRow_C(src_argb, dst_hist, width * 4);
+    src_argb += src_stride_argb;
+  }
+  return 0;
+}
+
 LIBYUV_API
 double SumSquareErrorToPsnr(uint64 sse, uint64 count) {
   double psnr;
@@ -266,6 +1184,58 @@ double I420Psnr(const uint8* src_y_a, int stride_y_a,
   return SumSquareErrorToPsnr(sse, samples);
 }
 
+LIBYUV_API
+double SumSquareErrorToPsnr_16(uint64 sse, uint64 count, int bits) {
+  const double max_value = (double)((1 << bits) - 1);
+  double psnr;
+  if (sse > 0) {
+    double mse = (double)(count) / (double)(sse);
+    psnr = 10.0 * log10(max_value * max_value * mse);
+  } else {
+    psnr = kMaxPsnr;      // Limit to prevent divide by 0
+  }
+
+  if (psnr > kMaxPsnr)
+    psnr = kMaxPsnr;
+
+  return psnr;
+}
+
+LIBYUV_API
+double CalcFramePsnr_16(const uint16* src_a, int stride_a,
+                        const uint16* src_b, int stride_b,
+                        int width, int height, int bits) {
+  const uint64 samples = width * height;
+  const uint64 sse = ComputeSumSquareErrorPlane_16(src_a, stride_a,
+                                                   src_b, stride_b,
+                                                   width, height);
+  return SumSquareErrorToPsnr_16(sse, samples, bits);
+}
+
+LIBYUV_API
+double I010Psnr(const uint16* src_y_a, int stride_y_a,
+                const uint16* src_u_a, int stride_u_a,
+                const uint16* src_v_a, int stride_v_a,
+                const uint16* src_y_b, int stride_y_b,
+                const uint16* src_u_b, int stride_u_b,
+                const uint16* src_v_b, int stride_v_b,
+                int width, int height) {
+  const uint64 sse_y = ComputeSumSquareErrorPlane_16(src_y_a, stride_y_a,
+                                                     src_y_b, stride_y_b,
+                                                     width, height);
+  const int width_uv = (width + 1) >> 1;
+  const int height_uv = (height + 1) >> 1;
+  const uint64 sse_u = ComputeSumSquareErrorPlane_16(src_u_a, stride_u_a,
+                                                     src_u_b, stride_u_b,
+                                                     width_uv, height_uv);
+  const uint64 sse_v = ComputeSumSquareErrorPlane_16(src_v_a, stride_v_a,
+                                                     src_v_b, stride_v_b,
+                                                     width_uv, height_uv);
+  const uint64 samples = width * height + 2 * (width_uv * height_uv);
+  const uint64 sse = sse_y + sse_u + sse_v;
+  return SumSquareErrorToPsnr_16(sse, samples, 10);
+}
+
 static const int64 cc1 =  26634;  // (64^2*(.01*255)^2
 static const int64 cc2 = 239708;  // (64^2*(.03*255)^2
 
@@ -346,6 +1316,75 @@ double CalcFrameSsim(const uint8* src_a, int stride_a,
   return ssim_total;
 }
 
+// The sums of 8x8 windows of 16 bit values need 64 bits, and the SSIM terms
+// are computed in double, where they remain exact.
+static double Ssim8x8_16_C(const uint16* src_a, int stride_a,
+                           const uint16* src_b, int stride_b,
+                           double c1, double c2) {
+  uint64 sum_a = 0;
+  uint64 sum_b = 0;
+  uint64 sum_sq_a = 0;
+  uint64 sum_sq_b = 0;
+  uint64 sum_axb = 0;
+
+  int i;
+  for (i = 0; i < 8; ++i) {
+    int j;
+    for (j = 0; j < 8; ++j) {
+      sum_a += src_a[j];
+      sum_b += src_b[j];
+      sum_sq_a += (uint32)(src_a[j]) * src_a[j];
+      sum_sq_b += (uint32)(src_b[j]) * src_b[j];
+      sum_axb += (uint32)(src_a[j]) * src_b[j];
+    }
+
+    src_a += stride_a;
+    src_b += stride_b;
+  }
+
+  {
+    const double count = 64.0;
+    const double sum_a_x_sum_b = (double)(sum_a) * sum_b;
+    const double sum_a_sq = (double)(sum_a) * sum_a;
+    const double sum_b_sq = (double)(sum_b) * sum_b;
+    const double ssim_n = (2 * sum_a_x_sum_b + c1) *
+                          (2 * count * sum_axb - 2 * sum_a_x_sum_b + c2);
+    const double ssim_d = (sum_a_sq + sum_b_sq + c1) *
+                          (count * sum_sq_a - sum_a_sq +
+                           count * sum_sq_b - sum_b_sq + c2);
+    return ssim_n / ssim_d;
+  }
+}
+
+LIBYUV_API
+double CalcFrameSsim_16(const uint16* src_a, int stride_a,
+                        const uint16* src_b, int stride_b,
+                        int width, int height, int bits) {
+  // Constants for the dynamic range, scaled by the number of pixels.
+  const double max_value = (double)((1 << bits) - 1);
+  const double c1 = 64.0 * 64.0 * (0.01 * max_value) * (0.01 * max_value);
+  const double c2 = 64.0 * 64.0 * (0.03 * max_value) * (0.03 * max_value);
+  int samples = 0;
+  double ssim_total = 0;
+
+  // sample point start with each 4x4 location
+  int i;
+  for (i = 0; i < height - 8; i += 4) {
+    int j;
+    for (j = 0; j < width - 8; j += 4) {
+      ssim_total += Ssim8x8_16_C(src_a + j, stride_a, src_b + j, stride_b,
+                                 c1, c2);
+      samples++;
+    }
+
+    src_a += stride_a * 4;
+    src_b += stride_b * 4;
+  }
+
+  ssim_total /= samples;
+  return ssim_total;
+}
+
 LIBYUV_API
 double I420Ssim(const uint8* src_y_a, int stride_y_a,
                 const uint8* src_u_a, int stride_u_a,
@@ -367,6 +1406,304 @@ double I420Ssim(const uint8* src_y_a, int stride_y_a,
   return ssim_y * 0.8 + 0.1 * (ssim_u + ssim_v);
 }
 
+LIBYUV_API
+double I010Ssim(const uint16* src_y_a, int stride_y_a,
+                const uint16* src_u_a, int stride_u_a,
+                const uint16* src_v_a, int stride_v_a,
+                const uint16* src_y_b, int stride_y_b,
+                const uint16* src_u_b, int stride_u_b,
+                const uint16* src_v_b, int stride_v_b,
+                int width, int height) {
+  const double ssim_y = CalcFrameSsim_16(src_y_a, stride_y_a,
+                                         src_y_b, stride_y_b,
+                                         width, height, 10);
+  const int width_uv = (width + 1) >> 1;
+  const int height_uv = (height + 1) >> 1;
+  const double ssim_u = CalcFrameSsim_16(src_u_a, stride_u_a,
+                                         src_u_b, stride_u_b,
+                                         width_uv, height_uv, 10);
+  const double ssim_v = CalcFrameSsim_16(src_v_a, stride_v_a,
+                                         src_v_b, stride_v_b,
+                                         width_uv, height_uv, 10);
+  return ssim_y * 0.8 + 0.1 * (ssim_u + ssim_v);
+}
+
+void SsimSums8x8_C(const uint8* src_a, int stride_a,
+                   const uint8* src_b, int stride_b, uint32* sums);
+#if !defined(LIBYUV_DISABLE_NEON) && \
+    (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
+#define HAS_SSIMSUMS8X8_NEON
+void SsimSums8x8_NEON(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, uint32* sums);
+#endif
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define HAS_SSIMSUMS8X8_SSE2
+void SsimSums8x8_SSE2(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, uint32* sums);
+#endif
+
+static void GetSsimSums8x8(void (**SsimSums8x8)(const uint8* src_a,
+    int stride_a, const uint8* src_b, int stride_b, uint32* sums)) {
+  *SsimSums8x8 = SsimSums8x8_C;
+#if defined(HAS_SSIMSUMS8X8_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    *SsimSums8x8 = SsimSums8x8_NEON;
+  }
+#endif
+#if defined(HAS_SSIMSUMS8X8_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    *SsimSums8x8 = SsimSums8x8_SSE2;
+  }
+#endif
+}
+
+// Weights of the 5 scales of MS-SSIM, from Wang, Simoncelli and Bovik,
+// "Multi-scale structural similarity for image quality assessment".
+static const int kMsSsimLevels = 5;
+static const double kMsSsimWeights[5] = {
+  0.0448, 0.2856, 0.3001, 0.2363, 0.1333
+};
+
+// SSIM of a window from its sums, split into the luminance term and the
+// contrast-structure term used by the finer scales of MS-SSIM.
+static void SsimFromSums(const uint32* sums, double* ssim, double* cs) {
+  const int64 count = 64;
+  const int64 c1 = (cc1 * count * count) >> 12;
+  const int64 c2 = (cc2 * count * count) >> 12;
+  const int64 sum_a = sums[0];
+  const int64 sum_b = sums[1];
+  const int64 sum_a_x_sum_b = sum_a * sum_b;
+  const int64 sum_a_sq = sum_a * sum_a;
+  const int64 sum_b_sq = sum_b * sum_b;
+  const double luminance = (2 * sum_a_x_sum_b + c1) * 1.0 /
+                           (sum_a_sq + sum_b_sq + c1);
+  const double contrast = (2 * count * sums[4] - 2 * sum_a_x_sum_b + c2) *
+                          1.0 / (count * sums[2] - sum_a_sq +
+                                 count * sums[3] - sum_b_sq + c2);
+  *ssim = luminance * contrast;
+  *cs = contrast;
+}
+
+// Returns the first and last window start of a block, on the grid of
+// CalcFrameSsim: multiples of 4 below size - 8.  Edge blocks with no window
+// start use the last window of the plane.
+static void BlockWindows(int start, int size, int block_size,
+                         int* first, int* last) {
+  const int last_window = (size - 9) & ~3;
+  *first = start;
+  *last = start + block_size - 4 < last_window ?
+      start + block_size - 4 : last_window;
+  if (*first > last_window) {
+    *first = *last = last_window;
+  }
+}
+
+LIBYUV_API
+int CalcBlockSsim(const uint8* src_a, int stride_a,
+                  const uint8* src_b, int stride_b,
+                  int width, int height, int block_size,
+                  double* dst_ssim, int dst_stride) {
+  void (*SsimSums8x8)(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, uint32* sums);
+  int bx, by;
+  if (!src_a || !src_b || !dst_ssim || width <= 8 || height <= 8 ||
+      !IsValidBlockSize(block_size)) {
+    return -1;
+  }
+  GetSsimSums8x8(&SsimSums8x8);
+  for (by = 0; by < height; by += block_size) {
+    int first_y, last_y;
+    BlockWindows(by, height, block_size, &first_y, &last_y);
+    for (bx = 0; bx < width; bx += block_size) {
+      int first_x, last_x;
+      int samples = 0;
+      double ssim_total = 0;
+      int i, j;
+      BlockWindows(bx, width, block_size, &first_x, &last_x);
+      for (i = first_y; i <= last_y; i += 4) {
+        for (j = first_x; j <= last_x; j += 4) {
+          uint32 sums[5];
+          double window_ssim;
+          double window_cs;
+          SsimSums8x8(src_a + i * stride_a + j, stride_a,
+                      src_b + i * stride_b + j, stride_b, sums);
+          SsimFromSums(sums, &window_ssim, &window_cs);
+          ssim_total += window_ssim;
+          ++samples;
+        }
+      }
+      dst_ssim[bx / block_size] = ssim_total / samples;
+    }
+    dst_ssim += dst_stride;
+  }
+  return 0;
+}
+
+// Computes the mean SSIM and contrast-structure of one level, on the same
+// 4x4 grid of 8x8 windows as CalcFrameSsim, and downsamples the level 2x2
+// into dst_a and dst_b while each band of 4 rows is in cache.
+// dst_a may be NULL for the last level.
+static void MsSsimLevel(const uint8* src_a, int stride_a,
+                        const uint8* src_b, int stride_b,
+                        int width, int height,
+                        uint8* dst_a, uint8* dst_b,
+                        double* ssim, double* cs,
+                        void (*SsimSums8x8)(const uint8* src_a, int stride_a,
+                            const uint8* src_b, int stride_b, uint32* sums),
+                        void (*ScaleRowDown2)(const uint8* src_ptr,
+                            ptrdiff_t src_stride, uint8* dst_ptr,
+                            int dst_width)) {
+  const int num_bands = (height + 3) >> 2;
+  const int dst_width = width >> 1;
+  const int dst_height = height >> 1;
+  double ssim_total = 0.0;
+  double cs_total = 0.0;
+  int samples = 0;
+  int band;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+: ssim_total, cs_total, samples)
+#endif
+  for (band = 0; band < num_bands; ++band) {
+    const int y = band * 4;
+    int x;
+    if (y < height - 8) {
+      for (x = 0; x < width - 8; x += 4) {
+        uint32 sums[5];
+        double window_ssim;
+        double window_cs;
+        SsimSums8x8(src_a + y * stride_a + x, stride_a,
+                    src_b + y * stride_b + x, stride_b, sums);
+        SsimFromSums(sums, &window_ssim, &window_cs);
+        ssim_total += window_ssim;
+        cs_total += window_cs;
+        ++samples;
+      }
+    }
+    if (dst_a) {
+      int dst_y;
+      for (dst_y = y >> 1; dst_y < (y >> 1) + 2 && dst_y < dst_height;
+           ++dst_y) {
+        ScaleRowDown2(src_a + dst_y * 2 * stride_a, stride_a,
+                      dst_a + dst_y * dst_width, dst_width);
+        ScaleRowDown2(src_b + dst_y * 2 * stride_b, stride_b,
+                      dst_b + dst_y * dst_width, dst_width);
+      }
+    }
+  }
+  *ssim = ssim_total / samples;
+  *cs = cs_total / samples;
+}
+
+// Levels are added while the next level has at least one 8x8 window, and
+// the weights of the levels used are normalized.  Negative means are
+// clamped to 0 before raising to the weights.
+LIBYUV_API
+double CalcFrameMsSsim(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b,
+                       int width, int height) {
+  int num_levels = 1;
+  int level;
+  int level_width = width;
+  int level_height = height;
+  double weights = 0.0;
+  double ms_ssim = 1.0;
+  const uint8* level_a = src_a;
+  const uint8* level_b = src_b;
+  int level_stride_a = stride_a;
+  int level_stride_b = stride_b;
+  void (*SsimSums8x8)(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, uint32* sums);
+  void (*ScaleRowDown2)(const uint8* src_ptr, ptrdiff_t src_stride,
+                        uint8* dst_ptr, int dst_width) = ScaleRowDown2Box_C;
+  if (!src_a || !src_b || width <= 8 || height <= 8) {
+    return 0.0;
+  }
+  while (num_levels < kMsSsimLevels &&
+         (width >> num_levels) > 8 && (height >> num_levels) > 8) {
+    ++num_levels;
+  }
+  GetSsimSums8x8(&SsimSums8x8);
+  // The width of each level is halved, so only the Any versions are used.
+#if defined(HAS_SCALEROWDOWN2_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ScaleRowDown2 = ScaleRowDown2Box_Any_NEON;
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ScaleRowDown2 = ScaleRowDown2Box_Any_SSE2;
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ScaleRowDown2 = ScaleRowDown2Box_Any_AVX2;
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ScaleRowDown2 = ScaleRowDown2Box_Any_AVX512BW;
+  }
+#endif
+
+  {
+    // Levels alternate between 2 buffers for each image: the first holds
+    // level 1 and the second level 2.
+    const int size1 = (width >> 1) * (height >> 1);
+    const int size2 = (width >> 2) * (height >> 2);
+    align_buffer_64(pyramid, (size1 + size2) * 2);
+    for (level = 0; level < num_levels; ++level) {
+      double ssim;
+      double cs;
+      uint8* dst_a = NULL;
+      uint8* dst_b = NULL;
+      if (level + 1 < num_levels) {
+        dst_a = pyramid + ((level & 1) ? size1 * 2 : 0);
+        dst_b = dst_a + ((level & 1) ? size2 : size1);
+      }
+      MsSsimLevel(level_a, level_stride_a, level_b, level_stride_b,
+                  level_width, level_height, dst_a, dst_b, &ssim, &cs,
+                  SsimSums8x8, ScaleRowDown2);
+      // The coarsest level uses the full SSIM, the others contrast-structure.
+      if (level + 1 == num_levels) {
+        cs = ssim;
+      }
+      ms_ssim *= pow(cs > 0.0 ? cs : 0.0, kMsSsimWeights[level]);
+      weights += kMsSsimWeights[level];
+      level_width >>= 1;
+      level_height >>= 1;
+      level_a = dst_a;
+      level_b = dst_b;
+      level_stride_a = level_width;
+      level_stride_b = level_width;
+    }
+    free_aligned_buffer_64(pyramid);
+  }
+  return pow(ms_ssim, 1.0 / weights);
+}
+
+LIBYUV_API
+double I420MsSsim(const uint8* src_y_a, int stride_y_a,
+                  const uint8* src_u_a, int stride_u_a,
+                  const uint8* src_v_a, int stride_v_a,
+                  const uint8* src_y_b, int stride_y_b,
+                  const uint8* src_u_b, int stride_u_b,
+                  const uint8* src_v_b, int stride_v_b,
+                  int width, int height) {
+  const double ms_ssim_y = CalcFrameMsSsim(src_y_a, stride_y_a,
+                                           src_y_b, stride_y_b,
+                                           width, height);
+  const int width_uv = (width + 1) >> 1;
+  const int height_uv = (height + 1) >> 1;
+  const double ms_ssim_u = CalcFrameMsSsim(src_u_a, stride_u_a,
+                                           src_u_b, stride_u_b,
+                                           width_uv, height_uv);
+  const double ms_ssim_v = CalcFrameMsSsim(src_v_a, stride_v_a,
+                                           src_v_b, stride_v_b,
+                                           width_uv, height_uv);
+  return ms_ssim_y * 0.8 + 0.1 * (ms_ssim_u + ms_ssim_v);
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
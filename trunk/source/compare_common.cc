@@ -10,6 +10,8 @@
 
 #include "libyuv/basic_types.h"
 
+#include <stdlib.h>  // For abs()
+
 #ifdef __cplusplus
 namespace libyuv {
 extern "C" {
@@ -25,6 +27,146 @@ uint32 SumSquareError_C(const uint8* src_a, const uint8* src_b, int count) {
   return sse;
 }
 
+// Adds the Sum Square Error of each group of 8 values to dst_sse.
+void SumSquareErrorBlock8_C(const uint8* src_a, const uint8* src_b,
+                            uint32* dst_sse, int count) {
+  int i;
+  for (i = 0; i < count; ++i) {
+    int diff = src_a[i] - src_b[i];
+    dst_sse[i >> 3] += (uint32)(diff * diff);
+  }
+}
+
+// Adds the Sum of Absolute Differences of each group of 8 values to dst_sad.
+void SumAbsDiffBlock8_C(const uint8* src_a, const uint8* src_b,
+                        uint32* dst_sad, int count) {
+  int i;
+  for (i = 0; i < count; ++i) {
+    int diff = src_a[i] - src_b[i];
+    dst_sad[i >> 3] += (uint32)(diff < 0 ? -diff : diff);
+  }
+}
+
+// Sum of Absolute Differences of a block.
+uint32 SadBlock_C(const uint8* src_a, int stride_a,
+                  const uint8* src_b, int stride_b,
+                  int width, int height) {
+  uint32 sad = 0u;
+  int x, y;
+  for (y = 0; y < height; ++y) {
+    for (x = 0; x < width; ++x) {
+      int diff = src_a[x] - src_b[x];
+      sad += (uint32)(diff < 0 ? -diff : diff);
+    }
+    src_a += stride_a;
+    src_b += stride_b;
+  }
+  return sad;
+}
+
+// Sum of absolute values of the 4x4 Hadamard transforms of the differences
+// of a block.  Width and height are multiples of 4.
+uint32 SatdBlock_C(const uint8* src_a, int stride_a,
+                   const uint8* src_b, int stride_b,
+                   int width, int height) {
+  uint32 satd = 0u;
+  int x, y, i;
+  for (y = 0; y < height - 3; y += 4) {
+    for (x = 0; x < width - 3; x += 4) {
+      int d[4][4];
+      for (i = 0; i < 4; ++i) {
+        const uint8* a = src_a + (y + i) * stride_a + x;
+        const uint8* b = src_b + (y + i) * stride_b + x;
+        int s01 = (a[0] - b[0]) + (a[1] - b[1]);
+        int d01 = (a[0] - b[0]) - (a[1] - b[1]);
+        int s23 = (a[2] - b[2]) + (a[3] - b[3]);
+        int d23 = (a[2] - b[2]) - (a[3] - b[3]);
+        d[i][0] = s01 + s23;
+        d[i][1] = s01 - s23;
+        d[i][2] = d01 + d23;
+        d[i][3] = d01 - d23;
+      }
+      for (i = 0; i < 4; ++i) {
+        int s01 = d[0][i] + d[1][i];
+        int d01 = d[0][i] - d[1][i];
+        int s23 = d[2][i] + d[3][i];
+        int d23 = d[2][i] - d[3][i];
+        satd += (uint32)(abs(s01 + s23) + abs(s01 - s23) +
+                         abs(d01 + d23) + abs(d01 - d23));
+      }
+    }
+  }
+  return satd;
+}
+
+// Returns the offset of the first byte that differs, or count if none do.
+int FindFirstDiff_C(const uint8* src_a, const uint8* src_b, int count) {
+  int i;
+  for (i = 0; i < count; ++i) {
+    if (src_a[i] != src_b[i]) {
+      break;
+    }
+  }
+  return i;
+}
+
+// Updates the minimum and maximum of each byte of the pixels.
+// dst_minmax holds 4 minimums followed by 4 maximums.
+void ARGBMinMaxRow_C(const uint8* src_argb, uint8* dst_minmax, int width) {
+  int x;
+  int i;
+  for (x = 0; x < width; ++x) {
+    for (i = 0; i < 4; ++i) {
+      if (src_argb[i] < dst_minmax[i]) {
+        dst_minmax[i] = src_argb[i];
+      }
+      if (src_argb[i] > dst_minmax[i + 4]) {
+        dst_minmax[i + 4] = src_argb[i];
+      }
+    }
+    src_argb += 4;
+  }
+}
+
+// Sums of a, b, a * a, b * b and a * b over an 8x8 window, for SSIM.
+void SsimSums8x8_C(const uint8* src_a, int stride_a,
+                   const uint8* src_b, int stride_b, uint32* sums) {
+  uint32 sum_a = 0u;
+  uint32 sum_b = 0u;
+  uint32 sum_sq_a = 0u;
+  uint32 sum_sq_b = 0u;
+  uint32 sum_axb = 0u;
+  int i;
+  for (i = 0; i < 8; ++i) {
+    int j;
+    for (j = 0; j < 8; ++j) {
+      sum_a += src_a[j];
+      sum_b += src_b[j];
+      sum_sq_a += src_a[j] * src_a[j];
+      sum_sq_b += src_b[j] * src_b[j];
+      sum_axb += src_a[j] * src_b[j];
+    }
+    src_a += stride_a;
+    src_b += stride_b;
+  }
+  sums[0] = sum_a;
+  sums[1] = sum_b;
+  sums[2] = sum_sq_a;
+  sums[3] = sum_sq_b;
+  sums[4] = sum_axb;
+}
+
+uint64 SumSquareError_16_C(const uint16* src_a, const uint16* src_b,
+                           int count) {
+  uint64 sse = 0u;
+  int i;
+  for (i = 0; i < count; ++i) {
+    uint32 diff = (uint32)(src_a[i] - src_b[i]);
+    sse += diff * diff;
+  }
+  return sse;
+}
+
 // hash seed of 5381 recommended.
 // Internal C version of HashDjb2 with int sized count for efficiency.
 uint32 HashDjb2_C(const uint8* src, int count, uint32 seed) {
@@ -36,6 +178,47 @@ uint32 HashDjb2_C(const uint8* src, int count, uint32 seed) {
   return hash;
 }
 
+// Sum, sum of squares, minimum and maximum of count values.
+// count is at most 65536 so the sum of squares fits in a uint32.
+void PlaneStatsRow_C(const uint8* src, uint32* dst_stats, int count) {
+  uint32 sum = 0u;
+  uint32 sum_sq = 0u;
+  uint32 min = 255u;
+  uint32 max = 0u;
+  int i;
+  for (i = 0; i < count; ++i) {
+    uint32 v = src[i];
+    sum += v;
+    sum_sq += v * v;
+    if (v < min) {
+      min = v;
+    }
+    if (v > max) {
+      max = v;
+    }
+  }
+  dst_stats[0] = sum;
+  dst_stats[1] = sum_sq;
+  dst_stats[2] = min;
+  dst_stats[3] = max;
+}
+
+// Counts values into 4 histograms of 256 by offset modulo 4, which are the
+// channels of ARGB.  Alternating histograms also avoids stalls on a store
+// followed by a load of the same counter when values repeat.
+void HistogramRow_C(const uint8* src, uint32* dst_hist, int count) {
+  int i;
+  for (i = 0; i < count - 3; i += 4) {
+    ++dst_hist[src[i]];
+    ++dst_hist[256 + src[i + 1]];
+    ++dst_hist[512 + src[i + 2]];
+    ++dst_hist[768 + src[i + 3]];
+  }
+  for (; i < count; ++i) {
+    ++dst_hist[((i & 3) << 8) + src[i]];
+  }
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -58,8 +58,1024 @@ uint32 SumSquareError_SSE2(const uint8* src_a, const uint8* src_b, int count) {
   return sse;
 }
 
+// Adds the Sum Square Error of each group of 8 values to dst_sse.
+// count is a multiple of 16.
+void SumSquareErrorBlock8_SSE2(const uint8* src_a, const uint8* src_b,
+                               uint32* dst_sse, int count) {
+  asm volatile (  // NOLINT
+    "pxor      %%xmm5,%%xmm5                   \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm1         \n"
+    "lea       " MEMLEA(0x10, 0) ",%0          \n"
+    "movdqu    " MEMACCESS(1) ",%%xmm2         \n"
+    "lea       " MEMLEA(0x10, 1) ",%1          \n"
+    "movdqa    %%xmm1,%%xmm3                   \n"
+    "psubusb   %%xmm2,%%xmm1                   \n"
+    "psubusb   %%xmm3,%%xmm2                   \n"
+    "por       %%xmm2,%%xmm1                   \n"
+    "movdqa    %%xmm1,%%xmm2                   \n"
+    "punpcklbw %%xmm5,%%xmm1                   \n"
+    "punpckhbw %%xmm5,%%xmm2                   \n"
+    "pmaddwd   %%xmm1,%%xmm1                   \n"
+    "pmaddwd   %%xmm2,%%xmm2                   \n"
+    "movdqa    %%xmm1,%%xmm3                   \n"
+    "punpckldq %%xmm2,%%xmm1                   \n"
+    "punpckhdq %%xmm2,%%xmm3                   \n"
+    "paddd     %%xmm3,%%xmm1                   \n"
+    "pshufd    $0xee,%%xmm1,%%xmm3             \n"
+    "paddd     %%xmm3,%%xmm1                   \n"
+    "movq      " MEMACCESS(2) ",%%xmm0         \n"
+    "paddd     %%xmm1,%%xmm0                   \n"
+    "movq      %%xmm0," MEMACCESS(2) "         \n"
+    "lea       " MEMLEA(0x8, 2) ",%2           \n"
+    "sub       $0x10,%3                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(dst_sse),    // %2
+    "+r"(count)       // %3
+  :: "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5"
+  );  // NOLINT
+}
+
+// Adds the Sum of Absolute Differences of each group of 8 values to dst_sad.
+// count is a multiple of 16.
+void SumAbsDiffBlock8_SSE2(const uint8* src_a, const uint8* src_b,
+                           uint32* dst_sad, int count) {
+  asm volatile (  // NOLINT
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm1         \n"
+    "lea       " MEMLEA(0x10, 0) ",%0          \n"
+    "movdqu    " MEMACCESS(1) ",%%xmm2         \n"
+    "lea       " MEMLEA(0x10, 1) ",%1          \n"
+    "psadbw    %%xmm2,%%xmm1                   \n"
+    "pshufd    $0x8,%%xmm1,%%xmm1              \n"
+    "movq      " MEMACCESS(2) ",%%xmm0         \n"
+    "paddd     %%xmm1,%%xmm0                   \n"
+    "movq      %%xmm0," MEMACCESS(2) "         \n"
+    "lea       " MEMLEA(0x8, 2) ",%2           \n"
+    "sub       $0x10,%3                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(dst_sad),    // %2
+    "+r"(count)       // %3
+  :: "memory", "cc", "xmm0", "xmm1", "xmm2"
+  );  // NOLINT
+}
+
+// Sum of Absolute Differences of a block 16 wide.
+uint32 SadBlock16_SSE2(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height) {
+  uint32 sad;
+  asm volatile (  // NOLINT
+    "pxor      %%xmm0,%%xmm0                   \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm1         \n"
+    "movdqu    " MEMACCESS(1) ",%%xmm2         \n"
+    "lea       " MEMLEA4(0x00,0,4,1) ",%0      \n"
+    "lea       " MEMLEA4(0x00,1,5,1) ",%1      \n"
+    "psadbw    %%xmm2,%%xmm1                   \n"
+    "paddd     %%xmm1,%%xmm0                   \n"
+    "sub       $0x1,%2                         \n"
+    "jg        1b                              \n"
+    "pshufd    $0xee,%%xmm0,%%xmm1             \n"
+    "paddd     %%xmm1,%%xmm0                   \n"
+    "movd      %%xmm0,%3                       \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(height),     // %2
+    "=g"(sad)         // %3
+  : "r"((intptr_t)(stride_a)),  // %4
+    "r"((intptr_t)(stride_b))   // %5
+  : "memory", "cc", "xmm0", "xmm1", "xmm2"
+  );  // NOLINT
+  return sad;
+}
+
+// Sum of Absolute Differences of a block 8 wide.  2 rows per loop.
+uint32 SadBlock8_SSE2(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, int height) {
+  uint32 sad;
+  asm volatile (  // NOLINT
+    "pxor      %%xmm0,%%xmm0                   \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movq      " MEMACCESS(0) ",%%xmm1         \n"
+    MEMOPREG(movhps,0x00,0,4,1,xmm1)           //  movhps (%0,%4,1),%%xmm1
+    "movq      " MEMACCESS(1) ",%%xmm2         \n"
+    MEMOPREG(movhps,0x00,1,5,1,xmm2)           //  movhps (%1,%5,1),%%xmm2
+    "lea       " MEMLEA4(0x00,0,4,2) ",%0      \n"
+    "lea       " MEMLEA4(0x00,1,5,2) ",%1      \n"
+    "psadbw    %%xmm2,%%xmm1                   \n"
+    "paddd     %%xmm1,%%xmm0                   \n"
+    "sub       $0x2,%2                         \n"
+    "jg        1b                              \n"
+    "pshufd    $0xee,%%xmm0,%%xmm1             \n"
+    "paddd     %%xmm1,%%xmm0                   \n"
+    "movd      %%xmm0,%3                       \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(height),     // %2
+    "=g"(sad)         // %3
+  : "r"((intptr_t)(stride_a)),  // %4
+    "r"((intptr_t)(stride_b))   // %5
+  : "memory", "cc", NACL_R14 "xmm0", "xmm1", "xmm2"
+  );  // NOLINT
+  return sad;
+}
+
+// Sum of Absolute Differences of a block 4 wide.  4 rows per loop.
+uint32 SadBlock4_SSE2(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, int height) {
+  uint32 sad;
+  asm volatile (  // NOLINT
+    "pxor      %%xmm0,%%xmm0                   \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movd      " MEMACCESS(0) ",%%xmm1         \n"
+    MEMOPREG(movd,0x00,0,4,1,xmm3)             //  movd (%0,%4,1),%%xmm3
+    "lea       " MEMLEA4(0x00,0,4,2) ",%0      \n"
+    "punpckldq %%xmm3,%%xmm1                   \n"
+    "movd      " MEMACCESS(0) ",%%xmm3         \n"
+    MEMOPREG(movd,0x00,0,4,1,xmm4)             //  movd (%0,%4,1),%%xmm4
+    "lea       " MEMLEA4(0x00,0,4,2) ",%0      \n"
+    "punpckldq %%xmm4,%%xmm3                   \n"
+    "punpcklqdq %%xmm3,%%xmm1                  \n"
+    "movd      " MEMACCESS(1) ",%%xmm2         \n"
+    MEMOPREG(movd,0x00,1,5,1,xmm3)             //  movd (%1,%5,1),%%xmm3
+    "lea       " MEMLEA4(0x00,1,5,2) ",%1      \n"
+    "punpckldq %%xmm3,%%xmm2                   \n"
+    "movd      " MEMACCESS(1) ",%%xmm3         \n"
+    MEMOPREG(movd,0x00,1,5,1,xmm4)             //  movd (%1,%5,1),%%xmm4
+    "lea       " MEMLEA4(0x00,1,5,2) ",%1      \n"
+    "punpckldq %%xmm4,%%xmm3                   \n"
+    "punpcklqdq %%xmm3,%%xmm2                  \n"
+    "psadbw    %%xmm2,%%xmm1                   \n"
+    "paddd     %%xmm1,%%xmm0                   \n"
+    "sub       $0x4,%2                         \n"
+    "jg        1b                              \n"
+    "pshufd    $0xee,%%xmm0,%%xmm1             \n"
+    "paddd     %%xmm1,%%xmm0                   \n"
+    "movd      %%xmm0,%3                       \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(height),     // %2
+    "=g"(sad)         // %3
+  : "r"((intptr_t)(stride_a)),  // %4
+    "r"((intptr_t)(stride_b))   // %5
+  : "memory", "cc", NACL_R14 "xmm0", "xmm1", "xmm2", "xmm3", "xmm4"
+  );  // NOLINT
+  return sad;
+}
+
+// Sum of absolute values of the 4x4 Hadamard transforms of the differences
+// of a block 8 wide.  4 rows, as two 4x4 transforms, per loop.
+uint32 SatdBlock8_SSE2(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height) {
+  uint32 satd;
+  asm volatile (  // NOLINT
+    "pxor      %%xmm7,%%xmm7                   \n"
+    LABELALIGN
+  "1:                                          \n"
+    // Differences of 4 rows as words.
+    "movq      " MEMACCESS(0) ",%%xmm0         \n"
+    MEMOPREG(movq,0x00,0,4,1,xmm1)             //  movq (%0,%4,1),%%xmm1
+    "lea       " MEMLEA4(0x00,0,4,2) ",%0      \n"
+    "movq      " MEMACCESS(0) ",%%xmm2         \n"
+    MEMOPREG(movq,0x00,0,4,1,xmm3)             //  movq (%0,%4,1),%%xmm3
+    "lea       " MEMLEA4(0x00,0,4,2) ",%0      \n"
+    "punpcklbw %%xmm0,%%xmm0                   \n"
+    "punpcklbw %%xmm1,%%xmm1                   \n"
+    "punpcklbw %%xmm2,%%xmm2                   \n"
+    "punpcklbw %%xmm3,%%xmm3                   \n"
+    "psrlw     $0x8,%%xmm0                     \n"
+    "psrlw     $0x8,%%xmm1                     \n"
+    "psrlw     $0x8,%%xmm2                     \n"
+    "psrlw     $0x8,%%xmm3                     \n"
+    "movq      " MEMACCESS(1) ",%%xmm4         \n"
+    MEMOPREG(movq,0x00,1,5,1,xmm5)             //  movq (%1,%5,1),%%xmm5
+    "lea       " MEMLEA4(0x00,1,5,2) ",%1      \n"
+    "punpcklbw %%xmm4,%%xmm4                   \n"
+    "punpcklbw %%xmm5,%%xmm5                   \n"
+    "psrlw     $0x8,%%xmm4                     \n"
+    "psrlw     $0x8,%%xmm5                     \n"
+    "psubw     %%xmm4,%%xmm0                   \n"
+    "psubw     %%xmm5,%%xmm1                   \n"
+    "movq      " MEMACCESS(1) ",%%xmm4         \n"
+    MEMOPREG(movq,0x00,1,5,1,xmm5)             //  movq (%1,%5,1),%%xmm5
+    "lea       " MEMLEA4(0x00,1,5,2) ",%1      \n"
+    "punpcklbw %%xmm4,%%xmm4                   \n"
+    "punpcklbw %%xmm5,%%xmm5                   \n"
+    "psrlw     $0x8,%%xmm4                     \n"
+    "psrlw     $0x8,%%xmm5                     \n"
+    "psubw     %%xmm4,%%xmm2                   \n"
+    "psubw     %%xmm5,%%xmm3                   \n"
+
+    // Vertical Hadamard.
+    "movdqa    %%xmm0,%%xmm4                   \n"
+    "paddw     %%xmm1,%%xmm0                   \n"
+    "psubw     %%xmm1,%%xmm4                   \n"
+    "movdqa    %%xmm2,%%xmm5                   \n"
+    "paddw     %%xmm3,%%xmm2                   \n"
+    "psubw     %%xmm3,%%xmm5                   \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "paddw     %%xmm2,%%xmm0                   \n"
+    "psubw     %%xmm2,%%xmm1                   \n"
+    "movdqa    %%xmm4,%%xmm3                   \n"
+    "paddw     %%xmm5,%%xmm4                   \n"
+    "psubw     %%xmm5,%%xmm3                   \n"
+
+    // Transpose each 4x4 of rows xmm0, xmm4, xmm1, xmm3 into columns
+    // xmm0, xmm1, xmm3, xmm5.
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "punpcklwd %%xmm4,%%xmm0                   \n"
+    "punpckhwd %%xmm4,%%xmm2                   \n"
+    "movdqa    %%xmm1,%%xmm5                   \n"
+    "punpcklwd %%xmm3,%%xmm1                   \n"
+    "punpckhwd %%xmm3,%%xmm5                   \n"
+    "movdqa    %%xmm0,%%xmm3                   \n"
+    "punpckldq %%xmm1,%%xmm0                   \n"
+    "punpckhdq %%xmm1,%%xmm3                   \n"
+    "movdqa    %%xmm2,%%xmm4                   \n"
+    "punpckldq %%xmm5,%%xmm2                   \n"
+    "punpckhdq %%xmm5,%%xmm4                   \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "punpcklqdq %%xmm2,%%xmm0                  \n"
+    "punpckhqdq %%xmm2,%%xmm1                  \n"
+    "movdqa    %%xmm3,%%xmm5                   \n"
+    "punpcklqdq %%xmm4,%%xmm3                  \n"
+    "punpckhqdq %%xmm4,%%xmm5                  \n"
+
+    // Horizontal Hadamard.
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "paddw     %%xmm1,%%xmm0                   \n"
+    "psubw     %%xmm1,%%xmm2                   \n"
+    "movdqa    %%xmm3,%%xmm4                   \n"
+    "paddw     %%xmm5,%%xmm3                   \n"
+    "psubw     %%xmm5,%%xmm4                   \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "paddw     %%xmm3,%%xmm0                   \n"
+    "psubw     %%xmm3,%%xmm1                   \n"
+    "movdqa    %%xmm2,%%xmm5                   \n"
+    "paddw     %%xmm4,%%xmm2                   \n"
+    "psubw     %%xmm4,%%xmm5                   \n"
+
+    // Sum absolute values.
+    "pxor      %%xmm6,%%xmm6                   \n"
+    "psubw     %%xmm0,%%xmm6                   \n"
+    "pmaxsw    %%xmm6,%%xmm0                   \n"
+    "pxor      %%xmm6,%%xmm6                   \n"
+    "psubw     %%xmm1,%%xmm6                   \n"
+    "pmaxsw    %%xmm6,%%xmm1                   \n"
+    "pxor      %%xmm6,%%xmm6                   \n"
+    "psubw     %%xmm2,%%xmm6                   \n"
+    "pmaxsw    %%xmm6,%%xmm2                   \n"
+    "pxor      %%xmm6,%%xmm6                   \n"
+    "psubw     %%xmm5,%%xmm6                   \n"
+    "pmaxsw    %%xmm6,%%xmm5                   \n"
+    "paddw     %%xmm1,%%xmm0                   \n"
+    "paddw     %%xmm2,%%xmm0                   \n"
+    "paddw     %%xmm5,%%xmm0                   \n"
+    "pcmpeqw   %%xmm6,%%xmm6                   \n"
+    "psrlw     $0xf,%%xmm6                     \n"
+    "pmaddwd   %%xmm6,%%xmm0                   \n"
+    "paddd     %%xmm0,%%xmm7                   \n"
+    "sub       $0x4,%2                         \n"
+    "jg        1b                              \n"
+
+    "pshufd    $0xee,%%xmm7,%%xmm0             \n"
+    "paddd     %%xmm0,%%xmm7                   \n"
+    "pshufd    $0x1,%%xmm7,%%xmm0              \n"
+    "paddd     %%xmm0,%%xmm7                   \n"
+    "movd      %%xmm7,%3                       \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(height),     // %2
+    "=g"(satd)        // %3
+  : "r"((intptr_t)(stride_a)),  // %4
+    "r"((intptr_t)(stride_b))   // %5
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );  // NOLINT
+  return satd;
+}
+
+// Returns the offset of the first byte that differs, or count if none do.
+// count is a multiple of 16.
+int FindFirstDiff_SSE2(const uint8* src_a, const uint8* src_b, int count) {
+  const uint8* src_start = src_a;
+  int mask;
+  asm volatile (  // NOLINT
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS(1) ",%%xmm1         \n"
+    "pcmpeqb   %%xmm1,%%xmm0                   \n"
+    "pmovmskb  %%xmm0,%3                       \n"
+    "xor       $0xffff,%3                      \n"
+    "jnz       2f                              \n"
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+  "2:                                          \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(count),      // %2
+    "=&r"(mask)       // %3
+  :: "memory", "cc", "xmm0", "xmm1"
+  );  // NOLINT
+  if (mask) {
+    return (int)(src_a - src_start) + __builtin_ctz(mask);
+  }
+  return (int)(src_a - src_start);
+}
+// Returns the number of leading pixels with 255 in bytes 0 and 3, in
+// multiples of 16.  width is a multiple of 16.
+int ARGBDetectRow_SSE2(const uint8* src_argb, int width) {
+  const uint8* src_start = src_argb;
+  int mask;
+  asm volatile (  // NOLINT
+    "pcmpeqb   %%xmm5,%%xmm5                   \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    "movdqu    " MEMACCESS2(0x20,0) ",%%xmm2   \n"
+    "movdqu    " MEMACCESS2(0x30,0) ",%%xmm3   \n"
+    "pand      %%xmm1,%%xmm0                   \n"
+    "pand      %%xmm3,%%xmm2                   \n"
+    "pand      %%xmm2,%%xmm0                   \n"
+    "pcmpeqb   %%xmm5,%%xmm0                   \n"
+    "pmovmskb  %%xmm0,%2                       \n"
+    "and       $0x9999,%2                      \n"
+    "cmp       $0x9999,%2                      \n"
+    "jne       2f                              \n"
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "sub       $0x10,%1                        \n"
+    "jg        1b                              \n"
+  "2:                                          \n"
+  : "+r"(src_argb),   // %0
+    "+r"(width),      // %1
+    "=&r"(mask)       // %2
+  :: "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5"
+  );  // NOLINT
+  return (int)(src_argb - src_start) >> 2;
+}
+
+// Updates the minimum and maximum of each byte of the pixels.
+// width is a multiple of 8.
+void ARGBMinMaxRow_SSE2(const uint8* src_argb, uint8* dst_minmax, int width) {
+  asm volatile (  // NOLINT
+    "movq      " MEMACCESS(1) ",%%xmm0         \n"
+    "pshufd    $0x55,%%xmm0,%%xmm1             \n"
+    "pshufd    $0x0,%%xmm0,%%xmm0              \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm2         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm3   \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "pminub    %%xmm2,%%xmm0                   \n"
+    "pmaxub    %%xmm2,%%xmm1                   \n"
+    "pminub    %%xmm3,%%xmm0                   \n"
+    "pmaxub    %%xmm3,%%xmm1                   \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+    "pshufd    $0xee,%%xmm0,%%xmm2             \n"
+    "pshufd    $0xee,%%xmm1,%%xmm3             \n"
+    "pminub    %%xmm2,%%xmm0                   \n"
+    "pmaxub    %%xmm3,%%xmm1                   \n"
+    "pshufd    $0x1,%%xmm0,%%xmm2              \n"
+    "pshufd    $0x1,%%xmm1,%%xmm3              \n"
+    "pminub    %%xmm2,%%xmm0                   \n"
+    "pmaxub    %%xmm3,%%xmm1                   \n"
+    "punpckldq %%xmm1,%%xmm0                   \n"
+    "movq      %%xmm0," MEMACCESS(1) "         \n"
+  : "+r"(src_argb),   // %0
+    "+r"(dst_minmax), // %1
+    "+r"(width)       // %2
+  :: "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3"
+  );  // NOLINT
+}
+// Sums of a, b, a * a, b * b and a * b over an 8x8 window, for SSIM.
+void SsimSums8x8_SSE2(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, uint32* sums) {
+  int rows = 8;
+  asm volatile (  // NOLINT
+    "pxor      %%xmm0,%%xmm0                   \n"
+    "pxor      %%xmm1,%%xmm1                   \n"
+    "pxor      %%xmm2,%%xmm2                   \n"
+    "pxor      %%xmm3,%%xmm3                   \n"
+    "pxor      %%xmm4,%%xmm4                   \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movq      " MEMACCESS(0) ",%%xmm6         \n"
+    "movq      " MEMACCESS(1) ",%%xmm7         \n"
+    "lea       " MEMLEA4(0x00,0,4,1) ",%0      \n"
+    "lea       " MEMLEA4(0x00,1,5,1) ",%1      \n"
+    "punpcklqdq %%xmm7,%%xmm6                  \n"
+    "movdqa    %%xmm6,%%xmm5                   \n"
+    "psadbw    %%xmm4,%%xmm5                   \n"  // sum a, sum b
+    "paddd     %%xmm5,%%xmm0                   \n"
+    "movdqa    %%xmm6,%%xmm7                   \n"
+    "punpcklbw %%xmm4,%%xmm6                   \n"
+    "punpckhbw %%xmm4,%%xmm7                   \n"
+    "movdqa    %%xmm6,%%xmm5                   \n"
+    "pmaddwd   %%xmm7,%%xmm5                   \n"  // a * b
+    "paddd     %%xmm5,%%xmm3                   \n"
+    "pmaddwd   %%xmm6,%%xmm6                   \n"  // a * a
+    "paddd     %%xmm6,%%xmm1                   \n"
+    "pmaddwd   %%xmm7,%%xmm7                   \n"  // b * b
+    "paddd     %%xmm7,%%xmm2                   \n"
+    "sub       $0x1,%2                         \n"
+    "jg        1b                              \n"
+    "movd      %%xmm0," MEMACCESS(3) "         \n"
+    "pshufd    $0x2,%%xmm0,%%xmm0              \n"
+    "movd      %%xmm0," MEMACCESS2(0x4,3) "    \n"
+    "pshufd    $0xee,%%xmm1,%%xmm5             \n"
+    "pshufd    $0xee,%%xmm2,%%xmm6             \n"
+    "pshufd    $0xee,%%xmm3,%%xmm7             \n"
+    "paddd     %%xmm5,%%xmm1                   \n"
+    "paddd     %%xmm6,%%xmm2                   \n"
+    "paddd     %%xmm7,%%xmm3                   \n"
+    "pshufd    $0x1,%%xmm1,%%xmm5              \n"
+    "pshufd    $0x1,%%xmm2,%%xmm6              \n"
+    "pshufd    $0x1,%%xmm3,%%xmm7              \n"
+    "paddd     %%xmm5,%%xmm1                   \n"
+    "paddd     %%xmm6,%%xmm2                   \n"
+    "paddd     %%xmm7,%%xmm3                   \n"
+    "movd      %%xmm1," MEMACCESS2(0x8,3) "    \n"
+    "movd      %%xmm2," MEMACCESS2(0xc,3) "    \n"
+    "movd      %%xmm3," MEMACCESS2(0x10,3) "   \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+rm"(rows)       // %2
+  : "r"(sums),        // %3
+    "r"((intptr_t)(stride_a)),  // %4
+    "r"((intptr_t)(stride_b))   // %5
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+    "xmm7"
+  );  // NOLINT
+}
+
+// Squares of differences of up to 16 bits are 32 bit and summed in 64 bits.
+// count is a multiple of 8.
+uint64 SumSquareError_16_SSE2(const uint16* src_a, const uint16* src_b,
+                              int count) {
+  uint64 sse;
+  asm volatile (  // NOLINT
+    "pxor      %%xmm0,%%xmm0                   \n"
+    "pxor      %%xmm5,%%xmm5                   \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm1         \n"
+    "movdqu    " MEMACCESS(1) ",%%xmm2         \n"
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "movdqa    %%xmm1,%%xmm3                   \n"
+    "psubusw   %%xmm2,%%xmm1                   \n"
+    "psubusw   %%xmm3,%%xmm2                   \n"
+    "por       %%xmm2,%%xmm1                   \n"  // abs(a - b)
+    "movdqa    %%xmm1,%%xmm2                   \n"
+    "pmullw    %%xmm1,%%xmm1                   \n"
+    "pmulhuw   %%xmm2,%%xmm2                   \n"
+    "movdqa    %%xmm1,%%xmm3                   \n"
+    "punpcklwd %%xmm2,%%xmm1                   \n"
+    "punpckhwd %%xmm2,%%xmm3                   \n"
+    "movdqa    %%xmm1,%%xmm2                   \n"
+    "punpckldq %%xmm5,%%xmm1                   \n"
+    "punpckhdq %%xmm5,%%xmm2                   \n"
+    "paddq     %%xmm1,%%xmm0                   \n"
+    "paddq     %%xmm2,%%xmm0                   \n"
+    "movdqa    %%xmm3,%%xmm2                   \n"
+    "punpckldq %%xmm5,%%xmm3                   \n"
+    "punpckhdq %%xmm5,%%xmm2                   \n"
+    "paddq     %%xmm3,%%xmm0                   \n"
+    "paddq     %%xmm2,%%xmm0                   \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+    "pshufd    $0xee,%%xmm0,%%xmm1             \n"
+    "paddq     %%xmm1,%%xmm0                   \n"
+    "movq      %%xmm0,%3                       \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(count),      // %2
+    "=m"(sse)         // %3
+  :: "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5"
+  );  // NOLINT
+  return sse;
+}
+
+// count is a multiple of 16 and at most 65536.
+void PlaneStatsRow_SSE2(const uint8* src, uint32* dst_stats, int count) {
+  asm volatile (  // NOLINT
+    "pxor      %%xmm0,%%xmm0                   \n"
+    "pxor      %%xmm1,%%xmm1                   \n"
+    "pcmpeqb   %%xmm2,%%xmm2                   \n"
+    "pxor      %%xmm3,%%xmm3                   \n"
+    "pxor      %%xmm5,%%xmm5                   \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm4         \n"
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "pminub    %%xmm4,%%xmm2                   \n"
+    "pmaxub    %%xmm4,%%xmm3                   \n"
+    "movdqa    %%xmm4,%%xmm6                   \n"
+    "psadbw    %%xmm5,%%xmm6                   \n"  // sum
+    "paddq     %%xmm6,%%xmm0                   \n"
+    "movdqa    %%xmm4,%%xmm6                   \n"
+    "punpcklbw %%xmm5,%%xmm6                   \n"
+    "punpckhbw %%xmm5,%%xmm4                   \n"
+    "pmaddwd   %%xmm6,%%xmm6                   \n"  // sum of squares
+    "pmaddwd   %%xmm4,%%xmm4                   \n"
+    "paddd     %%xmm6,%%xmm1                   \n"
+    "paddd     %%xmm4,%%xmm1                   \n"
+    "sub       $0x10,%1                        \n"
+    "jg        1b                              \n"
+    "pshufd    $0xee,%%xmm0,%%xmm6             \n"
+    "paddd     %%xmm6,%%xmm0                   \n"
+    "pshufd    $0xee,%%xmm1,%%xmm6             \n"
+    "paddd     %%xmm6,%%xmm1                   \n"
+    "pshufd    $0x1,%%xmm1,%%xmm6              \n"
+    "paddd     %%xmm6,%%xmm1                   \n"
+    "pshufd    $0xee,%%xmm2,%%xmm6             \n"
+    "pminub    %%xmm6,%%xmm2                   \n"
+    "pshufd    $0xee,%%xmm3,%%xmm6             \n"
+    "pmaxub    %%xmm6,%%xmm3                   \n"
+    "pshuflw   $0xe,%%xmm2,%%xmm6              \n"
+    "pminub    %%xmm6,%%xmm2                   \n"
+    "pshuflw   $0xe,%%xmm3,%%xmm6              \n"
+    "pmaxub    %%xmm6,%%xmm3                   \n"
+    "pshuflw   $0x1,%%xmm2,%%xmm6              \n"
+    "pminub    %%xmm6,%%xmm2                   \n"
+    "pshuflw   $0x1,%%xmm3,%%xmm6              \n"
+    "pmaxub    %%xmm6,%%xmm3                   \n"
+    "movdqa    %%xmm2,%%xmm6                   \n"
+    "psrlw     $0x8,%%xmm6                     \n"
+    "pminub    %%xmm6,%%xmm2                   \n"
+    "movdqa    %%xmm3,%%xmm6                   \n"
+    "psrlw     $0x8,%%xmm6                     \n"
+    "pmaxub    %%xmm6,%%xmm3                   \n"
+    "punpcklbw %%xmm5,%%xmm2                   \n"
+    "punpcklwd %%xmm5,%%xmm2                   \n"
+    "punpcklbw %%xmm5,%%xmm3                   \n"
+    "punpcklwd %%xmm5,%%xmm3                   \n"
+    "movd      %%xmm0," MEMACCESS(2) "         \n"
+    "movd      %%xmm1," MEMACCESS2(0x4,2) "    \n"
+    "movd      %%xmm2," MEMACCESS2(0x8,2) "    \n"
+    "movd      %%xmm3," MEMACCESS2(0xc,2) "    \n"
+  : "+r"(src),        // %0
+    "+r"(count)       // %1
+  : "r"(dst_stats)    // %2
+  : "memory", "cc"
+    , "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6"
+  );  // NOLINT
+}
+
 #endif  // defined(__x86_64__) || defined(__i386__)
 
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+uint32 SumSquareError_AVX2(const uint8* src_a, const uint8* src_b, int count) {
+  uint32 sse;
+  asm volatile (  // NOLINT
+    "vpxor    %%ymm0,%%ymm0,%%ymm0             \n"
+    "vpxor    %%ymm5,%%ymm5,%%ymm5             \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm1         \n"
+    "lea       " MEMLEA(0x20, 0) ",%0          \n"
+    "vmovdqu   " MEMACCESS(1) ",%%ymm2         \n"
+    "lea       " MEMLEA(0x20, 1) ",%1          \n"
+    "vpsubusb  %%ymm2,%%ymm1,%%ymm3            \n"  // abs difference trick
+    "vpsubusb  %%ymm1,%%ymm2,%%ymm2            \n"
+    "vpor     %%ymm2,%%ymm3,%%ymm1             \n"
+    "vpunpcklbw %%ymm5,%%ymm1,%%ymm2           \n"  // u16.  mutates order.
+    "vpunpckhbw %%ymm5,%%ymm1,%%ymm1           \n"
+    "vpmaddwd  %%ymm2,%%ymm2,%%ymm2            \n"  // square + hadd to u32.
+    "vpmaddwd  %%ymm1,%%ymm1,%%ymm1            \n"
+    "vpaddd    %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpaddd    %%ymm2,%%ymm0,%%ymm0            \n"
+    "sub       $0x20,%2                        \n"
+    "jg        1b                              \n"
+
+    "vextracti128 $0x1,%%ymm0,%%xmm1           \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vpshufd   $0xee,%%xmm0,%%xmm1             \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vpshufd   $0x1,%%xmm0,%%xmm1              \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vmovd     %%xmm0,%3                       \n"
+    "vzeroupper                                \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(count),      // %2
+    "=g"(sse)         // %3
+  :: "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5"
+  );  // NOLINT
+  return sse;
+}
+#endif  // GCC_HAS_AVX2
+
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512))
+uint32 SumSquareError_AVX512BW(const uint8* src_a, const uint8* src_b,
+                               int count) {
+  uint32 sse;
+  asm volatile (  // NOLINT
+    "vpxord    %%zmm0,%%zmm0,%%zmm0            \n"
+    "vpxord    %%zmm5,%%zmm5,%%zmm5            \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu8  " MEMACCESS(0) ",%%zmm1         \n"
+    "lea       " MEMLEA(0x40, 0) ",%0          \n"
+    "vmovdqu8  " MEMACCESS(1) ",%%zmm2         \n"
+    "lea       " MEMLEA(0x40, 1) ",%1          \n"
+    "vpsubusb  %%zmm2,%%zmm1,%%zmm3            \n"  // abs difference trick
+    "vpsubusb  %%zmm1,%%zmm2,%%zmm2            \n"
+    "vporq     %%zmm2,%%zmm3,%%zmm1            \n"
+    "vpunpcklbw %%zmm5,%%zmm1,%%zmm2           \n"  // u16.  mutates order.
+    "vpunpckhbw %%zmm5,%%zmm1,%%zmm1           \n"
+    "vpmaddwd  %%zmm2,%%zmm2,%%zmm2            \n"  // square + hadd to u32.
+    "vpmaddwd  %%zmm1,%%zmm1,%%zmm1            \n"
+    "vpaddd    %%zmm1,%%zmm0,%%zmm0            \n"
+    "vpaddd    %%zmm2,%%zmm0,%%zmm0            \n"
+    "sub       $0x40,%2                        \n"
+    "jg        1b                              \n"
+
+    "vextracti64x4 $0x1,%%zmm0,%%ymm1          \n"
+    "vpaddd    %%ymm1,%%ymm0,%%ymm0            \n"
+    "vextracti128 $0x1,%%ymm0,%%xmm1           \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vpshufd   $0xee,%%xmm0,%%xmm1             \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vpshufd   $0x1,%%xmm0,%%xmm1              \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vmovd     %%xmm0,%3                       \n"
+    "vzeroupper                                \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(count),      // %2
+    "=g"(sse)         // %3
+  :: "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5"
+  );  // NOLINT
+  return sse;
+}
+#endif  // GCC_HAS_AVX512
+
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+// Sum of Absolute Differences of a block 32 wide.
+uint32 SadBlock32_AVX2(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height) {
+  uint32 sad;
+  asm volatile (  // NOLINT
+    "vpxor     %%ymm0,%%ymm0,%%ymm0            \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm1         \n"
+    "vpsadbw   " MEMACCESS(1) ",%%ymm1,%%ymm1  \n"
+    "lea       " MEMLEA4(0x00,0,4,1) ",%0      \n"
+    "lea       " MEMLEA4(0x00,1,5,1) ",%1      \n"
+    "vpaddd    %%ymm1,%%ymm0,%%ymm0            \n"
+    "sub       $0x1,%2                         \n"
+    "jg        1b                              \n"
+    "vextracti128 $0x1,%%ymm0,%%xmm1           \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vpshufd   $0xee,%%xmm0,%%xmm1             \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vmovd     %%xmm0,%3                       \n"
+    "vzeroupper                                \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(height),     // %2
+    "=g"(sad)         // %3
+  : "r"((intptr_t)(stride_a)),  // %4
+    "r"((intptr_t)(stride_b))   // %5
+  : "memory", "cc", "xmm0", "xmm1"
+  );  // NOLINT
+  return sad;
+}
+
+// Sum of absolute values of the 4x4 Hadamard transforms of the differences
+// of a block 16 wide.  Each 128 bit lane does the 8x4 of SatdBlock8_SSE2, so
+// 4 rows are four 4x4 transforms per loop.
+uint32 SatdBlock16_AVX2(const uint8* src_a, int stride_a,
+                        const uint8* src_b, int stride_b, int height) {
+  uint32 satd;
+  asm volatile (  // NOLINT
+    "vpxor     %%ymm7,%%ymm7,%%ymm7            \n"
+    "vpcmpeqw  %%ymm6,%%ymm6,%%ymm6            \n"
+    "vpsrlw    $0xf,%%ymm6,%%ymm6              \n"
+    LABELALIGN
+  "1:                                          \n"
+    // Differences of 4 rows as words.
+    "vpmovzxbw " MEMACCESS(0) ",%%ymm0         \n"
+    MEMOPREG(vpmovzxbw,0x00,0,4,1,ymm1)        //  vpmovzxbw (%0,%4,1),%%ymm1
+    "lea       " MEMLEA4(0x00,0,4,2) ",%0      \n"
+    "vpmovzxbw " MEMACCESS(0) ",%%ymm2         \n"
+    MEMOPREG(vpmovzxbw,0x00,0,4,1,ymm3)        //  vpmovzxbw (%0,%4,1),%%ymm3
+    "lea       " MEMLEA4(0x00,0,4,2) ",%0      \n"
+    "vpmovzxbw " MEMACCESS(1) ",%%ymm4         \n"
+    MEMOPREG(vpmovzxbw,0x00,1,5,1,ymm5)        //  vpmovzxbw (%1,%5,1),%%ymm5
+    "lea       " MEMLEA4(0x00,1,5,2) ",%1      \n"
+    "vpsubw    %%ymm4,%%ymm0,%%ymm0            \n"
+    "vpsubw    %%ymm5,%%ymm1,%%ymm1            \n"
+    "vpmovzxbw " MEMACCESS(1) ",%%ymm4         \n"
+    MEMOPREG(vpmovzxbw,0x00,1,5,1,ymm5)        //  vpmovzxbw (%1,%5,1),%%ymm5
+    "lea       " MEMLEA4(0x00,1,5,2) ",%1      \n"
+    "vpsubw    %%ymm4,%%ymm2,%%ymm2            \n"
+    "vpsubw    %%ymm5,%%ymm3,%%ymm3            \n"
+
+    // Vertical Hadamard.  Rows are ymm0, ymm4, ymm1, ymm3.
+    "vpsubw    %%ymm1,%%ymm0,%%ymm4            \n"
+    "vpaddw    %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpsubw    %%ymm3,%%ymm2,%%ymm5            \n"
+    "vpaddw    %%ymm3,%%ymm2,%%ymm2            \n"
+    "vpsubw    %%ymm2,%%ymm0,%%ymm1            \n"
+    "vpaddw    %%ymm2,%%ymm0,%%ymm0            \n"
+    "vpsubw    %%ymm5,%%ymm4,%%ymm3            \n"
+    "vpaddw    %%ymm5,%%ymm4,%%ymm4            \n"
+
+    // Transpose each 4x4 into columns ymm0, ymm1, ymm3, ymm5.
+    "vpunpckhwd %%ymm4,%%ymm0,%%ymm2           \n"
+    "vpunpcklwd %%ymm4,%%ymm0,%%ymm0           \n"
+    "vpunpckhwd %%ymm3,%%ymm1,%%ymm5           \n"
+    "vpunpcklwd %%ymm3,%%ymm1,%%ymm1           \n"
+    "vpunpckhdq %%ymm1,%%ymm0,%%ymm3           \n"
+    "vpunpckldq %%ymm1,%%ymm0,%%ymm0           \n"
+    "vpunpckhdq %%ymm5,%%ymm2,%%ymm4           \n"
+    "vpunpckldq %%ymm5,%%ymm2,%%ymm2           \n"
+    "vpunpckhqdq %%ymm2,%%ymm0,%%ymm1          \n"
+    "vpunpcklqdq %%ymm2,%%ymm0,%%ymm0          \n"
+    "vpunpckhqdq %%ymm4,%%ymm3,%%ymm5          \n"
+    "vpunpcklqdq %%ymm4,%%ymm3,%%ymm3          \n"
+
+    // Horizontal Hadamard.
+    "vpsubw    %%ymm1,%%ymm0,%%ymm2            \n"
+    "vpaddw    %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpsubw    %%ymm5,%%ymm3,%%ymm4            \n"
+    "vpaddw    %%ymm5,%%ymm3,%%ymm3            \n"
+    "vpsubw    %%ymm3,%%ymm0,%%ymm1            \n"
+    "vpaddw    %%ymm3,%%ymm0,%%ymm0            \n"
+    "vpsubw    %%ymm4,%%ymm2,%%ymm5            \n"
+    "vpaddw    %%ymm4,%%ymm2,%%ymm2            \n"
+
+    // Sum absolute values.
+    "vpabsw    %%ymm0,%%ymm0                   \n"
+    "vpabsw    %%ymm1,%%ymm1                   \n"
+    "vpabsw    %%ymm2,%%ymm2                   \n"
+    "vpabsw    %%ymm5,%%ymm5                   \n"
+    "vpaddw    %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpaddw    %%ymm5,%%ymm2,%%ymm2            \n"
+    "vpaddw    %%ymm2,%%ymm0,%%ymm0            \n"
+    "vpmaddwd  %%ymm6,%%ymm0,%%ymm0            \n"
+    "vpaddd    %%ymm0,%%ymm7,%%ymm7            \n"
+    "sub       $0x4,%2                         \n"
+    "jg        1b                              \n"
+
+    "vextracti128 $0x1,%%ymm7,%%xmm0           \n"
+    "vpaddd    %%xmm0,%%xmm7,%%xmm7            \n"
+    "vpshufd   $0xee,%%xmm7,%%xmm0             \n"
+    "vpaddd    %%xmm0,%%xmm7,%%xmm7            \n"
+    "vpshufd   $0x1,%%xmm7,%%xmm0              \n"
+    "vpaddd    %%xmm0,%%xmm7,%%xmm7            \n"
+    "vmovd     %%xmm7,%3                       \n"
+    "vzeroupper                                \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(height),     // %2
+    "=g"(satd)        // %3
+  : "r"((intptr_t)(stride_a)),  // %4
+    "r"((intptr_t)(stride_b))   // %5
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );  // NOLINT
+  return satd;
+}
+
+// Returns the offset of the first byte that differs, or count if none do.
+// count is a multiple of 32.
+int FindFirstDiff_AVX2(const uint8* src_a, const uint8* src_b, int count) {
+  const uint8* src_start = src_a;
+  int mask;
+  asm volatile (  // NOLINT
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vpcmpeqb  " MEMACCESS(1) ",%%ymm0,%%ymm0  \n"
+    "vpmovmskb %%ymm0,%3                       \n"
+    "xor       $0xffffffff,%3                  \n"
+    "jnz       2f                              \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x20,%2                        \n"
+    "jg        1b                              \n"
+  "2:                                          \n"
+    "vzeroupper                                \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(count),      // %2
+    "=&r"(mask)       // %3
+  :: "memory", "cc", "xmm0"
+  );  // NOLINT
+  if (mask) {
+    return (int)(src_a - src_start) + __builtin_ctz(mask);
+  }
+  return (int)(src_a - src_start);
+}
+// Returns the number of leading pixels with 255 in bytes 0 and 3, in
+// multiples of 32.  width is a multiple of 32.
+int ARGBDetectRow_AVX2(const uint8* src_argb, int width) {
+  const uint8* src_start = src_argb;
+  int mask;
+  asm volatile (  // NOLINT
+    "vpcmpeqb  %%ymm5,%%ymm5,%%ymm5            \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vmovdqu   " MEMACCESS2(0x40,0) ",%%ymm2   \n"
+    "vpand     " MEMACCESS2(0x20,0) ",%%ymm0,%%ymm0 \n"
+    "vpand     " MEMACCESS2(0x60,0) ",%%ymm2,%%ymm2 \n"
+    "vpand     %%ymm2,%%ymm0,%%ymm0            \n"
+    "vpcmpeqb  %%ymm5,%%ymm0,%%ymm0            \n"
+    "vpmovmskb %%ymm0,%2                       \n"
+    "and       $0x99999999,%2                  \n"
+    "cmp       $0x99999999,%2                  \n"
+    "jne       2f                              \n"
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "sub       $0x20,%1                        \n"
+    "jg        1b                              \n"
+  "2:                                          \n"
+    "vzeroupper                                \n"
+  : "+r"(src_argb),   // %0
+    "+r"(width),      // %1
+    "=&r"(mask)       // %2
+  :: "memory", "cc", "xmm0", "xmm2", "xmm5"
+  );  // NOLINT
+  return (int)(src_argb - src_start) >> 2;
+}
+
+// Updates the minimum and maximum of each byte of the pixels.
+// width is a multiple of 16.
+void ARGBMinMaxRow_AVX2(const uint8* src_argb, uint8* dst_minmax, int width) {
+  asm volatile (  // NOLINT
+    "vpbroadcastd " MEMACCESS(1) ",%%ymm0      \n"
+    "vpbroadcastd " MEMACCESS2(0x4,1) ",%%ymm1 \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm2         \n"
+    "vmovdqu   " MEMACCESS2(0x20,0) ",%%ymm3   \n"
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "vpminub   %%ymm2,%%ymm0,%%ymm0            \n"
+    "vpmaxub   %%ymm2,%%ymm1,%%ymm1            \n"
+    "vpminub   %%ymm3,%%ymm0,%%ymm0            \n"
+    "vpmaxub   %%ymm3,%%ymm1,%%ymm1            \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+    "vextracti128 $0x1,%%ymm0,%%xmm2           \n"
+    "vextracti128 $0x1,%%ymm1,%%xmm3           \n"
+    "vpminub   %%xmm2,%%xmm0,%%xmm0            \n"
+    "vpmaxub   %%xmm3,%%xmm1,%%xmm1            \n"
+    "vpshufd   $0xee,%%xmm0,%%xmm2             \n"
+    "vpshufd   $0xee,%%xmm1,%%xmm3             \n"
+    "vpminub   %%xmm2,%%xmm0,%%xmm0            \n"
+    "vpmaxub   %%xmm3,%%xmm1,%%xmm1            \n"
+    "vpshufd   $0x1,%%xmm0,%%xmm2              \n"
+    "vpshufd   $0x1,%%xmm1,%%xmm3              \n"
+    "vpminub   %%xmm2,%%xmm0,%%xmm0            \n"
+    "vpmaxub   %%xmm3,%%xmm1,%%xmm1            \n"
+    "vpunpckldq %%xmm1,%%xmm0,%%xmm0           \n"
+    "vmovq     %%xmm0," MEMACCESS(1) "         \n"
+    "vzeroupper                                \n"
+  : "+r"(src_argb),   // %0
+    "+r"(dst_minmax), // %1
+    "+r"(width)       // %2
+  :: "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3"
+  );  // NOLINT
+}
+// count is a multiple of 16.
+uint64 SumSquareError_16_AVX2(const uint16* src_a, const uint16* src_b,
+                              int count) {
+  uint64 sse;
+  asm volatile (  // NOLINT
+    "vpxor     %%ymm0,%%ymm0,%%ymm0            \n"
+    "vpxor     %%ymm5,%%ymm5,%%ymm5            \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm1         \n"
+    "vmovdqu   " MEMACCESS(1) ",%%ymm2         \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "vpsubusw  %%ymm2,%%ymm1,%%ymm3            \n"
+    "vpsubusw  %%ymm1,%%ymm2,%%ymm2            \n"
+    "vpor      %%ymm2,%%ymm3,%%ymm1            \n"  // abs(a - b)
+    "vpmullw   %%ymm1,%%ymm1,%%ymm2            \n"
+    "vpmulhuw  %%ymm1,%%ymm1,%%ymm3            \n"
+    "vpunpcklwd %%ymm3,%%ymm2,%%ymm1           \n"
+    "vpunpckhwd %%ymm3,%%ymm2,%%ymm2           \n"
+    "vpunpckldq %%ymm5,%%ymm1,%%ymm3           \n"
+    "vpunpckhdq %%ymm5,%%ymm1,%%ymm1           \n"
+    "vpaddq    %%ymm3,%%ymm0,%%ymm0            \n"
+    "vpaddq    %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpunpckldq %%ymm5,%%ymm2,%%ymm3           \n"
+    "vpunpckhdq %%ymm5,%%ymm2,%%ymm2           \n"
+    "vpaddq    %%ymm3,%%ymm0,%%ymm0            \n"
+    "vpaddq    %%ymm2,%%ymm0,%%ymm0            \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+    "vextracti128 $0x1,%%ymm0,%%xmm1           \n"
+    "vpaddq    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vpshufd   $0xee,%%xmm0,%%xmm1             \n"
+    "vpaddq    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vmovq     %%xmm0,%3                       \n"
+    "vzeroupper                                \n"
+  : "+r"(src_a),      // %0
+    "+r"(src_b),      // %1
+    "+r"(count),      // %2
+    "=m"(sse)         // %3
+  :: "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5"
+  );  // NOLINT
+  return sse;
+}
+
+// count is a multiple of 32 and at most 65536.
+void PlaneStatsRow_AVX2(const uint8* src, uint32* dst_stats, int count) {
+  asm volatile (  // NOLINT
+    "vpxor     %%ymm0,%%ymm0,%%ymm0            \n"
+    "vpxor     %%ymm1,%%ymm1,%%ymm1            \n"
+    "vpcmpeqb  %%ymm2,%%ymm2,%%ymm2            \n"
+    "vpxor     %%ymm3,%%ymm3,%%ymm3            \n"
+    "vpxor     %%ymm5,%%ymm5,%%ymm5            \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm4         \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "vpminub   %%ymm4,%%ymm2,%%ymm2            \n"
+    "vpmaxub   %%ymm4,%%ymm3,%%ymm3            \n"
+    "vpsadbw   %%ymm5,%%ymm4,%%ymm6            \n"  // sum
+    "vpaddq    %%ymm6,%%ymm0,%%ymm0            \n"
+    "vpunpcklbw %%ymm5,%%ymm4,%%ymm6           \n"
+    "vpunpckhbw %%ymm5,%%ymm4,%%ymm4           \n"
+    "vpmaddwd  %%ymm6,%%ymm6,%%ymm6            \n"  // sum of squares
+    "vpmaddwd  %%ymm4,%%ymm4,%%ymm4            \n"
+    "vpaddd    %%ymm6,%%ymm1,%%ymm1            \n"
+    "vpaddd    %%ymm4,%%ymm1,%%ymm1            \n"
+    "sub       $0x20,%1                        \n"
+    "jg        1b                              \n"
+    "vextracti128 $0x1,%%ymm0,%%xmm6           \n"
+    "vpaddq    %%xmm6,%%xmm0,%%xmm0            \n"
+    "vextracti128 $0x1,%%ymm1,%%xmm6           \n"
+    "vpaddd    %%xmm6,%%xmm1,%%xmm1            \n"
+    "vextracti128 $0x1,%%ymm2,%%xmm6           \n"
+    "vpminub   %%xmm6,%%xmm2,%%xmm2            \n"
+    "vextracti128 $0x1,%%ymm3,%%xmm6           \n"
+    "vpmaxub   %%xmm6,%%xmm3,%%xmm3            \n"
+    "vpshufd   $0xee,%%xmm0,%%xmm6             \n"
+    "vpaddd    %%xmm6,%%xmm0,%%xmm0            \n"
+    "vpshufd   $0xee,%%xmm1,%%xmm6             \n"
+    "vpaddd    %%xmm6,%%xmm1,%%xmm1            \n"
+    "vpshufd   $0x1,%%xmm1,%%xmm6              \n"
+    "vpaddd    %%xmm6,%%xmm1,%%xmm1            \n"
+    "vpshufd   $0xee,%%xmm2,%%xmm6             \n"
+    "vpminub   %%xmm6,%%xmm2,%%xmm2            \n"
+    "vpshufd   $0xee,%%xmm3,%%xmm6             \n"
+    "vpmaxub   %%xmm6,%%xmm3,%%xmm3            \n"
+    "vpshuflw  $0xe,%%xmm2,%%xmm6              \n"
+    "vpminub   %%xmm6,%%xmm2,%%xmm2            \n"
+    "vpshuflw  $0xe,%%xmm3,%%xmm6              \n"
+    "vpmaxub   %%xmm6,%%xmm3,%%xmm3            \n"
+    "vpshuflw  $0x1,%%xmm2,%%xmm6              \n"
+    "vpminub   %%xmm6,%%xmm2,%%xmm2            \n"
+    "vpshuflw  $0x1,%%xmm3,%%xmm6              \n"
+    "vpmaxub   %%xmm6,%%xmm3,%%xmm3            \n"
+    "vpsrlw    $0x8,%%xmm2,%%xmm6              \n"
+    "vpminub   %%xmm6,%%xmm2,%%xmm2            \n"
+    "vpsrlw    $0x8,%%xmm3,%%xmm6              \n"
+    "vpmaxub   %%xmm6,%%xmm3,%%xmm3            \n"
+    "vpmovzxbd %%xmm2,%%xmm2                   \n"
+    "vpmovzxbd %%xmm3,%%xmm3                   \n"
+    "vmovd     %%xmm0," MEMACCESS(2) "         \n"
+    "vmovd     %%xmm1," MEMACCESS2(0x4,2) "    \n"
+    "vmovd     %%xmm2," MEMACCESS2(0x8,2) "    \n"
+    "vmovd     %%xmm3," MEMACCESS2(0xc,2) "    \n"
+    "vzeroupper                                \n"
+  : "+r"(src),        // %0
+    "+r"(count)       // %1
+  : "r"(dst_stats)    // %2
+  : "memory", "cc"
+    , "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6"
+  );  // NOLINT
+}
+#endif  // GCC_HAS_AVX2
+
 #if !defined(LIBYUV_DISABLE_X86) && \
     (defined(__x86_64__) || (defined(__i386__) && !defined(__pic__)))
 #define HAS_HASHDJB2_SSE41
@@ -143,6 +1159,260 @@ uint32 HashDjb2_SSE41(const uint8* src, int count, uint32 seed) {
   );  // NOLINT
   return hash;
 }
+
+// The wider hashes keep a vector of partial hashes, each multiplied by 33 to
+// the power of the bytes per loop, and add the lanes once at the end.  The
+// seed starts in lane 0 so it is multiplied by 33 ^ count.
+static const uint32 kHash64x33 = 0xf07f8801u;  // 33 ^ 64
+static const uint32 kHash128x33 = 0x193f1001u;  // 33 ^ 128
+static const uint32 kHashMul128[128] = {
+  0xa3ac93e1,  // 33 ^ 127
+  0x52891bc1,  // 33 ^ 126
+  0x120427a1,  // 33 ^ 125
+  0x465d3781,  // 33 ^ 124
+  0x09e3cb61,  // 33 ^ 123
+  0xaaf76341,  // 33 ^ 122
+  0x6a077f21,  // 33 ^ 121
+  0x77939f01,  // 33 ^ 120
+  0x322b42e1,  // 33 ^ 119
+  0xa46deac1,  // 33 ^ 118
+  0x430b16a1,  // 33 ^ 117
+  0xeac24681,  // 33 ^ 116
+  0x1e62fa61,  // 33 ^ 115
+  0x84ccb241,  // 33 ^ 114
+  0xa6eeee21,  // 33 ^ 113
+  0xedc92e01,  // 33 ^ 112
+  0xe06af1e1,  // 33 ^ 111
+  0xa1f3b9c1,  // 33 ^ 110
+  0xaf9305a1,  // 33 ^ 109
+  0xde885581,  // 33 ^ 108
+  0x9a232961,  // 33 ^ 107
+  0x61c30141,  // 33 ^ 106
+  0x86d75d21,  // 33 ^ 105
+  0x2adfbd01,  // 33 ^ 104
+  0x7d6ba0e1,  // 33 ^ 103
+  0x3a1a88c1,  // 33 ^ 102
+  0x669bf4a1,  // 33 ^ 101
+  0x50af6481,  // 33 ^ 100
+  0xcc245861,  // 33 ^ 99
+  0xb0da5041,  // 33 ^ 98
+  0x98c0cc21,  // 33 ^ 97
+  0xddd74c01,  // 33 ^ 96
+  0xd82d4fe1,  // 33 ^ 95
+  0x5be257c1,  // 33 ^ 94
+  0x7725e3a1,  // 33 ^ 93
+  0x70377381,  // 33 ^ 92
+  0x03668761,  // 33 ^ 91
+  0xe1129f41,  // 33 ^ 90
+  0x6bab3b21,  // 33 ^ 89
+  0xb5afdb01,  // 33 ^ 88
+  0xbfaffee1,  // 33 ^ 87
+  0xf64b26c1,  // 33 ^ 86
+  0xf030d2a1,  // 33 ^ 85
+  0x6c208281,  // 33 ^ 84
+  0x8ee9b661,  // 33 ^ 83
+  0x616bee41,  // 33 ^ 82
+  0x8e96aa21,  // 33 ^ 81
+  0x61696a01,  // 33 ^ 80
+  0x02f3ade1,  // 33 ^ 79
+  0xf854f5c1,  // 33 ^ 78
+  0xe0bcc1a1,  // 33 ^ 77
+  0x736a9181,  // 33 ^ 76
+  0xbdade561,  // 33 ^ 75
+  0xa0e63d41,  // 33 ^ 74
+  0x90831921,  // 33 ^ 73
+  0x9003f901,  // 33 ^ 72
+  0x70f85ce1,  // 33 ^ 71
+  0x50ffc4c1,  // 33 ^ 70
+  0x57c9b0a1,  // 33 ^ 69
+  0xb515a081,  // 33 ^ 68
+  0xdeb31461,  // 33 ^ 67
+  0x0e818c41,  // 33 ^ 66
+  0x00708821,  // 33 ^ 65
+  0xf07f8801,  // 33 ^ 64
+  0xd8be0be1,  // 33 ^ 63
+  0xef4b93c1,  // 33 ^ 62
+  0x64579fa1,  // 33 ^ 61
+  0x6021af81,  // 33 ^ 60
+  0x40f94361,  // 33 ^ 59
+  0x193ddb41,  // 33 ^ 58
+  0x6d5ef721,  // 33 ^ 57
+  0x31dc1701,  // 33 ^ 56
+  0x0944bae1,  // 33 ^ 55
+  0xc23862c1,  // 33 ^ 54
+  0x15668ea1,  // 33 ^ 53
+  0xa38ebe81,  // 33 ^ 52
+  0x33807261,  // 33 ^ 51
+  0x301b2a41,  // 33 ^ 50
+  0x664e6621,  // 33 ^ 49
+  0x0319a601,  // 33 ^ 48
+  0xd18c69e1,  // 33 ^ 47
+  0xb8c631c1,  // 33 ^ 46
+  0x79f67da1,  // 33 ^ 45
+  0xae5ccd81,  // 33 ^ 44
+  0x0548a161,  // 33 ^ 43
+  0xc2197941,  // 33 ^ 42
+  0x7a3ed521,  // 33 ^ 41
+  0x13383501,  // 33 ^ 40
+  0x009518e1,  // 33 ^ 39
+  0xc1f500c1,  // 33 ^ 38
+  0xa1076ca1,  // 33 ^ 37
+  0xaf8bdc81,  // 33 ^ 36
+  0x0551d061,  // 33 ^ 35
+  0x3e38c841,  // 33 ^ 34
+  0x38304421,  // 33 ^ 33
+  0x1137c401,  // 33 ^ 32
+  0x655ec7e1,  // 33 ^ 31
+  0xccc4cfc1,  // 33 ^ 30
+  0x99995ba1,  // 33 ^ 29
+  0xd61beb81,  // 33 ^ 28
+  0x829bff61,  // 33 ^ 27
+  0x13791741,  // 33 ^ 26
+  0x2f22b321,  // 33 ^ 25
+  0xac185301,  // 33 ^ 24
+  0xcee976e1,  // 33 ^ 23
+  0xc8359ec1,  // 33 ^ 22
+  0x72ac4aa1,  // 33 ^ 21
+  0x510cfa81,  // 33 ^ 20
+  0xcc272e61,  // 33 ^ 19
+  0xb0da6641,  // 33 ^ 18
+  0xee162221,  // 33 ^ 17
+  0x92d9e201,  // 33 ^ 16
+  0x0c3525e1,  // 33 ^ 15
+  0xa3476dc1,  // 33 ^ 14
+  0x3b4039a1,  // 33 ^ 13
+  0x4f5f0981,  // 33 ^ 12
+  0x30f35d61,  // 33 ^ 11
+  0x855cb541,  // 33 ^ 10
+  0x040a9121,  // 33 ^ 9
+  0x747c7101,  // 33 ^ 8
+  0xec41d4e1,  // 33 ^ 7
+  0x4cfa3cc1,  // 33 ^ 6
+  0x025528a1,  // 33 ^ 5
+  0x00121881,  // 33 ^ 4
+  0x00008c61,  // 33 ^ 3
+  0x00000441,  // 33 ^ 2
+  0x00000021,  // 33 ^ 1
+  0x00000001,  // 33 ^ 0
+};
+
+#if defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2)
+#define HAS_HASHDJB2_AVX2
+uint32 HashDjb2_AVX2(const uint8* src, int count, uint32 seed) {
+  uint32 hash;
+  asm volatile (  // NOLINT
+    "vmovd     %2,%%xmm0                       \n"
+    "vpbroadcastd %4,%%ymm6                    \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vpmulld   %%ymm6,%%ymm0,%%ymm0            \n"  // hash *= 33 ^ 64
+    "vpmovzxbd " MEMACCESS(0) ",%%ymm1         \n"
+    "vpmovzxbd " MEMACCESS2(0x8,0) ",%%ymm2    \n"
+    "vpmovzxbd " MEMACCESS2(0x10,0) ",%%ymm3   \n"
+    "vpmovzxbd " MEMACCESS2(0x18,0) ",%%ymm4   \n"
+    "vpmulld   " MEMACCESS(5) ",%%ymm1,%%ymm1   \n"
+    "vpmulld   " MEMACCESS2(0x20,5) ",%%ymm2,%%ymm2 \n"
+    "vpmulld   " MEMACCESS2(0x40,5) ",%%ymm3,%%ymm3 \n"
+    "vpmulld   " MEMACCESS2(0x60,5) ",%%ymm4,%%ymm4 \n"
+    "vpaddd    %%ymm2,%%ymm1,%%ymm1            \n"
+    "vpaddd    %%ymm4,%%ymm3,%%ymm3            \n"
+    "vpaddd    %%ymm3,%%ymm1,%%ymm1            \n"
+    "vpmovzxbd " MEMACCESS2(0x20,0) ",%%ymm2   \n"
+    "vpmovzxbd " MEMACCESS2(0x28,0) ",%%ymm3   \n"
+    "vpmovzxbd " MEMACCESS2(0x30,0) ",%%ymm4   \n"
+    "vpmovzxbd " MEMACCESS2(0x38,0) ",%%ymm5   \n"
+    "vpmulld   " MEMACCESS2(0x80,5) ",%%ymm2,%%ymm2 \n"
+    "vpmulld   " MEMACCESS2(0xa0,5) ",%%ymm3,%%ymm3 \n"
+    "vpmulld   " MEMACCESS2(0xc0,5) ",%%ymm4,%%ymm4 \n"
+    "vpmulld   " MEMACCESS2(0xe0,5) ",%%ymm5,%%ymm5 \n"
+    "vpaddd    %%ymm3,%%ymm2,%%ymm2            \n"
+    "vpaddd    %%ymm5,%%ymm4,%%ymm4            \n"
+    "vpaddd    %%ymm4,%%ymm2,%%ymm2            \n"
+    "vpaddd    %%ymm2,%%ymm1,%%ymm1            \n"
+    "lea       " MEMLEA(0x40, 0) ",%0          \n"
+    "vpaddd    %%ymm1,%%ymm0,%%ymm0            \n"
+    "sub       $0x40,%1                        \n"
+    "jg        1b                              \n"
+    "vextracti128 $0x1,%%ymm0,%%xmm1           \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vpshufd   $0xee,%%xmm0,%%xmm1             \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vpshufd   $0x1,%%xmm0,%%xmm1              \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vmovd     %%xmm0,%3                       \n"
+    "vzeroupper                                \n"
+  : "+r"(src),        // %0
+    "+r"(count),      // %1
+    "+rm"(seed),      // %2
+    "=g"(hash)        // %3
+  : "m"(kHash64x33),  // %4
+    "r"(kHashMul128 + 64)  // %5
+  : "memory", "cc"
+    , "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6"
+  );  // NOLINT
+  return hash;
+}
+#endif  // GCC_HAS_AVX2
+
+#if defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512)
+#define HAS_HASHDJB2_AVX512BW
+uint32 HashDjb2_AVX512BW(const uint8* src, int count, uint32 seed) {
+  uint32 hash;
+  asm volatile (  // NOLINT
+    "vmovd     %2,%%xmm0                       \n"
+    "vpbroadcastd %4,%%zmm6                    \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vpmulld   %%zmm6,%%zmm0,%%zmm0            \n"  // hash *= 33 ^ 128
+    "vpmovzxbd " MEMACCESS(0) ",%%zmm1         \n"
+    "vpmovzxbd " MEMACCESS2(0x10,0) ",%%zmm2   \n"
+    "vpmovzxbd " MEMACCESS2(0x20,0) ",%%zmm3   \n"
+    "vpmovzxbd " MEMACCESS2(0x30,0) ",%%zmm4   \n"
+    "vpmulld   " MEMACCESS(5) ",%%zmm1,%%zmm1   \n"
+    "vpmulld   " MEMACCESS2(0x40,5) ",%%zmm2,%%zmm2 \n"
+    "vpmulld   " MEMACCESS2(0x80,5) ",%%zmm3,%%zmm3 \n"
+    "vpmulld   " MEMACCESS2(0xc0,5) ",%%zmm4,%%zmm4 \n"
+    "vpaddd    %%zmm2,%%zmm1,%%zmm1            \n"
+    "vpaddd    %%zmm4,%%zmm3,%%zmm3            \n"
+    "vpaddd    %%zmm3,%%zmm1,%%zmm1            \n"
+    "vpmovzxbd " MEMACCESS2(0x40,0) ",%%zmm2   \n"
+    "vpmovzxbd " MEMACCESS2(0x50,0) ",%%zmm3   \n"
+    "vpmovzxbd " MEMACCESS2(0x60,0) ",%%zmm4   \n"
+    "vpmovzxbd " MEMACCESS2(0x70,0) ",%%zmm5   \n"
+    "vpmulld   " MEMACCESS2(0x100,5) ",%%zmm2,%%zmm2 \n"
+    "vpmulld   " MEMACCESS2(0x140,5) ",%%zmm3,%%zmm3 \n"
+    "vpmulld   " MEMACCESS2(0x180,5) ",%%zmm4,%%zmm4 \n"
+    "vpmulld   " MEMACCESS2(0x1c0,5) ",%%zmm5,%%zmm5 \n"
+    "vpaddd    %%zmm3,%%zmm2,%%zmm2            \n"
+    "vpaddd    %%zmm5,%%zmm4,%%zmm4            \n"
+    "vpaddd    %%zmm4,%%zmm2,%%zmm2            \n"
+    "vpaddd    %%zmm2,%%zmm1,%%zmm1            \n"
+    "lea       " MEMLEA(0x80, 0) ",%0          \n"
+    "vpaddd    %%zmm1,%%zmm0,%%zmm0            \n"
+    "sub       $0x80,%1                        \n"
+    "jg        1b                              \n"
+    "vextracti64x4 $0x1,%%zmm0,%%ymm1          \n"
+    "vpaddd    %%ymm1,%%ymm0,%%ymm0            \n"
+    "vextracti128 $0x1,%%ymm0,%%xmm1           \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vpshufd   $0xee,%%xmm0,%%xmm1             \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vpshufd   $0x1,%%xmm0,%%xmm1              \n"
+    "vpaddd    %%xmm1,%%xmm0,%%xmm0            \n"
+    "vmovd     %%xmm0,%3                       \n"
+    "vzeroupper                                \n"
+  : "+r"(src),        // %0
+    "+r"(count),      // %1
+    "+rm"(seed),      // %2
+    "=g"(hash)        // %3
+  : "m"(kHash128x33), // %4
+    "r"(kHashMul128)  // %5
+  : "memory", "cc"
+    , "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6"
+  );  // NOLINT
+  return hash;
+}
+#endif  // GCC_HAS_AVX512
 #endif  // defined(__x86_64__) || (defined(__i386__) && !defined(__pic__)))
 
 #ifdef __cplusplus
@@ -57,6 +57,453 @@ uint32 SumSquareError_NEON(const uint8* src_a, const uint8* src_b, int count) {
   return sse;
 }
 
+// Adds the Sum Square Error of each group of 8 values to dst_sse.
+// count is a multiple of 16.
+void SumSquareErrorBlock8_NEON(const uint8* src_a, const uint8* src_b,
+                               uint32* dst_sse, int count) {
+  asm volatile (
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld1.8     {q0}, [%0]!                    \n"
+    MEMACCESS(1)
+    "vld1.8     {q1}, [%1]!                    \n"
+    "subs       %3, %3, #16                    \n"
+    "vabdl.u8   q2, d0, d2                     \n"
+    "vabdl.u8   q3, d1, d3                     \n"
+    "vmull.u16  q8, d4, d4                     \n"
+    "vmlal.u16  q8, d5, d5                     \n"
+    "vmull.u16  q9, d6, d6                     \n"
+    "vmlal.u16  q9, d7, d7                     \n"
+    "vpadd.u32  d16, d16, d17                  \n"
+    "vpadd.u32  d18, d18, d19                  \n"
+    "vpadd.u32  d16, d16, d18                  \n"
+    MEMACCESS(2)
+    "vld1.32    {d20}, [%2]                    \n"
+    "vadd.u32   d20, d20, d16                  \n"
+    MEMACCESS(2)
+    "vst1.32    {d20}, [%2]!                   \n"
+    "bgt        1b                             \n"
+    : "+r"(src_a),
+      "+r"(src_b),
+      "+r"(dst_sse),
+      "+r"(count)
+    :
+    : "memory", "cc", "q0", "q1", "q2", "q3", "q8", "q9", "q10");
+}
+
+// Adds the Sum of Absolute Differences of each group of 8 values to dst_sad.
+// count is a multiple of 16.
+void SumAbsDiffBlock8_NEON(const uint8* src_a, const uint8* src_b,
+                           uint32* dst_sad, int count) {
+  asm volatile (
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld1.8     {q0}, [%0]!                    \n"
+    MEMACCESS(1)
+    "vld1.8     {q1}, [%1]!                    \n"
+    "subs       %3, %3, #16                    \n"
+    "vabdl.u8   q2, d0, d2                     \n"
+    "vabdl.u8   q3, d1, d3                     \n"
+    "vpaddl.u16 q2, q2                         \n"
+    "vpaddl.u16 q3, q3                         \n"
+    "vpadd.u32  d4, d4, d5                     \n"
+    "vpadd.u32  d6, d6, d7                     \n"
+    "vpadd.u32  d4, d4, d6                     \n"
+    MEMACCESS(2)
+    "vld1.32    {d20}, [%2]                    \n"
+    "vadd.u32   d20, d20, d4                   \n"
+    MEMACCESS(2)
+    "vst1.32    {d20}, [%2]!                   \n"
+    "bgt        1b                             \n"
+    : "+r"(src_a),
+      "+r"(src_b),
+      "+r"(dst_sad),
+      "+r"(count)
+    :
+    : "memory", "cc", "q0", "q1", "q2", "q3", "q10");
+}
+
+// Sum of Absolute Differences of a block 16 wide.
+uint32 SadBlock16_NEON(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height) {
+  uint32 sad;
+  asm volatile (
+    "vmov.u8    q8, #0                         \n"
+    "vmov.u8    q9, #0                         \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld1.8     {q0}, [%0], %4                 \n"
+    MEMACCESS(1)
+    "vld1.8     {q1}, [%1], %5                 \n"
+    "subs       %2, %2, #1                     \n"
+    "vabal.u8   q8, d0, d2                     \n"
+    "vabal.u8   q9, d1, d3                     \n"
+    "bgt        1b                             \n"
+    "vadd.u16   q8, q8, q9                     \n"
+    "vpaddl.u16 q8, q8                         \n"
+    "vpadd.u32  d16, d16, d17                  \n"
+    "vpaddl.u32 d16, d16                       \n"
+    "vmov.32    %3, d16[0]                     \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(height),   // %2
+      "=r"(sad)       // %3
+    : "r"(stride_a),  // %4
+      "r"(stride_b)   // %5
+    : "memory", "cc", "q0", "q1", "q8", "q9");
+  return sad;
+}
+
+// Sum of Absolute Differences of a block 8 wide.
+uint32 SadBlock8_NEON(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, int height) {
+  uint32 sad;
+  asm volatile (
+    "vmov.u8    q8, #0                         \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld1.8     {d0}, [%0], %4                 \n"
+    MEMACCESS(1)
+    "vld1.8     {d2}, [%1], %5                 \n"
+    "subs       %2, %2, #1                     \n"
+    "vabal.u8   q8, d0, d2                     \n"
+    "bgt        1b                             \n"
+    "vpaddl.u16 q8, q8                         \n"
+    "vpadd.u32  d16, d16, d17                  \n"
+    "vpaddl.u32 d16, d16                       \n"
+    "vmov.32    %3, d16[0]                     \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(height),   // %2
+      "=r"(sad)       // %3
+    : "r"(stride_a),  // %4
+      "r"(stride_b)   // %5
+    : "memory", "cc", "q0", "q1", "q8");
+  return sad;
+}
+
+// Sum of absolute values of the 4x4 Hadamard transforms of the differences
+// of a block 8 wide.  4 rows, as two 4x4 transforms, per loop.
+uint32 SatdBlock8_NEON(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height) {
+  uint32 satd;
+  asm volatile (
+    "vmov.u8    q15, #0                        \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld1.8     {d0}, [%0], %4                 \n"
+    MEMACCESS(0)
+    "vld1.8     {d1}, [%0], %4                 \n"
+    MEMACCESS(0)
+    "vld1.8     {d2}, [%0], %4                 \n"
+    MEMACCESS(0)
+    "vld1.8     {d3}, [%0], %4                 \n"
+    MEMACCESS(1)
+    "vld1.8     {d4}, [%1], %5                 \n"
+    MEMACCESS(1)
+    "vld1.8     {d5}, [%1], %5                 \n"
+    MEMACCESS(1)
+    "vld1.8     {d6}, [%1], %5                 \n"
+    MEMACCESS(1)
+    "vld1.8     {d7}, [%1], %5                 \n"
+    "subs       %2, %2, #4                     \n"
+    "vsubl.u8   q8, d0, d4                     \n"
+    "vsubl.u8   q9, d1, d5                     \n"
+    "vsubl.u8   q10, d2, d6                    \n"
+    "vsubl.u8   q11, d3, d7                    \n"
+    // Vertical Hadamard.
+    "vadd.s16   q0, q8, q9                     \n"
+    "vsub.s16   q1, q8, q9                     \n"
+    "vadd.s16   q2, q10, q11                   \n"
+    "vsub.s16   q3, q10, q11                   \n"
+    "vadd.s16   q8, q0, q2                     \n"
+    "vsub.s16   q10, q0, q2                    \n"
+    "vadd.s16   q9, q1, q3                     \n"
+    "vsub.s16   q11, q1, q3                    \n"
+    // Transpose each 4x4.
+    "vtrn.16    q8, q9                         \n"
+    "vtrn.16    q10, q11                       \n"
+    "vtrn.32    q8, q10                        \n"
+    "vtrn.32    q9, q11                        \n"
+    // Horizontal Hadamard.
+    "vadd.s16   q0, q8, q9                     \n"
+    "vsub.s16   q1, q8, q9                     \n"
+    "vadd.s16   q2, q10, q11                   \n"
+    "vsub.s16   q3, q10, q11                   \n"
+    "vadd.s16   q8, q0, q2                     \n"
+    "vsub.s16   q10, q0, q2                    \n"
+    "vadd.s16   q9, q1, q3                     \n"
+    "vsub.s16   q11, q1, q3                    \n"
+    // Sum absolute values.
+    "vabs.s16   q8, q8                         \n"
+    "vabs.s16   q9, q9                         \n"
+    "vabs.s16   q10, q10                       \n"
+    "vabs.s16   q11, q11                       \n"
+    "vadd.u16   q8, q8, q9                     \n"
+    "vadd.u16   q10, q10, q11                  \n"
+    "vadd.u16   q8, q8, q10                    \n"
+    "vpadal.u16 q15, q8                        \n"
+    "bgt        1b                             \n"
+    "vpadd.u32  d30, d30, d31                  \n"
+    "vpaddl.u32 d30, d30                       \n"
+    "vmov.32    %3, d30[0]                     \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(height),   // %2
+      "=r"(satd)      // %3
+    : "r"(stride_a),  // %4
+      "r"(stride_b)   // %5
+    : "memory", "cc", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11",
+      "q15");
+  return satd;
+}
+
+int FindFirstDiff_C(const uint8* src_a, const uint8* src_b, int count);
+
+// Returns the offset of the first byte that differs, or count if none do.
+// count is a multiple of 16.
+int FindFirstDiff_NEON(const uint8* src_a, const uint8* src_b, int count) {
+  const uint8* src_start = src_a;
+  uint32 mask;
+  uint32 mask_hi;
+  asm volatile (
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld1.8     {q0}, [%0]                     \n"
+    MEMACCESS(1)
+    "vld1.8     {q1}, [%1]                     \n"
+    "veor       q0, q0, q1                     \n"
+    "vorr       d0, d0, d1                     \n"
+    "vmov       %3, %4, d0                     \n"
+    "orrs       %3, %3, %4                     \n"
+    "bne        2f                             \n"
+    "add        %0, %0, #16                    \n"
+    "add        %1, %1, #16                    \n"
+    "subs       %2, %2, #16                    \n"
+    "bgt        1b                             \n"
+  "2:                                          \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(count),    // %2
+      "=&r"(mask),    // %3
+      "=&r"(mask_hi)  // %4
+    :
+    : "memory", "cc", "q0", "q1");
+  if (mask) {
+    return (int)(src_a - src_start) + FindFirstDiff_C(src_a, src_b, 16);
+  }
+  return (int)(src_a - src_start);
+}
+
+// Returns the number of leading pixels with 255 in bytes 0 and 3, in
+// multiples of 16.  width is a multiple of 16.
+int ARGBDetectRow_NEON(const uint8* src_argb, int width) {
+  const uint8* src_start = src_argb;
+  const uint8* src_next;
+  uint32 alpha;
+  asm volatile (
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    "add        %3, %0, #32                    \n"
+    MEMACCESS(0)
+    "vld4.8     {d0, d1, d2, d3}, [%0]         \n"
+    MEMACCESS(3)
+    "vld4.8     {d4, d5, d6, d7}, [%3]         \n"
+    "vand       d0, d0, d3                     \n"
+    "vand       d4, d4, d7                     \n"
+    "vand       d0, d0, d4                     \n"
+    "vpmin.u8   d0, d0, d0                     \n"
+    "vpmin.u8   d0, d0, d0                     \n"
+    "vpmin.u8   d0, d0, d0                     \n"
+    "vmov.u8    %2, d0[0]                      \n"
+    "cmp        %2, #255                       \n"
+    "bne        2f                             \n"
+    "add        %0, %0, #64                    \n"
+    "subs       %1, %1, #16                    \n"
+    "bgt        1b                             \n"
+  "2:                                          \n"
+    : "+r"(src_argb),   // %0
+      "+r"(width),      // %1
+      "=&r"(alpha),     // %2
+      "=&r"(src_next)   // %3
+    :
+    : "memory", "cc", "q0", "q1", "q2", "q3");
+  return (int)(src_argb - src_start) >> 2;
+}
+
+// Updates the minimum and maximum of each byte of the pixels.
+// width is a multiple of 8.
+void ARGBMinMaxRow_NEON(const uint8* src_argb, uint8* dst_minmax, int width) {
+  asm volatile (
+    MEMACCESS(1)
+    "vld4.8     {d16[], d17[], d18[], d19[]}, [%1]! \n"
+    MEMACCESS(1)
+    "vld4.8     {d20[], d21[], d22[], d23[]}, [%1]  \n"
+    "sub        %1, %1, #4                     \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld4.8     {d0, d1, d2, d3}, [%0]!        \n"
+    "subs       %2, %2, #8                     \n"
+    "vmin.u8    q8, q8, q0                     \n"
+    "vmin.u8    q9, q9, q1                     \n"
+    "vmax.u8    q10, q10, q0                   \n"
+    "vmax.u8    q11, q11, q1                   \n"
+    "bgt        1b                             \n"
+    "vpmin.u8   d16, d16, d17                  \n"
+    "vpmin.u8   d18, d18, d19                  \n"
+    "vpmax.u8   d20, d20, d21                  \n"
+    "vpmax.u8   d22, d22, d23                  \n"
+    "vpmin.u8   d16, d16, d18                  \n"
+    "vpmax.u8   d20, d20, d22                  \n"
+    "vpmin.u8   d16, d16, d16                  \n"
+    "vpmax.u8   d20, d20, d20                  \n"
+    MEMACCESS(1)
+    "vst1.32    {d16[0]}, [%1]!                \n"
+    MEMACCESS(1)
+    "vst1.32    {d20[0]}, [%1]                 \n"
+    : "+r"(src_argb),   // %0
+      "+r"(dst_minmax), // %1
+      "+r"(width)       // %2
+    :
+    : "memory", "cc", "q0", "q1", "q8", "q9", "q10", "q11");
+}
+
+// Sums of a, b, a * a, b * b and a * b over an 8x8 window, for SSIM.
+void SsimSums8x8_NEON(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, uint32* sums) {
+  int rows = 8;
+  asm volatile (
+    "vmov.u16   q8, #0                         \n"
+    "vmov.u16   q9, #0                         \n"
+    "vmov.u32   q10, #0                        \n"
+    "vmov.u32   q11, #0                        \n"
+    "vmov.u32   q12, #0                        \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld1.8     {d0}, [%0], %4                 \n"
+    MEMACCESS(1)
+    "vld1.8     {d1}, [%1], %5                 \n"
+    "subs       %2, %2, #1                     \n"
+    "vaddw.u8   q8, q8, d0                     \n"
+    "vaddw.u8   q9, q9, d1                     \n"
+    "vmull.u8   q1, d0, d0                     \n"
+    "vmull.u8   q2, d1, d1                     \n"
+    "vmull.u8   q3, d0, d1                     \n"
+    "vpadal.u16 q10, q1                        \n"
+    "vpadal.u16 q11, q2                        \n"
+    "vpadal.u16 q12, q3                        \n"
+    "bgt        1b                             \n"
+    "vpaddl.u16 q8, q8                         \n"
+    "vpaddl.u16 q9, q9                         \n"
+    "vpadd.u32  d16, d16, d17                  \n"
+    "vpadd.u32  d18, d18, d19                  \n"
+    "vpadd.u32  d20, d20, d21                  \n"
+    "vpadd.u32  d22, d22, d23                  \n"
+    "vpadd.u32  d24, d24, d25                  \n"
+    "vpadd.u32  d16, d16, d18                  \n"  // sum a, sum b
+    "vpadd.u32  d20, d20, d22                  \n"  // a * a, b * b
+    "vpadd.u32  d24, d24, d24                  \n"  // a * b
+    MEMACCESS(3)
+    "vst1.32    {d16}, [%3]!                   \n"
+    MEMACCESS(3)
+    "vst1.32    {d20}, [%3]!                   \n"
+    MEMACCESS(3)
+    "vst1.32    {d24[0]}, [%3]                 \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(rows),     // %2
+      "+r"(sums)      // %3
+    : "r"(stride_a),  // %4
+      "r"(stride_b)   // %5
+    : "memory", "cc", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11",
+      "q12");
+}
+
+// count is a multiple of 8.
+uint64 SumSquareError_16_NEON(const uint16* src_a, const uint16* src_b,
+                              int count) {
+  uint64 sse;
+  asm volatile (
+    "vmov.u8    q8, #0                         \n"
+    "vmov.u8    q9, #0                         \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld1.16    {q0}, [%0]!                    \n"
+    MEMACCESS(1)
+    "vld1.16    {q1}, [%1]!                    \n"
+    "subs       %2, %2, #8                     \n"
+    "vabd.u16   q0, q0, q1                     \n"
+    "vmull.u16  q1, d0, d0                     \n"
+    "vmull.u16  q2, d1, d1                     \n"
+    "vpadal.u32 q8, q1                         \n"
+    "vpadal.u32 q9, q2                         \n"
+    "bgt        1b                             \n"
+    "vadd.u64   q8, q8, q9                     \n"
+    "vadd.u64   d16, d16, d17                  \n"
+    "vmov       %Q3, %R3, d16                  \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(count),    // %2
+      "=r"(sse)       // %3
+    :
+    : "memory", "cc", "q0", "q1", "q2", "q8", "q9");
+  return sse;
+}
+
+// count is a multiple of 16 and at most 65536.
+void PlaneStatsRow_NEON(const uint8* src, uint32* dst_stats, int count) {
+  asm volatile (
+    "vmov.u32   q8, #0                         \n"
+    "vmov.u32   q9, #0                         \n"
+    "vmov.u8    q10, #255                      \n"
+    "vmov.u8    q11, #0                        \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld1.8     {q0}, [%0]!                    \n"
+    "subs       %1, %1, #16                    \n"
+    "vmin.u8    q10, q10, q0                   \n"
+    "vmax.u8    q11, q11, q0                   \n"
+    "vpaddl.u8  q1, q0                         \n"
+    "vmull.u8   q2, d0, d0                     \n"
+    "vmull.u8   q3, d1, d1                     \n"
+    "vpadal.u16 q8, q1                         \n"  // sum
+    "vpadal.u16 q9, q2                         \n"  // sum of squares
+    "vpadal.u16 q9, q3                         \n"
+    "bgt        1b                             \n"
+    "vadd.u32   d16, d16, d17                  \n"
+    "vadd.u32   d18, d18, d19                  \n"
+    "vpadd.u32  d16, d16, d16                  \n"
+    "vpadd.u32  d18, d18, d18                  \n"
+    "vpmin.u8   d20, d20, d21                  \n"
+    "vpmax.u8   d22, d22, d23                  \n"
+    "vpmin.u8   d20, d20, d20                  \n"
+    "vpmax.u8   d22, d22, d22                  \n"
+    "vpmin.u8   d20, d20, d20                  \n"
+    "vpmax.u8   d22, d22, d22                  \n"
+    "vpmin.u8   d20, d20, d20                  \n"
+    "vpmax.u8   d22, d22, d22                  \n"
+    "vmovl.u8   q10, d20                       \n"
+    "vmovl.u8   q11, d22                       \n"
+    "vmovl.u16  q10, d20                       \n"
+    "vmovl.u16  q11, d22                       \n"
+    MEMACCESS(2)
+    "vst4.32    {d16[0], d18[0], d20[0], d22[0]}, [%2] \n"
+    : "+r"(src),      // %0
+      "+r"(count)     // %1
+    : "r"(dst_stats)  // %2
+    : "memory", "cc", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11");
+}
+
 #endif  // defined(__ARM_NEON__) && !defined(__aarch64__)
 
 #ifdef __cplusplus
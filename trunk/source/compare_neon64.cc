@@ -55,6 +55,430 @@ uint32 SumSquareError_NEON(const uint8* src_a, const uint8* src_b, int count) {
   return sse;
 }
 
+// Adds the Sum Square Error of each group of 8 values to dst_sse.
+// count is a multiple of 16.
+void SumSquareErrorBlock8_NEON(const uint8* src_a, const uint8* src_b,
+                               uint32* dst_sse, int count) {
+  asm volatile (
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v0.16b}, [%0], #16            \n"
+    MEMACCESS(1)
+    "ld1        {v1.16b}, [%1], #16            \n"
+    "subs       %w3, %w3, #16                  \n"
+    "uabdl      v2.8h, v0.8b, v1.8b            \n"
+    "uabdl2     v3.8h, v0.16b, v1.16b          \n"
+    "umull      v4.4s, v2.4h, v2.4h            \n"
+    "umlal2     v4.4s, v2.8h, v2.8h            \n"
+    "umull      v5.4s, v3.4h, v3.4h            \n"
+    "umlal2     v5.4s, v3.8h, v3.8h            \n"
+    "addp       v4.4s, v4.4s, v5.4s            \n"
+    "addp       v4.4s, v4.4s, v4.4s            \n"
+    MEMACCESS(2)
+    "ld1        {v6.2s}, [%2]                  \n"
+    "add        v6.2s, v6.2s, v4.2s            \n"
+    MEMACCESS(2)
+    "st1        {v6.2s}, [%2], #8              \n"
+    "b.gt       1b                             \n"
+    : "+r"(src_a),
+      "+r"(src_b),
+      "+r"(dst_sse),
+      "+r"(count)
+    :
+    : "memory", "cc", "v0", "v1", "v2", "v3", "v4", "v5", "v6");
+}
+
+// Adds the Sum of Absolute Differences of each group of 8 values to dst_sad.
+// count is a multiple of 16.
+void SumAbsDiffBlock8_NEON(const uint8* src_a, const uint8* src_b,
+                           uint32* dst_sad, int count) {
+  asm volatile (
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v0.16b}, [%0], #16            \n"
+    MEMACCESS(1)
+    "ld1        {v1.16b}, [%1], #16            \n"
+    "subs       %w3, %w3, #16                  \n"
+    "uabdl      v2.8h, v0.8b, v1.8b            \n"
+    "uabdl2     v3.8h, v0.16b, v1.16b          \n"
+    "uaddlp     v2.4s, v2.8h                   \n"
+    "uaddlp     v3.4s, v3.8h                   \n"
+    "addp       v2.4s, v2.4s, v3.4s            \n"
+    "addp       v2.4s, v2.4s, v2.4s            \n"
+    MEMACCESS(2)
+    "ld1        {v6.2s}, [%2]                  \n"
+    "add        v6.2s, v6.2s, v2.2s            \n"
+    MEMACCESS(2)
+    "st1        {v6.2s}, [%2], #8              \n"
+    "b.gt       1b                             \n"
+    : "+r"(src_a),
+      "+r"(src_b),
+      "+r"(dst_sad),
+      "+r"(count)
+    :
+    : "memory", "cc", "v0", "v1", "v2", "v3", "v6");
+}
+
+// Sum of Absolute Differences of a block 16 wide.
+uint32 SadBlock16_NEON(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height) {
+  uint32 sad;
+  asm volatile (
+    "movi       v16.8h, #0                     \n"
+    "movi       v17.8h, #0                     \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v0.16b}, [%0], %4             \n"
+    MEMACCESS(1)
+    "ld1        {v1.16b}, [%1], %5             \n"
+    "subs       %w2, %w2, #1                   \n"
+    "uabal      v16.8h, v0.8b, v1.8b           \n"
+    "uabal2     v17.8h, v0.16b, v1.16b         \n"
+    "b.gt       1b                             \n"
+    "add        v16.8h, v16.8h, v17.8h         \n"
+    "uaddlv     s0, v16.8h                     \n"
+    "fmov       %w3, s0                        \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(height),   // %2
+      "=r"(sad)       // %3
+    : "r"((ptrdiff_t)stride_a),  // %4
+      "r"((ptrdiff_t)stride_b)   // %5
+    : "memory", "cc", "v0", "v1", "v16", "v17");
+  return sad;
+}
+
+// Sum of Absolute Differences of a block 8 wide.
+uint32 SadBlock8_NEON(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, int height) {
+  uint32 sad;
+  asm volatile (
+    "movi       v16.8h, #0                     \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v0.8b}, [%0], %4              \n"
+    MEMACCESS(1)
+    "ld1        {v1.8b}, [%1], %5              \n"
+    "subs       %w2, %w2, #1                   \n"
+    "uabal      v16.8h, v0.8b, v1.8b           \n"
+    "b.gt       1b                             \n"
+    "uaddlv     s0, v16.8h                     \n"
+    "fmov       %w3, s0                        \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(height),   // %2
+      "=r"(sad)       // %3
+    : "r"((ptrdiff_t)stride_a),  // %4
+      "r"((ptrdiff_t)stride_b)   // %5
+    : "memory", "cc", "v0", "v1", "v16");
+  return sad;
+}
+
+// Sum of absolute values of the 4x4 Hadamard transforms of the differences
+// of a block 8 wide.  4 rows, as two 4x4 transforms, per loop.
+uint32 SatdBlock8_NEON(const uint8* src_a, int stride_a,
+                       const uint8* src_b, int stride_b, int height) {
+  uint32 satd;
+  asm volatile (
+    "movi       v31.4s, #0                     \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v0.8b}, [%0], %4              \n"
+    MEMACCESS(0)
+    "ld1        {v1.8b}, [%0], %4              \n"
+    MEMACCESS(0)
+    "ld1        {v2.8b}, [%0], %4              \n"
+    MEMACCESS(0)
+    "ld1        {v3.8b}, [%0], %4              \n"
+    MEMACCESS(1)
+    "ld1        {v4.8b}, [%1], %5              \n"
+    MEMACCESS(1)
+    "ld1        {v5.8b}, [%1], %5              \n"
+    MEMACCESS(1)
+    "ld1        {v6.8b}, [%1], %5              \n"
+    MEMACCESS(1)
+    "ld1        {v7.8b}, [%1], %5              \n"
+    "subs       %w2, %w2, #4                   \n"
+    "usubl      v16.8h, v0.8b, v4.8b           \n"
+    "usubl      v17.8h, v1.8b, v5.8b           \n"
+    "usubl      v18.8h, v2.8b, v6.8b           \n"
+    "usubl      v19.8h, v3.8b, v7.8b           \n"
+    // Vertical Hadamard.
+    "add        v0.8h, v16.8h, v17.8h          \n"
+    "sub        v1.8h, v16.8h, v17.8h          \n"
+    "add        v2.8h, v18.8h, v19.8h          \n"
+    "sub        v3.8h, v18.8h, v19.8h          \n"
+    "add        v16.8h, v0.8h, v2.8h           \n"
+    "sub        v18.8h, v0.8h, v2.8h           \n"
+    "add        v17.8h, v1.8h, v3.8h           \n"
+    "sub        v19.8h, v1.8h, v3.8h           \n"
+    // Transpose each 4x4.
+    "trn1       v0.8h, v16.8h, v17.8h          \n"
+    "trn2       v1.8h, v16.8h, v17.8h          \n"
+    "trn1       v2.8h, v18.8h, v19.8h          \n"
+    "trn2       v3.8h, v18.8h, v19.8h          \n"
+    "trn1       v16.4s, v0.4s, v2.4s           \n"
+    "trn2       v18.4s, v0.4s, v2.4s           \n"
+    "trn1       v17.4s, v1.4s, v3.4s           \n"
+    "trn2       v19.4s, v1.4s, v3.4s           \n"
+    // Horizontal Hadamard.
+    "add        v0.8h, v16.8h, v17.8h          \n"
+    "sub        v1.8h, v16.8h, v17.8h          \n"
+    "add        v2.8h, v18.8h, v19.8h          \n"
+    "sub        v3.8h, v18.8h, v19.8h          \n"
+    "add        v16.8h, v0.8h, v2.8h           \n"
+    "sub        v18.8h, v0.8h, v2.8h           \n"
+    "add        v17.8h, v1.8h, v3.8h           \n"
+    "sub        v19.8h, v1.8h, v3.8h           \n"
+    // Sum absolute values.
+    "abs        v16.8h, v16.8h                 \n"
+    "abs        v17.8h, v17.8h                 \n"
+    "abs        v18.8h, v18.8h                 \n"
+    "abs        v19.8h, v19.8h                 \n"
+    "add        v16.8h, v16.8h, v17.8h         \n"
+    "add        v18.8h, v18.8h, v19.8h         \n"
+    "add        v16.8h, v16.8h, v18.8h         \n"
+    "uadalp     v31.4s, v16.8h                 \n"
+    "b.gt       1b                             \n"
+    "addv       s0, v31.4s                     \n"
+    "fmov       %w3, s0                        \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(height),   // %2
+      "=r"(satd)      // %3
+    : "r"((ptrdiff_t)stride_a),  // %4
+      "r"((ptrdiff_t)stride_b)   // %5
+    : "memory", "cc", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7",
+      "v16", "v17", "v18", "v19", "v31");
+  return satd;
+}
+
+int FindFirstDiff_C(const uint8* src_a, const uint8* src_b, int count);
+
+// Returns the offset of the first byte that differs, or count if none do.
+// count is a multiple of 16.
+int FindFirstDiff_NEON(const uint8* src_a, const uint8* src_b, int count) {
+  const uint8* src_start = src_a;
+  uint32 mask;
+  asm volatile (
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v0.16b}, [%0]                 \n"
+    MEMACCESS(1)
+    "ld1        {v1.16b}, [%1]                 \n"
+    "eor        v0.16b, v0.16b, v1.16b         \n"
+    "umaxv      b0, v0.16b                     \n"
+    "fmov       %w3, s0                        \n"
+    "cbnz       %w3, 2f                        \n"
+    "add        %0, %0, #16                    \n"
+    "add        %1, %1, #16                    \n"
+    "subs       %w2, %w2, #16                  \n"
+    "b.gt       1b                             \n"
+  "2:                                          \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(count),    // %2
+      "=&r"(mask)     // %3
+    :
+    : "memory", "cc", "v0", "v1");
+  if (mask) {
+    return (int)(src_a - src_start) + FindFirstDiff_C(src_a, src_b, 16);
+  }
+  return (int)(src_a - src_start);
+}
+
+// Returns the number of leading pixels with 255 in bytes 0 and 3, in
+// multiples of 16.  width is a multiple of 16.
+int ARGBDetectRow_NEON(const uint8* src_argb, int width) {
+  const uint8* src_start = src_argb;
+  uint32 alpha;
+  asm volatile (
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld4        {v0.16b,v1.16b,v2.16b,v3.16b}, [%0] \n"
+    "and        v0.16b, v0.16b, v3.16b         \n"
+    "uminv      b0, v0.16b                     \n"
+    "fmov       %w2, s0                        \n"
+    "cmp        %w2, #255                      \n"
+    "b.ne       2f                             \n"
+    "add        %0, %0, #64                    \n"
+    "subs       %w1, %w1, #16                  \n"
+    "b.gt       1b                             \n"
+  "2:                                          \n"
+    : "+r"(src_argb),   // %0
+      "+r"(width),      // %1
+      "=&r"(alpha)      // %2
+    :
+    : "memory", "cc", "v0", "v1", "v2", "v3");
+  return (int)(src_argb - src_start) >> 2;
+}
+
+// Updates the minimum and maximum of each byte of the pixels.
+// width is a multiple of 16.
+void ARGBMinMaxRow_NEON(const uint8* src_argb, uint8* dst_minmax, int width) {
+  asm volatile (
+    MEMACCESS(1)
+    "ld4r       {v16.16b,v17.16b,v18.16b,v19.16b}, [%1], #4 \n"
+    MEMACCESS(1)
+    "ld4r       {v20.16b,v21.16b,v22.16b,v23.16b}, [%1] \n"
+    "sub        %1, %1, #4                     \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld4        {v0.16b,v1.16b,v2.16b,v3.16b}, [%0], #64 \n"
+    "subs       %w2, %w2, #16                  \n"
+    "umin       v16.16b, v16.16b, v0.16b       \n"
+    "umin       v17.16b, v17.16b, v1.16b       \n"
+    "umin       v18.16b, v18.16b, v2.16b       \n"
+    "umin       v19.16b, v19.16b, v3.16b       \n"
+    "umax       v20.16b, v20.16b, v0.16b       \n"
+    "umax       v21.16b, v21.16b, v1.16b       \n"
+    "umax       v22.16b, v22.16b, v2.16b       \n"
+    "umax       v23.16b, v23.16b, v3.16b       \n"
+    "b.gt       1b                             \n"
+    "uminv      b16, v16.16b                   \n"
+    "uminv      b17, v17.16b                   \n"
+    "uminv      b18, v18.16b                   \n"
+    "uminv      b19, v19.16b                   \n"
+    "umaxv      b20, v20.16b                   \n"
+    "umaxv      b21, v21.16b                   \n"
+    "umaxv      b22, v22.16b                   \n"
+    "umaxv      b23, v23.16b                   \n"
+    MEMACCESS(1)
+    "st4        {v16.b,v17.b,v18.b,v19.b}[0], [%1], #4 \n"
+    MEMACCESS(1)
+    "st4        {v20.b,v21.b,v22.b,v23.b}[0], [%1] \n"
+    : "+r"(src_argb),   // %0
+      "+r"(dst_minmax), // %1
+      "+r"(width)       // %2
+    :
+    : "memory", "cc", "v0", "v1", "v2", "v3", "v16", "v17", "v18", "v19",
+      "v20", "v21", "v22", "v23");
+}
+
+// Sums of a, b, a * a, b * b and a * b over an 8x8 window, for SSIM.
+void SsimSums8x8_NEON(const uint8* src_a, int stride_a,
+                      const uint8* src_b, int stride_b, uint32* sums) {
+  int rows = 8;
+  asm volatile (
+    "movi       v16.8h, #0                     \n"
+    "movi       v17.8h, #0                     \n"
+    "movi       v18.4s, #0                     \n"
+    "movi       v19.4s, #0                     \n"
+    "movi       v20.4s, #0                     \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v0.8b}, [%0], %4              \n"
+    MEMACCESS(1)
+    "ld1        {v1.8b}, [%1], %5              \n"
+    "subs       %w2, %w2, #1                   \n"
+    "uaddw      v16.8h, v16.8h, v0.8b          \n"
+    "uaddw      v17.8h, v17.8h, v1.8b          \n"
+    "umull      v2.8h, v0.8b, v0.8b            \n"
+    "umull      v3.8h, v1.8b, v1.8b            \n"
+    "umull      v4.8h, v0.8b, v1.8b            \n"
+    "uadalp     v18.4s, v2.8h                  \n"
+    "uadalp     v19.4s, v3.8h                  \n"
+    "uadalp     v20.4s, v4.8h                  \n"
+    "b.gt       1b                             \n"
+    "uaddlv     s16, v16.8h                    \n"
+    "uaddlv     s17, v17.8h                    \n"
+    "addv       s18, v18.4s                    \n"
+    "addv       s19, v19.4s                    \n"
+    "addv       s20, v20.4s                    \n"
+    MEMACCESS(3)
+    "st1        {v16.s}[0], [%3], #4           \n"
+    MEMACCESS(3)
+    "st1        {v17.s}[0], [%3], #4           \n"
+    MEMACCESS(3)
+    "st1        {v18.s}[0], [%3], #4           \n"
+    MEMACCESS(3)
+    "st1        {v19.s}[0], [%3], #4           \n"
+    MEMACCESS(3)
+    "st1        {v20.s}[0], [%3]               \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(rows),     // %2
+      "+r"(sums)      // %3
+    : "r"((ptrdiff_t)stride_a),  // %4
+      "r"((ptrdiff_t)stride_b)   // %5
+    : "memory", "cc", "v0", "v1", "v2", "v3", "v4", "v16", "v17", "v18",
+      "v19", "v20");
+}
+
+// count is a multiple of 8.
+uint64 SumSquareError_16_NEON(const uint16* src_a, const uint16* src_b,
+                              int count) {
+  uint64 sse;
+  asm volatile (
+    "movi       v16.2d, #0                     \n"
+    "movi       v17.2d, #0                     \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v0.8h}, [%0], #16             \n"
+    MEMACCESS(1)
+    "ld1        {v1.8h}, [%1], #16             \n"
+    "subs       %w2, %w2, #8                   \n"
+    "uabd       v0.8h, v0.8h, v1.8h            \n"
+    "umull      v1.4s, v0.4h, v0.4h            \n"
+    "umull2     v2.4s, v0.8h, v0.8h            \n"
+    "uadalp     v16.2d, v1.4s                  \n"
+    "uadalp     v17.2d, v2.4s                  \n"
+    "b.gt       1b                             \n"
+    "add        v16.2d, v16.2d, v17.2d         \n"
+    "addp       d16, v16.2d                    \n"
+    "fmov       %3, d16                        \n"
+    : "+r"(src_a),    // %0
+      "+r"(src_b),    // %1
+      "+r"(count),    // %2
+      "=r"(sse)       // %3
+    :
+    : "memory", "cc", "v0", "v1", "v2", "v16", "v17");
+  return sse;
+}
+
+// count is a multiple of 16 and at most 65536.
+void PlaneStatsRow_NEON(const uint8* src, uint32* dst_stats, int count) {
+  asm volatile (
+    "movi       v16.4s, #0                     \n"
+    "movi       v17.4s, #0                     \n"
+    "movi       v18.16b, #255                  \n"
+    "movi       v19.16b, #0                    \n"
+    ".p2align  2                               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v0.16b}, [%0], #16            \n"
+    "subs       %w1, %w1, #16                  \n"
+    "umin       v18.16b, v18.16b, v0.16b       \n"
+    "umax       v19.16b, v19.16b, v0.16b       \n"
+    "uaddlp     v1.8h, v0.16b                  \n"
+    "umull      v2.8h, v0.8b, v0.8b            \n"
+    "umull2     v3.8h, v0.16b, v0.16b          \n"
+    "uadalp     v16.4s, v1.8h                  \n"  // sum
+    "uadalp     v17.4s, v2.8h                  \n"  // sum of squares
+    "uadalp     v17.4s, v3.8h                  \n"
+    "b.gt       1b                             \n"
+    "addv       s16, v16.4s                    \n"
+    "addv       s17, v17.4s                    \n"
+    "uminv      b18, v18.16b                   \n"
+    "umaxv      b19, v19.16b                   \n"
+    MEMACCESS(2)
+    "st4        {v16.s,v17.s,v18.s,v19.s}[0], [%2] \n"
+    : "+r"(src),      // %0
+      "+r"(count)     // %1
+    : "r"(dst_stats)  // %2
+    : "memory", "cc", "v0", "v1", "v2", "v3", "v16", "v17", "v18", "v19");
+}
+
 #endif  // !defined(LIBYUV_DISABLE_NEON) && defined(__aarch64__)
 
 #ifdef __cplusplus
@@ -14,8 +14,10 @@
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
 #endif
+#include "libyuv/perf_counters.h"
 #include "libyuv/rotate_argb.h"
 #include "libyuv/row.h"
+#include "libyuv/row_dispatch.h"
 #include "libyuv/video_common.h"
 
 #ifdef __cplusplus
@@ -119,12 +121,10 @@ int I422ToARGB(const uint8* src_y, int src_stride_y,
                const uint8* src_v, int src_stride_v,
                uint8* dst_argb, int dst_stride_argb,
                int width, int height) {
+  PERF_COUNTER(kPerfI422ToARGB, width, height);
   int y;
-  void (*I422ToARGBRow)(const uint8* y_buf,
-                        const uint8* u_buf,
-                        const uint8* v_buf,
-                        uint8* rgb_buf,
-                        int width) = I422ToARGBRow_C;
+  I422ToARGBRowFunction I422ToARGBRow;
+  int streaming = 0;
   if (!src_y || !src_u || !src_v ||
       !dst_argb ||
       width <= 0 || height == 0) {
@@ -145,39 +145,28 @@ int I422ToARGB(const uint8* src_y, int src_stride_y,
     height = 1;
     src_stride_y = src_stride_u = src_stride_v = dst_stride_argb = 0;
   }
-#if defined(HAS_I422TOARGBROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    I422ToARGBRow = I422ToARGBRow_Any_SSSE3;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    I422ToARGBRow = I422ToARGBRow_Any_AVX2;
-    if (IS_ALIGNED(width, 16)) {
-      I422ToARGBRow = I422ToARGBRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    I422ToARGBRow = I422ToARGBRow_Any_NEON;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_NEON;
-    }
-  }
-#endif
+  I422ToARGBRow =
+      (I422ToARGBRowFunction)(GetRowFunction(kRowI422ToARGB, width));
 #if defined(HAS_I422TOARGBROW_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) && IS_ALIGNED(width, 4) &&
       IS_ALIGNED(src_y, 4) && IS_ALIGNED(src_stride_y, 4) &&
       IS_ALIGNED(src_u, 2) && IS_ALIGNED(src_stride_u, 2) &&
       IS_ALIGNED(src_v, 2) && IS_ALIGNED(src_stride_v, 2) &&
       IS_ALIGNED(dst_argb, 4) && IS_ALIGNED(dst_stride_argb, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     I422ToARGBRow = I422ToARGBRow_MIPS_DSPR2;
   }
 #endif
+#if defined(HAS_I422TOARGBROW_NT_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2) && IS_ALIGNED(width, 16) &&
+      IS_ALIGNED(dst_argb, 32) && IS_ALIGNED(dst_stride_argb, 32) &&
+      UseStreamingStores((int64)(width) * 4 * height)) {
+    I422ToARGBRow = I422ToARGBRow_NT_AVX2;
+    streaming = 1;
+  }
+#endif
+  PERF_COUNTER_CPU_FLAG(streaming ? kCpuHasAVX2 :
+                        GetRowFunctionCpuFlag(kRowI422ToARGB));
 
   for (y = 0; y < height; ++y) {
     I422ToARGBRow(src_y, src_u, src_v, dst_argb, width);
@@ -186,6 +175,11 @@ int I422ToARGB(const uint8* src_y, int src_stride_y,
     src_u += src_stride_u;
     src_v += src_stride_v;
   }
+#if defined(HAS_STOREFENCE_SSE2)
+  if (streaming) {
+    StoreFence_SSE2();
+  }
+#endif
   return 0;
 }
 
@@ -717,12 +711,62 @@ int ARGB4444ToARGB(const uint8* src_argb4444, int src_stride_argb4444,
   return 0;
 }
 
+// Convert AR30 to ARGB.
+LIBYUV_API
+int AR30ToARGB(const uint8* src_ar30, int src_stride_ar30,
+               uint8* dst_argb, int dst_stride_argb,
+               int width, int height) {
+  int y;
+  void (*AR30ToARGBRow)(const uint8* src_ar30, uint8* dst_argb, int pix) =
+      AR30ToARGBRow_C;
+  if (!src_ar30 || !dst_argb || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_ar30 = src_ar30 + (height - 1) * src_stride_ar30;
+    src_stride_ar30 = -src_stride_ar30;
+  }
+  // Coalesce rows.
+  if (src_stride_ar30 == width * 4 &&
+      dst_stride_argb == width * 4) {
+    width *= height;
+    height = 1;
+    src_stride_ar30 = dst_stride_argb = 0;
+  }
+#if defined(HAS_AR30TOARGBROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    AR30ToARGBRow = AR30ToARGBRow_Any_SSE2;
+    if (IS_ALIGNED(width, 4)) {
+      AR30ToARGBRow = AR30ToARGBRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_AR30TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    AR30ToARGBRow = AR30ToARGBRow_Any_AVX2;
+    if (IS_ALIGNED(width, 8)) {
+      AR30ToARGBRow = AR30ToARGBRow_AVX2;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    AR30ToARGBRow(src_ar30, dst_argb, width);
+    src_ar30 += src_stride_ar30;
+    dst_argb += dst_stride_argb;
+  }
+  return 0;
+}
+
 // Convert NV12 to ARGB.
 LIBYUV_API
 int NV12ToARGB(const uint8* src_y, int src_stride_y,
                const uint8* src_uv, int src_stride_uv,
                uint8* dst_argb, int dst_stride_argb,
                int width, int height) {
+  PERF_COUNTER(kPerfNV12ToARGB, width, height);
   int y;
   void (*NV12ToARGBRow)(const uint8* y_buf,
                         const uint8* uv_buf,
@@ -740,6 +784,7 @@ int NV12ToARGB(const uint8* src_y, int src_stride_y,
   }
 #if defined(HAS_NV12TOARGBROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     NV12ToARGBRow = NV12ToARGBRow_Any_SSSE3;
     if (IS_ALIGNED(width, 8)) {
       NV12ToARGBRow = NV12ToARGBRow_SSSE3;
@@ -748,14 +793,25 @@ int NV12ToARGB(const uint8* src_y, int src_stride_y,
 #endif
 #if defined(HAS_NV12TOARGBROW_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     NV12ToARGBRow = NV12ToARGBRow_Any_AVX2;
     if (IS_ALIGNED(width, 16)) {
       NV12ToARGBRow = NV12ToARGBRow_AVX2;
     }
   }
 #endif
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX512BW);
+    NV12ToARGBRow = NV12ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      NV12ToARGBRow = NV12ToARGBRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_NV12TOARGBROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     NV12ToARGBRow = NV12ToARGBRow_Any_NEON;
     if (IS_ALIGNED(width, 8)) {
       NV12ToARGBRow = NV12ToARGBRow_NEON;
@@ -867,6 +923,14 @@ int M420ToARGB(const uint8* src_m420, int src_stride_m420,
     }
   }
 #endif
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      NV12ToARGBRow = NV12ToARGBRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_NV12TOARGBROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     NV12ToARGBRow = NV12ToARGBRow_Any_NEON;
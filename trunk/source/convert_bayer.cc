@@ -0,0 +1,273 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/convert.h"
+#include "libyuv/convert_argb.h"
+
+#include "libyuv/cpu_id.h"
+#include "libyuv/row.h"
+#include "libyuv/video_common.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Returns the BayerToARGBRow pattern of the first row, or -1 if fourcc is not
+// a Bayer format.  The pattern of odd rows is this pattern ^ 3.
+static int BayerPattern(uint32 fourcc) {
+  switch (CanonicalFourCC(fourcc)) {
+    case FOURCC_BGGR:
+      return 0;
+    case FOURCC_GBRG:
+      return 1;
+    case FOURCC_RGGB:
+      return 2;
+    case FOURCC_GRBG:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+// Returns row y, reflected across the top and bottom edges to keep the Bayer
+// phase.
+static const uint8* BayerRow(const uint8* src_bayer, int src_stride_bayer,
+                             int y, int height) {
+  if (y < 0) {
+    y = -y;
+  }
+  if (y >= height) {
+    y = 2 * height - 2 - y;
+  }
+  if (y < 0) {
+    y = 0;
+  }
+  return src_bayer + y * src_stride_bayer;
+}
+
+// Demosaics row y.  Interior pixels use the row function, and the first and
+// last pixels are reflected across the left and right edges.
+static void BayerRowToARGB(const uint8* src_bayer, int src_stride_bayer,
+                           uint8* dst_argb, int pattern,
+                           int y, int width, int height,
+                           void (*BayerToARGBRow)(const uint8* src_bayer0,
+                               const uint8* src_bayer1,
+                               const uint8* src_bayer2, uint8* dst_argb,
+                               int pattern, int width)) {
+  const uint8* src_rows[3];
+  uint8 edge[3][3];
+  int i;
+  src_rows[0] = BayerRow(src_bayer, src_stride_bayer, y - 1, height);
+  src_rows[1] = BayerRow(src_bayer, src_stride_bayer, y, height);
+  src_rows[2] = BayerRow(src_bayer, src_stride_bayer, y + 1, height);
+  if (y & 1) {
+    pattern ^= 3;
+  }
+  if (width > 2) {
+    BayerToARGBRow(src_rows[0] + 1, src_rows[1] + 1, src_rows[2] + 1,
+                   dst_argb + 4, pattern ^ 1, width - 2);
+  }
+  for (i = 0; i < 3; ++i) {
+    uint8 right = src_rows[i][width > 1 ? 1 : 0];
+    edge[i][0] = right;
+    edge[i][1] = src_rows[i][0];
+    edge[i][2] = right;
+  }
+  BayerToARGBRow_C(edge[0] + 1, edge[1] + 1, edge[2] + 1, dst_argb,
+                   pattern, 1);
+  if (width > 1) {
+    for (i = 0; i < 3; ++i) {
+      uint8 left = src_rows[i][width - 2];
+      edge[i][0] = left;
+      edge[i][1] = src_rows[i][width - 1];
+      edge[i][2] = left;
+    }
+    BayerToARGBRow_C(edge[0] + 1, edge[1] + 1, edge[2] + 1,
+                     dst_argb + (width - 1) * 4,
+                     pattern ^ ((width - 1) & 1), 1);
+  }
+}
+
+// Convert Bayer RGGB, BGGR, GRBG or GBRG to ARGB with bilinear demosaic.
+LIBYUV_API
+int BayerToARGB(const uint8* src_bayer, int src_stride_bayer,
+                uint8* dst_argb, int dst_stride_argb,
+                int width, int height, uint32 fourcc) {
+  int y;
+  int pattern = BayerPattern(fourcc);
+  void (*BayerToARGBRow)(const uint8* src_bayer0, const uint8* src_bayer1,
+      const uint8* src_bayer2, uint8* dst_argb, int pattern, int width) =
+      BayerToARGBRow_C;
+  if (!src_bayer || !dst_argb ||
+      width <= 0 || height == 0 || pattern < 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_bayer = src_bayer + (height - 1) * src_stride_bayer;
+    src_stride_bayer = -src_stride_bayer;
+    if (!(height & 1)) {
+      pattern ^= 3;  // First row is now an odd row.
+    }
+  }
+  // Row functions demosaic the interior width - 2 pixels.
+#if defined(HAS_BAYERTOARGBROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    BayerToARGBRow = BayerToARGBRow_Any_SSE2;
+    if (IS_ALIGNED(width - 2, 16)) {
+      BayerToARGBRow = BayerToARGBRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_BAYERTOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    BayerToARGBRow = BayerToARGBRow_Any_NEON;
+    if (IS_ALIGNED(width - 2, 16)) {
+      BayerToARGBRow = BayerToARGBRow_NEON;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    BayerRowToARGB(src_bayer, src_stride_bayer, dst_argb, pattern,
+                   y, width, height, BayerToARGBRow);
+    dst_argb += dst_stride_argb;
+  }
+  return 0;
+}
+
+// Convert Bayer RGGB, BGGR, GRBG or GBRG to I420.
+// Each pair of rows is demosaiced to ARGB rows that are converted to I420
+// while in cache, without an intermediate ARGB frame.
+LIBYUV_API
+int BayerToI420(const uint8* src_bayer, int src_stride_bayer,
+                uint8* dst_y, int dst_stride_y,
+                uint8* dst_u, int dst_stride_u,
+                uint8* dst_v, int dst_stride_v,
+                int width, int height, uint32 fourcc) {
+  int y;
+  int pattern = BayerPattern(fourcc);
+  void (*BayerToARGBRow)(const uint8* src_bayer0, const uint8* src_bayer1,
+      const uint8* src_bayer2, uint8* dst_argb, int pattern, int width) =
+      BayerToARGBRow_C;
+  void (*ARGBToUVRow)(const uint8* src_argb0, int src_stride_argb,
+      uint8* dst_u, uint8* dst_v, int width) = ARGBToUVRow_C;
+  void (*ARGBToYRow)(const uint8* src_argb, uint8* dst_y, int pix) =
+      ARGBToYRow_C;
+  if (!src_bayer || !dst_y || !dst_u || !dst_v ||
+      width <= 0 || height == 0 || pattern < 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_bayer = src_bayer + (height - 1) * src_stride_bayer;
+    src_stride_bayer = -src_stride_bayer;
+    if (!(height & 1)) {
+      pattern ^= 3;  // First row is now an odd row.
+    }
+  }
+#if defined(HAS_BAYERTOARGBROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    BayerToARGBRow = BayerToARGBRow_Any_SSE2;
+    if (IS_ALIGNED(width - 2, 16)) {
+      BayerToARGBRow = BayerToARGBRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_BAYERTOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    BayerToARGBRow = BayerToARGBRow_Any_NEON;
+    if (IS_ALIGNED(width - 2, 16)) {
+      BayerToARGBRow = BayerToARGBRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_SSSE3) && defined(HAS_ARGBTOUVROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBToUVRow = ARGBToUVRow_Any_SSSE3;
+    ARGBToYRow = ARGBToYRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToUVRow = ARGBToUVRow_SSSE3;
+      ARGBToYRow = ARGBToYRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_AVX2) && defined(HAS_ARGBTOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX2;
+    ARGBToYRow = ARGBToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX2;
+      ARGBToYRow = ARGBToYRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX512BW;
+    ARGBToYRow = ARGBToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 64)) {
+      ARGBToUVRow = ARGBToUVRow_AVX512BW;
+      ARGBToYRow = ARGBToYRow_AVX512BW;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ARGBToYRow = ARGBToYRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      ARGBToYRow = ARGBToYRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ARGBToUVRow = ARGBToUVRow_Any_NEON;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToUVRow = ARGBToUVRow_NEON;
+    }
+  }
+#endif
+
+  {
+    // Allocate 2 rows of ARGB.
+    const int kRowSize = (width * 4 + 31) & ~31;
+    align_buffer_64(row, kRowSize * 2);
+
+    for (y = 0; y < height - 1; y += 2) {
+      BayerRowToARGB(src_bayer, src_stride_bayer, row, pattern,
+                     y, width, height, BayerToARGBRow);
+      BayerRowToARGB(src_bayer, src_stride_bayer, row + kRowSize, pattern,
+                     y + 1, width, height, BayerToARGBRow);
+      ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
+      ARGBToYRow(row, dst_y, width);
+      ARGBToYRow(row + kRowSize, dst_y + dst_stride_y, width);
+      dst_y += dst_stride_y * 2;
+      dst_u += dst_stride_u;
+      dst_v += dst_stride_v;
+    }
+    if (height & 1) {
+      BayerRowToARGB(src_bayer, src_stride_bayer, row, pattern,
+                     y, width, height, BayerToARGBRow);
+      ARGBToUVRow(row, 0, dst_u, dst_v, width);
+      ARGBToYRow(row, dst_y, width);
+    }
+    free_aligned_buffer_64(row);
+  }
+  return 0;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
@@ -14,6 +14,7 @@
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
 #endif
+#include "libyuv/perf_counters.h"
 #include "libyuv/rotate_argb.h"
 #include "libyuv/row.h"
 #include "libyuv/video_common.h"
@@ -36,6 +37,7 @@ int ConvertToARGB(const uint8* sample, size_t sample_size,
                   int crop_width, int crop_height,
                   enum RotationMode rotation,
                   uint32 fourcc) {
+  PERF_COUNTER(kPerfConvertToARGB, src_width, src_height);
   uint32 format = CanonicalFourCC(fourcc);
   int aligned_src_width = (src_width + 1) & ~1;
   const uint8* src;
@@ -143,12 +145,38 @@ int ConvertToARGB(const uint8* sample, size_t sample_size,
                          crop_argb, argb_stride,
                          crop_width, inv_crop_height);
       break;
+    case FOURCC_AR30:
+      src = sample + (src_width * crop_y + crop_x) * 4;
+      r = AR30ToARGB(src, src_width * 4,
+                     crop_argb, argb_stride,
+                     crop_width, inv_crop_height);
+      break;
     case FOURCC_I400:
       src = sample + src_width * crop_y + crop_x;
       r = I400ToARGB(src, src_width,
                      crop_argb, argb_stride,
                      crop_width, inv_crop_height);
       break;
+    // Bayer formats
+    case FOURCC_RGGB:
+    case FOURCC_BGGR:
+    case FOURCC_GRBG:
+    case FOURCC_GBRG: {
+      // Shift the pattern to the crop origin: an odd crop_x swaps the colors
+      // within each row and an odd crop_y swaps the rows.
+      uint32 bayer = format;
+      if (crop_x & 1) {
+        bayer = ((bayer & 0x00ff00ff) << 8) | ((bayer >> 8) & 0x00ff00ff);
+      }
+      if (crop_y & 1) {
+        bayer = (bayer << 16) | (bayer >> 16);
+      }
+      src = sample + src_width * crop_y + crop_x;
+      r = BayerToARGB(src, src_width,
+                      crop_argb, argb_stride,
+                      crop_width, inv_crop_height, bayer);
+      break;
+    }
 
     // Biplanar formats
     case FOURCC_NV12:
@@ -12,6 +12,7 @@
 
 #include "libyuv/convert.h"
 
+#include "libyuv/perf_counters.h"
 #include "libyuv/video_common.h"
 
 #ifdef __cplusplus
@@ -35,6 +36,7 @@ int ConvertToI420(const uint8* sample,
                   int crop_width, int crop_height,
                   enum RotationMode rotation,
                   uint32 fourcc) {
+  PERF_COUNTER(kPerfConvertToI420, src_width, src_height);
   uint32 format = CanonicalFourCC(fourcc);
   int aligned_src_width = (src_width + 1) & ~1;
   const uint8* src;
@@ -180,6 +182,28 @@ int ConvertToI420(const uint8* sample,
                      v, v_stride,
                      crop_width, inv_crop_height);
       break;
+    // Bayer formats
+    case FOURCC_RGGB:
+    case FOURCC_BGGR:
+    case FOURCC_GRBG:
+    case FOURCC_GBRG: {
+      // Shift the pattern to the crop origin: an odd crop_x swaps the colors
+      // within each row and an odd crop_y swaps the rows.
+      uint32 bayer = format;
+      if (crop_x & 1) {
+        bayer = ((bayer & 0x00ff00ff) << 8) | ((bayer >> 8) & 0x00ff00ff);
+      }
+      if (crop_y & 1) {
+        bayer = (bayer << 16) | (bayer >> 16);
+      }
+      src = sample + src_width * crop_y + crop_x;
+      r = BayerToI420(src, src_width,
+                      y, y_stride,
+                      u, u_stride,
+                      v, v_stride,
+                      crop_width, inv_crop_height, bayer);
+      break;
+    }
     // Biplanar formats
     case FOURCC_NV12:
       src = sample + (src_width * crop_y + crop_x);
@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/convert_from.h"
+#include "libyuv/convert_from_argb.h"
+
+#ifdef HAVE_JPEG
+#include "libyuv/mjpeg_encoder.h"
+#endif
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+#ifdef HAVE_JPEG
+// I420 to MJPG (Motion JPeg).
+// For many frames, use MJpegEncoder directly to reuse the encoder state.
+LIBYUV_API
+int I420ToMJPG(const uint8* src_y, int src_stride_y,
+               const uint8* src_u, int src_stride_u,
+               const uint8* src_v, int src_stride_v,
+               int width, int height, int quality,
+               uint8* dst_mjpg, size_t* dst_size) {
+  if (!dst_size) {
+    return -1;
+  }
+  MJpegEncoder mjpeg_encoder;
+  mjpeg_encoder.SetQuality(quality);
+  size_t size = mjpeg_encoder.EncodeI420(src_y, src_stride_y,
+                                         src_u, src_stride_u,
+                                         src_v, src_stride_v,
+                                         width, height,
+                                         dst_mjpg, *dst_size);
+  if (!size) {
+    return -1;
+  }
+  *dst_size = size;
+  return 0;
+}
+
+// I422 to MJPG (Motion JPeg).
+LIBYUV_API
+int I422ToMJPG(const uint8* src_y, int src_stride_y,
+               const uint8* src_u, int src_stride_u,
+               const uint8* src_v, int src_stride_v,
+               int width, int height, int quality,
+               uint8* dst_mjpg, size_t* dst_size) {
+  if (!dst_size) {
+    return -1;
+  }
+  MJpegEncoder mjpeg_encoder;
+  mjpeg_encoder.SetQuality(quality);
+  size_t size = mjpeg_encoder.EncodeI422(src_y, src_stride_y,
+                                         src_u, src_stride_u,
+                                         src_v, src_stride_v,
+                                         width, height,
+                                         dst_mjpg, *dst_size);
+  if (!size) {
+    return -1;
+  }
+  *dst_size = size;
+  return 0;
+}
+
+// NV12 to MJPG (Motion JPeg).
+LIBYUV_API
+int NV12ToMJPG(const uint8* src_y, int src_stride_y,
+               const uint8* src_uv, int src_stride_uv,
+               int width, int height, int quality,
+               uint8* dst_mjpg, size_t* dst_size) {
+  if (!dst_size) {
+    return -1;
+  }
+  MJpegEncoder mjpeg_encoder;
+  mjpeg_encoder.SetQuality(quality);
+  size_t size = mjpeg_encoder.EncodeNV12(src_y, src_stride_y,
+                                         src_uv, src_stride_uv,
+                                         width, height,
+                                         dst_mjpg, *dst_size);
+  if (!size) {
+    return -1;
+  }
+  *dst_size = size;
+  return 0;
+}
+
+// ARGB to MJPG (Motion JPeg).
+LIBYUV_API
+int ARGBToMJPG(const uint8* src_argb, int src_stride_argb,
+               int width, int height, int quality,
+               uint8* dst_mjpg, size_t* dst_size) {
+  if (!dst_size) {
+    return -1;
+  }
+  MJpegEncoder mjpeg_encoder;
+  mjpeg_encoder.SetQuality(quality);
+  size_t size = mjpeg_encoder.EncodeARGB(src_argb, src_stride_argb,
+                                         width, height,
+                                         dst_mjpg, *dst_size);
+  if (!size) {
+    return -1;
+  }
+  *dst_size = size;
+  return 0;
+}
+#endif  // HAVE_JPEG
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
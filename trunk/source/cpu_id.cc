@@ -22,6 +22,11 @@
 #if !defined(__native_client__)
 #include <stdlib.h>  // For getenv()
 #endif
+#if defined(_WIN32)
+#include <windows.h>  // For GetSystemInfo()
+#elif defined(__linux__) || defined(__APPLE__)
+#include <unistd.h>  // For sysconf()
+#endif
 
 // For ArmCpuCaps() but unittested on all platforms
 #include <stdio.h>
@@ -104,7 +109,7 @@ void CpuId(uint32 eax, uint32 ecx, uint32* cpu_info) {
     !defined(__pnacl__) && !defined(__CLR_VER) && !defined(__native_client__)
 #define HAS_XGETBV
 // X86 CPUs have xgetbv to detect OS saves high parts of ymm registers.
-int TestOsSaveYmm() {
+static uint32 GetXCR0() {
   uint32 xcr0 = 0u;
 #if (defined(_MSC_VER) && !defined(__clang__)) && (_MSC_FULL_VER >= 160040219)
   xcr0 = (uint32)(_xgetbv(0));  // VS2010 SP1 required.
@@ -117,10 +122,33 @@ int TestOsSaveYmm() {
 #elif defined(__i386__) || defined(__x86_64__)
   asm(".byte 0x0f, 0x01, 0xd0" : "=a" (xcr0) : "c" (0) : "%edx");
 #endif  // defined(__i386__) || defined(__x86_64__)
-  return((xcr0 & 6) == 6);  // Is ymm saved?
+  return xcr0;
+}
+
+int TestOsSaveYmm() {
+  return((GetXCR0() & 6) == 6);  // Is ymm saved?
+}
+
+// Opmask, upper zmm0-15 and zmm16-31 must be saved as well as ymm.
+static int TestOsSaveZmm() {
+  return((GetXCR0() & 0xe6) == 0xe6);  // Is zmm saved?
 }
 #endif  // defined(_M_IX86) || defined(_M_X64) ..
 
+// Returns true if a line of features has the whole word feature, which
+// starts with a space.
+static int HasFeature(const char* line, const char* feature) {
+  size_t len = strlen(feature);
+  const char* p = strstr(line, feature);
+  while (p) {
+    if (p[len] == ' ' || p[len] == '\n' || p[len] == '\0') {
+      return 1;
+    }
+    p = strstr(p + len, feature);
+  }
+  return 0;
+}
+
 // based on libvpx arm_cpudetect.c
 // For Arm, but public to allow testing on any CPU
 LIBYUV_API SAFEBUFFERS
@@ -134,16 +162,18 @@ int ArmCpuCaps(const char* cpuinfo_name) {
   }
   while (fgets(cpuinfo_line, sizeof(cpuinfo_line) - 1, f)) {
     if (memcmp(cpuinfo_line, "Features", 8) == 0) {
-      char* p = strstr(cpuinfo_line, " neon");
-      if (p && (p[5] == ' ' || p[5] == '\n')) {
-        fclose(f);
-        return kCpuHasNEON;
+      // aarch64 uses asimd for Neon and asimddp for dot product.
+      int flags = 0;
+      if (HasFeature(cpuinfo_line, " neon") ||
+          HasFeature(cpuinfo_line, " asimd")) {
+        flags |= kCpuHasNEON;
+      }
+      if (HasFeature(cpuinfo_line, " asimddp")) {
+        flags |= kCpuHasNEON_DOTPROD;
       }
-      // aarch64 uses asimd for Neon.
-      p = strstr(cpuinfo_line, " asimd");
-      if (p && (p[6] == ' ' || p[6] == '\n')) {
+      if (flags) {
         fclose(f);
-        return kCpuHasNEON;
+        return flags;
       }
     }
   }
@@ -219,8 +249,16 @@ int InitCpuFlags(void) {
   if ((cpu_info1[2] & 0x18000000) == 0x18000000 &&  // AVX and OSSave
       TestOsSaveYmm()) {  // Saves YMM.
     cpu_info_ |= ((cpu_info7[1] & 0x00000020) ? kCpuHasAVX2 : 0) |
+                 ((cpu_info1[2] & 0x20000000) ? kCpuHasF16C : 0) |
                  kCpuHasAVX;
   }
+  // AVX512 extensions require AVX512F and the OS to save opmask and zmm.
+  if ((cpu_info_ & kCpuHasAVX2) && (cpu_info7[1] & 0x00010000) &&
+      TestOsSaveZmm()) {
+    cpu_info_ |= ((cpu_info7[1] & 0x40000000) ? kCpuHasAVX512BW : 0) |
+                 ((cpu_info7[1] & 0x80000000) ? kCpuHasAVX512VL : 0) |
+                 ((cpu_info7[2] & 0x00000800) ? kCpuHasAVX512VNNI : 0);
+  }
 #endif
   // Environment variable overrides for testing.
   if (TestEnv("LIBYUV_DISABLE_X86")) {
@@ -244,12 +282,24 @@ int InitCpuFlags(void) {
   if (TestEnv("LIBYUV_DISABLE_AVX2")) {
     cpu_info_ &= ~kCpuHasAVX2;
   }
+  if (TestEnv("LIBYUV_DISABLE_AVX512BW")) {
+    cpu_info_ &= ~kCpuHasAVX512BW;
+  }
+  if (TestEnv("LIBYUV_DISABLE_AVX512VL")) {
+    cpu_info_ &= ~kCpuHasAVX512VL;
+  }
+  if (TestEnv("LIBYUV_DISABLE_AVX512VNNI")) {
+    cpu_info_ &= ~kCpuHasAVX512VNNI;
+  }
   if (TestEnv("LIBYUV_DISABLE_ERMS")) {
     cpu_info_ &= ~kCpuHasERMS;
   }
   if (TestEnv("LIBYUV_DISABLE_FMA3")) {
     cpu_info_ &= ~kCpuHasFMA3;
   }
+  if (TestEnv("LIBYUV_DISABLE_F16C")) {
+    cpu_info_ &= ~kCpuHasF16C;
+  }
 #endif
 #if defined(__mips__) && defined(__linux__)
   // Linux mips parse text file for dsp detect.
@@ -281,13 +331,19 @@ int InitCpuFlags(void) {
 #endif
 #if defined(__aarch64__)
   cpu_info_ = kCpuHasNEON;
+#if defined(__linux__)
+  cpu_info_ |= ArmCpuCaps("/proc/cpuinfo") & kCpuHasNEON_DOTPROD;
+#endif
 #else
   // Linux arm parse text file for neon detect.
   cpu_info_ = ArmCpuCaps("/proc/cpuinfo");
 #endif
   cpu_info_ |= kCpuHasARM;
   if (TestEnv("LIBYUV_DISABLE_NEON")) {
-    cpu_info_ &= ~kCpuHasNEON;
+    cpu_info_ &= ~(kCpuHasNEON | kCpuHasNEON_DOTPROD);
+  }
+  if (TestEnv("LIBYUV_DISABLE_NEON_DOTPROD")) {
+    cpu_info_ &= ~kCpuHasNEON_DOTPROD;
   }
 #endif  // __arm__
   if (TestEnv("LIBYUV_DISABLE_ASM")) {
@@ -301,6 +357,181 @@ void MaskCpuFlags(int enable_flags) {
   cpu_info_ = InitCpuFlags() & enable_flags;
 }
 
+// Cache and topology of cpus without cpuid are read from /sys on Linux.
+#if (defined(__pnacl__) || defined(__CLR_VER) || !defined(CPU_X86)) && \
+    defined(__linux__) && !defined(__native_client__)
+#define HAS_SYS_CPU_FILES
+// Reads the first line of a /sys file.  Returns 0 if there is none.
+static int ReadSysFile(const char* file_name, char* line, int size) {
+  FILE* f = fopen(file_name, "r");
+  if (!f) {
+    return 0;
+  }
+  if (!fgets(line, size, f)) {
+    line[0] = '\0';
+  }
+  fclose(f);
+  return line[0] != '\0';
+}
+#endif
+
+LIBYUV_API
+int GetCpuCacheInfo(int* l1_data_size, int* l2_size, int* l3_size,
+                    int* line_size) {
+  *l1_data_size = *l2_size = *l3_size = *line_size = 0;
+#if !defined(__pnacl__) && !defined(__CLR_VER) && defined(CPU_X86)
+  {
+    uint32 cpu_info[4];
+    CpuId(0, 0, cpu_info);
+    if (cpu_info[1] == 0x68747541) {  // AuthenticAMD
+      // AMD extended functions for L1 and L2/L3 size in KB.
+      CpuId(0x80000000, 0, cpu_info);
+      if (cpu_info[0] >= 0x80000006) {
+        CpuId(0x80000005, 0, cpu_info);
+        *l1_data_size = (int)(cpu_info[2] >> 24) * 1024;
+        *line_size = (int)(cpu_info[2] & 0xff);
+        CpuId(0x80000006, 0, cpu_info);
+        *l2_size = (int)(cpu_info[2] >> 16) * 1024;
+        *l3_size = (int)(cpu_info[3] >> 18) * 512 * 1024;
+      }
+    } else if (cpu_info[0] >= 4) {
+      // Intel deterministic cache parameters, one cache per sub leaf.
+      uint32 i;
+      for (i = 0; i < 16; ++i) {
+        uint32 type, level, line, size;
+        CpuId(4, i, cpu_info);
+        type = cpu_info[0] & 0x1f;  // 1 data, 2 instruction, 3 unified.
+        if (type == 0) {
+          break;
+        }
+        if (type == 2) {
+          continue;
+        }
+        level = (cpu_info[0] >> 5) & 7;
+        line = (cpu_info[1] & 0xfff) + 1;
+        size = ((cpu_info[1] >> 22) + 1) *  // ways
+               (((cpu_info[1] >> 12) & 0x3ff) + 1) *  // partitions
+               line * (cpu_info[2] + 1);  // sets
+        if (level == 1) {
+          *l1_data_size = (int)(size);
+          *line_size = (int)(line);
+        } else if (level == 2) {
+          *l2_size = (int)(size);
+        } else if (level == 3) {
+          *l3_size = (int)(size);
+        }
+      }
+    }
+  }
+#elif defined(HAS_SYS_CPU_FILES)
+  {
+    int i;
+    for (i = 0; i < 16; ++i) {
+      char file_name[80];
+      char line[64];
+      int level, size;
+      sprintf(file_name, "/sys/devices/system/cpu/cpu0/cache/index%d/level",
+              i);
+      if (!ReadSysFile(file_name, line, sizeof(line))) {
+        break;
+      }
+      level = atoi(line);  // NOLINT
+      sprintf(file_name, "/sys/devices/system/cpu/cpu0/cache/index%d/type", i);
+      if (!ReadSysFile(file_name, line, sizeof(line)) ||
+          !strncmp(line, "Instruction", 11)) {
+        continue;
+      }
+      sprintf(file_name, "/sys/devices/system/cpu/cpu0/cache/index%d/size", i);
+      if (!ReadSysFile(file_name, line, sizeof(line))) {
+        continue;
+      }
+      size = atoi(line);  // NOLINT
+      if (strchr(line, 'K')) {
+        size *= 1024;
+      } else if (strchr(line, 'M')) {
+        size *= 1024 * 1024;
+      }
+      if (level == 1) {
+        *l1_data_size = size;
+        sprintf(file_name,
+                "/sys/devices/system/cpu/cpu0/cache/index%d/"
+                "coherency_line_size", i);
+        if (ReadSysFile(file_name, line, sizeof(line))) {
+          *line_size = atoi(line);  // NOLINT
+        }
+      } else if (level == 2) {
+        *l2_size = size;
+      } else if (level == 3) {
+        *l3_size = size;
+      }
+    }
+  }
+#endif
+  return (*l1_data_size || *l2_size || *l3_size) ? 0 : -1;
+}
+
+LIBYUV_API
+int GetCpuTopology(int* logical_cores, int* physical_cores) {
+  int threads_per_core = 1;
+  *logical_cores = *physical_cores = 0;
+#if defined(_WIN32)
+  {
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    *logical_cores = (int)(system_info.dwNumberOfProcessors);
+  }
+#elif defined(__linux__) || defined(__APPLE__)
+  *logical_cores = (int)(sysconf(_SC_NPROCESSORS_ONLN));
+#endif
+#if !defined(__pnacl__) && !defined(__CLR_VER) && defined(CPU_X86)
+  {
+    // Extended topology leaf level 0 is the threads of a core.
+    uint32 cpu_info[4];
+    CpuId(0, 0, cpu_info);
+    if (cpu_info[0] >= 0xb) {
+      CpuId(0xb, 0, cpu_info);
+      if (((cpu_info[2] >> 8) & 0xff) == 1 && (cpu_info[1] & 0xffff)) {
+        threads_per_core = (int)(cpu_info[1] & 0xffff);
+      }
+    }
+  }
+#elif defined(HAS_SYS_CPU_FILES)
+  {
+    // List of threads that share cpu0, ie "0-1" or "0,64".
+    char line[256];
+    if (ReadSysFile(
+        "/sys/devices/system/cpu/cpu0/topology/thread_siblings_list",
+        line, sizeof(line))) {
+      const char* p = line;
+      int threads = 0;
+      while (*p >= '0' && *p <= '9') {
+        int first = atoi(p);  // NOLINT
+        int last = first;
+        while (*p >= '0' && *p <= '9') ++p;
+        if (*p == '-') {
+          last = atoi(++p);  // NOLINT
+          while (*p >= '0' && *p <= '9') ++p;
+        }
+        threads += last - first + 1;
+        if (*p == ',') ++p;
+      }
+      if (threads > 0) {
+        threads_per_core = threads;
+      }
+    }
+  }
+#endif
+  if (*logical_cores <= 0) {
+    *logical_cores = 0;
+    return -1;
+  }
+  *physical_cores = *logical_cores / threads_per_core;
+  if (*physical_cores < 1) {
+    *physical_cores = 1;
+  }
+  return 0;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
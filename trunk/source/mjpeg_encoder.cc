@@ -0,0 +1,419 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/mjpeg_encoder.h"
+
+#ifdef HAVE_JPEG
+#include <string.h>  // For memset.
+
+#if !defined(__pnacl__) && !defined(__CLR_VER) && \
+    !defined(COVERAGE_ENABLED) && !defined(TARGET_IPHONE_SIMULATOR)
+// Must be included before jpeglib.
+#include <setjmp.h>
+#define HAVE_SETJMP
+
+#if defined(_MSC_VER)
+// disable warning 4324: structure was padded due to __declspec(align())
+#pragma warning(disable:4324)
+#endif
+
+#endif
+struct FILE;  // For jpeglib.h.
+
+// C++ build requires extern C for jpeg internals.
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <jpeglib.h>
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#include "libyuv/convert.h"  // For ARGBToI420().
+#include "libyuv/cpu_id.h"
+#include "libyuv/planar_functions.h"  // For CopyPlane().
+#include "libyuv/row.h"
+
+namespace libyuv {
+
+#ifdef HAVE_SETJMP
+struct SetJmpErrorMgr {
+  jpeg_error_mgr base;  // Must be at the top
+  jmp_buf setjmp_buffer;
+};
+
+// Shared with MJpegDecoder. Rewinds to the setjmp() of the active call.
+void ErrorHandler(jpeg_common_struct* cinfo);
+#endif
+
+// Methods that are passed to jpeglib.
+static void init_destination(jpeg_compress_struct*) {
+  // Nothing to do. Destination is set up by StartEncode().
+}
+
+static boolean empty_output_buffer(jpeg_compress_struct*) {
+  // ERROR: Output buffer too small. Returning FALSE suspends the compressor,
+  // which jpeglib reports as an error when writing markers.
+  return FALSE;
+}
+
+static void term_destination(jpeg_compress_struct*) {
+  // Nothing to do.
+}
+
+static int DivideAndRoundUp(int numerator, int denominator) {
+  return (numerator + denominator - 1) / denominator;
+}
+
+MJpegEncoder::MJpegEncoder()
+    : quality_(kDefaultQuality),
+      databuf_(NULL),
+      databuf_size_(0) {
+  compress_struct_ = new jpeg_compress_struct;
+  dest_mgr_ = new jpeg_destination_mgr;
+#ifdef HAVE_SETJMP
+  error_mgr_ = new SetJmpErrorMgr;
+  compress_struct_->err = jpeg_std_error(&error_mgr_->base);
+  // Override standard exit()-based error handler.
+  error_mgr_->base.error_exit = &ErrorHandler;
+#endif
+  compress_struct_->client_data = NULL;
+  dest_mgr_->init_destination = &init_destination;
+  dest_mgr_->empty_output_buffer = &empty_output_buffer;
+  dest_mgr_->term_destination = &term_destination;
+  jpeg_create_compress(compress_struct_);
+  compress_struct_->dest = dest_mgr_;
+  for (int i = 0; i < 3; ++i) {
+    scanlines_[i] = scanline_rows_[i];
+    databuf_planes_[i] = NULL;
+    databuf_strides_[i] = 0;
+  }
+}
+
+MJpegEncoder::~MJpegEncoder() {
+  jpeg_destroy_compress(compress_struct_);
+  delete compress_struct_;
+  delete dest_mgr_;
+#ifdef HAVE_SETJMP
+  delete error_mgr_;
+#endif
+  delete [] databuf_;
+}
+
+void MJpegEncoder::SetQuality(int quality) {
+  quality_ = quality < 1 ? 1 : (quality > 100 ? 100 : quality);
+}
+
+// Worst case size of a baseline 4:2:2 JPEG, which also bounds 4:2:0. This
+// matches libjpeg-turbo's tjBufSize(): 2 bytes per luma pixel plus 2 bytes
+// per pixel for the two half width chroma planes, and 2048 bytes of headers.
+size_t MJpegEncoder::MaxEncodedSize(int width, int height) {
+  return (size_t)((width + 15) & ~15) * (size_t)((height + 15) & ~15) * 4 +
+      2048;
+}
+
+int MJpegEncoder::GetImageScanlinesPerImcuRow() {
+  return compress_struct_->max_v_samp_factor * DCTSIZE;
+}
+
+int MJpegEncoder::GetComponentScanlinesPerImcuRow(int component) {
+  return compress_struct_->comp_info[component].v_samp_factor * DCTSIZE;
+}
+
+int MJpegEncoder::GetComponentWidth(int component) {
+  return DivideAndRoundUp(compress_struct_->image_width *
+                          compress_struct_->comp_info[component].h_samp_factor,
+                          compress_struct_->max_h_samp_factor);
+}
+
+// Get width in bytes padded out to a multiple of DCTSIZE
+int MJpegEncoder::GetComponentStride(int component) {
+  return (GetComponentWidth(component) + DCTSIZE - 1) & ~(DCTSIZE - 1);
+}
+
+// Sets up a YCbCr image with a 2x1 (4:2:2) or 2x2 (4:2:0) luma sampling
+// factor and starts compression into dst.
+// JDCT_IFAST is used for speed, matching MJpegDecoder.
+LIBYUV_BOOL MJpegEncoder::StartEncode(int width, int height, int subsample_y,
+                                      uint8* dst, size_t dst_size) {
+  dest_mgr_->next_output_byte = dst;
+  dest_mgr_->free_in_buffer = dst_size;
+
+  compress_struct_->image_width = width;
+  compress_struct_->image_height = height;
+  compress_struct_->input_components = 3;
+  compress_struct_->in_color_space = JCS_YCbCr;
+  jpeg_set_defaults(compress_struct_);
+  jpeg_set_quality(compress_struct_, quality_, TRUE);
+  compress_struct_->raw_data_in = TRUE;
+  compress_struct_->dct_method = JDCT_IFAST;  // JDCT_ISLOW is default
+  compress_struct_->comp_info[0].h_samp_factor = 2;
+  compress_struct_->comp_info[0].v_samp_factor = subsample_y;
+  for (int i = 1; i < 3; ++i) {
+    compress_struct_->comp_info[i].h_samp_factor = 1;
+    compress_struct_->comp_info[i].v_samp_factor = 1;
+  }
+  jpeg_start_compress(compress_struct_, TRUE);
+
+  int databuf_size = 0;
+  for (int i = 0; i < 3; ++i) {
+    databuf_size += GetComponentStride(i) * GetComponentScanlinesPerImcuRow(i);
+  }
+  if (databuf_size > databuf_size_) {
+    delete [] databuf_;
+    databuf_ = new uint8[databuf_size];
+    databuf_size_ = databuf_size;
+  }
+  uint8* databuf = databuf_;
+  for (int i = 0; i < 3; ++i) {
+    databuf_planes_[i] = databuf;
+    databuf_strides_[i] = GetComponentStride(i);
+    databuf += GetComponentStride(i) * GetComponentScanlinesPerImcuRow(i);
+  }
+  return LIBYUV_TRUE;
+}
+
+LIBYUV_BOOL MJpegEncoder::FinishEncode() {
+  jpeg_finish_compress(compress_struct_);
+  return LIBYUV_TRUE;
+}
+
+// jpeglib reads whole DCT blocks, so each row must be readable to a multiple
+// of DCTSIZE and the last iMCU row must have a full set of scanlines.
+// Rows below the image reuse the last valid row, and rows narrower than the
+// block width are copied to databuf_ with the last pixel replicated.
+LIBYUV_BOOL MJpegEncoder::WriteImcuRow(const uint8* const* planes,
+                                       const int* strides,
+                                       int rows) {
+  for (int i = 0; i < 3; ++i) {
+    int vs = compress_struct_->max_v_samp_factor /
+        compress_struct_->comp_info[i].v_samp_factor;
+    int component_rows = DivideAndRoundUp(rows, vs);
+    if (component_rows > GetComponentScanlinesPerImcuRow(i)) {
+      component_rows = GetComponentScanlinesPerImcuRow(i);
+    }
+    int component_width = GetComponentWidth(i);
+    int component_stride = GetComponentStride(i);
+    const uint8* src = planes[i];
+    int src_stride = strides[i];
+    if (component_width != component_stride) {
+      if (src != databuf_planes_[i]) {
+        CopyPlane(src, src_stride, databuf_planes_[i], databuf_strides_[i],
+                  component_width, component_rows);
+        src = databuf_planes_[i];
+        src_stride = databuf_strides_[i];
+      }
+      for (int j = 0; j < component_rows; ++j) {
+        uint8* row = databuf_planes_[i] + j * databuf_strides_[i];
+        memset(row + component_width, row[component_width - 1],
+               component_stride - component_width);
+      }
+    }
+    for (int j = 0; j < GetComponentScanlinesPerImcuRow(i); ++j) {
+      int y = j < component_rows ? j : component_rows - 1;
+      scanlines_[i][j] = const_cast<uint8*>(src + y * src_stride);
+    }
+  }
+  return (unsigned int)(GetImageScanlinesPerImcuRow()) ==
+      jpeg_write_raw_data(compress_struct_, scanlines_,
+                          GetImageScanlinesPerImcuRow());
+}
+
+size_t MJpegEncoder::EncodeI420(const uint8* src_y, int src_stride_y,
+                                const uint8* src_u, int src_stride_u,
+                                const uint8* src_v, int src_stride_v,
+                                int width, int height,
+                                uint8* dst, size_t dst_size) {
+  if (!src_y || !src_u || !src_v || !dst ||
+      width <= 0 || height <= 0) {
+    return 0;
+  }
+#ifdef HAVE_SETJMP
+  if (setjmp(error_mgr_->setjmp_buffer)) {
+    // We called into jpeglib, it experienced an error sometime during this
+    // function call, and we called longjmp() and rewound the stack to here.
+    // Return error.
+    jpeg_abort_compress(compress_struct_);
+    return 0;
+  }
+#endif
+  if (!StartEncode(width, height, 2, dst, dst_size)) {
+    return 0;
+  }
+  const int strides[3] = { src_stride_y, src_stride_u, src_stride_v };
+  for (int y = 0; y < height; y += GetImageScanlinesPerImcuRow()) {
+    const uint8* planes[3] = {
+      src_y + y * src_stride_y,
+      src_u + (y >> 1) * src_stride_u,
+      src_v + (y >> 1) * src_stride_v
+    };
+    if (!WriteImcuRow(planes, strides, height - y)) {
+      jpeg_abort_compress(compress_struct_);
+      return 0;
+    }
+  }
+  FinishEncode();
+  return dst_size - dest_mgr_->free_in_buffer;
+}
+
+size_t MJpegEncoder::EncodeI422(const uint8* src_y, int src_stride_y,
+                                const uint8* src_u, int src_stride_u,
+                                const uint8* src_v, int src_stride_v,
+                                int width, int height,
+                                uint8* dst, size_t dst_size) {
+  if (!src_y || !src_u || !src_v || !dst ||
+      width <= 0 || height <= 0) {
+    return 0;
+  }
+#ifdef HAVE_SETJMP
+  if (setjmp(error_mgr_->setjmp_buffer)) {
+    jpeg_abort_compress(compress_struct_);
+    return 0;
+  }
+#endif
+  if (!StartEncode(width, height, 1, dst, dst_size)) {
+    return 0;
+  }
+  const int strides[3] = { src_stride_y, src_stride_u, src_stride_v };
+  for (int y = 0; y < height; y += GetImageScanlinesPerImcuRow()) {
+    const uint8* planes[3] = {
+      src_y + y * src_stride_y,
+      src_u + y * src_stride_u,
+      src_v + y * src_stride_v
+    };
+    if (!WriteImcuRow(planes, strides, height - y)) {
+      jpeg_abort_compress(compress_struct_);
+      return 0;
+    }
+  }
+  FinishEncode();
+  return dst_size - dest_mgr_->free_in_buffer;
+}
+
+typedef void (*SplitUVRowFunction)(const uint8* src_uv, uint8* dst_u,
+                                   uint8* dst_v, int pix);
+
+static SplitUVRowFunction GetSplitUVRow(int halfwidth) {
+  SplitUVRowFunction SplitUVRow = SplitUVRow_C;
+#if defined(HAS_SPLITUVROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    SplitUVRow = SplitUVRow_Any_SSE2;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      SplitUVRow = SplitUVRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_SPLITUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SplitUVRow = SplitUVRow_Any_AVX2;
+    if (IS_ALIGNED(halfwidth, 32)) {
+      SplitUVRow = SplitUVRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SPLITUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SplitUVRow = SplitUVRow_Any_NEON;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      SplitUVRow = SplitUVRow_NEON;
+    }
+  }
+#endif
+  return SplitUVRow;
+}
+
+size_t MJpegEncoder::EncodeNV12(const uint8* src_y, int src_stride_y,
+                                const uint8* src_uv, int src_stride_uv,
+                                int width, int height,
+                                uint8* dst, size_t dst_size) {
+  int halfwidth = (width + 1) >> 1;
+  if (!src_y || !src_uv || !dst ||
+      width <= 0 || height <= 0) {
+    return 0;
+  }
+#ifdef HAVE_SETJMP
+  if (setjmp(error_mgr_->setjmp_buffer)) {
+    jpeg_abort_compress(compress_struct_);
+    return 0;
+  }
+#endif
+  // Resolved after setjmp() so that longjmp() cannot clobber it.
+  const SplitUVRowFunction SplitUVRow = GetSplitUVRow(halfwidth);
+  if (!StartEncode(width, height, 2, dst, dst_size)) {
+    return 0;
+  }
+  const int strides[3] = {
+    src_stride_y, databuf_strides_[1], databuf_strides_[2]
+  };
+  for (int y = 0; y < height; y += GetImageScanlinesPerImcuRow()) {
+    const uint8* planes[3] = {
+      src_y + y * src_stride_y, databuf_planes_[1], databuf_planes_[2]
+    };
+    // Deinterleave the UV rows of this iMCU row into databuf_.
+    const uint8* uv = src_uv + (y >> 1) * src_stride_uv;
+    int uv_rows = DivideAndRoundUp(height - y, 2);
+    if (uv_rows > GetComponentScanlinesPerImcuRow(1)) {
+      uv_rows = GetComponentScanlinesPerImcuRow(1);
+    }
+    for (int j = 0; j < uv_rows; ++j) {
+      SplitUVRow(uv, databuf_planes_[1] + j * databuf_strides_[1],
+                 databuf_planes_[2] + j * databuf_strides_[2], halfwidth);
+      uv += src_stride_uv;
+    }
+    if (!WriteImcuRow(planes, strides, height - y)) {
+      jpeg_abort_compress(compress_struct_);
+      return 0;
+    }
+  }
+  FinishEncode();
+  return dst_size - dest_mgr_->free_in_buffer;
+}
+
+size_t MJpegEncoder::EncodeARGB(const uint8* src_argb, int src_stride_argb,
+                                int width, int height,
+                                uint8* dst, size_t dst_size) {
+  if (!src_argb || !dst ||
+      width <= 0 || height <= 0) {
+    return 0;
+  }
+#ifdef HAVE_SETJMP
+  if (setjmp(error_mgr_->setjmp_buffer)) {
+    jpeg_abort_compress(compress_struct_);
+    return 0;
+  }
+#endif
+  if (!StartEncode(width, height, 2, dst, dst_size)) {
+    return 0;
+  }
+  for (int y = 0; y < height; y += GetImageScanlinesPerImcuRow()) {
+    int rows = height - y;
+    if (rows > GetImageScanlinesPerImcuRow()) {
+      rows = GetImageScanlinesPerImcuRow();
+    }
+    // Convert one iMCU row of ARGB into databuf_ so the frame is never
+    // fully expanded to I420.
+    ARGBToI420(src_argb + y * src_stride_argb, src_stride_argb,
+               databuf_planes_[0], databuf_strides_[0],
+               databuf_planes_[1], databuf_strides_[1],
+               databuf_planes_[2], databuf_strides_[2],
+               width, rows);
+    if (!WriteImcuRow(databuf_planes_, databuf_strides_, height - y)) {
+      jpeg_abort_compress(compress_struct_);
+      return 0;
+    }
+  }
+  FinishEncode();
+  return dst_size - dest_mgr_->free_in_buffer;
+}
+
+}  // namespace libyuv
+#endif  // HAVE_JPEG
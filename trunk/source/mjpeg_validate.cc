@@ -10,52 +10,75 @@
 
 #include "libyuv/mjpeg_decoder.h"
 
-#include <string.h>  // For memchr.
+#include "libyuv/cpu_id.h"
+#include "libyuv/row.h"
 
 #ifdef __cplusplus
 namespace libyuv {
 extern "C" {
 #endif
 
-// Enable this to try scasb implementation.
-// #define ENABLE_SCASB 1
-
-#ifdef ENABLE_SCASB
-
-// Multiple of 1.
-__declspec(naked)
-const uint8* ScanRow_ERMS(const uint8* src, uint32 val, int count) {
-  __asm {
-    mov        edx, edi
-    mov        edi, [esp + 4]   // src
-    mov        eax, [esp + 8]   // val
-    mov        ecx, [esp + 12]  // count
-    repne scasb
-    jne        sr99
-    mov        eax, edi
-    sub        eax, 1
-    mov        edi, edx
-    ret
-
-  sr99:
-    mov        eax, 0
-    mov        edi, edx
-    ret
+// Returns the offset of the first JPEG marker in sample, or sample_size.
+LIBYUV_API
+size_t ScanJpegMarker(const uint8* sample, size_t sample_size) {
+  // Row functions take an int count, so scan in blocks.
+  const size_t kBlockSize = 1 << 20;
+  int (*ScanJpegMarkerRow)(const uint8* src, int count) = ScanJpegMarkerRow_C;
+  int simd_mask = 0;
+  const uint8* src = sample;
+  size_t remaining;
+  if (sample_size < 2) {
+    return sample_size;
+  }
+#if defined(HAS_SCANJPEGMARKERROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ScanJpegMarkerRow = ScanJpegMarkerRow_SSE2;
+    simd_mask = 15;
+  }
+#endif
+#if defined(HAS_SCANJPEGMARKERROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ScanJpegMarkerRow = ScanJpegMarkerRow_AVX2;
+    simd_mask = 31;
+  }
+#endif
+#if defined(HAS_SCANJPEGMARKERROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ScanJpegMarkerRow = ScanJpegMarkerRow_NEON;
+    simd_mask = 15;
   }
-}
 #endif
 
+  // The last byte can not start a marker; it is read as the marker code.
+  remaining = sample_size - 1;
+  while (remaining > 0) {
+    int count = static_cast<int>(remaining < kBlockSize ? remaining :
+                                 kBlockSize);
+    int simd_count = count & ~simd_mask;
+    int pos = 0;
+    if (simd_count > 0) {
+      pos = ScanJpegMarkerRow(src, simd_count);
+    }
+    if (pos == simd_count && simd_count < count) {
+      pos = simd_count + ScanJpegMarkerRow_C(src + simd_count,
+                                             count - simd_count);
+    }
+    if (pos < count) {
+      return static_cast<size_t>(src - sample) + pos;
+    }
+    src += count;
+    remaining -= count;
+  }
+  return sample_size;
+}
+
 // Helper function to scan for EOI marker.
 static LIBYUV_BOOL ScanEOI(const uint8* sample, size_t sample_size) {
-  const uint8* end = sample + sample_size - 1;
+  const uint8* end = sample + sample_size;
   const uint8* it = sample;
-  for (;;) {
-#ifdef ENABLE_SCASB
-    it = ScanRow_ERMS(it, 0xff, end - it);
-#else
-    it = static_cast<const uint8*>(memchr(it, 0xff, end - it));
-#endif
-    if (it == NULL) {
+  while (it < end) {
+    it += ScanJpegMarker(it, end - it);
+    if (it >= end) {
       break;
     }
     if (it[1] == 0xd9) {
@@ -91,11 +114,140 @@ LIBYUV_BOOL ValidateJpeg(const uint8* sample, size_t sample_size) {
     sample_size = sample_size - kBackSearchSize + 1;
   }
   return ScanEOI(sample, sample_size);
-
 }
 
 #ifdef __cplusplus
 }  // extern "C"
+
+MJpegFrameSplitter::MJpegFrameSplitter() {
+  Reset();
+}
+
+void MJpegFrameSplitter::Reset() {
+  state_ = kStateSearchSoi;
+  pending_ff_ = LIBYUV_FALSE;
+  marker_ = 0;
+  length_bytes_ = 0;
+  segment_remaining_ = 0;
+  frame_size_ = 0;
+}
+
+// Handles a marker code. The 0xff and code have been consumed.
+MJpegFrameSplitter::Result MJpegFrameSplitter::OnMarker(uint8 code) {
+  if (code == 0xd8) {  // Start Of Image.
+    state_ = kStateMarker;
+    return kFrameStart;
+  }
+  if (state_ == kStateSearchSoi) {
+    return kNeedMoreData;
+  }
+  if (code == 0xd9) {  // End Of Image.
+    state_ = kStateSearchSoi;
+    return kFrameEnd;
+  }
+  if ((code & 0xf8) == 0xd0) {  // Restart markers precede entropy data.
+    state_ = kStateEntropy;
+    return kNeedMoreData;
+  }
+  if (code == 0x01) {  // TEM has no length.
+    state_ = kStateMarker;
+    return kNeedMoreData;
+  }
+  if (code == 0x00) {  // Not a marker.
+    Reset();
+    return kNeedMoreData;
+  }
+  marker_ = code;
+  length_bytes_ = 0;
+  segment_remaining_ = 0;
+  state_ = kStateLength;
+  return kNeedMoreData;
+}
+
+MJpegFrameSplitter::Result MJpegFrameSplitter::Scan(const uint8* data,
+                                                    size_t size,
+                                                    size_t* consumed) {
+  Result result = kNeedMoreData;
+  size_t pos = 0;
+  while (pos < size && result == kNeedMoreData) {
+    switch (state_) {
+      case kStateSearchSoi:
+      case kStateEntropy: {
+        if (pending_ff_) {
+          uint8 code = data[pos];
+          if (code == 0xff) {  // Fill byte.
+            ++pos;
+            break;
+          }
+          pending_ff_ = LIBYUV_FALSE;
+          if (code != 0x00 && (code & 0xf8) != 0xd0) {
+            ++pos;
+            result = OnMarker(code);
+            break;
+          }
+        }
+        size_t offset = ScanJpegMarker(data + pos, size - pos);
+        if (offset < size - pos) {
+          uint8 code = data[pos + offset + 1];
+          pos += offset + 2;
+          result = OnMarker(code);
+        } else {
+          pos = size;
+          pending_ff_ = data[size - 1] == 0xff;
+        }
+        break;
+      }
+      case kStateMarker: {
+        uint8 code = data[pos++];
+        if (!pending_ff_) {
+          if (code == 0xff) {
+            pending_ff_ = LIBYUV_TRUE;
+          } else {
+            Reset();  // ERROR: Expected a marker.
+          }
+        } else if (code != 0xff) {  // 0xff is a fill byte.
+          pending_ff_ = LIBYUV_FALSE;
+          result = OnMarker(code);
+        }
+        break;
+      }
+      case kStateLength: {
+        segment_remaining_ = (segment_remaining_ << 8) | data[pos++];
+        if (++length_bytes_ == 2) {
+          if (segment_remaining_ < 2) {
+            Reset();  // ERROR: Invalid segment length.
+            break;
+          }
+          segment_remaining_ -= 2;
+          state_ = kStateSegment;
+        }
+        break;
+      }
+      case kStateSegment: {
+        size_t skip = size - pos;
+        if (skip > segment_remaining_) {
+          skip = segment_remaining_;
+        }
+        pos += skip;
+        segment_remaining_ -= skip;
+        break;
+      }
+    }
+    // Start Of Scan is followed by entropy coded data.
+    if (state_ == kStateSegment && segment_remaining_ == 0) {
+      state_ = (marker_ == 0xda) ? kStateEntropy : kStateMarker;
+    }
+  }
+
+  if (result == kFrameStart) {
+    frame_size_ = 2;
+  } else if (result == kFrameEnd || state_ != kStateSearchSoi) {
+    frame_size_ += pos;
+  }
+  *consumed = pos;
+  return result;
+}
+
 }  // namespace libyuv
 #endif
 
@@ -0,0 +1,171 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/perf_counters.h"
+
+#include <string.h>  // For memset()
+
+#if defined(LIBYUV_PERF_COUNTERS)
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>  // For clock_gettime()
+#endif
+#endif
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+static const char* const kPerfCounterNames[kPerfCounterCount] = {
+  "I420ToARGB",
+  "I422ToARGB",
+  "NV12ToARGB",
+  "ARGBToI420",
+  "I420Copy",
+  "CopyPlane",
+  "ConvertToI420",
+  "ConvertToARGB",
+  "ScalePlane",
+  "I420Scale",
+  "ARGBScale",
+  "I420Rotate",
+};
+
+#if defined(LIBYUV_PERF_COUNTERS)
+int perf_counters_enabled_ = 0;
+
+// Updated with atomic adds so threads can count without a lock.
+struct PerfCounterState {
+  volatile int64 calls;
+  volatile int64 pixels;
+  volatile int64 nanoseconds;
+  volatile int cpu_flags;
+};
+
+static struct PerfCounterState perf_counters_[kPerfCounterCount];
+
+// Widest row function flag of the call being counted on this thread.
+#if defined(_MSC_VER)
+static __declspec(thread) int perf_cpu_flags_ = 0;
+#else
+static __thread int perf_cpu_flags_ = 0;
+#endif
+
+static void AtomicAdd64(volatile int64* value, int64 add) {
+#ifdef _WIN32
+  InterlockedExchangeAdd64((volatile LONGLONG*)(value), add);
+#else
+  __sync_fetch_and_add(value, add);
+#endif
+}
+
+static void AtomicSet64(volatile int64* value, int64 set) {
+#ifdef _WIN32
+  InterlockedExchange64((volatile LONGLONG*)(value), set);
+#else
+  __sync_lock_test_and_set(value, set);
+#endif
+}
+
+int64 PerfCounterTime(void) {
+#ifdef _WIN32
+  LARGE_INTEGER t, f;
+  QueryPerformanceCounter(&t);
+  QueryPerformanceFrequency(&f);
+  return (int64)(t.QuadPart * 1e9 / f.QuadPart);
+#else
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (int64)(t.tv_sec) * 1000000000 + t.tv_nsec;
+#endif
+}
+
+// A ladder picks the last, widest, flag that passes, so the largest flag
+// recorded is the one that ran.
+void AddPerfCounterCpuFlag(int cpu_flag) {
+  if (cpu_flag > perf_cpu_flags_) {
+    perf_cpu_flags_ = cpu_flag;
+  }
+}
+
+int BeginPerfCounterCpuFlags(void) {
+  int outer_cpu_flags = perf_cpu_flags_;
+  perf_cpu_flags_ = 0;
+  return outer_cpu_flags;
+}
+
+int EndPerfCounterCpuFlags(int outer_cpu_flags) {
+  int cpu_flags = perf_cpu_flags_;
+  perf_cpu_flags_ = outer_cpu_flags;
+  AddPerfCounterCpuFlag(cpu_flags);
+  return cpu_flags;
+}
+
+void AddPerfCounter(int counter_id, int64 pixels, int64 nanoseconds,
+                    int cpu_flags) {
+  struct PerfCounterState* state = &perf_counters_[counter_id];
+  AtomicAdd64(&state->calls, 1);
+  AtomicAdd64(&state->pixels, pixels);
+  AtomicAdd64(&state->nanoseconds, nanoseconds);
+  state->cpu_flags = cpu_flags;
+}
+#endif  // defined(LIBYUV_PERF_COUNTERS)
+
+LIBYUV_API
+void SetPerfCountersEnabled(int enable) {
+#if defined(LIBYUV_PERF_COUNTERS)
+  perf_counters_enabled_ = enable;
+#else
+  (void)enable;
+#endif
+}
+
+LIBYUV_API
+int GetPerfCounters(struct PerfCounter* counters, int count) {
+  int i;
+  if (!counters || count < 0) {
+    return 0;
+  }
+  if (count > kPerfCounterCount) {
+    count = kPerfCounterCount;
+  }
+  memset(counters, 0, count * sizeof(counters[0]));
+  for (i = 0; i < count; ++i) {
+    counters[i].name = kPerfCounterNames[i];
+#if defined(LIBYUV_PERF_COUNTERS)
+    counters[i].calls = (uint64)(perf_counters_[i].calls);
+    counters[i].pixels = (uint64)(perf_counters_[i].pixels);
+    counters[i].nanoseconds = (uint64)(perf_counters_[i].nanoseconds);
+    counters[i].cpu_flags = perf_counters_[i].cpu_flags;
+#endif
+  }
+  return count;
+}
+
+LIBYUV_API
+void ResetPerfCounters(void) {
+#if defined(LIBYUV_PERF_COUNTERS)
+  int i;
+  for (i = 0; i < kPerfCounterCount; ++i) {
+    struct PerfCounterState* state = &perf_counters_[i];
+    AtomicSet64(&state->calls, 0);
+    AtomicSet64(&state->pixels, 0);
+    AtomicSet64(&state->nanoseconds, 0);
+    state->cpu_flags = 0;
+  }
+#endif
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
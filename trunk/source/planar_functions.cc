@@ -16,7 +16,9 @@
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
 #endif
+#include "libyuv/perf_counters.h"
 #include "libyuv/row.h"
+#include "libyuv/row_dispatch.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -28,8 +30,10 @@ LIBYUV_API
 void CopyPlane(const uint8* src_y, int src_stride_y,
                uint8* dst_y, int dst_stride_y,
                int width, int height) {
+  PERF_COUNTER(kPerfCopyPlane, width, height);
   int y;
-  void (*CopyRow)(const uint8* src, uint8* dst, int width) = CopyRow_C;
+  int streaming = 0;  // kCpuHas flag of the streaming CopyRow.
+  CopyRowFunction CopyRow;
   // Coalesce rows.
   if (src_stride_y == width &&
       dst_stride_y == width) {
@@ -41,31 +45,30 @@ void CopyPlane(const uint8* src_y, int src_stride_y,
   if (src_y == dst_y && src_stride_y == dst_stride_y) {
     return;
   }
-#if defined(HAS_COPYROW_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2)) {
-    CopyRow = IS_ALIGNED(width, 32) ? CopyRow_SSE2 : CopyRow_Any_SSE2;
-  }
-#endif
-#if defined(HAS_COPYROW_AVX)
-  if (TestCpuFlag(kCpuHasAVX)) {
-    CopyRow = IS_ALIGNED(width, 64) ? CopyRow_AVX : CopyRow_Any_AVX;
-  }
+  CopyRow = (CopyRowFunction)(GetRowFunction(kRowCopy, width));
+  if (UseStreamingStores((int64)(width) * height)) {
+#if defined(HAS_COPYROW_NT_SSE2)
+    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(width, 32) &&
+        IS_ALIGNED(dst_y, 16) && IS_ALIGNED(dst_stride_y, 16)) {
+      CopyRow = CopyRow_NT_SSE2;
+      streaming = kCpuHasSSE2;
+    }
 #endif
-#if defined(HAS_COPYROW_ERMS)
-  if (TestCpuFlag(kCpuHasERMS)) {
-    CopyRow = CopyRow_ERMS;
-  }
+#if defined(HAS_COPYROW_NT_AVX)
+    if (TestCpuFlag(kCpuHasAVX) && IS_ALIGNED(width, 64) &&
+        IS_ALIGNED(dst_y, 32) && IS_ALIGNED(dst_stride_y, 32)) {
+      CopyRow = CopyRow_NT_AVX;
+      streaming = kCpuHasAVX;
+    }
 #endif
-#if defined(HAS_COPYROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    CopyRow = IS_ALIGNED(width, 32) ? CopyRow_NEON : CopyRow_Any_NEON;
-  }
+#if defined(HAS_COPYROW_NT_NEON)
+    if (TestCpuFlag(kCpuHasNEON) && IS_ALIGNED(width, 32)) {
+      CopyRow = CopyRow_NT_NEON;
+    }
 #endif
-#if defined(HAS_COPYROW_MIPS)
-  if (TestCpuFlag(kCpuHasMIPS)) {
-    CopyRow = CopyRow_MIPS;
   }
-#endif
+  PERF_COUNTER_CPU_FLAG(streaming ? streaming :
+                        GetRowFunctionCpuFlag(kRowCopy));
 
   // Copy plane
   for (y = 0; y < height; ++y) {
@@ -73,6 +76,11 @@ void CopyPlane(const uint8* src_y, int src_stride_y,
     src_y += src_stride_y;
     dst_y += dst_stride_y;
   }
+#if defined(HAS_STOREFENCE_SSE2)
+  if (streaming) {
+    StoreFence_SSE2();
+  }
+#endif
 }
 
 LIBYUV_API
@@ -326,6 +334,16 @@ int YUY2ToI422(const uint8* src_yuy2, int src_stride_yuy2,
     }
   }
 #endif
+#if defined(HAS_YUY2TOYROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    YUY2ToUV422Row = YUY2ToUV422Row_Any_AVX512BW;
+    YUY2ToYRow = YUY2ToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 64)) {
+      YUY2ToUV422Row = YUY2ToUV422Row_AVX512BW;
+      YUY2ToYRow = YUY2ToYRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_YUY2TOYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     YUY2ToYRow = YUY2ToYRow_Any_NEON;
@@ -398,6 +416,16 @@ int UYVYToI422(const uint8* src_uyvy, int src_stride_uyvy,
     }
   }
 #endif
+#if defined(HAS_UYVYTOYROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    UYVYToUV422Row = UYVYToUV422Row_Any_AVX512BW;
+    UYVYToYRow = UYVYToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 64)) {
+      UYVYToUV422Row = UYVYToUV422Row_AVX512BW;
+      UYVYToYRow = UYVYToYRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_UYVYTOYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     UYVYToYRow = UYVYToYRow_Any_NEON;
@@ -535,6 +563,12 @@ LIBYUV_API
 ARGBBlendRow GetARGBBlend() {
   void (*ARGBBlendRow)(const uint8* src_argb, const uint8* src_argb1,
                        uint8* dst_argb, int width) = ARGBBlendRow_C;
+#if defined(HAS_ARGBBLENDROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBBlendRow = ARGBBlendRow_AVX512BW;
+    return ARGBBlendRow;
+  }
+#endif
 #if defined(HAS_ARGBBLENDROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     ARGBBlendRow = ARGBBlendRow_SSSE3;
@@ -1875,6 +1909,14 @@ int ARGBInterpolate(const uint8* src_argb0, int src_stride_argb0,
     }
   }
 #endif
+#if defined(HAS_INTERPOLATEROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    InterpolateRow = InterpolateRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 16)) {
+      InterpolateRow = InterpolateRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_INTERPOLATEROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     InterpolateRow = InterpolateRow_Any_NEON;
@@ -2341,6 +2383,475 @@ int ARGBCopyYToAlpha(const uint8* src_y, int src_stride_y,
   return 0;
 }
 
+// Pack scale and bias for ARGBToPlanarFloatRow.
+static void PlanarFloatScaleBias(const float* scale, const float* bias,
+                                 float* scale_bias) {
+  int i;
+  for (i = 0; i < 3; ++i) {
+    scale_bias[i] = scale ? scale[i] : 1.f;
+    scale_bias[i + 3] = bias ? bias[i] : 0.f;
+  }
+}
+
+// Convert ARGB to planar float R, G and B.
+LIBYUV_API
+int ARGBToPlanarFloat(const uint8* src_argb, int src_stride_argb,
+                      float* dst_r, int dst_stride_r,
+                      float* dst_g, int dst_stride_g,
+                      float* dst_b, int dst_stride_b,
+                      const float* scale, const float* bias,
+                      int width, int height) {
+  int y;
+  float scale_bias[6];
+  void (*ARGBToPlanarFloatRow)(const uint8* src_argb, float* dst_r,
+                               float* dst_g, float* dst_b,
+                               const float* scale_bias, int width) =
+      ARGBToPlanarFloatRow_C;
+  if (!src_argb || !dst_r || !dst_g || !dst_b || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_argb = src_argb + (height - 1) * src_stride_argb;
+    src_stride_argb = -src_stride_argb;
+  }
+  // Coalesce rows.
+  if (src_stride_argb == width * 4 &&
+      dst_stride_r == width && dst_stride_g == width &&
+      dst_stride_b == width) {
+    width *= height;
+    height = 1;
+    src_stride_argb = dst_stride_r = dst_stride_g = dst_stride_b = 0;
+  }
+  PlanarFloatScaleBias(scale, bias, scale_bias);
+#if defined(HAS_ARGBTOPLANARFLOATROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_Any_SSE2;
+    if (IS_ALIGNED(width, 4)) {
+      ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOPLANARFLOATROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_Any_AVX2;
+    if (IS_ALIGNED(width, 8)) {
+      ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOPLANARFLOATROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_NEON;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    ARGBToPlanarFloatRow(src_argb, dst_r, dst_g, dst_b, scale_bias, width);
+    src_argb += src_stride_argb;
+    dst_r += dst_stride_r;
+    dst_g += dst_stride_g;
+    dst_b += dst_stride_b;
+  }
+  return 0;
+}
+
+// Convert NV12 to planar float R, G and B, by way of a row of ARGB.
+LIBYUV_API
+int NV12ToPlanarRGBFloat(const uint8* src_y, int src_stride_y,
+                         const uint8* src_uv, int src_stride_uv,
+                         float* dst_r, int dst_stride_r,
+                         float* dst_g, int dst_stride_g,
+                         float* dst_b, int dst_stride_b,
+                         const float* scale, const float* bias,
+                         int width, int height) {
+  int y;
+  float scale_bias[6];
+  void (*NV12ToARGBRow)(const uint8* y_buf,
+                        const uint8* uv_buf,
+                        uint8* rgb_buf,
+                        int width) = NV12ToARGBRow_C;
+  void (*ARGBToPlanarFloatRow)(const uint8* src_argb, float* dst_r,
+                               float* dst_g, float* dst_b,
+                               const float* scale_bias, int width) =
+      ARGBToPlanarFloatRow_C;
+  if (!src_y || !src_uv || !dst_r || !dst_g || !dst_b ||
+      width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_r = dst_r + (height - 1) * dst_stride_r;
+    dst_g = dst_g + (height - 1) * dst_stride_g;
+    dst_b = dst_b + (height - 1) * dst_stride_b;
+    dst_stride_r = -dst_stride_r;
+    dst_stride_g = -dst_stride_g;
+    dst_stride_b = -dst_stride_b;
+  }
+  PlanarFloatScaleBias(scale, bias, scale_bias);
+#if defined(HAS_NV12TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 8)) {
+      NV12ToARGBRow = NV12ToARGBRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      NV12ToARGBRow = NV12ToARGBRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      NV12ToARGBRow = NV12ToARGBRow_AVX512BW;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      NV12ToARGBRow = NV12ToARGBRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOPLANARFLOATROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_Any_SSE2;
+    if (IS_ALIGNED(width, 4)) {
+      ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOPLANARFLOATROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_Any_AVX2;
+    if (IS_ALIGNED(width, 8)) {
+      ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOPLANARFLOATROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      ARGBToPlanarFloatRow = ARGBToPlanarFloatRow_NEON;
+    }
+  }
+#endif
+  {
+    // Allocate a row of ARGB.  It stays in L1 between the two passes.
+    align_buffer_64(row, width * 4);
+
+    for (y = 0; y < height; ++y) {
+      NV12ToARGBRow(src_y, src_uv, row, width);
+      ARGBToPlanarFloatRow(row, dst_r, dst_g, dst_b, scale_bias, width);
+      src_y += src_stride_y;
+      if (y & 1) {
+        src_uv += src_stride_uv;
+      }
+      dst_r += dst_stride_r;
+      dst_g += dst_stride_g;
+      dst_b += dst_stride_b;
+    }
+    free_aligned_buffer_64(row);
+  }
+  return 0;
+}
+
+// Convert a plane of float to half float.
+LIBYUV_API
+int HalfFloatPlane(const float* src, int src_stride,
+                   uint16* dst, int dst_stride,
+                   float scale, float bias,
+                   int width, int height) {
+  int y;
+  void (*HalfFloatRow)(const float* src, uint16* dst, float scale, float bias,
+                       int width) = HalfFloatRow_C;
+  if (!src || !dst || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src = src + (height - 1) * src_stride;
+    src_stride = -src_stride;
+  }
+  // Coalesce rows.
+  if (src_stride == width &&
+      dst_stride == width) {
+    width *= height;
+    height = 1;
+    src_stride = dst_stride = 0;
+  }
+#if defined(HAS_HALFFLOATROW_F16C)
+  if (TestCpuFlag(kCpuHasAVX) && TestCpuFlag(kCpuHasF16C)) {
+    HalfFloatRow = HalfFloatRow_Any_F16C;
+    if (IS_ALIGNED(width, 8)) {
+      HalfFloatRow = HalfFloatRow_F16C;
+    }
+  }
+#endif
+#if defined(HAS_HALFFLOATROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    HalfFloatRow = HalfFloatRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      HalfFloatRow = HalfFloatRow_NEON;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    HalfFloatRow(src, dst, scale, bias, width);
+    src += src_stride;
+    dst += dst_stride;
+  }
+  return 0;
+}
+
+// Split packed RGB into R, G and B planes.
+LIBYUV_API
+int SplitRGBPlane(const uint8* src_rgb, int src_stride_rgb,
+                  uint8* dst_r, int dst_stride_r,
+                  uint8* dst_g, int dst_stride_g,
+                  uint8* dst_b, int dst_stride_b,
+                  int width, int height) {
+  int y;
+  void (*SplitRGBRow)(const uint8* src_rgb, uint8* dst_r, uint8* dst_g,
+                      uint8* dst_b, int width) = SplitRGBRow_C;
+  if (!src_rgb || !dst_r || !dst_g || !dst_b || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_rgb = src_rgb + (height - 1) * src_stride_rgb;
+    src_stride_rgb = -src_stride_rgb;
+  }
+  // Coalesce rows.
+  if (src_stride_rgb == width * 3 &&
+      dst_stride_r == width && dst_stride_g == width &&
+      dst_stride_b == width) {
+    width *= height;
+    height = 1;
+    src_stride_rgb = dst_stride_r = dst_stride_g = dst_stride_b = 0;
+  }
+#if defined(HAS_SPLITRGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    SplitRGBRow = SplitRGBRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      SplitRGBRow = SplitRGBRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_SPLITRGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SplitRGBRow = SplitRGBRow_Any_NEON;
+    if (IS_ALIGNED(width, 16)) {
+      SplitRGBRow = SplitRGBRow_NEON;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    SplitRGBRow(src_rgb, dst_r, dst_g, dst_b, width);
+    src_rgb += src_stride_rgb;
+    dst_r += dst_stride_r;
+    dst_g += dst_stride_g;
+    dst_b += dst_stride_b;
+  }
+  return 0;
+}
+
+// Merge R, G and B planes into packed RGB.
+LIBYUV_API
+int MergeRGBPlane(const uint8* src_r, int src_stride_r,
+                  const uint8* src_g, int src_stride_g,
+                  const uint8* src_b, int src_stride_b,
+                  uint8* dst_rgb, int dst_stride_rgb,
+                  int width, int height) {
+  int y;
+  void (*MergeRGBRow)(const uint8* src_r, const uint8* src_g,
+                      const uint8* src_b, uint8* dst_rgb, int width) =
+      MergeRGBRow_C;
+  if (!src_r || !src_g || !src_b || !dst_rgb || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_rgb = dst_rgb + (height - 1) * dst_stride_rgb;
+    dst_stride_rgb = -dst_stride_rgb;
+  }
+  // Coalesce rows.
+  if (src_stride_r == width && src_stride_g == width &&
+      src_stride_b == width && dst_stride_rgb == width * 3) {
+    width *= height;
+    height = 1;
+    src_stride_r = src_stride_g = src_stride_b = dst_stride_rgb = 0;
+  }
+#if defined(HAS_MERGERGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    MergeRGBRow = MergeRGBRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      MergeRGBRow = MergeRGBRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_MERGERGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    MergeRGBRow = MergeRGBRow_Any_NEON;
+    if (IS_ALIGNED(width, 16)) {
+      MergeRGBRow = MergeRGBRow_NEON;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    MergeRGBRow(src_r, src_g, src_b, dst_rgb, width);
+    src_r += src_stride_r;
+    src_g += src_stride_g;
+    src_b += src_stride_b;
+    dst_rgb += dst_stride_rgb;
+  }
+  return 0;
+}
+
+// Convert ARGB to planar G, B and R.
+LIBYUV_API
+int ARGBToGBRP(const uint8* src_argb, int src_stride_argb,
+               uint8* dst_g, int dst_stride_g,
+               uint8* dst_b, int dst_stride_b,
+               uint8* dst_r, int dst_stride_r,
+               int width, int height) {
+  int y;
+  void (*SplitXRGBRow)(const uint8* src_argb, uint8* dst_r, uint8* dst_g,
+                       uint8* dst_b, int width) = SplitXRGBRow_C;
+  if (!src_argb || !dst_g || !dst_b || !dst_r || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_argb = src_argb + (height - 1) * src_stride_argb;
+    src_stride_argb = -src_stride_argb;
+  }
+  // Coalesce rows.
+  if (src_stride_argb == width * 4 &&
+      dst_stride_g == width && dst_stride_b == width &&
+      dst_stride_r == width) {
+    width *= height;
+    height = 1;
+    src_stride_argb = dst_stride_g = dst_stride_b = dst_stride_r = 0;
+  }
+#if defined(HAS_SPLITXRGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    SplitXRGBRow = SplitXRGBRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      SplitXRGBRow = SplitXRGBRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_SPLITXRGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SplitXRGBRow = SplitXRGBRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      SplitXRGBRow = SplitXRGBRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SPLITXRGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SplitXRGBRow = SplitXRGBRow_Any_NEON;
+    if (IS_ALIGNED(width, 16)) {
+      SplitXRGBRow = SplitXRGBRow_NEON;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    SplitXRGBRow(src_argb, dst_r, dst_g, dst_b, width);
+    src_argb += src_stride_argb;
+    dst_g += dst_stride_g;
+    dst_b += dst_stride_b;
+    dst_r += dst_stride_r;
+  }
+  return 0;
+}
+
+// Convert planar G, B and R to ARGB.
+LIBYUV_API
+int GBRPToARGB(const uint8* src_g, int src_stride_g,
+               const uint8* src_b, int src_stride_b,
+               const uint8* src_r, int src_stride_r,
+               uint8* dst_argb, int dst_stride_argb,
+               int width, int height) {
+  int y;
+  void (*MergeXRGBRow)(const uint8* src_r, const uint8* src_g,
+                       const uint8* src_b, uint8* dst_argb, int width) =
+      MergeXRGBRow_C;
+  if (!src_g || !src_b || !src_r || !dst_argb || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_argb = dst_argb + (height - 1) * dst_stride_argb;
+    dst_stride_argb = -dst_stride_argb;
+  }
+  // Coalesce rows.
+  if (src_stride_g == width && src_stride_b == width &&
+      src_stride_r == width && dst_stride_argb == width * 4) {
+    width *= height;
+    height = 1;
+    src_stride_g = src_stride_b = src_stride_r = dst_stride_argb = 0;
+  }
+#if defined(HAS_MERGEXRGBROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    MergeXRGBRow = MergeXRGBRow_Any_SSE2;
+    if (IS_ALIGNED(width, 16)) {
+      MergeXRGBRow = MergeXRGBRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_MERGEXRGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    MergeXRGBRow = MergeXRGBRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      MergeXRGBRow = MergeXRGBRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_MERGEXRGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    MergeXRGBRow = MergeXRGBRow_Any_NEON;
+    if (IS_ALIGNED(width, 16)) {
+      MergeXRGBRow = MergeXRGBRow_NEON;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    MergeXRGBRow(src_r, src_g, src_b, dst_argb, width);
+    src_g += src_stride_g;
+    src_b += src_stride_b;
+    src_r += src_stride_r;
+    dst_argb += dst_stride_argb;
+  }
+  return 0;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -12,6 +12,7 @@
 
 #include "libyuv/cpu_id.h"
 #include "libyuv/convert.h"
+#include "libyuv/perf_counters.h"
 #include "libyuv/planar_functions.h"
 #include "libyuv/row.h"
 
@@ -806,21 +807,25 @@ void TransposePlane(const uint8* src, int src_stride,
                        int width) = TransposeWx8_C;
 #if defined(HAS_TRANSPOSE_WX8_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     TransposeWx8 = TransposeWx8_NEON;
   }
 #endif
 #if defined(HAS_TRANSPOSE_WX8_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && IS_ALIGNED(width, 8)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     TransposeWx8 = TransposeWx8_SSSE3;
   }
 #endif
 #if defined(HAS_TRANSPOSE_WX8_FAST_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && IS_ALIGNED(width, 16)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     TransposeWx8 = TransposeWx8_FAST_SSSE3;
   }
 #endif
 #if defined(HAS_TRANSPOSE_WX8_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     if (IS_ALIGNED(width, 4) &&
         IS_ALIGNED(src, 4) && IS_ALIGNED(src_stride, 4)) {
       TransposeWx8 = TransposeWx8_FAST_MIPS_DSPR2;
@@ -879,6 +884,7 @@ void RotatePlane180(const uint8* src, int src_stride,
   void (*CopyRow)(const uint8* src, uint8* dst, int width) = CopyRow_C;
 #if defined(HAS_MIRRORROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     MirrorRow = MirrorRow_Any_NEON;
     if (IS_ALIGNED(width, 16)) {
       MirrorRow = MirrorRow_NEON;
@@ -887,6 +893,7 @@ void RotatePlane180(const uint8* src, int src_stride,
 #endif
 #if defined(HAS_MIRRORROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     MirrorRow = MirrorRow_Any_SSE2;
     if (IS_ALIGNED(width, 16)) {
       MirrorRow = MirrorRow_SSE2;
@@ -895,6 +902,7 @@ void RotatePlane180(const uint8* src, int src_stride,
 #endif
 #if defined(HAS_MIRRORROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     MirrorRow = MirrorRow_Any_SSSE3;
     if (IS_ALIGNED(width, 16)) {
       MirrorRow = MirrorRow_SSSE3;
@@ -903,6 +911,7 @@ void RotatePlane180(const uint8* src, int src_stride,
 #endif
 #if defined(HAS_MIRRORROW_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     MirrorRow = MirrorRow_Any_AVX2;
     if (IS_ALIGNED(width, 32)) {
       MirrorRow = MirrorRow_AVX2;
@@ -914,31 +923,37 @@ void RotatePlane180(const uint8* src, int src_stride,
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) &&
       IS_ALIGNED(src, 4) && IS_ALIGNED(src_stride, 4) &&
       IS_ALIGNED(dst, 4) && IS_ALIGNED(dst_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     MirrorRow = MirrorRow_MIPS_DSPR2;
   }
 #endif
 #if defined(HAS_COPYROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     CopyRow = IS_ALIGNED(width, 32) ? CopyRow_SSE2 : CopyRow_Any_SSE2;
   }
 #endif
 #if defined(HAS_COPYROW_AVX)
   if (TestCpuFlag(kCpuHasAVX)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX);
     CopyRow = IS_ALIGNED(width, 64) ? CopyRow_AVX : CopyRow_Any_AVX;
   }
 #endif
 #if defined(HAS_COPYROW_ERMS)
   if (TestCpuFlag(kCpuHasERMS)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasERMS);
     CopyRow = CopyRow_ERMS;
   }
 #endif
 #if defined(HAS_COPYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     CopyRow = IS_ALIGNED(width, 32) ? CopyRow_NEON : CopyRow_Any_NEON;
   }
 #endif
 #if defined(HAS_COPYROW_MIPS)
   if (TestCpuFlag(kCpuHasMIPS)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS);
     CopyRow = CopyRow_MIPS;
   }
 #endif
@@ -1010,17 +1025,20 @@ void TransposeUV(const uint8* src, int src_stride,
                          int width) = TransposeUVWx8_C;
 #if defined(HAS_TRANSPOSE_UVWX8_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     TransposeUVWx8 = TransposeUVWx8_NEON;
   }
 #endif
 #if defined(HAS_TRANSPOSE_UVWX8_SSE2)
   if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(width, 8)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     TransposeUVWx8 = TransposeUVWx8_SSE2;
   }
 #endif
 #if defined(HAS_TRANSPOSE_UVWx8_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) && IS_ALIGNED(width, 2) &&
       IS_ALIGNED(src, 4) && IS_ALIGNED(src_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     TransposeUVWx8 = TransposeUVWx8_MIPS_DSPR2;
   }
 #endif
@@ -1084,17 +1102,20 @@ void RotateUV180(const uint8* src, int src_stride,
       MirrorUVRow_C;
 #if defined(HAS_MIRRORUVROW_NEON)
   if (TestCpuFlag(kCpuHasNEON) && IS_ALIGNED(width, 8)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     MirrorRowUV = MirrorUVRow_NEON;
   }
 #endif
 #if defined(HAS_MIRRORROW_UV_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && IS_ALIGNED(width, 16)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     MirrorRowUV = MirrorUVRow_SSSE3;
   }
 #endif
 #if defined(HAS_MIRRORUVROW_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) &&
       IS_ALIGNED(src, 4) && IS_ALIGNED(src_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     MirrorRowUV = MirrorUVRow_MIPS_DSPR2;
   }
 #endif
@@ -1163,6 +1184,7 @@ int I420Rotate(const uint8* src_y, int src_stride_y,
                uint8* dst_v, int dst_stride_v,
                int width, int height,
                enum RotationMode mode) {
+  PERF_COUNTER(kPerfI420Rotate, width, height);
   int halfwidth = (width + 1) >> 1;
   int halfheight = (height + 1) >> 1;
   if (!src_y || !src_u || !src_v || width <= 0 || height == 0 ||
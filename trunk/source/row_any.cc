@@ -72,6 +72,16 @@ YANY(J422ToARGBRow_Any_AVX2, J422ToARGBRow_AVX2, J422ToARGBRow_C, 1, 4, 15)
 #ifdef HAS_I422TOARGBROW_AVX2
 YANY(I422ToARGBRow_Any_AVX2, I422ToARGBRow_AVX2, I422ToARGBRow_C, 1, 4, 15)
 #endif
+#ifdef HAS_I422TOAR30ROW_SSSE3
+YANY(I422ToAR30Row_Any_SSSE3, I422ToAR30Row_SSSE3, I422ToAR30Row_C, 1, 4, 7)
+#endif
+#ifdef HAS_I422TOAR30ROW_AVX2
+YANY(I422ToAR30Row_Any_AVX2, I422ToAR30Row_AVX2, I422ToAR30Row_C, 1, 4, 15)
+#endif
+#ifdef HAS_I422TOARGBROW_AVX512BW
+YANY(I422ToARGBRow_Any_AVX512BW, I422ToARGBRow_AVX512BW, I422ToARGBRow_C,
+     1, 4, 31)
+#endif
 #ifdef HAS_I422TOBGRAROW_AVX2
 YANY(I422ToBGRARow_Any_AVX2, I422ToBGRARow_AVX2, I422ToBGRARow_C, 1, 4, 15)
 #endif
@@ -122,6 +132,25 @@ YANY(I422ToUYVYRow_Any_NEON, I422ToUYVYRow_NEON, I422ToUYVYRow_C, 1, 2, 15)
 #endif
 #undef YANY
 
+// 10 bit YUV to RGB does multiple of 8 with SIMD and remainder with C.
+#define Y16ANY(NAMEANY, I210TORGB_SIMD, I210TORGB_C, UV_SHIFT, BPP, MASK)      \
+    void NAMEANY(const uint16* y_buf, const uint16* u_buf,                     \
+                 const uint16* v_buf, uint8* rgb_buf, int width) {             \
+      int n = width & ~MASK;                                                   \
+      if (n > 0) {                                                             \
+        I210TORGB_SIMD(y_buf, u_buf, v_buf, rgb_buf, n);                       \
+      }                                                                        \
+      I210TORGB_C(y_buf + n,                                                   \
+                  u_buf + (n >> UV_SHIFT),                                     \
+                  v_buf + (n >> UV_SHIFT),                                     \
+                  rgb_buf + n * BPP, width & MASK);                            \
+    }
+
+#ifdef HAS_I210TOAR30ROW_SSSE3
+Y16ANY(I210ToAR30Row_Any_SSSE3, I210ToAR30Row_SSSE3, I210ToAR30Row_C, 1, 4, 7)
+#endif
+#undef Y16ANY
+
 // Wrappers to handle odd width
 #define NV2NY(NAMEANY, NV12TORGB_SIMD, NV12TORGB_C, UV_SHIFT, BPP, MASK)       \
     void NAMEANY(const uint8* y_buf, const uint8* uv_buf,                      \
@@ -143,6 +172,10 @@ NV2NY(NV21ToARGBRow_Any_SSSE3, NV21ToARGBRow_SSSE3, NV21ToARGBRow_C, 0, 4, 7)
 NV2NY(NV12ToARGBRow_Any_AVX2, NV12ToARGBRow_AVX2, NV12ToARGBRow_C, 0, 4, 15)
 NV2NY(NV21ToARGBRow_Any_AVX2, NV21ToARGBRow_AVX2, NV21ToARGBRow_C, 0, 4, 15)
 #endif
+#ifdef HAS_NV12TOARGBROW_AVX512BW
+NV2NY(NV12ToARGBRow_Any_AVX512BW, NV12ToARGBRow_AVX512BW, NV12ToARGBRow_C,
+      0, 4, 31)
+#endif
 #ifdef HAS_NV12TOARGBROW_NEON
 NV2NY(NV12ToARGBRow_Any_NEON, NV12ToARGBRow_NEON, NV12ToARGBRow_C, 0, 4, 7)
 NV2NY(NV21ToARGBRow_Any_NEON, NV21ToARGBRow_NEON, NV21ToARGBRow_C, 0, 4, 7)
@@ -197,6 +230,19 @@ RGBANY(ARGBToARGB4444Row_Any_AVX2, ARGBToARGB4444Row_AVX2, ARGBToARGB4444Row_C,
        4, 2, 7)
 #endif
 
+#if defined(HAS_ARGBTOAR30ROW_SSSE3)
+RGBANY(ARGBToAR30Row_Any_SSSE3, ARGBToAR30Row_SSSE3, ARGBToAR30Row_C,
+       4, 4, 3)
+#endif
+#if defined(HAS_ARGBTOAR30ROW_AVX2)
+RGBANY(ARGBToAR30Row_Any_AVX2, ARGBToAR30Row_AVX2, ARGBToAR30Row_C, 4, 4, 7)
+#endif
+#if defined(HAS_AR30TOARGBROW_SSE2)
+RGBANY(AR30ToARGBRow_Any_SSE2, AR30ToARGBRow_SSE2, AR30ToARGBRow_C, 4, 4, 3)
+#endif
+#if defined(HAS_AR30TOARGBROW_AVX2)
+RGBANY(AR30ToARGBRow_Any_AVX2, AR30ToARGBRow_AVX2, AR30ToARGBRow_C, 4, 4, 7)
+#endif
 #if defined(HAS_J400TOARGBROW_SSE2)
 RGBANY(J400ToARGBRow_Any_SSE2, J400ToARGBRow_SSE2, J400ToARGBRow_C, 1, 4, 7)
 #endif
@@ -290,6 +336,9 @@ RGBDANY(ARGBToRGB565DitherRow_Any_NEON, ARGBToRGB565DitherRow_NEON,
 #ifdef HAS_ARGBTOYROW_AVX2
 YANY(ARGBToYRow_Any_AVX2, ARGBToYRow_AVX2, ARGBToYRow_C, 4, 1, 31)
 #endif
+#ifdef HAS_ARGBTOYROW_AVX512BW
+YANY(ARGBToYRow_Any_AVX512BW, ARGBToYRow_AVX512BW, ARGBToYRow_C, 4, 1, 63)
+#endif
 #ifdef HAS_ARGBTOYJROW_AVX2
 YANY(ARGBToYJRow_Any_AVX2, ARGBToYJRow_AVX2, ARGBToYJRow_C, 4, 1, 31)
 #endif
@@ -299,6 +348,12 @@ YANY(UYVYToYRow_Any_AVX2, UYVYToYRow_AVX2, UYVYToYRow_C, 2, 1, 31)
 #ifdef HAS_YUY2TOYROW_AVX2
 YANY(YUY2ToYRow_Any_AVX2, YUY2ToYRow_AVX2, YUY2ToYRow_C, 2, 1, 31)
 #endif
+#ifdef HAS_YUY2TOYROW_AVX512BW
+YANY(YUY2ToYRow_Any_AVX512BW, YUY2ToYRow_AVX512BW, YUY2ToYRow_C, 2, 1, 63)
+#endif
+#ifdef HAS_UYVYTOYROW_AVX512BW
+YANY(UYVYToYRow_Any_AVX512BW, UYVYToYRow_AVX512BW, UYVYToYRow_C, 2, 1, 63)
+#endif
 #ifdef HAS_ARGBTOYROW_SSSE3
 YANY(ARGBToYRow_Any_SSSE3, ARGBToYRow_SSSE3, ARGBToYRow_C, 4, 1, 15)
 #endif
@@ -408,6 +463,9 @@ YANY(ARGBAttenuateRow_Any_NEON, ARGBAttenuateRow_NEON, ARGBAttenuateRow_C,
 #ifdef HAS_ARGBTOUVROW_AVX2
 UVANY(ARGBToUVRow_Any_AVX2, ARGBToUVRow_AVX2, ARGBToUVRow_C, 4, 31)
 #endif
+#ifdef HAS_ARGBTOUVROW_AVX512BW
+UVANY(ARGBToUVRow_Any_AVX512BW, ARGBToUVRow_AVX512BW, ARGBToUVRow_C, 4, 63)
+#endif
 #ifdef HAS_ARGBTOUVROW_SSSE3
 UVANY(ARGBToUVRow_Any_SSSE3, ARGBToUVRow_SSSE3, ARGBToUVRow_C, 4, 15)
 UVANY(ARGBToUVJRow_Any_SSSE3, ARGBToUVJRow_SSSE3, ARGBToUVJRow_C, 4, 15)
@@ -419,6 +477,12 @@ UVANY(RGBAToUVRow_Any_SSSE3, RGBAToUVRow_SSSE3, RGBAToUVRow_C, 4, 15)
 UVANY(YUY2ToUVRow_Any_AVX2, YUY2ToUVRow_AVX2, YUY2ToUVRow_C, 2, 31)
 UVANY(UYVYToUVRow_Any_AVX2, UYVYToUVRow_AVX2, UYVYToUVRow_C, 2, 31)
 #endif
+#ifdef HAS_YUY2TOYROW_AVX512BW
+UVANY(YUY2ToUVRow_Any_AVX512BW, YUY2ToUVRow_AVX512BW, YUY2ToUVRow_C, 2, 63)
+#endif
+#ifdef HAS_UYVYTOYROW_AVX512BW
+UVANY(UYVYToUVRow_Any_AVX512BW, UYVYToUVRow_AVX512BW, UYVYToUVRow_C, 2, 63)
+#endif
 #ifdef HAS_YUY2TOUVROW_SSE2
 UVANY(YUY2ToUVRow_Any_SSE2, YUY2ToUVRow_SSE2, YUY2ToUVRow_C, 2, 15)
 UVANY(UYVYToUVRow_Any_SSE2, UYVYToUVRow_SSE2, UYVYToUVRow_C, 2, 15)
@@ -483,6 +547,14 @@ UV422ANY(YUY2ToUV422Row_Any_AVX2, YUY2ToUV422Row_AVX2,
 UV422ANY(UYVYToUV422Row_Any_AVX2, UYVYToUV422Row_AVX2,
          UYVYToUV422Row_C, 2, 1, 31)
 #endif
+#ifdef HAS_YUY2TOYROW_AVX512BW
+UV422ANY(YUY2ToUV422Row_Any_AVX512BW, YUY2ToUV422Row_AVX512BW,
+         YUY2ToUV422Row_C, 2, 1, 63)
+#endif
+#ifdef HAS_UYVYTOYROW_AVX512BW
+UV422ANY(UYVYToUV422Row_Any_AVX512BW, UYVYToUV422Row_AVX512BW,
+         UYVYToUV422Row_C, 2, 1, 63)
+#endif
 #ifdef HAS_ARGBTOUV422ROW_SSSE3
 UV422ANY(ARGBToUV422Row_Any_SSSE3, ARGBToUV422Row_SSSE3,
          ARGBToUV422Row_C, 4, 1, 15)
@@ -558,6 +630,76 @@ MERGEUVROW_ANY(MergeUVRow_Any_NEON, MergeUVRow_NEON, MergeUVRow_C, 15)
 #endif
 #undef MERGEUVROW_ANY
 
+// Split packed RGB to 3 planes.  BPP is 3 for RGB and 4 for ARGB.
+#define SPLITRGBROW_ANY(NAMEANY, ANYTORGB_SIMD, ANYTORGB_C, BPP, MASK)         \
+    void NAMEANY(const uint8* src_rgb, uint8* dst_r, uint8* dst_g,             \
+                 uint8* dst_b, int width) {                                    \
+      int n = width & ~MASK;                                                   \
+      if (n > 0) {                                                             \
+        ANYTORGB_SIMD(src_rgb, dst_r, dst_g, dst_b, n);                        \
+      }                                                                        \
+      ANYTORGB_C(src_rgb + n * BPP,                                            \
+                 dst_r + n,                                                    \
+                 dst_g + n,                                                    \
+                 dst_b + n,                                                    \
+                 width & MASK);                                                \
+    }
+
+#ifdef HAS_SPLITRGBROW_SSSE3
+SPLITRGBROW_ANY(SplitRGBRow_Any_SSSE3, SplitRGBRow_SSSE3, SplitRGBRow_C, 3, 15)
+#endif
+#ifdef HAS_SPLITRGBROW_NEON
+SPLITRGBROW_ANY(SplitRGBRow_Any_NEON, SplitRGBRow_NEON, SplitRGBRow_C, 3, 15)
+#endif
+#ifdef HAS_SPLITXRGBROW_SSSE3
+SPLITRGBROW_ANY(SplitXRGBRow_Any_SSSE3, SplitXRGBRow_SSSE3, SplitXRGBRow_C,
+                4, 15)
+#endif
+#ifdef HAS_SPLITXRGBROW_AVX2
+SPLITRGBROW_ANY(SplitXRGBRow_Any_AVX2, SplitXRGBRow_AVX2, SplitXRGBRow_C,
+                4, 31)
+#endif
+#ifdef HAS_SPLITXRGBROW_NEON
+SPLITRGBROW_ANY(SplitXRGBRow_Any_NEON, SplitXRGBRow_NEON, SplitXRGBRow_C,
+                4, 15)
+#endif
+#undef SPLITRGBROW_ANY
+
+// Merge 3 planes to packed RGB.  BPP is 3 for RGB and 4 for ARGB.
+#define MERGERGBROW_ANY(NAMEANY, RGBTOANY_SIMD, RGBTOANY_C, BPP, MASK)         \
+    void NAMEANY(const uint8* src_r, const uint8* src_g,                       \
+                 const uint8* src_b, uint8* dst_rgb, int width) {              \
+      int n = width & ~MASK;                                                   \
+      if (n > 0) {                                                             \
+        RGBTOANY_SIMD(src_r, src_g, src_b, dst_rgb, n);                        \
+      }                                                                        \
+      RGBTOANY_C(src_r + n,                                                    \
+                 src_g + n,                                                    \
+                 src_b + n,                                                    \
+                 dst_rgb + n * BPP,                                            \
+                 width & MASK);                                                \
+    }
+
+#ifdef HAS_MERGERGBROW_SSSE3
+MERGERGBROW_ANY(MergeRGBRow_Any_SSSE3, MergeRGBRow_SSSE3, MergeRGBRow_C, 3, 15)
+#endif
+#ifdef HAS_MERGERGBROW_NEON
+MERGERGBROW_ANY(MergeRGBRow_Any_NEON, MergeRGBRow_NEON, MergeRGBRow_C, 3, 15)
+#endif
+#ifdef HAS_MERGEXRGBROW_SSE2
+MERGERGBROW_ANY(MergeXRGBRow_Any_SSE2, MergeXRGBRow_SSE2, MergeXRGBRow_C,
+                4, 15)
+#endif
+#ifdef HAS_MERGEXRGBROW_AVX2
+MERGERGBROW_ANY(MergeXRGBRow_Any_AVX2, MergeXRGBRow_AVX2, MergeXRGBRow_C,
+                4, 31)
+#endif
+#ifdef HAS_MERGEXRGBROW_NEON
+MERGERGBROW_ANY(MergeXRGBRow_Any_NEON, MergeXRGBRow_NEON, MergeXRGBRow_C,
+                4, 15)
+#endif
+#undef MERGERGBROW_ANY
+
 #define MATHROW_ANY(NAMEANY, ARGBMATH_SIMD, ARGBMATH_C, SBPP, DBPP, MASK)      \
     void NAMEANY(const uint8* src_argb0, const uint8* src_argb1,               \
                  uint8* dst_argb, int width) {                                 \
@@ -673,6 +815,10 @@ YANY(ARGBShuffleRow_Any_NEON, ARGBShuffleRow_NEON,
 #ifdef HAS_INTERPOLATEROW_AVX2
 NANY(InterpolateRow_Any_AVX2, InterpolateRow_AVX2, InterpolateRow_C, 1, 1, 31)
 #endif
+#ifdef HAS_INTERPOLATEROW_AVX512BW
+NANY(InterpolateRow_Any_AVX512BW, InterpolateRow_AVX512BW, InterpolateRow_C,
+     1, 1, 63)
+#endif
 #ifdef HAS_INTERPOLATEROW_SSSE3
 NANY(InterpolateRow_Any_SSSE3, InterpolateRow_SSSE3, InterpolateRow_C, 1, 1, 15)
 #endif
@@ -763,6 +909,74 @@ SETANY(ARGBSetRow_Any_NEON, ARGBSetRow_NEON, ARGBSetRow_C, uint32, 4, 3)
 #endif
 #undef SETANY
 
+// Bayer demosaic does multiple of 16 with SIMD and remainder with C.
+#define BAYERANY(NAMEANY, BAYERTOARGB_SIMD, BAYERTOARGB_C, MASK)              \
+    void NAMEANY(const uint8* src_bayer0, const uint8* src_bayer1,             \
+                 const uint8* src_bayer2, uint8* dst_argb,                     \
+                 int pattern, int width) {                                     \
+      int n = width & ~MASK;                                                   \
+      if (n > 0) {                                                             \
+        BAYERTOARGB_SIMD(src_bayer0, src_bayer1, src_bayer2, dst_argb,         \
+                         pattern, n);                                          \
+      }                                                                        \
+      BAYERTOARGB_C(src_bayer0 + n, src_bayer1 + n, src_bayer2 + n,            \
+                    dst_argb + n * 4, pattern, width & MASK);                  \
+    }
+
+#ifdef HAS_BAYERTOARGBROW_SSE2
+BAYERANY(BayerToARGBRow_Any_SSE2, BayerToARGBRow_SSE2, BayerToARGBRow_C, 15)
+#endif
+#ifdef HAS_BAYERTOARGBROW_NEON
+BAYERANY(BayerToARGBRow_Any_NEON, BayerToARGBRow_NEON, BayerToARGBRow_C, 15)
+#endif
+#undef BAYERANY
+
+// ARGB to planar float does multiple of MASK + 1 with SIMD and remainder
+// with C.
+#define PFANY(NAMEANY, ARGBTOPF_SIMD, ARGBTOPF_C, MASK)                        \
+    void NAMEANY(const uint8* src_argb, float* dst_r, float* dst_g,            \
+                 float* dst_b, const float* scale_bias, int width) {           \
+      int n = width & ~MASK;                                                   \
+      if (n > 0) {                                                             \
+        ARGBTOPF_SIMD(src_argb, dst_r, dst_g, dst_b, scale_bias, n);           \
+      }                                                                        \
+      ARGBTOPF_C(src_argb + n * 4, dst_r + n, dst_g + n, dst_b + n,            \
+                 scale_bias, width & MASK);                                    \
+    }
+
+#ifdef HAS_ARGBTOPLANARFLOATROW_SSE2
+PFANY(ARGBToPlanarFloatRow_Any_SSE2, ARGBToPlanarFloatRow_SSE2,
+      ARGBToPlanarFloatRow_C, 3)
+#endif
+#ifdef HAS_ARGBTOPLANARFLOATROW_AVX2
+PFANY(ARGBToPlanarFloatRow_Any_AVX2, ARGBToPlanarFloatRow_AVX2,
+      ARGBToPlanarFloatRow_C, 7)
+#endif
+#ifdef HAS_ARGBTOPLANARFLOATROW_NEON
+PFANY(ARGBToPlanarFloatRow_Any_NEON, ARGBToPlanarFloatRow_NEON,
+      ARGBToPlanarFloatRow_C, 7)
+#endif
+#undef PFANY
+
+// Half float does multiple of MASK + 1 with SIMD and remainder with C.
+#define HFANY(NAMEANY, HALFFLOAT_SIMD, HALFFLOAT_C, MASK)                      \
+    void NAMEANY(const float* src, uint16* dst, float scale, float bias,       \
+                 int width) {                                                  \
+      int n = width & ~MASK;                                                   \
+      if (n > 0) {                                                             \
+        HALFFLOAT_SIMD(src, dst, scale, bias, n);                              \
+      }                                                                        \
+      HALFFLOAT_C(src + n, dst + n, scale, bias, width & MASK);                \
+    }
+
+#ifdef HAS_HALFFLOATROW_F16C
+HFANY(HalfFloatRow_Any_F16C, HalfFloatRow_F16C, HalfFloatRow_C, 7)
+#endif
+#ifdef HAS_HALFFLOATROW_NEON
+HFANY(HalfFloatRow_Any_NEON, HalfFloatRow_NEON, HalfFloatRow_C, 7)
+#endif
+#undef HFANY
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -59,6 +59,11 @@ static __inline uint32 Abs(int32 v) {
 }
 #endif  // USE_BRANCHLESS
 
+static __inline uint32 Clamp10(int32 val) {
+  int v = clamp0(val);
+  return (uint32)((v > 1023) ? 1023 : v);
+}
+
 #ifdef LIBYUV_LITTLE_ENDIAN
 #define WRITEWORD(p, v) *(uint32*)(p) = v
 #else
@@ -149,6 +154,21 @@ void ARGB4444ToARGBRow_C(const uint8* src_argb4444, uint8* dst_argb,
   }
 }
 
+// 2 bit alpha is replicated to 8 bits, 10 bit color keeps the upper 8.
+void AR30ToARGBRow_C(const uint8* src_ar30, uint8* dst_argb, int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    uint32 ar30 = src_ar30[0] | (src_ar30[1] << 8) | (src_ar30[2] << 16) |
+        ((uint32)(src_ar30[3]) << 24);
+    dst_argb[0] = (uint8)(ar30 >> 2);
+    dst_argb[1] = (uint8)(ar30 >> 12);
+    dst_argb[2] = (uint8)(ar30 >> 22);
+    dst_argb[3] = (uint8)((ar30 >> 30) * 0x55);
+    dst_argb += 4;
+    src_ar30 += 4;
+  }
+}
+
 void ARGBToRGB24Row_C(const uint8* src_argb, uint8* dst_rgb, int width) {
   int x;
   for (x = 0; x < width; ++x) {
@@ -287,6 +307,82 @@ void ARGBToARGB4444Row_C(const uint8* src_argb, uint8* dst_rgb, int width) {
   }
 }
 
+// 8 bit color is replicated to 10 bits, alpha keeps the upper 2.
+void ARGBToAR30Row_C(const uint8* src_argb, uint8* dst_ar30, int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    uint32 b = (src_argb[0] << 2) | (src_argb[0] >> 6);
+    uint32 g = (src_argb[1] << 2) | (src_argb[1] >> 6);
+    uint32 r = (src_argb[2] << 2) | (src_argb[2] >> 6);
+    uint32 a = src_argb[3] >> 6;
+    WRITEWORD(dst_ar30, b | (g << 10) | (r << 20) | (a << 30));
+    dst_ar30 += 4;
+    src_argb += 4;
+  }
+}
+
+// scale_bias is 3 scales then 3 biases, in R, G, B order.
+// Compilers may fuse the multiply and add, so this can round differently to
+// the SIMD rows.
+void ARGBToPlanarFloatRow_C(const uint8* src_argb,
+                            float* dst_r, float* dst_g, float* dst_b,
+                            const float* scale_bias, int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    dst_r[x] = (float)(src_argb[2]) * scale_bias[0] + scale_bias[3];
+    dst_g[x] = (float)(src_argb[1]) * scale_bias[1] + scale_bias[4];
+    dst_b[x] = (float)(src_argb[0]) * scale_bias[2] + scale_bias[5];
+    src_argb += 4;
+  }
+}
+
+// Round to nearest even, as vcvtps2ph with an immediate of 0 does.
+static uint16 FloatToHalf(float value) {
+  uint32 f;
+  uint32 sign;
+  uint32 h;
+  uint32 rem;
+  memcpy(&f, &value, 4);
+  sign = (f >> 16) & 0x8000;
+  f &= 0x7fffffff;
+  if (f >= 0x7f800000) {  // Inf and NaN.  NaN is made quiet.
+    return (uint16)(sign | 0x7c00 |
+                    (f > 0x7f800000 ? 0x200 | ((f >> 13) & 0x3ff) : 0));
+  }
+  if (f >= 0x477ff000) {  // 65520 and above round to Inf.
+    return (uint16)(sign | 0x7c00);
+  }
+  if (f < 0x38800000) {  // Below 2^-14 is a denormal half.
+    int shift;
+    uint32 m;
+    if (f < 0x33000000) {  // 2^-25 and below round to 0.
+      return (uint16)(sign);
+    }
+    shift = 126 - (int)(f >> 23);
+    m = (f & 0x7fffff) | 0x800000;
+    h = m >> shift;
+    rem = m & ((1u << shift) - 1);
+    if (rem > (1u << (shift - 1)) || (rem == (1u << (shift - 1)) && (h & 1))) {
+      ++h;
+    }
+    return (uint16)(sign | h);
+  }
+  h = (f >> 13) - (112 << 10);
+  rem = f & 0x1fff;
+  if (rem > 0x1000 || (rem == 0x1000 && (h & 1))) {
+    ++h;
+  }
+  return (uint16)(sign | h);
+}
+
+void HalfFloatRow_C(const float* src, uint16* dst, float scale, float bias,
+                    int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    dst[x] = FloatToHalf(src[x] * scale + bias);
+  }
+}
+
 static __inline int RGBToY(uint8 r, uint8 g, uint8 b) {
   return (66 * r + 129 * g +  25 * b + 0x1080) >> 8;
 }
@@ -1024,6 +1120,27 @@ static __inline void YuvPixel(uint8 y, uint8 u, uint8 v,
   *r = Clamp((int32)(-(v * VR)+ y1 + BR) >> 6);
 }
 
+// C reference code that mimics the YUV to 10 bit RGB assembly.
+// y16 is Y scaled to 16 bits, ie y * 0x0101 for 8 bit Y.
+static __inline void YuvPixel10(uint16 y16, uint8 u, uint8 v,
+                                uint32* b, uint32* g, uint32* r) {
+  uint32 y1 = (uint32)(y16 * YG) >> 16;
+  *b = Clamp10((int32)(-(u * UB) + y1 + BB) >> 4);
+  *g = Clamp10((int32)(-(v * VG + u * UG) + y1 + BG) >> 4);
+  *r = Clamp10((int32)(-(v * VR)+ y1 + BR) >> 4);
+}
+
+// C reference code that mimics the 10 bit YUV to 10 bit RGB assembly.  The
+// products of 10 bit UV are floored to the scale of 8 bit UV, so UV keeps
+// its low 2 bits.
+static __inline void Yuv10Pixel10(uint16 y16, uint16 u, uint16 v,
+                                  uint32* b, uint32* g, uint32* r) {
+  uint32 y1 = (uint32)(y16 * YG) >> 16;
+  *b = Clamp10((int32)(((int32)(u * -UB) >> 2) + y1 + BB) >> 4);
+  *g = Clamp10((int32)(((int32)(-(u * UG + v * VG)) >> 2) + y1 + BG) >> 4);
+  *r = Clamp10((int32)(((int32)(v * -VR) >> 2) + y1 + BR) >> 4);
+}
+
 // C reference code that mimics the YUV assembly.
 static __inline void YPixel(uint8 y, uint8* b, uint8* g, uint8* r) {
   uint32 y1 = (uint32)(y * 0x0101 * YG) >> 16;
@@ -1154,6 +1271,69 @@ void I422ToARGBRow_C(const uint8* src_y,
   }
 }
 
+static __inline void StoreAR30(uint8* rgb_buf, uint32 b, uint32 g, uint32 r) {
+  WRITEWORD(rgb_buf, b | (g << 10) | (r << 20) | 0xc0000000);
+}
+
+void I422ToAR30Row_C(const uint8* src_y,
+                     const uint8* src_u,
+                     const uint8* src_v,
+                     uint8* rgb_buf,
+                     int width) {
+  int x;
+  uint32 b, g, r;
+  for (x = 0; x < width - 1; x += 2) {
+    YuvPixel10(src_y[0] * 0x0101, src_u[0], src_v[0], &b, &g, &r);
+    StoreAR30(rgb_buf, b, g, r);
+    YuvPixel10(src_y[1] * 0x0101, src_u[0], src_v[0], &b, &g, &r);
+    StoreAR30(rgb_buf + 4, b, g, r);
+    src_y += 2;
+    src_u += 1;
+    src_v += 1;
+    rgb_buf += 8;  // Advance 2 pixels.
+  }
+  if (width & 1) {
+    YuvPixel10(src_y[0] * 0x0101, src_u[0], src_v[0], &b, &g, &r);
+    StoreAR30(rgb_buf, b, g, r);
+  }
+}
+
+// 10 bit Y is scaled to 16 bits and 10 bit UV clamped to 1023, as the
+// assembly does.
+static __inline uint16 Y10To16(uint16 y) {
+  return (uint16)((y << 6) | (y >> 4));
+}
+
+static __inline uint16 ClampUV10(uint16 uv) {
+  return uv > 1023 ? 1023 : uv;
+}
+
+void I210ToAR30Row_C(const uint16* src_y,
+                     const uint16* src_u,
+                     const uint16* src_v,
+                     uint8* rgb_buf,
+                     int width) {
+  int x;
+  uint32 b, g, r;
+  for (x = 0; x < width - 1; x += 2) {
+    uint16 u = ClampUV10(src_u[0]);
+    uint16 v = ClampUV10(src_v[0]);
+    Yuv10Pixel10(Y10To16(src_y[0]), u, v, &b, &g, &r);
+    StoreAR30(rgb_buf, b, g, r);
+    Yuv10Pixel10(Y10To16(src_y[1]), u, v, &b, &g, &r);
+    StoreAR30(rgb_buf + 4, b, g, r);
+    src_y += 2;
+    src_u += 1;
+    src_v += 1;
+    rgb_buf += 8;  // Advance 2 pixels.
+  }
+  if (width & 1) {
+    Yuv10Pixel10(Y10To16(src_y[0]), ClampUV10(src_u[0]), ClampUV10(src_v[0]),
+                 &b, &g, &r);
+    StoreAR30(rgb_buf, b, g, r);
+  }
+}
+
 void J422ToARGBRow_C(const uint8* src_y,
                      const uint8* src_u,
                      const uint8* src_v,
@@ -1703,6 +1883,53 @@ void MergeUVRow_C(const uint8* src_u, const uint8* src_v, uint8* dst_uv,
   }
 }
 
+void SplitRGBRow_C(const uint8* src_rgb, uint8* dst_r, uint8* dst_g,
+                   uint8* dst_b, int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    dst_r[x] = src_rgb[0];
+    dst_g[x] = src_rgb[1];
+    dst_b[x] = src_rgb[2];
+    src_rgb += 3;
+  }
+}
+
+void MergeRGBRow_C(const uint8* src_r, const uint8* src_g,
+                   const uint8* src_b, uint8* dst_rgb, int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    dst_rgb[0] = src_r[x];
+    dst_rgb[1] = src_g[x];
+    dst_rgb[2] = src_b[x];
+    dst_rgb += 3;
+  }
+}
+
+// Alpha is dropped.
+void SplitXRGBRow_C(const uint8* src_argb, uint8* dst_r, uint8* dst_g,
+                    uint8* dst_b, int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    dst_r[x] = src_argb[2];
+    dst_g[x] = src_argb[1];
+    dst_b[x] = src_argb[0];
+    src_argb += 4;
+  }
+}
+
+// Alpha is set to 255.
+void MergeXRGBRow_C(const uint8* src_r, const uint8* src_g,
+                    const uint8* src_b, uint8* dst_argb, int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    dst_argb[0] = src_b[x];
+    dst_argb[1] = src_g[x];
+    dst_argb[2] = src_r[x];
+    dst_argb[3] = 255u;
+    dst_argb += 4;
+  }
+}
+
 void CopyRow_C(const uint8* src, uint8* dst, int count) {
   memcpy(dst, src, count);
 }
@@ -2570,6 +2797,53 @@ void ARGBCopyYToAlphaRow_C(const uint8* src, uint8* dst, int width) {
   }
 }
 
+// Rounded average, matching pavgb and vrhadd.
+#define BAYER_AVG(a, b) (((a) + (b) + 1) >> 1)
+
+void BayerToARGBRow_C(const uint8* src_bayer0, const uint8* src_bayer1,
+                      const uint8* src_bayer2, uint8* dst_argb,
+                      int pattern, int width) {
+  // Byte offsets of the red/blue color in src_bayer1 and the other color.
+  const int kC = (pattern & 2) ? 2 : 0;
+  const int kO = 2 - kC;
+  int x;
+  for (x = 0; x < width; ++x) {
+    int h = BAYER_AVG(src_bayer1[x - 1], src_bayer1[x + 1]);
+    int v = BAYER_AVG(src_bayer0[x], src_bayer2[x]);
+    if (((x ^ pattern) & 1) == 0) {  // Red or blue pixel.
+      int d = BAYER_AVG(BAYER_AVG(src_bayer0[x - 1], src_bayer0[x + 1]),
+                        BAYER_AVG(src_bayer2[x - 1], src_bayer2[x + 1]));
+      dst_argb[kC] = src_bayer1[x];
+      dst_argb[1] = BAYER_AVG(h, v);
+      dst_argb[kO] = d;
+    } else {  // Green pixel.
+      dst_argb[kC] = h;
+      dst_argb[1] = src_bayer1[x];
+      dst_argb[kO] = v;
+    }
+    dst_argb[3] = 255u;
+    dst_argb += 4;
+  }
+}
+#undef BAYER_AVG
+
+int ScanJpegMarkerRow_C(const uint8* src, int count) {
+  const uint8* it = src;
+  const uint8* end = src + count;
+  while (it < end) {
+    it = (const uint8*)(memchr(it, 0xff, end - it));
+    if (it == NULL) {
+      break;
+    }
+    // Skip stuffing (0xff00), fill (0xffff) and restart (0xffd0-0xffd7).
+    if (it[1] != 0x00 && it[1] != 0xff && (it[1] & 0xf8) != 0xd0) {
+      return (int)(it - src);
+    }
+    ++it;
+  }
+  return count;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -0,0 +1,417 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/row_dispatch.h"
+
+#include <stdio.h>  // For fprintf()
+#include <stdlib.h>  // For getenv()
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "libyuv/cpu_id.h"
+#include "libyuv/row.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+struct RowFunctionEntry {
+  RowFunction any_function;  // Any width.
+  RowFunction function;      // Width is a multiple of width_mask + 1.
+  int width_mask;
+  int cpu_flag;              // kCpuHas flag of both functions, 0 for C.
+  const char* any_name;
+  const char* name;
+};
+
+static const char* const kRowFunctionNames[kRowFunctionCount] = {
+  "I422ToARGBRow",
+  "ARGBToYRow",
+  "ARGBToUVRow",
+  "CopyRow",
+};
+
+struct RowFunctionTable {
+  int cpu_info;  // cpu flags the table was resolved for.
+  int trace;
+  struct RowFunctionEntry entries[kRowFunctionCount];
+};
+
+// A table is resolved into a slot of the pool and never changed once it is
+// published, so a thread sees a whole table even while another resolves
+// the table for new cpu flags.  Only MaskCpuFlags changes the flags, so a
+// few slots cover the masks a program uses.  When the pool is full the
+// table is resolved on the stack of each call, which reads only the cpu
+// flags and the cached LIBYUV_TRACE setting.
+#define kRowTablePoolSize 16
+enum { kRowTableFree = 0, kRowTableWriting, kRowTablePublished };
+static struct RowFunctionTable row_table_pool_[kRowTablePoolSize];
+static volatile int row_table_state_[kRowTablePoolSize];
+// The table of the last call, checked first.
+static struct RowFunctionTable* volatile row_table_ = NULL;
+// Set by SetRowFunction, which is not thread safe.
+static struct RowFunctionEntry row_overrides_[kRowFunctionCount];
+// LIBYUV_TRACE prints each row function chosen that differs from the last
+// one for the same function_id, ie a fall back to C or _Any_ for a width.
+static const char* volatile row_traced_[kRowFunctionCount];
+// LIBYUV_TRACE read once.  -1 until read.
+static volatile int row_trace_ = -1;
+// Bytes of cache a strip may use and size of the last level cache, read
+// once from GetCpuCacheInfo.  row_strip_bytes_ is stored last, so once it
+// is not 0 both are set.
+static volatile int row_strip_bytes_ = 0;
+static volatile int last_level_cache_size_ = 0;
+// Set by SetRowStripBytes and SetStreamingStores.
+static volatile int row_strip_override_ = 0;
+static volatile int streaming_stores_ = kStreamingStoresOff;
+
+#ifdef _WIN32
+static void* AtomicLoadPointer(void* volatile* p) {
+  return InterlockedCompareExchangePointer(p, NULL, NULL);
+}
+
+static void AtomicStorePointer(void* volatile* p, void* value) {
+  InterlockedExchangePointer(p, value);
+}
+
+static int AtomicLoadInt(volatile int* p) {
+  return (int)(InterlockedCompareExchange((volatile LONG*)(p), 0, 0));
+}
+
+static void AtomicStoreInt(volatile int* p, int value) {
+  InterlockedExchange((volatile LONG*)(p), value);
+}
+
+// Returns 1 if *p was old_value and is now value.
+static int AtomicCompareExchangeInt(volatile int* p, int old_value,
+                                    int value) {
+  return InterlockedCompareExchange((volatile LONG*)(p), value, old_value) ==
+      old_value;
+}
+#else
+static void* AtomicLoadPointer(void* volatile* p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void AtomicStorePointer(void* volatile* p, void* value) {
+  __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+static int AtomicLoadInt(volatile int* p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void AtomicStoreInt(volatile int* p, int value) {
+  __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+// Returns 1 if *p was old_value and is now value.
+static int AtomicCompareExchangeInt(volatile int* p, int old_value,
+                                    int value) {
+  return __sync_bool_compare_and_swap(p, old_value, value);
+}
+#endif
+
+static void SetEntry(struct RowFunctionEntry* entry,
+                     RowFunction any_function, const char* any_name,
+                     RowFunction function, const char* name,
+                     int width_mask, int cpu_flag) {
+  entry->any_function = any_function;
+  entry->function = function;
+  entry->width_mask = width_mask;
+  entry->cpu_flag = cpu_flag;
+  entry->any_name = any_name;
+  entry->name = name;
+}
+
+#define SETROW(id, any_function, function, width_mask, cpu_flag)              \
+    SetEntry(&table->entries[id], (RowFunction)(any_function), #any_function, \
+             (RowFunction)(function), #function, width_mask, cpu_flag)
+
+static int GetTrace(void) {
+  int trace = AtomicLoadInt(&row_trace_);
+  if (trace < 0) {
+    trace = 0;
+#if !defined(__native_client__) && !defined(_M_ARM)
+    {
+      const char* env = getenv("LIBYUV_TRACE");
+      trace = env && env[0] != '0';
+    }
+#endif
+    AtomicStoreInt(&row_trace_, trace);
+  }
+  return trace;
+}
+
+// The same choices as the TestCpuFlag ladders of the conversions, made once
+// for cpu_info.  Later checks take priority.
+static void ResolveRowFunctions(int cpu_info,
+                                struct RowFunctionTable* table) {
+  table->cpu_info = cpu_info;
+  table->trace = GetTrace();
+  SETROW(kRowI422ToARGB, I422ToARGBRow_C, I422ToARGBRow_C, 0, 0);
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (cpu_info & kCpuHasSSSE3) {
+    SETROW(kRowI422ToARGB, I422ToARGBRow_Any_SSSE3, I422ToARGBRow_SSSE3,
+           7, kCpuHasSSSE3);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX2)
+  if (cpu_info & kCpuHasAVX2) {
+    SETROW(kRowI422ToARGB, I422ToARGBRow_Any_AVX2, I422ToARGBRow_AVX2,
+           15, kCpuHasAVX2);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (cpu_info & kCpuHasAVX512BW) {
+    SETROW(kRowI422ToARGB, I422ToARGBRow_Any_AVX512BW, I422ToARGBRow_AVX512BW,
+           31, kCpuHasAVX512BW);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_NEON)
+  if (cpu_info & kCpuHasNEON) {
+    SETROW(kRowI422ToARGB, I422ToARGBRow_Any_NEON, I422ToARGBRow_NEON,
+           7, kCpuHasNEON);
+  }
+#endif
+
+  SETROW(kRowARGBToY, ARGBToYRow_C, ARGBToYRow_C, 0, 0);
+  SETROW(kRowARGBToUV, ARGBToUVRow_C, ARGBToUVRow_C, 0, 0);
+#if defined(HAS_ARGBTOYROW_SSSE3) && defined(HAS_ARGBTOUVROW_SSSE3)
+  if (cpu_info & kCpuHasSSSE3) {
+    SETROW(kRowARGBToY, ARGBToYRow_Any_SSSE3, ARGBToYRow_SSSE3,
+           15, kCpuHasSSSE3);
+    SETROW(kRowARGBToUV, ARGBToUVRow_Any_SSSE3, ARGBToUVRow_SSSE3,
+           15, kCpuHasSSSE3);
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_AVX2) && defined(HAS_ARGBTOUVROW_AVX2)
+  if (cpu_info & kCpuHasAVX2) {
+    SETROW(kRowARGBToY, ARGBToYRow_Any_AVX2, ARGBToYRow_AVX2, 31, kCpuHasAVX2);
+    SETROW(kRowARGBToUV, ARGBToUVRow_Any_AVX2, ARGBToUVRow_AVX2,
+           31, kCpuHasAVX2);
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (cpu_info & kCpuHasAVX512BW) {
+    SETROW(kRowARGBToY, ARGBToYRow_Any_AVX512BW, ARGBToYRow_AVX512BW,
+           63, kCpuHasAVX512BW);
+    SETROW(kRowARGBToUV, ARGBToUVRow_Any_AVX512BW, ARGBToUVRow_AVX512BW,
+           63, kCpuHasAVX512BW);
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_NEON)
+  if (cpu_info & kCpuHasNEON) {
+    SETROW(kRowARGBToY, ARGBToYRow_Any_NEON, ARGBToYRow_NEON, 7, kCpuHasNEON);
+  }
+#endif
+#if defined(HAS_ARGBTOUVROW_NEON)
+  if (cpu_info & kCpuHasNEON) {
+    SETROW(kRowARGBToUV, ARGBToUVRow_Any_NEON, ARGBToUVRow_NEON,
+           15, kCpuHasNEON);
+  }
+#endif
+
+  SETROW(kRowCopy, CopyRow_C, CopyRow_C, 0, 0);
+#if defined(HAS_COPYROW_SSE2)
+  if (cpu_info & kCpuHasSSE2) {
+    SETROW(kRowCopy, CopyRow_Any_SSE2, CopyRow_SSE2, 31, kCpuHasSSE2);
+  }
+#endif
+#if defined(HAS_COPYROW_AVX)
+  if (cpu_info & kCpuHasAVX) {
+    SETROW(kRowCopy, CopyRow_Any_AVX, CopyRow_AVX, 63, kCpuHasAVX);
+  }
+#endif
+#if defined(HAS_COPYROW_ERMS)
+  if (cpu_info & kCpuHasERMS) {
+    SETROW(kRowCopy, CopyRow_ERMS, CopyRow_ERMS, 0, kCpuHasERMS);
+  }
+#endif
+#if defined(HAS_COPYROW_NEON)
+  if (cpu_info & kCpuHasNEON) {
+    SETROW(kRowCopy, CopyRow_Any_NEON, CopyRow_NEON, 31, kCpuHasNEON);
+  }
+#endif
+#if defined(HAS_COPYROW_MIPS)
+  if (cpu_info & kCpuHasMIPS) {
+    SETROW(kRowCopy, CopyRow_MIPS, CopyRow_MIPS, 0, kCpuHasMIPS);
+  }
+#endif
+}
+
+// Returns the published table for the current cpu flags, resolving and
+// publishing it if there is none.  Returns local, resolved, when the pool
+// is full.
+static const struct RowFunctionTable* GetTable(
+    struct RowFunctionTable* local) {
+  int cpu_info = TestCpuFlag(-1);
+  struct RowFunctionTable* table =
+      (struct RowFunctionTable*)(AtomicLoadPointer(
+          (void* volatile*)(&row_table_)));
+  int i;
+  if (table && table->cpu_info == cpu_info) {
+    return table;
+  }
+  for (i = 0; i < kRowTablePoolSize; ++i) {
+    if (AtomicLoadInt(&row_table_state_[i]) == kRowTablePublished &&
+        row_table_pool_[i].cpu_info == cpu_info) {
+      table = &row_table_pool_[i];
+      AtomicStorePointer((void* volatile*)(&row_table_), table);
+      return table;
+    }
+  }
+  ResolveRowFunctions(cpu_info, local);
+  for (i = 0; i < kRowTablePoolSize; ++i) {
+    if (AtomicCompareExchangeInt(&row_table_state_[i], kRowTableFree,
+                                 kRowTableWriting)) {
+      table = &row_table_pool_[i];
+      *table = *local;
+      AtomicStoreInt(&row_table_state_[i], kRowTablePublished);
+      AtomicStorePointer((void* volatile*)(&row_table_), table);
+      return table;
+    }
+  }
+  return local;
+}
+
+static const struct RowFunctionEntry* GetEntry(
+    int function_id, struct RowFunctionTable* local, int* trace) {
+  const struct RowFunctionTable* table;
+  if (function_id < 0 || function_id >= kRowFunctionCount) {
+    return NULL;
+  }
+  table = GetTable(local);
+  *trace = table->trace;
+  if (row_overrides_[function_id].any_function) {
+    return &row_overrides_[function_id];
+  }
+  return &table->entries[function_id];
+}
+
+static int UseFullFunction(const struct RowFunctionEntry* entry, int width) {
+  return entry->function && !(width & entry->width_mask);
+}
+
+LIBYUV_API
+RowFunction GetRowFunction(int function_id, int width) {
+  struct RowFunctionTable local;
+  int trace = 0;
+  const struct RowFunctionEntry* entry = GetEntry(function_id, &local, &trace);
+  if (!entry) {
+    return NULL;
+  }
+  if (trace) {
+    const char* name = UseFullFunction(entry, width) ? entry->name :
+        entry->any_name;
+    if (AtomicLoadPointer((void* volatile*)(&row_traced_[function_id])) !=
+        name) {
+      AtomicStorePointer((void* volatile*)(&row_traced_[function_id]),
+                         (void*)(name));
+      fprintf(stderr, "libyuv: %s width %d uses %s\n",
+              kRowFunctionNames[function_id], width, name);
+    }
+  }
+  return UseFullFunction(entry, width) ? entry->function :
+      entry->any_function;
+}
+
+LIBYUV_API
+const char* GetRowFunctionName(int function_id, int width) {
+  struct RowFunctionTable local;
+  int trace = 0;
+  const struct RowFunctionEntry* entry = GetEntry(function_id, &local, &trace);
+  if (!entry) {
+    return NULL;
+  }
+  return UseFullFunction(entry, width) ? entry->name : entry->any_name;
+}
+
+LIBYUV_API
+int GetRowFunctionCpuFlag(int function_id) {
+  struct RowFunctionTable local;
+  int trace = 0;
+  const struct RowFunctionEntry* entry = GetEntry(function_id, &local, &trace);
+  return entry ? entry->cpu_flag : 0;
+}
+
+LIBYUV_API
+int SetRowFunction(int function_id, RowFunction any_function,
+                   RowFunction function, int width_mask) {
+  if (function_id < 0 || function_id >= kRowFunctionCount) {
+    return -1;
+  }
+  SetEntry(&row_overrides_[function_id], any_function, "override",
+           function, "override", width_mask, 0);
+  return 0;
+}
+
+// Strips use half of the L1 data cache, leaving the other half for the
+// lines that are written and for stack and tables.  32 KB of L1 and 8 MB of
+// last level cache are assumed when the sizes are unknown.  Threads that
+// race to resolve store the same values.  Returns the strip bytes.
+static int ResolveCacheSizes(void) {
+  int strip_bytes = AtomicLoadInt(&row_strip_bytes_);
+  int l1_data_size, l2_size, l3_size, line_size;
+  if (strip_bytes) {
+    return strip_bytes;
+  }
+  GetCpuCacheInfo(&l1_data_size, &l2_size, &l3_size, &line_size);
+  if (l1_data_size <= 0) {
+    l1_data_size = 32 * 1024;
+  }
+  AtomicStoreInt(&last_level_cache_size_, l3_size > 0 ? l3_size :
+                 (l2_size > 0 ? l2_size : 8 * 1024 * 1024));
+  strip_bytes = l1_data_size / 2;
+  AtomicStoreInt(&row_strip_bytes_, strip_bytes);
+  return strip_bytes;
+}
+
+LIBYUV_API
+int GetRowStripWidth(int width, int bytes_per_pixel) {
+  int strip_bytes = AtomicLoadInt(&row_strip_override_);
+  int strip_width;
+  if (!strip_bytes) {
+    strip_bytes = ResolveCacheSizes();
+  }
+  strip_width = (strip_bytes / (bytes_per_pixel > 0 ? bytes_per_pixel : 1)) &
+      ~63;
+  if (strip_width < 64) {
+    strip_width = 64;
+  }
+  return width > strip_width ? strip_width : width;
+}
+
+LIBYUV_API
+void SetRowStripBytes(int strip_bytes) {
+  AtomicStoreInt(&row_strip_override_, strip_bytes > 0 ? strip_bytes : 0);
+}
+
+LIBYUV_API
+void SetStreamingStores(int mode) {
+  AtomicStoreInt(&streaming_stores_, mode);
+}
+
+LIBYUV_API
+int UseStreamingStores(int64 size) {
+  int mode = AtomicLoadInt(&streaming_stores_);
+  if (mode == kStreamingStoresLarge) {
+    ResolveCacheSizes();
+    return size > AtomicLoadInt(&last_level_cache_size_);
+  }
+  return mode == kStreamingStoresOn;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
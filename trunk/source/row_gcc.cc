@@ -660,6 +660,347 @@ void ARGBToARGB4444Row_SSE2(const uint8* src, uint8* dst, int pix) {
 }
 #endif  // HAS_RGB24TOARGBROW_SSSE3
 
+#if defined(HAS_ARGBTOAR30ROW_SSSE3) || defined(HAS_ARGBTOAR30ROW_AVX2)
+// Shuffle tables for ARGBToAR30.  B and R, then G, as 16 bit v * 0x0101.
+static uvec8 kShuffleBRToAR30 = {
+  0u, 0u, 2u, 2u, 4u, 4u, 6u, 6u, 8u, 8u, 10u, 10u, 12u, 12u, 14u, 14u
+};
+
+static uvec8 kShuffleGToAR30 = {
+  1u, 1u, 128u, 128u, 5u, 5u, 128u, 128u,
+  9u, 9u, 128u, 128u, 13u, 13u, 128u, 128u
+};
+
+// pmulhuw by 1024 is >> 6 for 10 bit B, and by 16384 is >> 2 which is masked
+// to 10 bit R << 4, the high word of R << 20.
+static uvec16 kMulBRToAR30 = {
+  1024u, 16384u, 1024u, 16384u, 1024u, 16384u, 1024u, 16384u
+};
+
+static uvec16 kMaskBRToAR30 = {
+  0x03ffu, 0xfff0u, 0x03ffu, 0xfff0u, 0x03ffu, 0xfff0u, 0x03ffu, 0xfff0u
+};
+#endif
+
+#ifdef HAS_ARGBTOAR30ROW_SSSE3
+void ARGBToAR30Row_SSSE3(const uint8* src, uint8* dst, int pix) {
+  asm volatile (
+    "movdqa    %3,%%xmm3                       \n"
+    "movdqa    %4,%%xmm4                       \n"
+    "movdqa    %5,%%xmm5                       \n"
+    "movdqa    %6,%%xmm6                       \n"
+    "pcmpeqb   %%xmm7,%%xmm7                   \n"
+    "pslld     $0x1e,%%xmm7                    \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "pshufb    %%xmm3,%%xmm1                   \n"
+    "pshufb    %%xmm4,%%xmm2                   \n"
+    "pand      %%xmm7,%%xmm0                   \n"  // A
+    "pmulhuw   %%xmm5,%%xmm1                   \n"
+    "pand      %%xmm6,%%xmm1                   \n"  // B and R << 20
+    "psrlw     $0x6,%%xmm2                     \n"
+    "pslld     $0xa,%%xmm2                     \n"  // G << 10
+    "por       %%xmm1,%%xmm0                   \n"
+    "por       %%xmm2,%%xmm0                   \n"
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x4,%2                         \n"
+    "jg        1b                              \n"
+  : "+r"(src),  // %0
+    "+r"(dst),  // %1
+    "+r"(pix)   // %2
+  : "m"(kShuffleBRToAR30),  // %3
+    "m"(kShuffleGToAR30),   // %4
+    "m"(kMulBRToAR30),      // %5
+    "m"(kMaskBRToAR30)      // %6
+  : "memory", "cc",
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_ARGBTOAR30ROW_SSSE3
+
+#ifdef HAS_ARGBTOAR30ROW_AVX2
+void ARGBToAR30Row_AVX2(const uint8* src, uint8* dst, int pix) {
+  asm volatile (
+    "vbroadcastf128 %3,%%ymm3                  \n"
+    "vbroadcastf128 %4,%%ymm4                  \n"
+    "vbroadcastf128 %5,%%ymm5                  \n"
+    "vbroadcastf128 %6,%%ymm6                  \n"
+    "vpcmpeqb  %%ymm7,%%ymm7,%%ymm7            \n"
+    "vpslld    $0x1e,%%ymm7,%%ymm7             \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "vpshufb   %%ymm3,%%ymm0,%%ymm1            \n"
+    "vpshufb   %%ymm4,%%ymm0,%%ymm2            \n"
+    "vpand     %%ymm7,%%ymm0,%%ymm0            \n"  // A
+    "vpmulhuw  %%ymm5,%%ymm1,%%ymm1            \n"
+    "vpand     %%ymm6,%%ymm1,%%ymm1            \n"  // B and R << 20
+    "vpsrlw    $0x6,%%ymm2,%%ymm2              \n"
+    "vpslld    $0xa,%%ymm2,%%ymm2              \n"  // G << 10
+    "vpor      %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpor      %%ymm2,%%ymm0,%%ymm0            \n"
+    "vmovdqu   %%ymm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src),  // %0
+    "+r"(dst),  // %1
+    "+r"(pix)   // %2
+  : "m"(kShuffleBRToAR30),  // %3
+    "m"(kShuffleGToAR30),   // %4
+    "m"(kMulBRToAR30),      // %5
+    "m"(kMaskBRToAR30)      // %6
+  : "memory", "cc",
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_ARGBTOAR30ROW_AVX2
+
+#ifdef HAS_AR30TOARGBROW_SSE2
+void AR30ToARGBRow_SSE2(const uint8* src, uint8* dst, int pix) {
+  asm volatile (
+    "pcmpeqb   %%xmm4,%%xmm4                   \n"
+    "psrld     $0x18,%%xmm4                    \n"  // 0x000000ff
+    "movdqa    %%xmm4,%%xmm5                   \n"
+    "pslld     $0x8,%%xmm5                     \n"  // 0x0000ff00
+    "movdqa    %%xmm4,%%xmm6                   \n"
+    "pslld     $0x10,%%xmm6                    \n"  // 0x00ff0000
+    "pcmpeqb   %%xmm7,%%xmm7                   \n"
+    "pslld     $0x1e,%%xmm7                    \n"  // 0xc0000000
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "movdqa    %%xmm0,%%xmm3                   \n"
+    "psrld     $0x2,%%xmm1                     \n"
+    "psrld     $0x4,%%xmm2                     \n"
+    "psrld     $0x6,%%xmm3                     \n"
+    "pand      %%xmm4,%%xmm1                   \n"  // B
+    "pand      %%xmm5,%%xmm2                   \n"  // G
+    "pand      %%xmm6,%%xmm3                   \n"  // R
+    "pand      %%xmm7,%%xmm0                   \n"  // 2 bit A
+    "por       %%xmm2,%%xmm1                   \n"
+    "por       %%xmm3,%%xmm1                   \n"
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "psrld     $0x2,%%xmm2                     \n"
+    "por       %%xmm2,%%xmm0                   \n"
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "psrld     $0x4,%%xmm2                     \n"
+    "por       %%xmm2,%%xmm0                   \n"  // 8 bit A
+    "por       %%xmm1,%%xmm0                   \n"
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x4,%2                         \n"
+    "jg        1b                              \n"
+  : "+r"(src),  // %0
+    "+r"(dst),  // %1
+    "+r"(pix)   // %2
+  :
+  : "memory", "cc",
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_AR30TOARGBROW_SSE2
+
+#ifdef HAS_AR30TOARGBROW_AVX2
+void AR30ToARGBRow_AVX2(const uint8* src, uint8* dst, int pix) {
+  asm volatile (
+    "vpcmpeqb  %%ymm4,%%ymm4,%%ymm4            \n"
+    "vpsrld    $0x18,%%ymm4,%%ymm4             \n"  // 0x000000ff
+    "vpslld    $0x8,%%ymm4,%%ymm5              \n"  // 0x0000ff00
+    "vpslld    $0x10,%%ymm4,%%ymm6             \n"  // 0x00ff0000
+    "vpcmpeqb  %%ymm7,%%ymm7,%%ymm7            \n"
+    "vpslld    $0x1e,%%ymm7,%%ymm7             \n"  // 0xc0000000
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "vpsrld    $0x2,%%ymm0,%%ymm1              \n"
+    "vpsrld    $0x4,%%ymm0,%%ymm2              \n"
+    "vpsrld    $0x6,%%ymm0,%%ymm3              \n"
+    "vpand     %%ymm4,%%ymm1,%%ymm1            \n"  // B
+    "vpand     %%ymm5,%%ymm2,%%ymm2            \n"  // G
+    "vpand     %%ymm6,%%ymm3,%%ymm3            \n"  // R
+    "vpand     %%ymm7,%%ymm0,%%ymm0            \n"  // 2 bit A
+    "vpor      %%ymm2,%%ymm1,%%ymm1            \n"
+    "vpor      %%ymm3,%%ymm1,%%ymm1            \n"
+    "vpsrld    $0x2,%%ymm0,%%ymm2              \n"
+    "vpor      %%ymm2,%%ymm0,%%ymm0            \n"
+    "vpsrld    $0x4,%%ymm0,%%ymm2              \n"
+    "vpor      %%ymm2,%%ymm0,%%ymm0            \n"  // 8 bit A
+    "vpor      %%ymm1,%%ymm0,%%ymm0            \n"
+    "vmovdqu   %%ymm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src),  // %0
+    "+r"(dst),  // %1
+    "+r"(pix)   // %2
+  :
+  : "memory", "cc",
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_AR30TOARGBROW_AVX2
+
+#ifdef HAS_ARGBTOPLANARFLOATROW_SSE2
+// 4 ARGB pixels to 4 floats each of R, G and B.  Each channel is isolated
+// with a shift left then right, so all 8 xmm registers are enough.
+void ARGBToPlanarFloatRow_SSE2(const uint8* src_argb,
+                               float* dst_r, float* dst_g, float* dst_b,
+                               const float* scale_bias, int width) {
+  asm volatile (
+    "movss     " MEMACCESS(5) ",%%xmm2         \n"
+    "movss     " MEMACCESS2(0x4,5) ",%%xmm3    \n"
+    "movss     " MEMACCESS2(0x8,5) ",%%xmm4    \n"
+    "movss     " MEMACCESS2(0xc,5) ",%%xmm5    \n"
+    "movss     " MEMACCESS2(0x10,5) ",%%xmm6   \n"
+    "movss     " MEMACCESS2(0x14,5) ",%%xmm7   \n"
+    "shufps    $0x0,%%xmm2,%%xmm2              \n"
+    "shufps    $0x0,%%xmm3,%%xmm3              \n"
+    "shufps    $0x0,%%xmm4,%%xmm4              \n"
+    "shufps    $0x0,%%xmm5,%%xmm5              \n"
+    "shufps    $0x0,%%xmm6,%%xmm6              \n"
+    "shufps    $0x0,%%xmm7,%%xmm7              \n"
+    "sub       %1,%2                           \n"
+    "sub       %1,%3                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "pslld     $0x8,%%xmm1                     \n"
+    "psrld     $0x18,%%xmm1                    \n"  // R
+    "cvtdq2ps  %%xmm1,%%xmm1                   \n"
+    "mulps     %%xmm2,%%xmm1                   \n"
+    "addps     %%xmm5,%%xmm1                   \n"
+    "movups    %%xmm1," MEMACCESS(1) "         \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "pslld     $0x10,%%xmm1                    \n"
+    "psrld     $0x18,%%xmm1                    \n"  // G
+    "cvtdq2ps  %%xmm1,%%xmm1                   \n"
+    "mulps     %%xmm3,%%xmm1                   \n"
+    "addps     %%xmm6,%%xmm1                   \n"
+    MEMOPMEM(movups,xmm1,0x00,1,2,1)           //  movups  %%xmm1,(%1,%2)
+    "pslld     $0x18,%%xmm0                    \n"
+    "psrld     $0x18,%%xmm0                    \n"  // B
+    "cvtdq2ps  %%xmm0,%%xmm0                   \n"
+    "mulps     %%xmm4,%%xmm0                   \n"
+    "addps     %%xmm7,%%xmm0                   \n"
+    MEMOPMEM(movups,xmm0,0x00,1,3,1)           //  movups  %%xmm0,(%1,%3)
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "subl      $0x4,%4                         \n"
+    "jg        1b                              \n"
+  : "+r"(src_argb),  // %0
+    "+r"(dst_r),     // %1
+    "+r"(dst_g),     // %2
+    "+r"(dst_b),     // %3
+#if defined(__i386__) && defined(__pic__)
+    "+m"(width)      // %4
+#else
+    "+rm"(width)     // %4
+#endif
+  : "r"(scale_bias)  // %5
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_ARGBTOPLANARFLOATROW_SSE2
+
+#ifdef HAS_ARGBTOPLANARFLOATROW_AVX2
+// 8 ARGB pixels to 8 floats each of R, G and B.
+void ARGBToPlanarFloatRow_AVX2(const uint8* src_argb,
+                               float* dst_r, float* dst_g, float* dst_b,
+                               const float* scale_bias, int width) {
+  asm volatile (
+    "vbroadcastss " MEMACCESS(5) ",%%ymm2      \n"
+    "vbroadcastss " MEMACCESS2(0x4,5) ",%%ymm3 \n"
+    "vbroadcastss " MEMACCESS2(0x8,5) ",%%ymm4 \n"
+    "vbroadcastss " MEMACCESS2(0xc,5) ",%%ymm5 \n"
+    "vbroadcastss " MEMACCESS2(0x10,5) ",%%ymm6 \n"
+    "vbroadcastss " MEMACCESS2(0x14,5) ",%%ymm7 \n"
+    "sub       %1,%2                           \n"
+    "sub       %1,%3                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "vpslld    $0x8,%%ymm0,%%ymm1              \n"
+    "vpsrld    $0x18,%%ymm1,%%ymm1             \n"  // R
+    "vcvtdq2ps %%ymm1,%%ymm1                   \n"
+    "vmulps    %%ymm2,%%ymm1,%%ymm1            \n"
+    "vaddps    %%ymm5,%%ymm1,%%ymm1            \n"
+    "vmovups   %%ymm1," MEMACCESS(1) "         \n"
+    "vpslld    $0x10,%%ymm0,%%ymm1             \n"
+    "vpsrld    $0x18,%%ymm1,%%ymm1             \n"  // G
+    "vcvtdq2ps %%ymm1,%%ymm1                   \n"
+    "vmulps    %%ymm3,%%ymm1,%%ymm1            \n"
+    "vaddps    %%ymm6,%%ymm1,%%ymm1            \n"
+    MEMOPMEM(vmovups,ymm1,0x00,1,2,1)          //  vmovups %%ymm1,(%1,%2)
+    "vpslld    $0x18,%%ymm0,%%ymm0             \n"
+    "vpsrld    $0x18,%%ymm0,%%ymm0             \n"  // B
+    "vcvtdq2ps %%ymm0,%%ymm0                   \n"
+    "vmulps    %%ymm4,%%ymm0,%%ymm0            \n"
+    "vaddps    %%ymm7,%%ymm0,%%ymm0            \n"
+    MEMOPMEM(vmovups,ymm0,0x00,1,3,1)          //  vmovups %%ymm0,(%1,%3)
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "subl      $0x8,%4                         \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_argb),  // %0
+    "+r"(dst_r),     // %1
+    "+r"(dst_g),     // %2
+    "+r"(dst_b),     // %3
+#if defined(__i386__) && defined(__pic__)
+    "+m"(width)      // %4
+#else
+    "+rm"(width)     // %4
+#endif
+  : "r"(scale_bias)  // %5
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_ARGBTOPLANARFLOATROW_AVX2
+
+#ifdef HAS_HALFFLOATROW_F16C
+// 8 floats to 8 half floats, rounded to nearest even.
+void HalfFloatRow_F16C(const float* src, uint16* dst, float scale, float bias,
+                       int width) {
+  asm volatile (
+    "vbroadcastss %3,%%ymm4                    \n"
+    "vbroadcastss %4,%%ymm5                    \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmulps    " MEMACCESS(0) ",%%ymm4,%%ymm0  \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "vaddps    %%ymm5,%%ymm0,%%ymm0            \n"
+    "vcvtps2ph $0x0,%%ymm0," MEMACCESS(1) "    \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src),    // %0
+    "+r"(dst),    // %1
+    "+r"(width)   // %2
+  : "m"(scale),   // %3
+    "m"(bias)     // %4
+  : "memory", "cc",
+    "xmm0", "xmm4", "xmm5"
+  );
+}
+#endif  // HAS_HALFFLOATROW_F16C
+
 #ifdef HAS_ARGBTOYROW_SSSE3
 // Convert 16 ARGB pixels (64 bytes) to 16 Y values.
 void ARGBToYRow_SSSE3(const uint8* src_argb, uint8* dst_y, int pix) {
@@ -782,6 +1123,59 @@ void ARGBToYRow_AVX2(const uint8* src_argb, uint8* dst_y, int pix) {
 }
 #endif  // HAS_ARGBTOYROW_AVX2
 
+#ifdef HAS_ARGBTOYROW_AVX512BW
+// vpermd for vpackssdw + vpackuswb.
+static const uint32 kPermdARGBToY_AVX512[16] = {
+  0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15
+};
+
+// Convert 64 ARGB pixels (256 bytes) to 64 Y values.
+void ARGBToYRow_AVX512BW(const uint8* src_argb, uint8* dst_y, int pix) {
+  asm volatile (
+    "vbroadcasti32x4 %3,%%zmm4                 \n"
+    "vbroadcasti32x4 %4,%%zmm5                 \n"
+    "vmovdqu32  %5,%%zmm6                      \n"
+    "vpternlogd $0xff,%%zmm7,%%zmm7,%%zmm7     \n"
+    "vpsrlw     $0xf,%%zmm7,%%zmm7             \n"  // 1 for vpmaddwd.
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu8   " MEMACCESS(0) ",%%zmm0        \n"
+    "vmovdqu8   " MEMACCESS2(0x40,0) ",%%zmm1  \n"
+    "vmovdqu8   " MEMACCESS2(0x80,0) ",%%zmm2  \n"
+    "vmovdqu8   " MEMACCESS2(0xc0,0) ",%%zmm3  \n"
+    "vpmaddubsw %%zmm4,%%zmm0,%%zmm0           \n"
+    "vpmaddubsw %%zmm4,%%zmm1,%%zmm1           \n"
+    "vpmaddubsw %%zmm4,%%zmm2,%%zmm2           \n"
+    "vpmaddubsw %%zmm4,%%zmm3,%%zmm3           \n"
+    "lea       " MEMLEA(0x100,0) ",%0          \n"
+    "vpmaddwd   %%zmm7,%%zmm0,%%zmm0           \n"  // No vphaddw for zmm.
+    "vpmaddwd   %%zmm7,%%zmm1,%%zmm1           \n"
+    "vpmaddwd   %%zmm7,%%zmm2,%%zmm2           \n"
+    "vpmaddwd   %%zmm7,%%zmm3,%%zmm3           \n"
+    "vpackssdw  %%zmm1,%%zmm0,%%zmm0           \n"  // mutates.
+    "vpackssdw  %%zmm3,%%zmm2,%%zmm2           \n"
+    "vpsrlw     $0x7,%%zmm0,%%zmm0             \n"
+    "vpsrlw     $0x7,%%zmm2,%%zmm2             \n"
+    "vpackuswb  %%zmm2,%%zmm0,%%zmm0           \n"  // mutates.
+    "vpermd     %%zmm0,%%zmm6,%%zmm0           \n"  // unmutate.
+    "vpaddb     %%zmm5,%%zmm0,%%zmm0           \n"  // add 16 for Y
+    "vmovdqu8   %%zmm0," MEMACCESS(1) "        \n"
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "sub       $0x40,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_argb),  // %0
+    "+r"(dst_y),     // %1
+    "+r"(pix)        // %2
+  : "m"(kARGBToY),   // %3
+    "m"(kAddY16),    // %4
+    "m"(kPermdARGBToY_AVX512)  // %5
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+    "xmm7"
+  );
+}
+#endif  // HAS_ARGBTOYROW_AVX512BW
+
 #ifdef HAS_ARGBTOYJROW_AVX2
 // Convert 32 ARGB pixels (128 bytes) to 32 Y values.
 void ARGBToYJRow_AVX2(const uint8* src_argb, uint8* dst_y, int pix) {
@@ -952,6 +1346,77 @@ void ARGBToUVRow_AVX2(const uint8* src_argb0, int src_stride_argb,
 }
 #endif  // HAS_ARGBTOUVROW_AVX2
 
+#ifdef HAS_ARGBTOUVROW_AVX512BW
+// vpermw for vpackssdw + vpacksswb.  U words then V words.
+static const uint16 kPermwARGBToUV_AVX512[32] = {
+  0, 8, 16, 24, 1, 9, 17, 25, 2, 10, 18, 26, 3, 11, 19, 27,
+  4, 12, 20, 28, 5, 13, 21, 29, 6, 14, 22, 30, 7, 15, 23, 31
+};
+
+void ARGBToUVRow_AVX512BW(const uint8* src_argb0, int src_stride_argb,
+                          uint8* dst_u, uint8* dst_v, int width) {
+  asm volatile (
+    "vbroadcasti32x4 %6,%%zmm6                 \n"
+    "vbroadcasti32x4 %7,%%zmm7                 \n"
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+    "vpsrlw     $0xf,%%zmm5,%%zmm5             \n"  // 1 for vpmaddwd.
+    "sub       %1,%2                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu8   " MEMACCESS(0) ",%%zmm0        \n"
+    "vmovdqu8   " MEMACCESS2(0x40,0) ",%%zmm1  \n"
+    "vmovdqu8   " MEMACCESS2(0x80,0) ",%%zmm2  \n"
+    "vmovdqu8   " MEMACCESS2(0xc0,0) ",%%zmm3  \n"
+    VMEMOPREG(vpavgb,0x00,0,4,1,zmm0,zmm0)     // vpavgb (%0,%4,1),%%zmm0,%%zmm0
+    VMEMOPREG(vpavgb,0x40,0,4,1,zmm1,zmm1)
+    VMEMOPREG(vpavgb,0x80,0,4,1,zmm2,zmm2)
+    VMEMOPREG(vpavgb,0xc0,0,4,1,zmm3,zmm3)
+    "lea       " MEMLEA(0x100,0) ",%0          \n"
+    "vshufps    $0x88,%%zmm1,%%zmm0,%%zmm4     \n"
+    "vshufps    $0xdd,%%zmm1,%%zmm0,%%zmm0     \n"
+    "vpavgb     %%zmm4,%%zmm0,%%zmm0           \n"
+    "vshufps    $0x88,%%zmm3,%%zmm2,%%zmm4     \n"
+    "vshufps    $0xdd,%%zmm3,%%zmm2,%%zmm2     \n"
+    "vpavgb     %%zmm4,%%zmm2,%%zmm2           \n"
+
+    "vpmaddubsw %%zmm7,%%zmm0,%%zmm1           \n"
+    "vpmaddubsw %%zmm7,%%zmm2,%%zmm3           \n"
+    "vpmaddubsw %%zmm6,%%zmm0,%%zmm0           \n"
+    "vpmaddubsw %%zmm6,%%zmm2,%%zmm2           \n"
+    "vpmaddwd   %%zmm5,%%zmm1,%%zmm1           \n"  // No vphaddw for zmm.
+    "vpmaddwd   %%zmm5,%%zmm3,%%zmm3           \n"
+    "vpmaddwd   %%zmm5,%%zmm0,%%zmm0           \n"
+    "vpmaddwd   %%zmm5,%%zmm2,%%zmm2           \n"
+    "vpackssdw  %%zmm3,%%zmm1,%%zmm1           \n"  // mutates.
+    "vpackssdw  %%zmm2,%%zmm0,%%zmm0           \n"
+    "vpsraw     $0x8,%%zmm1,%%zmm1             \n"
+    "vpsraw     $0x8,%%zmm0,%%zmm0             \n"
+    "vpacksswb  %%zmm0,%%zmm1,%%zmm0           \n"  // mutates.
+    "vmovdqu16  %8,%%zmm4                      \n"
+    "vpermw     %%zmm0,%%zmm4,%%zmm0           \n"  // unmutate.
+    "vpxord     %5%{1to16%},%%zmm0,%%zmm0      \n"  // add 128 for UV
+
+    "vmovdqu    %%ymm0," MEMACCESS(1) "        \n"
+    VEXTOPMEM(vextracti64x4,1,zmm0,0x0,1,2,1) // vextracti64x4 $1,%%zmm0,(%1,%2,1)
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x40,%3                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_argb0),       // %0
+    "+r"(dst_u),           // %1
+    "+r"(dst_v),           // %2
+    "+rm"(width)           // %3
+  : "r"((intptr_t)(src_stride_argb)), // %4
+    "m"(kAddUV128),  // %5
+    "m"(kARGBToV),   // %6
+    "m"(kARGBToU),   // %7
+    "m"(kPermwARGBToUV_AVX512)  // %8
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_ARGBTOUVROW_AVX512BW
+
 #ifdef HAS_ARGBTOUVJROW_SSSE3
 void ARGBToUVJRow_SSSE3(const uint8* src_argb0, int src_stride_argb,
                         uint8* dst_u, uint8* dst_v, int width) {
@@ -1458,6 +1923,14 @@ static YuvConstants SIMD_ALIGNED(kYuvConstants) = {
   { YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG }
 };
 
+#if defined(HAS_I210TOAR30ROW_SSSE3)
+// BT601 U and V contributions to B, G and R for 10 bit UV, negated, as word
+// pairs for pmaddwd.  The products are 4 times those of 8 bit UV.
+static vec16 kUV10ToB = { -UB, 0, -UB, 0, -UB, 0, -UB, 0 };
+static vec16 kUV10ToG = { -UG, -VG, -UG, -VG, -UG, -VG, -UG, -VG };
+static vec16 kUV10ToR = { 0, -VR, 0, -VR, 0, -VR, 0, -VR };
+#endif
+
 // BT601 constants for NV21 where chroma plane is VU instead of UV.
 static YuvConstants SIMD_ALIGNED(kYvuConstants) = {
   { 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB,
@@ -1954,58 +2427,245 @@ void OMITFP I422ToRGBARow_SSSE3(const uint8* y_buf,
   );
 }
 
-#endif  // HAS_I422TOARGBROW_SSSE3
 
-// Read 8 UV from 422, upsample to 16 UV.
-#define READYUV422_AVX2                                                        \
-    "vmovq       " MEMACCESS([u_buf]) ",%%xmm0                      \n"        \
-    MEMOPREG(vmovq, 0x00, [u_buf], [v_buf], 1, xmm1)                           \
-    "lea        " MEMLEA(0x8, [u_buf]) ",%[u_buf]                   \n"        \
-    "vpunpcklbw %%ymm1,%%ymm0,%%ymm0                                \n"        \
-    "vpermq     $0xd8,%%ymm0,%%ymm0                                 \n"        \
-    "vpunpcklwd %%ymm0,%%ymm0,%%ymm0                                \n"
+#if defined(HAS_I422TOAR30ROW_SSSE3) || defined(HAS_I422TOAR30ROW_AVX2)
+// B + G * 1024 with pmaddwd.
+static uvec16 kMulBGToAR30 = {
+  1u, 1024u, 1u, 1024u, 1u, 1024u, 1u, 1024u
+};
+#endif
 
-// Convert 16 pixels: 16 UV and 16 Y.
-#define YUVTORGB_AVX2(YuvConstants)                                            \
-    "vpmaddubsw  " MEMACCESS2(64, [YuvConstants]) ",%%ymm0,%%ymm2   \n"        \
-    "vpmaddubsw  " MEMACCESS2(32, [YuvConstants]) ",%%ymm0,%%ymm1   \n"        \
-    "vpmaddubsw  " MEMACCESS([YuvConstants]) ",%%ymm0,%%ymm0        \n"        \
-    "vmovdqu     " MEMACCESS2(160, [YuvConstants]) ",%%ymm3         \n"        \
-    "vpsubw      %%ymm2,%%ymm3,%%ymm2                               \n"        \
-    "vmovdqu     " MEMACCESS2(128, [YuvConstants]) ",%%ymm3         \n"        \
-    "vpsubw      %%ymm1,%%ymm3,%%ymm1                               \n"        \
-    "vmovdqu     " MEMACCESS2(96, [YuvConstants]) ",%%ymm3          \n"        \
-    "vpsubw      %%ymm0,%%ymm3,%%ymm0                               \n"        \
-    "vmovdqu     " MEMACCESS([y_buf]) ",%%xmm3                      \n"        \
-    "lea         " MEMLEA(0x10, [y_buf]) ",%[y_buf]                 \n"        \
-    "vpermq      $0xd8,%%ymm3,%%ymm3                                \n"        \
-    "vpunpcklbw  %%ymm3,%%ymm3,%%ymm3                               \n"        \
-    "vpmulhuw    " MEMACCESS2(192, [YuvConstants]) ",%%ymm3,%%ymm3  \n"        \
-    "vpaddsw     %%ymm3,%%ymm0,%%ymm0           \n"                            \
-    "vpaddsw     %%ymm3,%%ymm1,%%ymm1           \n"                            \
-    "vpaddsw     %%ymm3,%%ymm2,%%ymm2           \n"                            \
-    "vpsraw      $0x6,%%ymm0,%%ymm0             \n"                            \
-    "vpsraw      $0x6,%%ymm1,%%ymm1             \n"                            \
-    "vpsraw      $0x6,%%ymm2,%%ymm2             \n"                            \
-    "vpackuswb   %%ymm0,%%ymm0,%%ymm0           \n"                            \
-    "vpackuswb   %%ymm1,%%ymm1,%%ymm1           \n"                            \
-    "vpackuswb   %%ymm2,%%ymm2,%%ymm2           \n"
+#if defined(HAS_I422TOAR30ROW_SSSE3) || defined(HAS_I210TOAR30ROW_SSSE3)
+// Read 8 Y scaled to 16 bits for YUVTORGB16.
+#define READY16                                                                \
+    "movq       " MEMACCESS([y_buf]) ",%%xmm4                   \n"            \
+    "lea        " MEMLEA(0x8, [y_buf]) ",%[y_buf]               \n"            \
+    "punpcklbw  %%xmm4,%%xmm4                                   \n"
 
-#if defined(HAS_I422TOBGRAROW_AVX2)
-// 16 pixels
-// 8 UV values upsampled to 16 UV, mixed with 16 Y producing 16 BGRA (64 bytes).
-void OMITFP I422ToBGRARow_AVX2(const uint8* y_buf,
-                               const uint8* u_buf,
-                               const uint8* v_buf,
-                               uint8* dst_bgra,
-                               int width) {
-  asm volatile (
-    "sub       %[u_buf],%[v_buf]               \n"
-    "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
-    LABELALIGN
-  "1:                                          \n"
-    READYUV422_AVX2
-    YUVTORGB_AVX2(kYuvConstants)
+// Read 4 UV from 10 bit 422 clamped to 1023, and read 8 10 bit Y scaled to
+// 16 bits.  Assumes XMM6 is 1023.
+#define READYUV210                                                             \
+    "movq       " MEMACCESS([u_buf]) ",%%xmm0                   \n"            \
+    MEMOPREG(movq, 0x00, [u_buf], [v_buf], 1, xmm1)                            \
+    "lea        " MEMLEA(0x8, [u_buf]) ",%[u_buf]               \n"            \
+    "punpcklwd  %%xmm1,%%xmm0                                   \n"            \
+    "movdqa     %%xmm0,%%xmm1                                   \n"            \
+    "psubusw    %%xmm6,%%xmm1                                   \n"            \
+    "psubw      %%xmm1,%%xmm0                                   \n"            \
+    "movdqu     " MEMACCESS([y_buf]) ",%%xmm4                   \n"            \
+    "lea        " MEMLEA(0x10, [y_buf]) ",%[y_buf]              \n"            \
+    "movdqa     %%xmm4,%%xmm3                                   \n"            \
+    "psllw      $0x6,%%xmm4                                     \n"            \
+    "psrlw      $0x4,%%xmm3                                     \n"            \
+    "por        %%xmm3,%%xmm4                                   \n"
+
+// Convert 8 pixels: 4 10 bit UV and 8 Y scaled to 16 bits in xmm4, to 16
+// bit B, G and R with 6 bits of fraction.  The UV products are floored to
+// the scale of 8 bit UV and upsampled to 8.
+#define YUV10TORGB16(YuvConstants)                                             \
+    "movdqa     %%xmm0,%%xmm1                                   \n"            \
+    "movdqa     %%xmm0,%%xmm2                                   \n"            \
+    "pmaddwd    %[kUV10ToB],%%xmm0                              \n"            \
+    "pmaddwd    %[kUV10ToG],%%xmm1                              \n"            \
+    "pmaddwd    %[kUV10ToR],%%xmm2                              \n"            \
+    "psrad      $0x2,%%xmm0                                     \n"            \
+    "psrad      $0x2,%%xmm1                                     \n"            \
+    "psrad      $0x2,%%xmm2                                     \n"            \
+    "packssdw   %%xmm0,%%xmm0                                   \n"            \
+    "packssdw   %%xmm1,%%xmm1                                   \n"            \
+    "packssdw   %%xmm2,%%xmm2                                   \n"            \
+    "punpcklwd  %%xmm0,%%xmm0                                   \n"            \
+    "punpcklwd  %%xmm1,%%xmm1                                   \n"            \
+    "punpcklwd  %%xmm2,%%xmm2                                   \n"            \
+    "paddw      " MEMACCESS2(96, [YuvConstants]) ",%%xmm0       \n"            \
+    "paddw      " MEMACCESS2(128, [YuvConstants]) ",%%xmm1      \n"            \
+    "paddw      " MEMACCESS2(160, [YuvConstants]) ",%%xmm2      \n"            \
+    "pmulhuw    " MEMACCESS2(192, [YuvConstants]) ",%%xmm4      \n"            \
+    "paddsw     %%xmm4,%%xmm0                                   \n"            \
+    "paddsw     %%xmm4,%%xmm1                                   \n"            \
+    "paddsw     %%xmm4,%%xmm2                                   \n"
+
+// Convert 8 pixels: 8 UV and 8 Y scaled to 16 bits in xmm4, to 16 bit B, G
+// and R with 6 bits of fraction.
+#define YUVTORGB16(YuvConstants)                                               \
+    "movdqa     %%xmm0,%%xmm1                                   \n"            \
+    "movdqa     %%xmm0,%%xmm2                                   \n"            \
+    "movdqa     %%xmm0,%%xmm3                                   \n"            \
+    "movdqa     " MEMACCESS2(96, [YuvConstants]) ",%%xmm0       \n"            \
+    "pmaddubsw  " MEMACCESS([YuvConstants]) ",%%xmm1            \n"            \
+    "psubw      %%xmm1,%%xmm0                                   \n"            \
+    "movdqa     " MEMACCESS2(128, [YuvConstants]) ",%%xmm1      \n"            \
+    "pmaddubsw  " MEMACCESS2(32, [YuvConstants]) ",%%xmm2       \n"            \
+    "psubw      %%xmm2,%%xmm1                                   \n"            \
+    "movdqa     " MEMACCESS2(160, [YuvConstants]) ",%%xmm2      \n"            \
+    "pmaddubsw  " MEMACCESS2(64, [YuvConstants]) ",%%xmm3       \n"            \
+    "psubw      %%xmm3,%%xmm2                                   \n"            \
+    "pmulhuw    " MEMACCESS2(192, [YuvConstants]) ",%%xmm4      \n"            \
+    "paddsw     %%xmm4,%%xmm0                                   \n"            \
+    "paddsw     %%xmm4,%%xmm1                                   \n"            \
+    "paddsw     %%xmm4,%%xmm2                                   \n"
+
+// Store 8 AR30 values.  Assumes XMM5 is zero, XMM6 is 1023 and XMM7 is
+// kMulBGToAR30.
+#define STOREAR30                                                              \
+    "psraw      $0x4,%%xmm0                                     \n"            \
+    "psraw      $0x4,%%xmm1                                     \n"            \
+    "psraw      $0x4,%%xmm2                                     \n"            \
+    "pminsw     %%xmm6,%%xmm0                                   \n"            \
+    "pminsw     %%xmm6,%%xmm1                                   \n"            \
+    "pminsw     %%xmm6,%%xmm2                                   \n"            \
+    "pmaxsw     %%xmm5,%%xmm0                                   \n"            \
+    "pmaxsw     %%xmm5,%%xmm1                                   \n"            \
+    "pmaxsw     %%xmm5,%%xmm2                                   \n"            \
+    "movdqa     %%xmm0,%%xmm3                                   \n"            \
+    "punpcklwd  %%xmm1,%%xmm0                                   \n"            \
+    "punpckhwd  %%xmm1,%%xmm3                                   \n"            \
+    "pmaddwd    %%xmm7,%%xmm0                                   \n"            \
+    "pmaddwd    %%xmm7,%%xmm3                                   \n"            \
+    "psllw      $0x4,%%xmm2                                     \n"            \
+    "pcmpeqb    %%xmm1,%%xmm1                                   \n"            \
+    "psllw      $0xe,%%xmm1                                     \n"            \
+    "por        %%xmm1,%%xmm2                                   \n"            \
+    "movdqa     %%xmm5,%%xmm1                                   \n"            \
+    "movdqa     %%xmm5,%%xmm4                                   \n"            \
+    "punpcklwd  %%xmm2,%%xmm1                                   \n"            \
+    "punpckhwd  %%xmm2,%%xmm4                                   \n"            \
+    "por        %%xmm1,%%xmm0                                   \n"            \
+    "por        %%xmm4,%%xmm3                                   \n"            \
+    "movdqu     %%xmm0," MEMACCESS([dst_ar30]) "                \n"            \
+    "movdqu     %%xmm3," MEMACCESS2(0x10, [dst_ar30]) "         \n"            \
+    "lea        " MEMLEA(0x20, [dst_ar30]) ", %[dst_ar30]       \n"
+#endif
+
+#if defined(HAS_I422TOAR30ROW_SSSE3)
+void OMITFP I422ToAR30Row_SSSE3(const uint8* y_buf,
+                                const uint8* u_buf,
+                                const uint8* v_buf,
+                                uint8* dst_ar30,
+                                int width) {
+  asm volatile (
+    "sub       %[u_buf],%[v_buf]               \n"
+    "pxor      %%xmm5,%%xmm5                   \n"
+    "pcmpeqb   %%xmm6,%%xmm6                   \n"
+    "psrlw     $0x6,%%xmm6                     \n"
+    "movdqa    %[kMulBGToAR30],%%xmm7          \n"
+    LABELALIGN
+  "1:                                          \n"
+    READYUV422
+    READY16
+    YUVTORGB16(kYuvConstants)
+    STOREAR30
+    "subl      $0x8,%[width]                   \n"
+    "jg        1b                              \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [u_buf]"+r"(u_buf),    // %[u_buf]
+    [v_buf]"+r"(v_buf),    // %[v_buf]
+    [dst_ar30]"+r"(dst_ar30),  // %[dst_ar30]
+#if defined(__i386__) && defined(__pic__)
+    [width]"+m"(width)     // %[width]
+#else
+    [width]"+rm"(width)    // %[width]
+#endif
+  : [kYuvConstants]"r"(&kYuvConstants.kUVToB),  // %[kYuvConstants]
+    [kMulBGToAR30]"m"(kMulBGToAR30)
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_I422TOAR30ROW_SSSE3
+
+#if defined(HAS_I210TOAR30ROW_SSSE3)
+// 8 pixels of 10 bit YUV.  Y and UV keep 10 bits.
+void OMITFP I210ToAR30Row_SSSE3(const uint16* y_buf,
+                                const uint16* u_buf,
+                                const uint16* v_buf,
+                                uint8* dst_ar30,
+                                int width) {
+  asm volatile (
+    "sub       %[u_buf],%[v_buf]               \n"
+    "pxor      %%xmm5,%%xmm5                   \n"
+    "pcmpeqb   %%xmm6,%%xmm6                   \n"
+    "psrlw     $0x6,%%xmm6                     \n"
+    "movdqa    %[kMulBGToAR30],%%xmm7          \n"
+    LABELALIGN
+  "1:                                          \n"
+    READYUV210
+    YUV10TORGB16(kYuvConstants)
+    STOREAR30
+    "subl      $0x8,%[width]                   \n"
+    "jg        1b                              \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [u_buf]"+r"(u_buf),    // %[u_buf]
+    [v_buf]"+r"(v_buf),    // %[v_buf]
+    [dst_ar30]"+r"(dst_ar30),  // %[dst_ar30]
+#if defined(__i386__) && defined(__pic__)
+    [width]"+m"(width)     // %[width]
+#else
+    [width]"+rm"(width)    // %[width]
+#endif
+  : [kYuvConstants]"r"(&kYuvConstants.kUVToB),  // %[kYuvConstants]
+    [kMulBGToAR30]"m"(kMulBGToAR30),
+    [kUV10ToB]"m"(kUV10ToB),
+    [kUV10ToG]"m"(kUV10ToG),
+    [kUV10ToR]"m"(kUV10ToR)
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_I210TOAR30ROW_SSSE3
+
+#endif  // HAS_I422TOARGBROW_SSSE3
+
+// Read 8 UV from 422, upsample to 16 UV.
+#define READYUV422_AVX2                                                        \
+    "vmovq       " MEMACCESS([u_buf]) ",%%xmm0                      \n"        \
+    MEMOPREG(vmovq, 0x00, [u_buf], [v_buf], 1, xmm1)                           \
+    "lea        " MEMLEA(0x8, [u_buf]) ",%[u_buf]                   \n"        \
+    "vpunpcklbw %%ymm1,%%ymm0,%%ymm0                                \n"        \
+    "vpermq     $0xd8,%%ymm0,%%ymm0                                 \n"        \
+    "vpunpcklwd %%ymm0,%%ymm0,%%ymm0                                \n"
+
+// Convert 16 pixels: 16 UV and 16 Y.
+#define YUVTORGB_AVX2(YuvConstants)                                            \
+    "vpmaddubsw  " MEMACCESS2(64, [YuvConstants]) ",%%ymm0,%%ymm2   \n"        \
+    "vpmaddubsw  " MEMACCESS2(32, [YuvConstants]) ",%%ymm0,%%ymm1   \n"        \
+    "vpmaddubsw  " MEMACCESS([YuvConstants]) ",%%ymm0,%%ymm0        \n"        \
+    "vmovdqu     " MEMACCESS2(160, [YuvConstants]) ",%%ymm3         \n"        \
+    "vpsubw      %%ymm2,%%ymm3,%%ymm2                               \n"        \
+    "vmovdqu     " MEMACCESS2(128, [YuvConstants]) ",%%ymm3         \n"        \
+    "vpsubw      %%ymm1,%%ymm3,%%ymm1                               \n"        \
+    "vmovdqu     " MEMACCESS2(96, [YuvConstants]) ",%%ymm3          \n"        \
+    "vpsubw      %%ymm0,%%ymm3,%%ymm0                               \n"        \
+    "vmovdqu     " MEMACCESS([y_buf]) ",%%xmm3                      \n"        \
+    "lea         " MEMLEA(0x10, [y_buf]) ",%[y_buf]                 \n"        \
+    "vpermq      $0xd8,%%ymm3,%%ymm3                                \n"        \
+    "vpunpcklbw  %%ymm3,%%ymm3,%%ymm3                               \n"        \
+    "vpmulhuw    " MEMACCESS2(192, [YuvConstants]) ",%%ymm3,%%ymm3  \n"        \
+    "vpaddsw     %%ymm3,%%ymm0,%%ymm0           \n"                            \
+    "vpaddsw     %%ymm3,%%ymm1,%%ymm1           \n"                            \
+    "vpaddsw     %%ymm3,%%ymm2,%%ymm2           \n"                            \
+    "vpsraw      $0x6,%%ymm0,%%ymm0             \n"                            \
+    "vpsraw      $0x6,%%ymm1,%%ymm1             \n"                            \
+    "vpsraw      $0x6,%%ymm2,%%ymm2             \n"                            \
+    "vpackuswb   %%ymm0,%%ymm0,%%ymm0           \n"                            \
+    "vpackuswb   %%ymm1,%%ymm1,%%ymm1           \n"                            \
+    "vpackuswb   %%ymm2,%%ymm2,%%ymm2           \n"
+
+#if defined(HAS_I422TOBGRAROW_AVX2)
+// 16 pixels
+// 8 UV values upsampled to 16 UV, mixed with 16 Y producing 16 BGRA (64 bytes).
+void OMITFP I422ToBGRARow_AVX2(const uint8* y_buf,
+                               const uint8* u_buf,
+                               const uint8* v_buf,
+                               uint8* dst_bgra,
+                               int width) {
+  asm volatile (
+    "sub       %[u_buf],%[v_buf]               \n"
+    "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
+    LABELALIGN
+  "1:                                          \n"
+    READYUV422_AVX2
+    YUVTORGB_AVX2(kYuvConstants)
 
     // Step 3: Weave into BGRA
     "vpunpcklbw %%ymm0,%%ymm1,%%ymm1           \n"  // GB
@@ -2075,6 +2735,273 @@ void OMITFP I422ToARGBRow_AVX2(const uint8* y_buf,
 }
 #endif  // HAS_I422TOARGBROW_AVX2
 
+#if defined(HAS_I422TOARGBROW_NT_AVX2)
+// 16 pixels with non-temporal stores.  dst_argb must be 32 byte aligned.
+void OMITFP I422ToARGBRow_NT_AVX2(const uint8* y_buf,
+                                  const uint8* u_buf,
+                                  const uint8* v_buf,
+                                  uint8* dst_argb,
+                                  int width) {
+  asm volatile (
+    "sub       %[u_buf],%[v_buf]               \n"
+    "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
+    LABELALIGN
+  "1:                                          \n"
+    READYUV422_AVX2
+    YUVTORGB_AVX2(kYuvConstants)
+
+    // Step 3: Weave into ARGB
+    "vpunpcklbw %%ymm1,%%ymm0,%%ymm0           \n"  // BG
+    "vpermq     $0xd8,%%ymm0,%%ymm0            \n"
+    "vpunpcklbw %%ymm5,%%ymm2,%%ymm2           \n"  // RA
+    "vpermq     $0xd8,%%ymm2,%%ymm2            \n"
+    "vpunpcklwd %%ymm2,%%ymm0,%%ymm1           \n"  // BGRA first 8 pixels
+    "vpunpckhwd %%ymm2,%%ymm0,%%ymm0           \n"  // BGRA next 8 pixels
+
+    "vmovntdq   %%ymm1," MEMACCESS([dst_argb]) "\n"
+    "vmovntdq   %%ymm0," MEMACCESS2(0x20,[dst_argb]) "\n"
+    "lea       " MEMLEA(0x40,[dst_argb]) ",%[dst_argb] \n"
+    "sub       $0x10,%[width]                  \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [u_buf]"+r"(u_buf),    // %[u_buf]
+    [v_buf]"+r"(v_buf),    // %[v_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [kYuvConstants]"r"(&kYuvConstants.kUVToB)  // %[kYuvConstants]
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm5"
+  );
+}
+#endif  // HAS_I422TOARGBROW_NT_AVX2
+
+#if defined(HAS_I422TOAR30ROW_AVX2)
+// Read 16 Y scaled to 16 bits for YUVTORGB16_AVX2.
+#define READY16_AVX2                                                           \
+    "vmovdqu    " MEMACCESS([y_buf]) ",%%xmm4                   \n"            \
+    "lea        " MEMLEA(0x10, [y_buf]) ",%[y_buf]              \n"            \
+    "vpermq     $0xd8,%%ymm4,%%ymm4                             \n"            \
+    "vpunpcklbw %%ymm4,%%ymm4,%%ymm4                            \n"
+
+// Convert 16 pixels: 16 UV and 16 Y scaled to 16 bits in ymm4, to 16 bit B,
+// G and R with 6 bits of fraction.
+#define YUVTORGB16_AVX2(YuvConstants)                                          \
+    "vpmaddubsw  " MEMACCESS2(64, [YuvConstants]) ",%%ymm0,%%ymm2   \n"        \
+    "vpmaddubsw  " MEMACCESS2(32, [YuvConstants]) ",%%ymm0,%%ymm1   \n"        \
+    "vpmaddubsw  " MEMACCESS([YuvConstants]) ",%%ymm0,%%ymm0        \n"        \
+    "vmovdqu     " MEMACCESS2(160, [YuvConstants]) ",%%ymm3         \n"        \
+    "vpsubw      %%ymm2,%%ymm3,%%ymm2                               \n"        \
+    "vmovdqu     " MEMACCESS2(128, [YuvConstants]) ",%%ymm3         \n"        \
+    "vpsubw      %%ymm1,%%ymm3,%%ymm1                               \n"        \
+    "vmovdqu     " MEMACCESS2(96, [YuvConstants]) ",%%ymm3          \n"        \
+    "vpsubw      %%ymm0,%%ymm3,%%ymm0                               \n"        \
+    "vpmulhuw    " MEMACCESS2(192, [YuvConstants]) ",%%ymm4,%%ymm4  \n"        \
+    "vpaddsw     %%ymm4,%%ymm0,%%ymm0                               \n"        \
+    "vpaddsw     %%ymm4,%%ymm1,%%ymm1                               \n"        \
+    "vpaddsw     %%ymm4,%%ymm2,%%ymm2                               \n"
+
+// Store 16 AR30 values.  Assumes YMM5 is zero, YMM6 is 1023 and YMM7 is
+// kMulBGToAR30.
+#define STOREAR30_AVX2                                                         \
+    "vpsraw     $0x4,%%ymm0,%%ymm0                              \n"            \
+    "vpsraw     $0x4,%%ymm1,%%ymm1                              \n"            \
+    "vpsraw     $0x4,%%ymm2,%%ymm2                              \n"            \
+    "vpminsw    %%ymm6,%%ymm0,%%ymm0                            \n"            \
+    "vpminsw    %%ymm6,%%ymm1,%%ymm1                            \n"            \
+    "vpminsw    %%ymm6,%%ymm2,%%ymm2                            \n"            \
+    "vpmaxsw    %%ymm5,%%ymm0,%%ymm0                            \n"            \
+    "vpmaxsw    %%ymm5,%%ymm1,%%ymm1                            \n"            \
+    "vpmaxsw    %%ymm5,%%ymm2,%%ymm2                            \n"            \
+    "vpunpckhwd %%ymm1,%%ymm0,%%ymm3                            \n"            \
+    "vpunpcklwd %%ymm1,%%ymm0,%%ymm0                            \n"            \
+    "vpmaddwd   %%ymm7,%%ymm0,%%ymm0                            \n"            \
+    "vpmaddwd   %%ymm7,%%ymm3,%%ymm3                            \n"            \
+    "vpsllw     $0x4,%%ymm2,%%ymm2                              \n"            \
+    "vpcmpeqb   %%ymm1,%%ymm1,%%ymm1                            \n"            \
+    "vpsllw     $0xe,%%ymm1,%%ymm1                              \n"            \
+    "vpor       %%ymm1,%%ymm2,%%ymm2                            \n"            \
+    "vpunpckhwd %%ymm2,%%ymm5,%%ymm4                            \n"            \
+    "vpunpcklwd %%ymm2,%%ymm5,%%ymm1                            \n"            \
+    "vpor       %%ymm1,%%ymm0,%%ymm0                            \n"            \
+    "vpor       %%ymm4,%%ymm3,%%ymm3                            \n"            \
+    "vperm2i128 $0x20,%%ymm3,%%ymm0,%%ymm1                      \n"            \
+    "vperm2i128 $0x31,%%ymm3,%%ymm0,%%ymm0                      \n"            \
+    "vmovdqu    %%ymm1," MEMACCESS([dst_ar30]) "                \n"            \
+    "vmovdqu    %%ymm0," MEMACCESS2(0x20, [dst_ar30]) "         \n"            \
+    "lea        " MEMLEA(0x40, [dst_ar30]) ", %[dst_ar30]       \n"
+
+// 16 pixels
+// 8 UV values upsampled to 16 UV, mixed with 16 Y producing 16 AR30 (64 bytes).
+void OMITFP I422ToAR30Row_AVX2(const uint8* y_buf,
+                               const uint8* u_buf,
+                               const uint8* v_buf,
+                               uint8* dst_ar30,
+                               int width) {
+  asm volatile (
+    "sub       %[u_buf],%[v_buf]               \n"
+    "vpxor     %%ymm5,%%ymm5,%%ymm5            \n"
+    "vpcmpeqb  %%ymm6,%%ymm6,%%ymm6            \n"
+    "vpsrlw    $0x6,%%ymm6,%%ymm6              \n"
+    "vbroadcastf128 %[kMulBGToAR30],%%ymm7     \n"
+    LABELALIGN
+  "1:                                          \n"
+    READYUV422_AVX2
+    READY16_AVX2
+    YUVTORGB16_AVX2(kYuvConstants)
+    STOREAR30_AVX2
+    "subl      $0x10,%[width]                  \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [u_buf]"+r"(u_buf),    // %[u_buf]
+    [v_buf]"+r"(v_buf),    // %[v_buf]
+    [dst_ar30]"+r"(dst_ar30),  // %[dst_ar30]
+#if defined(__i386__) && defined(__pic__)
+    [width]"+m"(width)     // %[width]
+#else
+    [width]"+rm"(width)    // %[width]
+#endif
+  : [kYuvConstants]"r"(&kYuvConstants.kUVToB),  // %[kYuvConstants]
+    [kMulBGToAR30]"m"(kMulBGToAR30)
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_I422TOAR30ROW_AVX2
+
+#if defined(HAS_I422TOARGBROW_AVX512BW) || defined(HAS_NV12TOARGBROW_AVX512BW)
+// vpermi2q to interleave the lanes of vpunpcklwd and vpunpckhwd.
+static const uint64 kPermqARGB0_AVX512[8] = { 0, 1, 8, 9, 2, 3, 10, 11 };
+static const uint64 kPermqARGB1_AVX512[8] = { 4, 5, 12, 13, 6, 7, 14, 15 };
+
+// Read 16 UV from 422, upsample to 32 UV.
+#define READYUV422_AVX512BW                                                    \
+    "vpmovzxbw   " MEMACCESS([u_buf]) ",%%ymm0                      \n"        \
+    MEMOPREG(vpmovzxbw, 0x00, [u_buf], [v_buf], 1, ymm1)                       \
+    "lea        " MEMLEA(0x10, [u_buf]) ",%[u_buf]                  \n"        \
+    "vpsllw     $0x8,%%ymm1,%%ymm1                                  \n"        \
+    "vpor       %%ymm1,%%ymm0,%%ymm0                                \n"        \
+    "vpmovzxwd  %%ymm0,%%zmm0                                       \n"        \
+    "vpslld     $0x10,%%zmm0,%%zmm1                                 \n"        \
+    "vpord      %%zmm1,%%zmm0,%%zmm0                                \n"
+
+// Read 16 UV from NV12, upsample to 32 UV.
+#define READNV12_AVX512BW                                                      \
+    "vpmovzxwd   " MEMACCESS([uv_buf]) ",%%zmm0                     \n"        \
+    "lea        " MEMLEA(0x20, [uv_buf]) ",%[uv_buf]                \n"        \
+    "vpslld     $0x10,%%zmm0,%%zmm1                                 \n"        \
+    "vpord      %%zmm1,%%zmm0,%%zmm0                                \n"
+
+// Convert 32 pixels: 32 UV and 32 Y.
+// Constants are broadcast from the 256 bit AVX2 table.
+#define YUVTORGB_AVX512BW(YuvConstants)                                        \
+    "vbroadcasti64x4 " MEMACCESS2(64, [YuvConstants]) ",%%zmm4      \n"        \
+    "vpmaddubsw  %%zmm4,%%zmm0,%%zmm2                               \n"        \
+    "vbroadcasti64x4 " MEMACCESS2(32, [YuvConstants]) ",%%zmm4      \n"        \
+    "vpmaddubsw  %%zmm4,%%zmm0,%%zmm1                               \n"        \
+    "vbroadcasti64x4 " MEMACCESS([YuvConstants]) ",%%zmm4           \n"        \
+    "vpmaddubsw  %%zmm4,%%zmm0,%%zmm0                               \n"        \
+    "vbroadcasti64x4 " MEMACCESS2(160, [YuvConstants]) ",%%zmm4     \n"        \
+    "vpsubw      %%zmm2,%%zmm4,%%zmm2                               \n"        \
+    "vbroadcasti64x4 " MEMACCESS2(128, [YuvConstants]) ",%%zmm4     \n"        \
+    "vpsubw      %%zmm1,%%zmm4,%%zmm1                               \n"        \
+    "vbroadcasti64x4 " MEMACCESS2(96, [YuvConstants]) ",%%zmm4      \n"        \
+    "vpsubw      %%zmm0,%%zmm4,%%zmm0                               \n"        \
+    "vpmovzxbw   " MEMACCESS([y_buf]) ",%%zmm3                      \n"        \
+    "lea         " MEMLEA(0x20, [y_buf]) ",%[y_buf]                 \n"        \
+    "vpsllw      $0x8,%%zmm3,%%zmm4                                 \n"        \
+    "vporq       %%zmm4,%%zmm3,%%zmm3                               \n"        \
+    "vbroadcasti64x4 " MEMACCESS2(192, [YuvConstants]) ",%%zmm4     \n"        \
+    "vpmulhuw    %%zmm4,%%zmm3,%%zmm3                               \n"        \
+    "vpaddsw     %%zmm3,%%zmm0,%%zmm0           \n"                            \
+    "vpaddsw     %%zmm3,%%zmm1,%%zmm1           \n"                            \
+    "vpaddsw     %%zmm3,%%zmm2,%%zmm2           \n"                            \
+    "vpsraw      $0x6,%%zmm0,%%zmm0             \n"                            \
+    "vpsraw      $0x6,%%zmm1,%%zmm1             \n"                            \
+    "vpsraw      $0x6,%%zmm2,%%zmm2             \n"                            \
+    "vpackuswb   %%zmm0,%%zmm0,%%zmm0           \n"                            \
+    "vpackuswb   %%zmm1,%%zmm1,%%zmm1           \n"                            \
+    "vpackuswb   %%zmm2,%%zmm2,%%zmm2           \n"
+
+// Store 32 ARGB values.
+#define STOREARGB_AVX512BW                                                     \
+    "vpunpcklbw %%zmm1,%%zmm0,%%zmm0           \n"                             \
+    "vpunpcklbw %%zmm5,%%zmm2,%%zmm2           \n"                             \
+    "vpunpckhwd %%zmm2,%%zmm0,%%zmm1           \n"                             \
+    "vpunpcklwd %%zmm2,%%zmm0,%%zmm0           \n"                             \
+    "vmovdqu64  %[kPermqARGB0],%%zmm3          \n"                             \
+    "vpermi2q   %%zmm1,%%zmm0,%%zmm3           \n"                             \
+    "vmovdqu64  %[kPermqARGB1],%%zmm4          \n"                             \
+    "vpermi2q   %%zmm1,%%zmm0,%%zmm4           \n"                             \
+    "vmovdqu64  %%zmm3," MEMACCESS([dst_argb]) "\n"                            \
+    "vmovdqu64  %%zmm4," MEMACCESS2(0x40,[dst_argb]) "\n"                      \
+    "lea       " MEMLEA(0x80,[dst_argb]) ",%[dst_argb] \n"
+#endif
+
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+// 32 pixels
+// 16 UV values upsampled to 32 UV, mixed with 32 Y producing 32 ARGB (128 bytes).
+void OMITFP I422ToARGBRow_AVX512BW(const uint8* y_buf,
+                                   const uint8* u_buf,
+                                   const uint8* v_buf,
+                                   uint8* dst_argb,
+                                   int width) {
+  asm volatile (
+    "sub       %[u_buf],%[v_buf]               \n"
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+    LABELALIGN
+  "1:                                          \n"
+    READYUV422_AVX512BW
+    YUVTORGB_AVX512BW(kYuvConstants)
+    STOREARGB_AVX512BW
+    "sub       $0x20,%[width]                  \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [u_buf]"+r"(u_buf),    // %[u_buf]
+    [v_buf]"+r"(v_buf),    // %[v_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [kYuvConstants]"r"(&kYuvConstants.kUVToB),  // %[kYuvConstants]
+    [kPermqARGB0]"m"(kPermqARGB0_AVX512),  // %[kPermqARGB0]
+    [kPermqARGB1]"m"(kPermqARGB1_AVX512)   // %[kPermqARGB1]
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  );
+}
+#endif  // HAS_I422TOARGBROW_AVX512BW
+
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+// 32 pixels
+// 16 UV values upsampled to 32 UV, mixed with 32 Y producing 32 ARGB (128 bytes).
+void OMITFP NV12ToARGBRow_AVX512BW(const uint8* y_buf,
+                                   const uint8* uv_buf,
+                                   uint8* dst_argb,
+                                   int width) {
+  asm volatile (
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+    LABELALIGN
+  "1:                                          \n"
+    READNV12_AVX512BW
+    YUVTORGB_AVX512BW(kYuvConstants)
+    STOREARGB_AVX512BW
+    "sub       $0x20,%[width]                  \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [uv_buf]"+r"(uv_buf),    // %[uv_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [kYuvConstants]"r"(&kYuvConstants.kUVToB),  // %[kYuvConstants]
+    [kPermqARGB0]"m"(kPermqARGB0_AVX512),  // %[kPermqARGB0]
+    [kPermqARGB1]"m"(kPermqARGB1_AVX512)   // %[kPermqARGB1]
+  : "memory", "cc",
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  );
+}
+#endif  // HAS_NV12TOARGBROW_AVX512BW
+
 #if defined(HAS_J422TOARGBROW_AVX2)
 // 16 pixels
 // 8 UV values upsampled to 16 UV, mixed with 16 Y producing 16 ARGB (64 bytes).
@@ -2588,27 +3515,462 @@ void MergeUVRow_SSE2(const uint8* src_u, const uint8* src_v, uint8* dst_uv,
 }
 #endif  // HAS_MERGEUVROW_SSE2
 
-#ifdef HAS_COPYROW_SSE2
-void CopyRow_SSE2(const uint8* src, uint8* dst, int count) {
+#ifdef HAS_SPLITRGBROW_SSSE3
+// Shuffle tables for gathering R, G and B from 3 registers of 16 RGB pixels.
+static uvec8 kShuffleRGBToR0 = {
+  0u, 3u, 6u, 9u, 12u, 15u, 128u, 128u,
+  128u, 128u, 128u, 128u, 128u, 128u, 128u, 128u
+};
+
+static uvec8 kShuffleRGBToR1 = {
+  128u, 128u, 128u, 128u, 128u, 128u, 2u, 5u,
+  8u, 11u, 14u, 128u, 128u, 128u, 128u, 128u
+};
+
+static uvec8 kShuffleRGBToR2 = {
+  128u, 128u, 128u, 128u, 128u, 128u, 128u, 128u,
+  128u, 128u, 128u, 1u, 4u, 7u, 10u, 13u
+};
+
+static uvec8 kShuffleRGBToG0 = {
+  1u, 4u, 7u, 10u, 13u, 128u, 128u, 128u,
+  128u, 128u, 128u, 128u, 128u, 128u, 128u, 128u
+};
+
+static uvec8 kShuffleRGBToG1 = {
+  128u, 128u, 128u, 128u, 128u, 0u, 3u, 6u,
+  9u, 12u, 15u, 128u, 128u, 128u, 128u, 128u
+};
+
+static uvec8 kShuffleRGBToG2 = {
+  128u, 128u, 128u, 128u, 128u, 128u, 128u, 128u,
+  128u, 128u, 128u, 2u, 5u, 8u, 11u, 14u
+};
+
+static uvec8 kShuffleRGBToB0 = {
+  2u, 5u, 8u, 11u, 14u, 128u, 128u, 128u,
+  128u, 128u, 128u, 128u, 128u, 128u, 128u, 128u
+};
+
+static uvec8 kShuffleRGBToB1 = {
+  128u, 128u, 128u, 128u, 128u, 1u, 4u, 7u,
+  10u, 13u, 128u, 128u, 128u, 128u, 128u, 128u
+};
+
+static uvec8 kShuffleRGBToB2 = {
+  128u, 128u, 128u, 128u, 128u, 128u, 128u, 128u,
+  128u, 128u, 0u, 3u, 6u, 9u, 12u, 15u
+};
+
+void SplitRGBRow_SSSE3(const uint8* src_rgb, uint8* dst_r, uint8* dst_g,
+                       uint8* dst_b, int width) {
   asm volatile (
+    "sub       %1,%2                           \n"
+    "sub       %1,%3                           \n"
     LABELALIGN
   "1:                                          \n"
     "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
     "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
-    "lea       " MEMLEA(0x20,0) ",%0           \n"
-    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
-    "movdqu    %%xmm1," MEMACCESS2(0x10,1) "   \n"
-    "lea       " MEMLEA(0x20,1) ",%1           \n"
-    "sub       $0x20,%2                        \n"
-    "jg        1b                              \n"
-  : "+r"(src),   // %0
-    "+r"(dst),   // %1
-    "+r"(count)  // %2
-  :
-  : "memory", "cc"
-    , "xmm0", "xmm1"
-  );
-}
+    "movdqu    " MEMACCESS2(0x20,0) ",%%xmm2   \n"
+    "lea       " MEMLEA(0x30,0) ",%0           \n"
+    "movdqa    %%xmm0,%%xmm3                   \n"
+    "pshufb    %5,%%xmm3                       \n"
+    "movdqa    %%xmm1,%%xmm4                   \n"
+    "pshufb    %6,%%xmm4                       \n"
+    "por       %%xmm4,%%xmm3                   \n"
+    "movdqa    %%xmm2,%%xmm4                   \n"
+    "pshufb    %7,%%xmm4                       \n"
+    "por       %%xmm4,%%xmm3                   \n"  // R
+    "movdqu    %%xmm3," MEMACCESS(1) "         \n"
+    "movdqa    %%xmm0,%%xmm3                   \n"
+    "pshufb    %8,%%xmm3                       \n"
+    "movdqa    %%xmm1,%%xmm4                   \n"
+    "pshufb    %9,%%xmm4                       \n"
+    "por       %%xmm4,%%xmm3                   \n"
+    "movdqa    %%xmm2,%%xmm4                   \n"
+    "pshufb    %10,%%xmm4                      \n"
+    "por       %%xmm4,%%xmm3                   \n"  // G
+    MEMOPMEM(movdqu,xmm3,0x00,1,2,1)           //  movdqu  %%xmm3,(%1,%2)
+    "pshufb    %11,%%xmm0                      \n"
+    "pshufb    %12,%%xmm1                      \n"
+    "pshufb    %13,%%xmm2                      \n"
+    "por       %%xmm1,%%xmm0                   \n"
+    "por       %%xmm2,%%xmm0                   \n"  // B
+    MEMOPMEM(movdqu,xmm0,0x00,1,3,1)           //  movdqu  %%xmm0,(%1,%3)
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "subl      $0x10,%4                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_rgb),  // %0
+    "+r"(dst_r),    // %1
+    "+r"(dst_g),    // %2
+    "+r"(dst_b),    // %3
+#if defined(__i386__) && defined(__pic__)
+    "+m"(width)     // %4
+#else
+    "+rm"(width)    // %4
+#endif
+  : "m"(kShuffleRGBToR0),  // %5
+    "m"(kShuffleRGBToR1),  // %6
+    "m"(kShuffleRGBToR2),  // %7
+    "m"(kShuffleRGBToG0),  // %8
+    "m"(kShuffleRGBToG1),  // %9
+    "m"(kShuffleRGBToG2),  // %10
+    "m"(kShuffleRGBToB0),  // %11
+    "m"(kShuffleRGBToB1),  // %12
+    "m"(kShuffleRGBToB2)   // %13
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4"
+  );
+}
+#endif  // HAS_SPLITRGBROW_SSSE3
+
+#ifdef HAS_MERGERGBROW_SSSE3
+// Shuffle tables for spreading R, G and B over 3 registers of 16 RGB pixels.
+static uvec8 kShuffleRToRGB0 = {
+  0u, 128u, 128u, 1u, 128u, 128u, 2u, 128u,
+  128u, 3u, 128u, 128u, 4u, 128u, 128u, 5u
+};
+
+static uvec8 kShuffleGToRGB0 = {
+  128u, 0u, 128u, 128u, 1u, 128u, 128u, 2u,
+  128u, 128u, 3u, 128u, 128u, 4u, 128u, 128u
+};
+
+static uvec8 kShuffleBToRGB0 = {
+  128u, 128u, 0u, 128u, 128u, 1u, 128u, 128u,
+  2u, 128u, 128u, 3u, 128u, 128u, 4u, 128u
+};
+
+static uvec8 kShuffleRToRGB1 = {
+  128u, 128u, 6u, 128u, 128u, 7u, 128u, 128u,
+  8u, 128u, 128u, 9u, 128u, 128u, 10u, 128u
+};
+
+static uvec8 kShuffleGToRGB1 = {
+  5u, 128u, 128u, 6u, 128u, 128u, 7u, 128u,
+  128u, 8u, 128u, 128u, 9u, 128u, 128u, 10u
+};
+
+static uvec8 kShuffleBToRGB1 = {
+  128u, 5u, 128u, 128u, 6u, 128u, 128u, 7u,
+  128u, 128u, 8u, 128u, 128u, 9u, 128u, 128u
+};
+
+static uvec8 kShuffleRToRGB2 = {
+  128u, 11u, 128u, 128u, 12u, 128u, 128u, 13u,
+  128u, 128u, 14u, 128u, 128u, 15u, 128u, 128u
+};
+
+static uvec8 kShuffleGToRGB2 = {
+  128u, 128u, 11u, 128u, 128u, 12u, 128u, 128u,
+  13u, 128u, 128u, 14u, 128u, 128u, 15u, 128u
+};
+
+static uvec8 kShuffleBToRGB2 = {
+  10u, 128u, 128u, 11u, 128u, 128u, 12u, 128u,
+  128u, 13u, 128u, 128u, 14u, 128u, 128u, 15u
+};
+
+void MergeRGBRow_SSSE3(const uint8* src_r, const uint8* src_g,
+                       const uint8* src_b, uint8* dst_rgb, int width) {
+  asm volatile (
+    "sub       %0,%1                           \n"
+    "sub       %0,%2                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"  // R
+    MEMOPREG(movdqu,0x00,0,1,1,xmm1)           //  movdqu  (%0,%1),%%xmm1
+    MEMOPREG(movdqu,0x00,0,2,1,xmm2)           //  movdqu  (%0,%2),%%xmm2
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "movdqa    %%xmm0,%%xmm3                   \n"
+    "pshufb    %5,%%xmm3                       \n"
+    "movdqa    %%xmm1,%%xmm4                   \n"
+    "pshufb    %6,%%xmm4                       \n"
+    "por       %%xmm4,%%xmm3                   \n"
+    "movdqa    %%xmm2,%%xmm4                   \n"
+    "pshufb    %7,%%xmm4                       \n"
+    "por       %%xmm4,%%xmm3                   \n"
+    "movdqu    %%xmm3," MEMACCESS(3) "         \n"
+    "movdqa    %%xmm0,%%xmm3                   \n"
+    "pshufb    %8,%%xmm3                       \n"
+    "movdqa    %%xmm1,%%xmm4                   \n"
+    "pshufb    %9,%%xmm4                       \n"
+    "por       %%xmm4,%%xmm3                   \n"
+    "movdqa    %%xmm2,%%xmm4                   \n"
+    "pshufb    %10,%%xmm4                      \n"
+    "por       %%xmm4,%%xmm3                   \n"
+    "movdqu    %%xmm3," MEMACCESS2(0x10,3) "   \n"
+    "pshufb    %11,%%xmm0                      \n"
+    "pshufb    %12,%%xmm1                      \n"
+    "pshufb    %13,%%xmm2                      \n"
+    "por       %%xmm1,%%xmm0                   \n"
+    "por       %%xmm2,%%xmm0                   \n"
+    "movdqu    %%xmm0," MEMACCESS2(0x20,3) "   \n"
+    "lea       " MEMLEA(0x30,3) ",%3           \n"
+    "subl      $0x10,%4                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_r),    // %0
+    "+r"(src_g),    // %1
+    "+r"(src_b),    // %2
+    "+r"(dst_rgb),  // %3
+#if defined(__i386__) && defined(__pic__)
+    "+m"(width)     // %4
+#else
+    "+rm"(width)    // %4
+#endif
+  : "m"(kShuffleRToRGB0),  // %5
+    "m"(kShuffleGToRGB0),  // %6
+    "m"(kShuffleBToRGB0),  // %7
+    "m"(kShuffleRToRGB1),  // %8
+    "m"(kShuffleGToRGB1),  // %9
+    "m"(kShuffleBToRGB1),  // %10
+    "m"(kShuffleRToRGB2),  // %11
+    "m"(kShuffleGToRGB2),  // %12
+    "m"(kShuffleBToRGB2)   // %13
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4"
+  );
+}
+#endif  // HAS_MERGERGBROW_SSSE3
+
+#if defined(HAS_SPLITXRGBROW_SSSE3) || defined(HAS_SPLITXRGBROW_AVX2)
+// Shuffle table for grouping 4 ARGB pixels as 4 R, 4 G, 4 B and 4 A.
+static uvec8 kShuffleXRGBToPlanar = {
+  2u, 6u, 10u, 14u, 1u, 5u, 9u, 13u,
+  0u, 4u, 8u, 12u, 3u, 7u, 11u, 15u
+};
+#endif
+
+#ifdef HAS_SPLITXRGBROW_SSSE3
+// 16 ARGB pixels to 16 each of R, G and B.  Alpha is dropped.
+void SplitXRGBRow_SSSE3(const uint8* src_argb, uint8* dst_r, uint8* dst_g,
+                        uint8* dst_b, int width) {
+  asm volatile (
+    "movdqa    %5,%%xmm4                       \n"
+    "sub       %1,%2                           \n"
+    "sub       %1,%3                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    "movdqu    " MEMACCESS2(0x20,0) ",%%xmm2   \n"
+    "movdqu    " MEMACCESS2(0x30,0) ",%%xmm3   \n"
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "pshufb    %%xmm4,%%xmm0                   \n"
+    "pshufb    %%xmm4,%%xmm1                   \n"
+    "pshufb    %%xmm4,%%xmm2                   \n"
+    "pshufb    %%xmm4,%%xmm3                   \n"
+    "movdqa    %%xmm0,%%xmm5                   \n"
+    "punpckldq %%xmm1,%%xmm0                   \n"  // RRGG
+    "punpckhdq %%xmm1,%%xmm5                   \n"  // BBAA
+    "movdqa    %%xmm2,%%xmm6                   \n"
+    "punpckldq %%xmm3,%%xmm2                   \n"
+    "punpckhdq %%xmm3,%%xmm6                   \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "punpcklqdq %%xmm2,%%xmm0                  \n"  // R
+    "punpckhqdq %%xmm2,%%xmm1                  \n"  // G
+    "punpcklqdq %%xmm6,%%xmm5                  \n"  // B
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    MEMOPMEM(movdqu,xmm1,0x00,1,2,1)           //  movdqu  %%xmm1,(%1,%2)
+    MEMOPMEM(movdqu,xmm5,0x00,1,3,1)           //  movdqu  %%xmm5,(%1,%3)
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "subl      $0x10,%4                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_argb),  // %0
+    "+r"(dst_r),     // %1
+    "+r"(dst_g),     // %2
+    "+r"(dst_b),     // %3
+#if defined(__i386__) && defined(__pic__)
+    "+m"(width)      // %4
+#else
+    "+rm"(width)     // %4
+#endif
+  : "m"(kShuffleXRGBToPlanar)  // %5
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6"
+  );
+}
+#endif  // HAS_SPLITXRGBROW_SSSE3
+
+#ifdef HAS_SPLITXRGBROW_AVX2
+// vpermd order that undoes the in lane transpose.
+static const lvec32 kPermdXRGBToPlanar = {
+  0, 4, 1, 5, 2, 6, 3, 7
+};
+
+// 32 ARGB pixels to 32 each of R, G and B.  Alpha is dropped.
+void SplitXRGBRow_AVX2(const uint8* src_argb, uint8* dst_r, uint8* dst_g,
+                       uint8* dst_b, int width) {
+  asm volatile (
+    "vbroadcastf128 %5,%%ymm4                  \n"
+    "vmovdqu   %6,%%ymm7                       \n"
+    "sub       %1,%2                           \n"
+    "sub       %1,%3                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vmovdqu   " MEMACCESS2(0x20,0) ",%%ymm1   \n"
+    "vmovdqu   " MEMACCESS2(0x40,0) ",%%ymm2   \n"
+    "vmovdqu   " MEMACCESS2(0x60,0) ",%%ymm3   \n"
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "vpshufb   %%ymm4,%%ymm0,%%ymm0            \n"
+    "vpshufb   %%ymm4,%%ymm1,%%ymm1            \n"
+    "vpshufb   %%ymm4,%%ymm2,%%ymm2            \n"
+    "vpshufb   %%ymm4,%%ymm3,%%ymm3            \n"
+    "vpunpckhdq %%ymm1,%%ymm0,%%ymm5           \n"  // BBAA
+    "vpunpckldq %%ymm1,%%ymm0,%%ymm0           \n"  // RRGG
+    "vpunpckhdq %%ymm3,%%ymm2,%%ymm6           \n"
+    "vpunpckldq %%ymm3,%%ymm2,%%ymm2           \n"
+    "vpunpckhqdq %%ymm2,%%ymm0,%%ymm1          \n"  // G
+    "vpunpcklqdq %%ymm2,%%ymm0,%%ymm0          \n"  // R
+    "vpunpcklqdq %%ymm6,%%ymm5,%%ymm5          \n"  // B
+    "vpermd    %%ymm0,%%ymm7,%%ymm0            \n"
+    "vpermd    %%ymm1,%%ymm7,%%ymm1            \n"
+    "vpermd    %%ymm5,%%ymm7,%%ymm5            \n"
+    "vmovdqu   %%ymm0," MEMACCESS(1) "         \n"
+    MEMOPMEM(vmovdqu,ymm1,0x00,1,2,1)          //  vmovdqu %%ymm1,(%1,%2)
+    MEMOPMEM(vmovdqu,ymm5,0x00,1,3,1)          //  vmovdqu %%ymm5,(%1,%3)
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "subl      $0x20,%4                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_argb),  // %0
+    "+r"(dst_r),     // %1
+    "+r"(dst_g),     // %2
+    "+r"(dst_b),     // %3
+#if defined(__i386__) && defined(__pic__)
+    "+m"(width)      // %4
+#else
+    "+rm"(width)     // %4
+#endif
+  : "m"(kShuffleXRGBToPlanar),  // %5
+    "m"(kPermdXRGBToPlanar)     // %6
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_SPLITXRGBROW_AVX2
+
+#ifdef HAS_MERGEXRGBROW_SSE2
+// 16 each of R, G and B to 16 ARGB pixels with alpha of 255.
+void MergeXRGBRow_SSE2(const uint8* src_r, const uint8* src_g,
+                       const uint8* src_b, uint8* dst_argb, int width) {
+  asm volatile (
+    "pcmpeqb   %%xmm7,%%xmm7                   \n"
+    "sub       %0,%1                           \n"
+    "sub       %0,%2                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm2         \n"  // R
+    MEMOPREG(movdqu,0x00,0,1,1,xmm1)           //  movdqu  (%0,%1),%%xmm1
+    MEMOPREG(movdqu,0x00,0,2,1,xmm0)           //  movdqu  (%0,%2),%%xmm0
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "movdqa    %%xmm0,%%xmm3                   \n"
+    "punpcklbw %%xmm1,%%xmm0                   \n"  // BG
+    "punpckhbw %%xmm1,%%xmm3                   \n"
+    "movdqa    %%xmm2,%%xmm4                   \n"
+    "punpcklbw %%xmm7,%%xmm2                   \n"  // RA
+    "punpckhbw %%xmm7,%%xmm4                   \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "punpcklwd %%xmm2,%%xmm0                   \n"  // BGRA
+    "punpckhwd %%xmm2,%%xmm1                   \n"
+    "movdqa    %%xmm3,%%xmm5                   \n"
+    "punpcklwd %%xmm4,%%xmm3                   \n"
+    "punpckhwd %%xmm4,%%xmm5                   \n"
+    "movdqu    %%xmm0," MEMACCESS(3) "         \n"
+    "movdqu    %%xmm1," MEMACCESS2(0x10,3) "   \n"
+    "movdqu    %%xmm3," MEMACCESS2(0x20,3) "   \n"
+    "movdqu    %%xmm5," MEMACCESS2(0x30,3) "   \n"
+    "lea       " MEMLEA(0x40,3) ",%3           \n"
+    "subl      $0x10,%4                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_r),     // %0
+    "+r"(src_g),     // %1
+    "+r"(src_b),     // %2
+    "+r"(dst_argb),  // %3
+#if defined(__i386__) && defined(__pic__)
+    "+m"(width)      // %4
+#else
+    "+rm"(width)     // %4
+#endif
+  :
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm7"
+  );
+}
+#endif  // HAS_MERGEXRGBROW_SSE2
+
+#ifdef HAS_MERGEXRGBROW_AVX2
+// 32 each of R, G and B to 32 ARGB pixels with alpha of 255.
+void MergeXRGBRow_AVX2(const uint8* src_r, const uint8* src_g,
+                       const uint8* src_b, uint8* dst_argb, int width) {
+  asm volatile (
+    "vpcmpeqb  %%ymm7,%%ymm7,%%ymm7            \n"
+    "sub       %0,%1                           \n"
+    "sub       %0,%2                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm2         \n"  // R
+    MEMOPREG(vmovdqu,0x00,0,1,1,ymm1)          //  vmovdqu (%0,%1),%%ymm1
+    MEMOPREG(vmovdqu,0x00,0,2,1,ymm0)          //  vmovdqu (%0,%2),%%ymm0
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "vpunpcklbw %%ymm1,%%ymm0,%%ymm3           \n"  // BG
+    "vpunpckhbw %%ymm1,%%ymm0,%%ymm0           \n"
+    "vpunpcklbw %%ymm7,%%ymm2,%%ymm1           \n"  // RA
+    "vpunpckhbw %%ymm7,%%ymm2,%%ymm2           \n"
+    "vpunpcklwd %%ymm1,%%ymm3,%%ymm4           \n"  // BGRA 0-3 16-19
+    "vpunpckhwd %%ymm1,%%ymm3,%%ymm3           \n"  // 4-7 20-23
+    "vpunpcklwd %%ymm2,%%ymm0,%%ymm1           \n"  // 8-11 24-27
+    "vpunpckhwd %%ymm2,%%ymm0,%%ymm0           \n"  // 12-15 28-31
+    "vperm2i128 $0x20,%%ymm3,%%ymm4,%%ymm2     \n"  // 0-7
+    "vperm2i128 $0x31,%%ymm3,%%ymm4,%%ymm4     \n"  // 16-23
+    "vperm2i128 $0x20,%%ymm0,%%ymm1,%%ymm3     \n"  // 8-15
+    "vperm2i128 $0x31,%%ymm0,%%ymm1,%%ymm1     \n"  // 24-31
+    "vmovdqu   %%ymm2," MEMACCESS(3) "         \n"
+    "vmovdqu   %%ymm3," MEMACCESS2(0x20,3) "   \n"
+    "vmovdqu   %%ymm4," MEMACCESS2(0x40,3) "   \n"
+    "vmovdqu   %%ymm1," MEMACCESS2(0x60,3) "   \n"
+    "lea       " MEMLEA(0x80,3) ",%3           \n"
+    "subl      $0x20,%4                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_r),     // %0
+    "+r"(src_g),     // %1
+    "+r"(src_b),     // %2
+    "+r"(dst_argb),  // %3
+#if defined(__i386__) && defined(__pic__)
+    "+m"(width)      // %4
+#else
+    "+rm"(width)     // %4
+#endif
+  :
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm7"
+  );
+}
+#endif  // HAS_MERGEXRGBROW_AVX2
+
+#ifdef HAS_COPYROW_SSE2
+void CopyRow_SSE2(const uint8* src, uint8* dst, int count) {
+  asm volatile (
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    "movdqu    %%xmm1," MEMACCESS2(0x10,1) "   \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x20,%2                        \n"
+    "jg        1b                              \n"
+  : "+r"(src),   // %0
+    "+r"(dst),   // %1
+    "+r"(count)  // %2
+  :
+  : "memory", "cc"
+    , "xmm0", "xmm1"
+  );
+}
 #endif  // HAS_COPYROW_SSE2
 
 #ifdef HAS_COPYROW_AVX
@@ -2649,6 +4011,68 @@ void CopyRow_ERMS(const uint8* src, uint8* dst, int width) {
 }
 #endif  // HAS_COPYROW_ERMS
 
+#ifdef HAS_COPYROW_NT_SSE2
+// Multiple of 32.  dst must be 16 byte aligned.
+void CopyRow_NT_SSE2(const uint8* src, uint8* dst, int count) {
+  asm volatile (
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "movntdq   %%xmm0," MEMACCESS(1) "         \n"
+    "movntdq   %%xmm1," MEMACCESS2(0x10,1) "   \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x20,%2                        \n"
+    "jg        1b                              \n"
+  : "+r"(src),   // %0
+    "+r"(dst),   // %1
+    "+r"(count)  // %2
+  :
+  : "memory", "cc"
+    , "xmm0", "xmm1"
+  );
+}
+#endif  // HAS_COPYROW_NT_SSE2
+
+#ifdef HAS_COPYROW_NT_AVX
+// Multiple of 64.  dst must be 32 byte aligned.
+void CopyRow_NT_AVX(const uint8* src, uint8* dst, int count) {
+  asm volatile (
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vmovdqu   " MEMACCESS2(0x20,0) ",%%ymm1   \n"
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "vmovntdq  %%ymm0," MEMACCESS(1) "         \n"
+    "vmovntdq  %%ymm1," MEMACCESS2(0x20,1) "   \n"
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "sub       $0x40,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src),   // %0
+    "+r"(dst),   // %1
+    "+r"(count)  // %2
+  :
+  : "memory", "cc"
+    , "xmm0", "xmm1"
+  );
+}
+#endif  // HAS_COPYROW_NT_AVX
+
+#ifdef HAS_STOREFENCE_SSE2
+// Orders non-temporal stores before the stores that follow, ie a flag that
+// tells another thread the frame is ready.
+void StoreFence_SSE2(void) {
+  asm volatile (
+    "sfence                                    \n"
+  :
+  :
+  : "memory"
+  );
+}
+#endif  // HAS_STOREFENCE_SSE2
+
 #ifdef HAS_ARGBCOPYALPHAROW_SSE2
 // width in pixels
 void ARGBCopyAlphaRow_SSE2(const uint8* src, uint8* dst, int width) {
@@ -3108,113 +4532,334 @@ void YUY2ToUV422Row_AVX2(const uint8* src_yuy2,
     "+r"(dst_u),       // %1
     "+r"(dst_v),       // %2
     "+r"(pix)          // %3
-  :
+  :
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm5"
+  );
+}
+
+void UYVYToYRow_AVX2(const uint8* src_uyvy, uint8* dst_y, int pix) {
+  asm volatile (
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vmovdqu   " MEMACCESS2(0x20,0) ",%%ymm1   \n"
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "vpsrlw    $0x8,%%ymm0,%%ymm0              \n"
+    "vpsrlw    $0x8,%%ymm1,%%ymm1              \n"
+    "vpackuswb %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vmovdqu   %%ymm0," MEMACCESS(1) "         \n"
+    "lea      " MEMLEA(0x20,1) ",%1            \n"
+    "sub       $0x20,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_uyvy),  // %0
+    "+r"(dst_y),     // %1
+    "+r"(pix)        // %2
+  :
+  : "memory", "cc"
+    , "xmm0", "xmm1", "xmm5"
+  );
+}
+void UYVYToUVRow_AVX2(const uint8* src_uyvy, int stride_uyvy,
+                      uint8* dst_u, uint8* dst_v, int pix) {
+  asm volatile (
+    "vpcmpeqb  %%ymm5,%%ymm5,%%ymm5            \n"
+    "vpsrlw    $0x8,%%ymm5,%%ymm5              \n"
+    "sub       %1,%2                           \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vmovdqu   " MEMACCESS2(0x20,0) ",%%ymm1   \n"
+    VMEMOPREG(vpavgb,0x00,0,4,1,ymm0,ymm0)     // vpavgb (%0,%4,1),%%ymm0,%%ymm0
+    VMEMOPREG(vpavgb,0x20,0,4,1,ymm1,ymm1)
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "vpand     %%ymm5,%%ymm0,%%ymm0            \n"
+    "vpand     %%ymm5,%%ymm1,%%ymm1            \n"
+    "vpackuswb %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vpand     %%ymm5,%%ymm0,%%ymm1            \n"
+    "vpsrlw    $0x8,%%ymm0,%%ymm0              \n"
+    "vpackuswb %%ymm1,%%ymm1,%%ymm1            \n"
+    "vpackuswb %%ymm0,%%ymm0,%%ymm0            \n"
+    "vpermq    $0xd8,%%ymm1,%%ymm1             \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vextractf128 $0x0,%%ymm1," MEMACCESS(1) " \n"
+    VEXTOPMEM(vextractf128,0,ymm0,0x00,1,2,1) // vextractf128 $0x0,%%ymm0,(%1,%2,1)
+    "lea      " MEMLEA(0x10,1) ",%1            \n"
+    "sub       $0x20,%3                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_uyvy),    // %0
+    "+r"(dst_u),       // %1
+    "+r"(dst_v),       // %2
+    "+r"(pix)          // %3
+  : "r"((intptr_t)(stride_uyvy))  // %4
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm5"
+  );
+}
+
+void UYVYToUV422Row_AVX2(const uint8* src_uyvy,
+                         uint8* dst_u, uint8* dst_v, int pix) {
+  asm volatile (
+    "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
+    "vpsrlw     $0x8,%%ymm5,%%ymm5             \n"
+    "sub       %1,%2                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vmovdqu   " MEMACCESS2(0x20,0) ",%%ymm1   \n"
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "vpand     %%ymm5,%%ymm0,%%ymm0            \n"
+    "vpand     %%ymm5,%%ymm1,%%ymm1            \n"
+    "vpackuswb %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vpand     %%ymm5,%%ymm0,%%ymm1            \n"
+    "vpsrlw    $0x8,%%ymm0,%%ymm0              \n"
+    "vpackuswb %%ymm1,%%ymm1,%%ymm1            \n"
+    "vpackuswb %%ymm0,%%ymm0,%%ymm0            \n"
+    "vpermq    $0xd8,%%ymm1,%%ymm1             \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vextractf128 $0x0,%%ymm1," MEMACCESS(1) " \n"
+    VEXTOPMEM(vextractf128,0,ymm0,0x00,1,2,1) // vextractf128 $0x0,%%ymm0,(%1,%2,1)
+    "lea      " MEMLEA(0x10,1) ",%1            \n"
+    "sub       $0x20,%3                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_uyvy),    // %0
+    "+r"(dst_u),       // %1
+    "+r"(dst_v),       // %2
+    "+r"(pix)          // %3
+  :
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm5"
+  );
+}
+#endif  // HAS_YUY2TOYROW_AVX2
+
+#if defined(HAS_YUY2TOYROW_AVX512BW) || defined(HAS_UYVYTOYROW_AVX512BW)
+// vpermq for vpackuswb.
+static const uint64 kPermqPack_AVX512[8] = { 0, 2, 4, 6, 1, 3, 5, 7 };
+#endif
+
+#ifdef HAS_YUY2TOYROW_AVX512BW
+void YUY2ToYRow_AVX512BW(const uint8* src_yuy2, uint8* dst_y, int pix) {
+  asm volatile (
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+    "vpsrlw    $0x8,%%zmm5,%%zmm5              \n"
+    "vmovdqu64 %3,%%zmm4                       \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu8  " MEMACCESS(0) ",%%zmm0         \n"
+    "vmovdqu8  " MEMACCESS2(0x40,0) ",%%zmm1   \n"
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "vpandq    %%zmm5,%%zmm0,%%zmm0            \n"
+    "vpandq    %%zmm5,%%zmm1,%%zmm1            \n"
+    "vpackuswb %%zmm1,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vmovdqu8  %%zmm0," MEMACCESS(1) "         \n"
+    "lea      " MEMLEA(0x40,1) ",%1            \n"
+    "sub       $0x40,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_yuy2),  // %0
+    "+r"(dst_y),     // %1
+    "+r"(pix)        // %2
+  : "m"(kPermqPack_AVX512)  // %3
+  : "memory", "cc"
+    , "xmm0", "xmm1", "xmm4", "xmm5"
+  );
+}
+
+void YUY2ToUVRow_AVX512BW(const uint8* src_yuy2, int stride_yuy2,
+                          uint8* dst_u, uint8* dst_v, int pix) {
+  asm volatile (
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+    "vpsrlw    $0x8,%%zmm5,%%zmm5              \n"
+    "vmovdqu64 %5,%%zmm4                       \n"
+    "sub       %1,%2                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu8  " MEMACCESS(0) ",%%zmm0         \n"
+    "vmovdqu8  " MEMACCESS2(0x40,0) ",%%zmm1   \n"
+    VMEMOPREG(vpavgb,0x00,0,4,1,zmm0,zmm0)     // vpavgb (%0,%4,1),%%zmm0,%%zmm0
+    VMEMOPREG(vpavgb,0x40,0,4,1,zmm1,zmm1)
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "vpsrlw    $0x8,%%zmm0,%%zmm0              \n"
+    "vpsrlw    $0x8,%%zmm1,%%zmm1              \n"
+    "vpackuswb %%zmm1,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vpandq    %%zmm5,%%zmm0,%%zmm1            \n"
+    "vpsrlw    $0x8,%%zmm0,%%zmm0              \n"
+    "vpackuswb %%zmm1,%%zmm1,%%zmm1            \n"
+    "vpackuswb %%zmm0,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm1,%%zmm4,%%zmm1            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vmovdqu   %%ymm1," MEMACCESS(1) "         \n"
+    MEMOPMEM(vmovdqu,ymm0,0x00,1,2,1)          //  vmovdqu %%ymm0,(%1,%2)
+    "lea      " MEMLEA(0x20,1) ",%1            \n"
+    "sub       $0x40,%3                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_yuy2),    // %0
+    "+r"(dst_u),       // %1
+    "+r"(dst_v),       // %2
+    "+r"(pix)          // %3
+  : "r"((intptr_t)(stride_yuy2)),  // %4
+    "m"(kPermqPack_AVX512)  // %5
   : "memory", "cc", NACL_R14
-    "xmm0", "xmm1", "xmm5"
+    "xmm0", "xmm1", "xmm4", "xmm5"
   );
 }
 
-void UYVYToYRow_AVX2(const uint8* src_uyvy, uint8* dst_y, int pix) {
+void YUY2ToUV422Row_AVX512BW(const uint8* src_yuy2,
+                             uint8* dst_u, uint8* dst_v, int pix) {
   asm volatile (
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+    "vpsrlw    $0x8,%%zmm5,%%zmm5              \n"
+    "vmovdqu64 %4,%%zmm4                       \n"
+    "sub       %1,%2                           \n"
     LABELALIGN
   "1:                                          \n"
-    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
-    "vmovdqu   " MEMACCESS2(0x20,0) ",%%ymm1   \n"
-    "lea       " MEMLEA(0x40,0) ",%0           \n"
-    "vpsrlw    $0x8,%%ymm0,%%ymm0              \n"
-    "vpsrlw    $0x8,%%ymm1,%%ymm1              \n"
-    "vpackuswb %%ymm1,%%ymm0,%%ymm0            \n"
-    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
-    "vmovdqu   %%ymm0," MEMACCESS(1) "         \n"
+    "vmovdqu8  " MEMACCESS(0) ",%%zmm0         \n"
+    "vmovdqu8  " MEMACCESS2(0x40,0) ",%%zmm1   \n"
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "vpsrlw    $0x8,%%zmm0,%%zmm0              \n"
+    "vpsrlw    $0x8,%%zmm1,%%zmm1              \n"
+    "vpackuswb %%zmm1,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vpandq    %%zmm5,%%zmm0,%%zmm1            \n"
+    "vpsrlw    $0x8,%%zmm0,%%zmm0              \n"
+    "vpackuswb %%zmm1,%%zmm1,%%zmm1            \n"
+    "vpackuswb %%zmm0,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm1,%%zmm4,%%zmm1            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vmovdqu   %%ymm1," MEMACCESS(1) "         \n"
+    MEMOPMEM(vmovdqu,ymm0,0x00,1,2,1)          //  vmovdqu %%ymm0,(%1,%2)
     "lea      " MEMLEA(0x20,1) ",%1            \n"
-    "sub       $0x20,%2                        \n"
+    "sub       $0x40,%3                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_yuy2),    // %0
+    "+r"(dst_u),       // %1
+    "+r"(dst_v),       // %2
+    "+r"(pix)          // %3
+  : "m"(kPermqPack_AVX512)  // %4
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm4", "xmm5"
+  );
+}
+#endif  // HAS_YUY2TOYROW_AVX512BW
+
+#ifdef HAS_UYVYTOYROW_AVX512BW
+void UYVYToYRow_AVX512BW(const uint8* src_uyvy, uint8* dst_y, int pix) {
+  asm volatile (
+    "vmovdqu64 %3,%%zmm4                       \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu8  " MEMACCESS(0) ",%%zmm0         \n"
+    "vmovdqu8  " MEMACCESS2(0x40,0) ",%%zmm1   \n"
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "vpsrlw    $0x8,%%zmm0,%%zmm0              \n"
+    "vpsrlw    $0x8,%%zmm1,%%zmm1              \n"
+    "vpackuswb %%zmm1,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vmovdqu8  %%zmm0," MEMACCESS(1) "         \n"
+    "lea      " MEMLEA(0x40,1) ",%1            \n"
+    "sub       $0x40,%2                        \n"
     "jg        1b                              \n"
     "vzeroupper                                \n"
   : "+r"(src_uyvy),  // %0
     "+r"(dst_y),     // %1
     "+r"(pix)        // %2
-  :
+  : "m"(kPermqPack_AVX512)  // %3
   : "memory", "cc"
-    , "xmm0", "xmm1", "xmm5"
+    , "xmm0", "xmm1", "xmm4"
   );
 }
-void UYVYToUVRow_AVX2(const uint8* src_uyvy, int stride_uyvy,
-                      uint8* dst_u, uint8* dst_v, int pix) {
+
+void UYVYToUVRow_AVX512BW(const uint8* src_uyvy, int stride_uyvy,
+                          uint8* dst_u, uint8* dst_v, int pix) {
   asm volatile (
-    "vpcmpeqb  %%ymm5,%%ymm5,%%ymm5            \n"
-    "vpsrlw    $0x8,%%ymm5,%%ymm5              \n"
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+    "vpsrlw    $0x8,%%zmm5,%%zmm5              \n"
+    "vmovdqu64 %5,%%zmm4                       \n"
     "sub       %1,%2                           \n"
-
     LABELALIGN
   "1:                                          \n"
-    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
-    "vmovdqu   " MEMACCESS2(0x20,0) ",%%ymm1   \n"
-    VMEMOPREG(vpavgb,0x00,0,4,1,ymm0,ymm0)     // vpavgb (%0,%4,1),%%ymm0,%%ymm0
-    VMEMOPREG(vpavgb,0x20,0,4,1,ymm1,ymm1)
-    "lea       " MEMLEA(0x40,0) ",%0           \n"
-    "vpand     %%ymm5,%%ymm0,%%ymm0            \n"
-    "vpand     %%ymm5,%%ymm1,%%ymm1            \n"
-    "vpackuswb %%ymm1,%%ymm0,%%ymm0            \n"
-    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
-    "vpand     %%ymm5,%%ymm0,%%ymm1            \n"
-    "vpsrlw    $0x8,%%ymm0,%%ymm0              \n"
-    "vpackuswb %%ymm1,%%ymm1,%%ymm1            \n"
-    "vpackuswb %%ymm0,%%ymm0,%%ymm0            \n"
-    "vpermq    $0xd8,%%ymm1,%%ymm1             \n"
-    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
-    "vextractf128 $0x0,%%ymm1," MEMACCESS(1) " \n"
-    VEXTOPMEM(vextractf128,0,ymm0,0x00,1,2,1) // vextractf128 $0x0,%%ymm0,(%1,%2,1)
-    "lea      " MEMLEA(0x10,1) ",%1            \n"
-    "sub       $0x20,%3                        \n"
+    "vmovdqu8  " MEMACCESS(0) ",%%zmm0         \n"
+    "vmovdqu8  " MEMACCESS2(0x40,0) ",%%zmm1   \n"
+    VMEMOPREG(vpavgb,0x00,0,4,1,zmm0,zmm0)     // vpavgb (%0,%4,1),%%zmm0,%%zmm0
+    VMEMOPREG(vpavgb,0x40,0,4,1,zmm1,zmm1)
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "vpandq    %%zmm5,%%zmm0,%%zmm0            \n"
+    "vpandq    %%zmm5,%%zmm1,%%zmm1            \n"
+    "vpackuswb %%zmm1,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vpandq    %%zmm5,%%zmm0,%%zmm1            \n"
+    "vpsrlw    $0x8,%%zmm0,%%zmm0              \n"
+    "vpackuswb %%zmm1,%%zmm1,%%zmm1            \n"
+    "vpackuswb %%zmm0,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm1,%%zmm4,%%zmm1            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vmovdqu   %%ymm1," MEMACCESS(1) "         \n"
+    MEMOPMEM(vmovdqu,ymm0,0x00,1,2,1)          //  vmovdqu %%ymm0,(%1,%2)
+    "lea      " MEMLEA(0x20,1) ",%1            \n"
+    "sub       $0x40,%3                        \n"
     "jg        1b                              \n"
     "vzeroupper                                \n"
   : "+r"(src_uyvy),    // %0
     "+r"(dst_u),       // %1
     "+r"(dst_v),       // %2
     "+r"(pix)          // %3
-  : "r"((intptr_t)(stride_uyvy))  // %4
+  : "r"((intptr_t)(stride_uyvy)),  // %4
+    "m"(kPermqPack_AVX512)  // %5
   : "memory", "cc", NACL_R14
-    "xmm0", "xmm1", "xmm5"
+    "xmm0", "xmm1", "xmm4", "xmm5"
   );
 }
 
-void UYVYToUV422Row_AVX2(const uint8* src_uyvy,
-                         uint8* dst_u, uint8* dst_v, int pix) {
+void UYVYToUV422Row_AVX512BW(const uint8* src_uyvy,
+                             uint8* dst_u, uint8* dst_v, int pix) {
   asm volatile (
-    "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
-    "vpsrlw     $0x8,%%ymm5,%%ymm5             \n"
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+    "vpsrlw    $0x8,%%zmm5,%%zmm5              \n"
+    "vmovdqu64 %4,%%zmm4                       \n"
     "sub       %1,%2                           \n"
     LABELALIGN
   "1:                                          \n"
-    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
-    "vmovdqu   " MEMACCESS2(0x20,0) ",%%ymm1   \n"
-    "lea       " MEMLEA(0x40,0) ",%0           \n"
-    "vpand     %%ymm5,%%ymm0,%%ymm0            \n"
-    "vpand     %%ymm5,%%ymm1,%%ymm1            \n"
-    "vpackuswb %%ymm1,%%ymm0,%%ymm0            \n"
-    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
-    "vpand     %%ymm5,%%ymm0,%%ymm1            \n"
-    "vpsrlw    $0x8,%%ymm0,%%ymm0              \n"
-    "vpackuswb %%ymm1,%%ymm1,%%ymm1            \n"
-    "vpackuswb %%ymm0,%%ymm0,%%ymm0            \n"
-    "vpermq    $0xd8,%%ymm1,%%ymm1             \n"
-    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
-    "vextractf128 $0x0,%%ymm1," MEMACCESS(1) " \n"
-    VEXTOPMEM(vextractf128,0,ymm0,0x00,1,2,1) // vextractf128 $0x0,%%ymm0,(%1,%2,1)
-    "lea      " MEMLEA(0x10,1) ",%1            \n"
-    "sub       $0x20,%3                        \n"
+    "vmovdqu8  " MEMACCESS(0) ",%%zmm0         \n"
+    "vmovdqu8  " MEMACCESS2(0x40,0) ",%%zmm1   \n"
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "vpandq    %%zmm5,%%zmm0,%%zmm0            \n"
+    "vpandq    %%zmm5,%%zmm1,%%zmm1            \n"
+    "vpackuswb %%zmm1,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vpandq    %%zmm5,%%zmm0,%%zmm1            \n"
+    "vpsrlw    $0x8,%%zmm0,%%zmm0              \n"
+    "vpackuswb %%zmm1,%%zmm1,%%zmm1            \n"
+    "vpackuswb %%zmm0,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm1,%%zmm4,%%zmm1            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vmovdqu   %%ymm1," MEMACCESS(1) "         \n"
+    MEMOPMEM(vmovdqu,ymm0,0x00,1,2,1)          //  vmovdqu %%ymm0,(%1,%2)
+    "lea      " MEMLEA(0x20,1) ",%1            \n"
+    "sub       $0x40,%3                        \n"
     "jg        1b                              \n"
     "vzeroupper                                \n"
   : "+r"(src_uyvy),    // %0
     "+r"(dst_u),       // %1
     "+r"(dst_v),       // %2
     "+r"(pix)          // %3
-  :
+  : "m"(kPermqPack_AVX512)  // %4
   : "memory", "cc", NACL_R14
-    "xmm0", "xmm1", "xmm5"
+    "xmm0", "xmm1", "xmm4", "xmm5"
   );
 }
-#endif  // HAS_YUY2TOYROW_AVX2
+#endif  // HAS_UYVYTOYROW_AVX512BW
 
 #ifdef HAS_ARGBBLENDROW_SSE2
 // Blend 8 pixels at a time.
@@ -3465,6 +5110,98 @@ void ARGBBlendRow_SSSE3(const uint8* src_argb0, const uint8* src_argb1,
 }
 #endif  // HAS_ARGBBLENDROW_SSSE3
 
+#ifdef HAS_ARGBBLENDROW_AVX512BW
+// Shuffle table for isolating alpha, 4 copies of kShuffleAlpha.
+static const uint8 kShuffleAlpha_AVX512[64] = {
+  3u, 0x80, 3u, 0x80, 7u, 0x80, 7u, 0x80,
+  11u, 0x80, 11u, 0x80, 15u, 0x80, 15u, 0x80,
+  3u, 0x80, 3u, 0x80, 7u, 0x80, 7u, 0x80,
+  11u, 0x80, 11u, 0x80, 15u, 0x80, 15u, 0x80,
+  3u, 0x80, 3u, 0x80, 7u, 0x80, 7u, 0x80,
+  11u, 0x80, 11u, 0x80, 15u, 0x80, 15u, 0x80,
+  3u, 0x80, 3u, 0x80, 7u, 0x80, 7u, 0x80,
+  11u, 0x80, 11u, 0x80, 15u, 0x80, 15u, 0x80
+};
+
+// Blend 16 pixels at a time, then 1 pixel at a time for the remainder.
+// Same as SSSE3 without the loop to align the destination.
+void ARGBBlendRow_AVX512BW(const uint8* src_argb0, const uint8* src_argb1,
+                           uint8* dst_argb, int width) {
+  asm volatile (
+    "vpternlogd $0xff,%%zmm7,%%zmm7,%%zmm7     \n"
+    "vpsrlw     $0xf,%%zmm7,%%zmm7             \n"
+    "vpternlogd $0xff,%%zmm6,%%zmm6,%%zmm6     \n"
+    "vpsrlw     $0x8,%%zmm6,%%zmm6             \n"
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+    "vpsllw     $0x8,%%zmm5,%%zmm5             \n"
+    "vpternlogd $0xff,%%zmm4,%%zmm4,%%zmm4     \n"
+    "vpslld     $0x18,%%zmm4,%%zmm4            \n"
+    "sub       $0x10,%3                        \n"
+    "jl        49f                             \n"
+
+    // 16 pixel loop.
+    LABELALIGN
+  "40:                                         \n"
+    "vmovdqu64  " MEMACCESS(0) ",%%zmm0        \n"
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "vpxord     %%zmm4,%%zmm0,%%zmm3           \n"
+    "vpshufb    %4,%%zmm3,%%zmm3               \n"
+    "vmovdqu64  " MEMACCESS(1) ",%%zmm2        \n"
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "vpsrlw     $0x8,%%zmm2,%%zmm1             \n"
+    "vpandq     %%zmm6,%%zmm2,%%zmm2           \n"
+    "vpaddw     %%zmm7,%%zmm3,%%zmm3           \n"
+    "vpmullw    %%zmm3,%%zmm2,%%zmm2           \n"
+    "vpmullw    %%zmm3,%%zmm1,%%zmm1           \n"
+    "vporq      %%zmm4,%%zmm0,%%zmm0           \n"
+    "vpsrlw     $0x8,%%zmm2,%%zmm2             \n"
+    "vpaddusb   %%zmm2,%%zmm0,%%zmm0           \n"
+    "vpandq     %%zmm5,%%zmm1,%%zmm1           \n"
+    "vpaddusb   %%zmm1,%%zmm0,%%zmm0           \n"
+    "vmovdqu64  %%zmm0," MEMACCESS(2) "        \n"
+    "lea       " MEMLEA(0x40,2) ",%2           \n"
+    "sub       $0x10,%3                        \n"
+    "jge       40b                             \n"
+
+  "49:                                         \n"
+    "add       $0xf,%3                         \n"
+    "jl        99f                             \n"
+
+    // 1 pixel loop.
+  "91:                                         \n"
+    "vmovd      " MEMACCESS(0) ",%%xmm0        \n"
+    "lea       " MEMLEA(0x4,0) ",%0            \n"
+    "vpxor      %%xmm4,%%xmm0,%%xmm3           \n"
+    "vpshufb    %4,%%xmm3,%%xmm3               \n"
+    "vmovd      " MEMACCESS(1) ",%%xmm2        \n"
+    "lea       " MEMLEA(0x4,1) ",%1            \n"
+    "vpsrlw     $0x8,%%xmm2,%%xmm1             \n"
+    "vpand      %%xmm6,%%xmm2,%%xmm2           \n"
+    "vpaddw     %%xmm7,%%xmm3,%%xmm3           \n"
+    "vpmullw    %%xmm3,%%xmm2,%%xmm2           \n"
+    "vpmullw    %%xmm3,%%xmm1,%%xmm1           \n"
+    "vpor       %%xmm4,%%xmm0,%%xmm0           \n"
+    "vpsrlw     $0x8,%%xmm2,%%xmm2             \n"
+    "vpaddusb   %%xmm2,%%xmm0,%%xmm0           \n"
+    "vpand      %%xmm5,%%xmm1,%%xmm1           \n"
+    "vpaddusb   %%xmm1,%%xmm0,%%xmm0           \n"
+    "vmovd      %%xmm0," MEMACCESS(2) "        \n"
+    "lea       " MEMLEA(0x4,2) ",%2            \n"
+    "sub       $0x1,%3                         \n"
+    "jge       91b                             \n"
+  "99:                                         \n"
+    "vzeroupper                                \n"
+  : "+r"(src_argb0),    // %0
+    "+r"(src_argb1),    // %1
+    "+r"(dst_argb),     // %2
+    "+r"(width)         // %3
+  : "m"(kShuffleAlpha_AVX512)  // %4
+  : "memory", "cc"
+    , "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_ARGBBLENDROW_AVX512BW
+
 #ifdef HAS_ARGBATTENUATEROW_SSE2
 // Attenuate 4 pixels at a time.
 void ARGBAttenuateRow_SSE2(const uint8* src_argb, uint8* dst_argb, int width) {
@@ -4919,6 +6656,105 @@ void InterpolateRow_AVX2(uint8* dst_ptr, const uint8* src_ptr,
 }
 #endif  // HAS_INTERPOLATEROW_AVX2
 
+#ifdef HAS_INTERPOLATEROW_AVX512BW
+// Bilinear filter 64x2 -> 64x1
+void InterpolateRow_AVX512BW(uint8* dst_ptr, const uint8* src_ptr,
+                             ptrdiff_t src_stride, int dst_width,
+                             int source_y_fraction) {
+  asm volatile (
+    "shr       %3                              \n"
+    "cmp       $0x0,%3                         \n"
+    "je        100f                            \n"
+    "sub       %1,%0                           \n"
+    "cmp       $0x20,%3                        \n"
+    "je        75f                             \n"
+    "cmp       $0x40,%3                        \n"
+    "je        50f                             \n"
+    "cmp       $0x60,%3                        \n"
+    "je        25f                             \n"
+
+    "vmovd      %3,%%xmm0                      \n"
+    "neg        %3                             \n"
+    "add        $0x80,%3                       \n"
+    "vmovd      %3,%%xmm5                      \n"
+    "vpunpcklbw %%xmm0,%%xmm5,%%xmm5           \n"
+    "vpbroadcastw %%xmm5,%%zmm5                \n"
+
+    // General purpose row blend.
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu8   " MEMACCESS(1) ",%%zmm0        \n"
+    MEMOPREG(vmovdqu8,0x00,1,4,1,zmm2)
+    "vpunpckhbw %%zmm2,%%zmm0,%%zmm1           \n"
+    "vpunpcklbw %%zmm2,%%zmm0,%%zmm0           \n"
+    "vpmaddubsw %%zmm5,%%zmm0,%%zmm0           \n"
+    "vpmaddubsw %%zmm5,%%zmm1,%%zmm1           \n"
+    "vpsrlw     $0x7,%%zmm0,%%zmm0             \n"
+    "vpsrlw     $0x7,%%zmm1,%%zmm1             \n"
+    "vpackuswb  %%zmm1,%%zmm0,%%zmm0           \n"
+    MEMOPMEM(vmovdqu8,zmm0,0x00,1,0,1)
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "sub       $0x40,%2                        \n"
+    "jg        1b                              \n"
+    "jmp       99f                             \n"
+
+    // Blend 25 / 75.
+    LABELALIGN
+  "25:                                         \n"
+    "vmovdqu8   " MEMACCESS(1) ",%%zmm0        \n"
+    MEMOPREG(vmovdqu8,0x00,1,4,1,zmm1)
+    "vpavgb     %%zmm1,%%zmm0,%%zmm0           \n"
+    "vpavgb     %%zmm1,%%zmm0,%%zmm0           \n"
+    MEMOPMEM(vmovdqu8,zmm0,0x00,1,0,1)
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "sub       $0x40,%2                        \n"
+    "jg        25b                             \n"
+    "jmp       99f                             \n"
+
+    // Blend 50 / 50.
+    LABELALIGN
+  "50:                                         \n"
+    "vmovdqu8   " MEMACCESS(1) ",%%zmm0        \n"
+    VMEMOPREG(vpavgb,0x00,1,4,1,zmm0,zmm0)     // vpavgb (%1,%4,1),%%zmm0,%%zmm0
+    MEMOPMEM(vmovdqu8,zmm0,0x00,1,0,1)
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "sub       $0x40,%2                        \n"
+    "jg        50b                             \n"
+    "jmp       99f                             \n"
+
+    // Blend 75 / 25.
+    LABELALIGN
+  "75:                                         \n"
+    "vmovdqu8   " MEMACCESS(1) ",%%zmm1        \n"
+    MEMOPREG(vmovdqu8,0x00,1,4,1,zmm0)
+    "vpavgb     %%zmm1,%%zmm0,%%zmm0           \n"
+    "vpavgb     %%zmm1,%%zmm0,%%zmm0           \n"
+    MEMOPMEM(vmovdqu8,zmm0,0x00,1,0,1)
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "sub       $0x40,%2                        \n"
+    "jg        75b                             \n"
+    "jmp       99f                             \n"
+
+    // Blend 100 / 0 - Copy row unchanged.
+    LABELALIGN
+  "100:                                        \n"
+    "rep movsb " MEMMOVESTRING(1,0) "          \n"
+    "jmp       999f                            \n"
+
+  "99:                                         \n"
+    "vzeroupper                                \n"
+  "999:                                        \n"
+  : "+D"(dst_ptr),    // %0
+    "+S"(src_ptr),    // %1
+    "+c"(dst_width),  // %2
+    "+r"(source_y_fraction)  // %3
+  : "r"((intptr_t)(src_stride))  // %4
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm5"
+  );
+}
+#endif  // HAS_INTERPOLATEROW_AVX512BW
+
 #ifdef HAS_INTERPOLATEROW_SSE2
 // Bilinear filter 16x2 -> 16x1
 void InterpolateRow_SSE2(uint8* dst_ptr, const uint8* src_ptr,
@@ -5533,6 +7369,206 @@ void ARGBLumaColorTableRow_SSSE3(const uint8* src_argb, uint8* dst_argb,
 }
 #endif  // HAS_ARGBLUMACOLORTABLEROW_SSSE3
 
+#ifdef HAS_BAYERTOARGBROW_SSE2
+// Selects red/blue pixels for pattern bit 0.
+static uvec8 kBayerEvenMask = {
+  255u, 0u, 255u, 0u, 255u, 0u, 255u, 0u,
+  255u, 0u, 255u, 0u, 255u, 0u, 255u, 0u
+};
+static uvec8 kBayerOddMask = {
+  0u, 255u, 0u, 255u, 0u, 255u, 0u, 255u,
+  0u, 255u, 0u, 255u, 0u, 255u, 0u, 255u
+};
+// Swaps red and blue for pattern bit 1.
+static uvec8 kBayerNoSwap = {
+  0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u
+};
+static uvec8 kBayerSwap = {
+  255u, 255u, 255u, 255u, 255u, 255u, 255u, 255u,
+  255u, 255u, 255u, 255u, 255u, 255u, 255u, 255u
+};
+
+// Bilinear demosaic of 16 pixels.  All neighbour averages are computed for
+// every pixel, then selected with the red/blue mask: (a ^ b) & mask ^ b.
+void BayerToARGBRow_SSE2(const uint8* src_bayer0, const uint8* src_bayer1,
+                         const uint8* src_bayer2, uint8* dst_argb,
+                         int pattern, int width) {
+  asm volatile (
+    "movdqa    %5,%%xmm7                       \n"
+    "movdqa    %6,%%xmm6                       \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS2(-0x1,1) ",%%xmm1   \n"
+    "movdqu    " MEMACCESS2(0x1,1) ",%%xmm2    \n"
+    "pavgb     %%xmm2,%%xmm1                   \n"  // horizontal
+    "movdqu    " MEMACCESS(0) ",%%xmm2         \n"
+    "movdqu    " MEMACCESS(2) ",%%xmm3         \n"
+    "pavgb     %%xmm3,%%xmm2                   \n"  // vertical
+    "movdqu    " MEMACCESS2(-0x1,0) ",%%xmm3   \n"
+    "movdqu    " MEMACCESS2(0x1,0) ",%%xmm4    \n"
+    "pavgb     %%xmm4,%%xmm3                   \n"
+    "movdqu    " MEMACCESS2(-0x1,2) ",%%xmm4   \n"
+    "movdqu    " MEMACCESS2(0x1,2) ",%%xmm5    \n"
+    "pavgb     %%xmm5,%%xmm4                   \n"
+    "pavgb     %%xmm4,%%xmm3                   \n"  // diagonal
+    "movdqa    %%xmm1,%%xmm4                   \n"
+    "pavgb     %%xmm2,%%xmm4                   \n"  // cross
+    "movdqu    " MEMACCESS(1) ",%%xmm0         \n"  // center
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "lea       " MEMLEA(0x10,2) ",%2           \n"
+
+    "movdqa    %%xmm0,%%xmm5                   \n"  // color of center row
+    "pxor      %%xmm1,%%xmm5                   \n"
+    "pand      %%xmm7,%%xmm5                   \n"
+    "pxor      %%xmm1,%%xmm5                   \n"
+    "movdqa    %%xmm4,%%xmm1                   \n"  // green
+    "pxor      %%xmm0,%%xmm1                   \n"
+    "pand      %%xmm7,%%xmm1                   \n"
+    "pxor      %%xmm0,%%xmm1                   \n"
+    "movdqa    %%xmm3,%%xmm0                   \n"  // other color
+    "pxor      %%xmm2,%%xmm0                   \n"
+    "pand      %%xmm7,%%xmm0                   \n"
+    "pxor      %%xmm2,%%xmm0                   \n"
+    "movdqa    %%xmm0,%%xmm2                   \n"  // swap to B and R
+    "pxor      %%xmm5,%%xmm2                   \n"
+    "pand      %%xmm6,%%xmm2                   \n"
+    "pxor      %%xmm2,%%xmm5                   \n"  // B
+    "pxor      %%xmm2,%%xmm0                   \n"  // R
+
+    "movdqa    %%xmm5,%%xmm2                   \n"
+    "punpcklbw %%xmm1,%%xmm2                   \n"  // BG low
+    "punpckhbw %%xmm1,%%xmm5                   \n"  // BG high
+    "pcmpeqb   %%xmm4,%%xmm4                   \n"
+    "movdqa    %%xmm0,%%xmm3                   \n"
+    "punpcklbw %%xmm4,%%xmm3                   \n"  // RA low
+    "punpckhbw %%xmm4,%%xmm0                   \n"  // RA high
+    "movdqa    %%xmm2,%%xmm1                   \n"
+    "punpcklwd %%xmm3,%%xmm2                   \n"
+    "punpckhwd %%xmm3,%%xmm1                   \n"
+    "movdqa    %%xmm5,%%xmm3                   \n"
+    "punpcklwd %%xmm0,%%xmm5                   \n"
+    "punpckhwd %%xmm0,%%xmm3                   \n"
+    "movdqu    %%xmm2," MEMACCESS(3) "         \n"
+    "movdqu    %%xmm1," MEMACCESS2(0x10,3) "   \n"
+    "movdqu    %%xmm5," MEMACCESS2(0x20,3) "   \n"
+    "movdqu    %%xmm3," MEMACCESS2(0x30,3) "   \n"
+    "lea       " MEMLEA(0x40,3) ",%3           \n"
+    "sub       $0x10,%4                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_bayer0),  // %0
+    "+r"(src_bayer1),  // %1
+    "+r"(src_bayer2),  // %2
+    "+r"(dst_argb),    // %3
+    "+r"(width)        // %4
+  : "m"(*((pattern & 1) ? &kBayerOddMask : &kBayerEvenMask)),  // %5
+    "m"(*((pattern & 2) ? &kBayerSwap : &kBayerNoSwap))        // %6
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+    "xmm7"
+  );
+}
+#endif  // HAS_BAYERTOARGBROW_SSE2
+
+#ifdef HAS_SCANJPEGMARKERROW_SSE2
+static uvec8 kJpegRstMask = {
+  0xf8u, 0xf8u, 0xf8u, 0xf8u, 0xf8u, 0xf8u, 0xf8u, 0xf8u,
+  0xf8u, 0xf8u, 0xf8u, 0xf8u, 0xf8u, 0xf8u, 0xf8u, 0xf8u
+};
+static uvec8 kJpegRst = {
+  0xd0u, 0xd0u, 0xd0u, 0xd0u, 0xd0u, 0xd0u, 0xd0u, 0xd0u,
+  0xd0u, 0xd0u, 0xd0u, 0xd0u, 0xd0u, 0xd0u, 0xd0u, 0xd0u
+};
+
+// Compare each byte to 0xff and the following byte to stuffing, fill and
+// restart codes.  The loop exits on the first 16 byte block with a marker.
+int ScanJpegMarkerRow_SSE2(const uint8* src, int count) {
+  const uint8* src_start = src;
+  int mask;
+  asm volatile (
+    "pcmpeqb   %%xmm5,%%xmm5                   \n"
+    "pxor      %%xmm4,%%xmm4                   \n"
+    "movdqa    %3,%%xmm6                       \n"
+    "movdqa    %4,%%xmm7                       \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x1,0) ",%%xmm1    \n"
+    "pcmpeqb   %%xmm5,%%xmm0                   \n"  // 0xff
+    "movdqa    %%xmm1,%%xmm2                   \n"
+    "movdqa    %%xmm1,%%xmm3                   \n"
+    "pcmpeqb   %%xmm4,%%xmm2                   \n"  // stuffing 0x00
+    "pcmpeqb   %%xmm5,%%xmm3                   \n"  // fill 0xff
+    "pand      %%xmm6,%%xmm1                   \n"
+    "pcmpeqb   %%xmm7,%%xmm1                   \n"  // restart 0xd0-0xd7
+    "por       %%xmm3,%%xmm2                   \n"
+    "por       %%xmm1,%%xmm2                   \n"
+    "pandn     %%xmm0,%%xmm2                   \n"
+    "pmovmskb  %%xmm2,%2                       \n"
+    "test      %2,%2                           \n"
+    "jnz       2f                              \n"
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "sub       $0x10,%1                        \n"
+    "jg        1b                              \n"
+  "2:                                          \n"
+  : "+r"(src),    // %0
+    "+r"(count),  // %1
+    "=&r"(mask)   // %2
+  : "m"(kJpegRstMask),  // %3
+    "m"(kJpegRst)       // %4
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+    "xmm7"
+  );
+  if (mask) {
+    return (int)(src - src_start) + __builtin_ctz(mask);
+  }
+  return (int)(src - src_start);
+}
+#endif  // HAS_SCANJPEGMARKERROW_SSE2
+
+#ifdef HAS_SCANJPEGMARKERROW_AVX2
+int ScanJpegMarkerRow_AVX2(const uint8* src, int count) {
+  const uint8* src_start = src;
+  int mask;
+  asm volatile (
+    "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
+    "vpxor      %%ymm4,%%ymm4,%%ymm4           \n"
+    "vbroadcastf128 %3,%%ymm6                  \n"
+    "vbroadcastf128 %4,%%ymm7                  \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu    " MEMACCESS(0) ",%%ymm0        \n"
+    "vmovdqu    " MEMACCESS2(0x1,0) ",%%ymm1   \n"
+    "vpcmpeqb   %%ymm5,%%ymm0,%%ymm0           \n"  // 0xff
+    "vpcmpeqb   %%ymm4,%%ymm1,%%ymm2           \n"  // stuffing 0x00
+    "vpcmpeqb   %%ymm5,%%ymm1,%%ymm3           \n"  // fill 0xff
+    "vpand      %%ymm6,%%ymm1,%%ymm1           \n"
+    "vpcmpeqb   %%ymm7,%%ymm1,%%ymm1           \n"  // restart 0xd0-0xd7
+    "vpor       %%ymm3,%%ymm2,%%ymm2           \n"
+    "vpor       %%ymm1,%%ymm2,%%ymm2           \n"
+    "vpandn     %%ymm0,%%ymm2,%%ymm2           \n"
+    "vpmovmskb  %%ymm2,%2                      \n"
+    "test       %2,%2                          \n"
+    "jnz        2f                             \n"
+    "lea        " MEMLEA(0x20,0) ",%0          \n"
+    "sub        $0x20,%1                       \n"
+    "jg         1b                             \n"
+  "2:                                          \n"
+    "vzeroupper                                \n"
+  : "+r"(src),    // %0
+    "+r"(count),  // %1
+    "=&r"(mask)   // %2
+  : "m"(kJpegRstMask),  // %3
+    "m"(kJpegRst)       // %4
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+    "xmm7"
+  );
+  if (mask) {
+    return (int)(src - src_start) + __builtin_ctz(mask);
+  }
+  return (int)(src - src_start);
+}
+#endif  // HAS_SCANJPEGMARKERROW_AVX2
+
 #endif  // defined(__x86_64__) || defined(__i386__)
 
 #ifdef __cplusplus
@@ -797,6 +797,119 @@ void MergeUVRow_NEON(const uint8* src_u, const uint8* src_v, uint8* dst_uv,
   );
 }
 
+// Reads 16 packed RGB and writes out 16 each of R, G and B.
+void SplitRGBRow_NEON(const uint8* src_rgb, uint8* dst_r, uint8* dst_g,
+                      uint8* dst_b, int width) {
+  asm volatile (
+    ".p2align   2                              \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld3.8     {d0, d2, d4}, [%0]!            \n"  // load 8 RGB
+    MEMACCESS(0)
+    "vld3.8     {d1, d3, d5}, [%0]!            \n"  // next 8 RGB
+    "subs       %4, %4, #16                    \n"  // 16 processed per loop
+    MEMACCESS(1)
+    "vst1.8     {q0}, [%1]!                    \n"  // store R
+    MEMACCESS(2)
+    "vst1.8     {q1}, [%2]!                    \n"  // store G
+    MEMACCESS(3)
+    "vst1.8     {q2}, [%3]!                    \n"  // store B
+    "bgt        1b                             \n"
+    : "+r"(src_rgb),  // %0
+      "+r"(dst_r),    // %1
+      "+r"(dst_g),    // %2
+      "+r"(dst_b),    // %3
+      "+r"(width)     // %4
+    :                 // Input registers
+    : "cc", "memory", "q0", "q1", "q2"  // Clobber List
+  );
+}
+
+// Reads 16 each of R, G and B and writes out 16 packed RGB.
+void MergeRGBRow_NEON(const uint8* src_r, const uint8* src_g,
+                      const uint8* src_b, uint8* dst_rgb, int width) {
+  asm volatile (
+    ".p2align   2                              \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld1.8     {q0}, [%0]!                    \n"  // load R
+    MEMACCESS(1)
+    "vld1.8     {q1}, [%1]!                    \n"  // load G
+    MEMACCESS(2)
+    "vld1.8     {q2}, [%2]!                    \n"  // load B
+    "subs       %4, %4, #16                    \n"  // 16 processed per loop
+    MEMACCESS(3)
+    "vst3.8     {d0, d2, d4}, [%3]!            \n"  // store 8 RGB
+    MEMACCESS(3)
+    "vst3.8     {d1, d3, d5}, [%3]!            \n"  // next 8 RGB
+    "bgt        1b                             \n"
+    : "+r"(src_r),    // %0
+      "+r"(src_g),    // %1
+      "+r"(src_b),    // %2
+      "+r"(dst_rgb),  // %3
+      "+r"(width)     // %4
+    :                 // Input registers
+    : "cc", "memory", "q0", "q1", "q2"  // Clobber List
+  );
+}
+
+// Reads 16 ARGB and writes out 16 each of R, G and B.  Alpha is dropped.
+void SplitXRGBRow_NEON(const uint8* src_argb, uint8* dst_r, uint8* dst_g,
+                       uint8* dst_b, int width) {
+  asm volatile (
+    ".p2align   2                              \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld4.8     {d0, d2, d4, d6}, [%0]!        \n"  // load 8 ARGB
+    MEMACCESS(0)
+    "vld4.8     {d1, d3, d5, d7}, [%0]!        \n"  // next 8 ARGB
+    "subs       %4, %4, #16                    \n"  // 16 processed per loop
+    MEMACCESS(1)
+    "vst1.8     {q2}, [%1]!                    \n"  // store R
+    MEMACCESS(2)
+    "vst1.8     {q1}, [%2]!                    \n"  // store G
+    MEMACCESS(3)
+    "vst1.8     {q0}, [%3]!                    \n"  // store B
+    "bgt        1b                             \n"
+    : "+r"(src_argb),  // %0
+      "+r"(dst_r),     // %1
+      "+r"(dst_g),     // %2
+      "+r"(dst_b),     // %3
+      "+r"(width)      // %4
+    :                  // Input registers
+    : "cc", "memory", "q0", "q1", "q2", "q3"  // Clobber List
+  );
+}
+
+// Reads 16 each of R, G and B and writes out 16 ARGB with alpha of 255.
+void MergeXRGBRow_NEON(const uint8* src_r, const uint8* src_g,
+                       const uint8* src_b, uint8* dst_argb, int width) {
+  asm volatile (
+    "vmov.u8    q3, #255                       \n"  // alpha
+    ".p2align   2                              \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "vld1.8     {q2}, [%0]!                    \n"  // load R
+    MEMACCESS(1)
+    "vld1.8     {q1}, [%1]!                    \n"  // load G
+    MEMACCESS(2)
+    "vld1.8     {q0}, [%2]!                    \n"  // load B
+    "subs       %4, %4, #16                    \n"  // 16 processed per loop
+    MEMACCESS(3)
+    "vst4.8     {d0, d2, d4, d6}, [%3]!        \n"  // store 8 ARGB
+    MEMACCESS(3)
+    "vst4.8     {d1, d3, d5, d7}, [%3]!        \n"  // next 8 ARGB
+    "bgt        1b                             \n"
+    : "+r"(src_r),     // %0
+      "+r"(src_g),     // %1
+      "+r"(src_b),     // %2
+      "+r"(dst_argb),  // %3
+      "+r"(width)      // %4
+    :                  // Input registers
+    : "cc", "memory", "q0", "q1", "q2", "q3"  // Clobber List
+  );
+}
+
 // Copy multiple of 32.  vld4.8  allow unaligned and is fastest on a15.
 void CopyRow_NEON(const uint8* src, uint8* dst, int count) {
   asm volatile (
@@ -3076,6 +3189,119 @@ void SobelYRow_NEON(const uint8* src_y0, const uint8* src_y1,
   : "cc", "memory", "q0", "q1"  // Clobber List
   );
 }
+// Bilinear demosaic of 8 pixels.  All neighbour averages are computed for
+// every pixel, then selected with the red/blue mask.
+void BayerToARGBRow_NEON(const uint8* src_bayer0, const uint8* src_bayer1,
+                         const uint8* src_bayer2, uint8* dst_argb,
+                         int pattern, int width) {
+  const uint8* src_tmp;
+  asm volatile (
+    "vdup.16    d30, %6                        \n"  // red/blue mask
+    "vdup.8     d29, %7                        \n"  // swap red and blue
+    "vmov.u8    d31, #255                      \n"  // alpha
+  "1:                                          \n"
+    "sub        %5, %0, #1                     \n"
+    MEMACCESS(5)
+    "vld1.8     {d0}, [%5]                     \n"  // above left
+    "add        %5, %0, #1                     \n"
+    MEMACCESS(5)
+    "vld1.8     {d1}, [%5]                     \n"  // above right
+    MEMACCESS(0)
+    "vld1.8     {d2}, [%0]!                    \n"  // above
+    "sub        %5, %1, #1                     \n"
+    MEMACCESS(5)
+    "vld1.8     {d3}, [%5]                     \n"  // left
+    "add        %5, %1, #1                     \n"
+    MEMACCESS(5)
+    "vld1.8     {d4}, [%5]                     \n"  // right
+    MEMACCESS(1)
+    "vld1.8     {d5}, [%1]!                    \n"  // center
+    "sub        %5, %2, #1                     \n"
+    MEMACCESS(5)
+    "vld1.8     {d6}, [%5]                     \n"  // below left
+    "add        %5, %2, #1                     \n"
+    MEMACCESS(5)
+    "vld1.8     {d7}, [%5]                     \n"  // below right
+    MEMACCESS(2)
+    "vld1.8     {d16}, [%2]!                   \n"  // below
+    "vrhadd.u8  d3, d3, d4                     \n"  // horizontal
+    "vrhadd.u8  d2, d2, d16                    \n"  // vertical
+    "vrhadd.u8  d0, d0, d1                     \n"
+    "vrhadd.u8  d6, d6, d7                     \n"
+    "vrhadd.u8  d0, d0, d6                     \n"  // diagonal
+    "vrhadd.u8  d4, d3, d2                     \n"  // cross
+    "vmov       d20, d30                       \n"
+    "vbsl       d20, d5, d3                    \n"  // color of center row
+    "vmov       d25, d30                       \n"
+    "vbsl       d25, d4, d5                    \n"  // G
+    "vmov       d22, d30                       \n"
+    "vbsl       d22, d0, d2                    \n"  // other color
+    "vmov       d24, d29                       \n"
+    "vbsl       d24, d22, d20                  \n"  // B
+    "vmov       d26, d29                       \n"
+    "vbsl       d26, d20, d22                  \n"  // R
+    "vmov       d27, d31                       \n"  // A
+    "subs       %4, %4, #8                     \n"
+    MEMACCESS(3)
+    "vst4.8     {d24, d25, d26, d27}, [%3]!    \n"
+    "bgt        1b                             \n"
+  : "+r"(src_bayer0),  // %0
+    "+r"(src_bayer1),  // %1
+    "+r"(src_bayer2),  // %2
+    "+r"(dst_argb),    // %3
+    "+r"(width),       // %4
+    "=&r"(src_tmp)     // %5
+  : "r"((pattern & 1) ? 0xff00 : 0x00ff),  // %6
+    "r"((pattern & 2) ? 0xff : 0)          // %7
+  : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q10", "q11", "q12", "q13",
+    "q14", "q15"
+  );
+}
+
+// Find the first 16 byte block with a marker, then locate it in C.
+int ScanJpegMarkerRow_NEON(const uint8* src, int count) {
+  const uint8* src_start = src;
+  const uint8* src_next;
+  uint32 mask;
+  asm volatile (
+    "vmov.u8    q15, #0xff                     \n"
+    "vmov.u8    q14, #0xf8                     \n"
+    "vmov.u8    q13, #0xd0                     \n"
+  "1:                                          \n"
+    "add        %2, %0, #1                     \n"
+    MEMACCESS(0)
+    "vld1.8     {q0}, [%0]                     \n"
+    MEMACCESS(2)
+    "vld1.8     {q1}, [%2]                     \n"
+    "vceq.i8    q0, q0, q15                    \n"  // 0xff
+    "vceq.i8    q2, q1, #0                     \n"  // stuffing 0x00
+    "vceq.i8    q3, q1, q15                    \n"  // fill 0xff
+    "vand       q1, q1, q14                    \n"
+    "vceq.i8    q1, q1, q13                    \n"  // restart 0xd0-0xd7
+    "vorr       q2, q2, q3                     \n"
+    "vorr       q2, q2, q1                     \n"
+    "vbic       q0, q0, q2                     \n"
+    "vpmax.u8   d0, d0, d1                     \n"
+    "vpmax.u8   d0, d0, d0                     \n"
+    "vmov.32    %3, d0[0]                      \n"
+    "cmp        %3, #0                         \n"
+    "bne        2f                             \n"
+    "add        %0, %0, #16                    \n"
+    "subs       %1, %1, #16                    \n"
+    "bgt        1b                             \n"
+  "2:                                          \n"
+  : "+r"(src),        // %0
+    "+r"(count),      // %1
+    "=&r"(src_next),  // %2
+    "=&r"(mask)       // %3
+  :
+  : "cc", "memory", "q0", "q1", "q2", "q3", "q13", "q14", "q15"
+  );
+  if (mask) {
+    return (int)(src - src_start) + ScanJpegMarkerRow_C(src, 16);
+  }
+  return (int)(src - src_start);
+}
 #endif  // defined(__ARM_NEON__) && !defined(__aarch64__)
 
 #ifdef __cplusplus
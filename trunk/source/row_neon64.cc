@@ -772,6 +772,115 @@ void MergeUVRow_NEON(const uint8* src_u, const uint8* src_v, uint8* dst_uv,
 }
 #endif  // HAS_MERGEUVROW_NEON
 
+#ifdef HAS_SPLITRGBROW_NEON
+// Reads 16 packed RGB and writes out 16 each of R, G and B.
+void SplitRGBRow_NEON(const uint8* src_rgb, uint8* dst_r, uint8* dst_g,
+                      uint8* dst_b, int width) {
+  asm volatile (
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld3        {v0.16b,v1.16b,v2.16b}, [%0], #48 \n"  // load 16 RGB
+    "subs       %w4, %w4, #16                  \n"  // 16 processed per loop
+    MEMACCESS(1)
+    "st1        {v0.16b}, [%1], #16            \n"  // store R
+    MEMACCESS(2)
+    "st1        {v1.16b}, [%2], #16            \n"  // store G
+    MEMACCESS(3)
+    "st1        {v2.16b}, [%3], #16            \n"  // store B
+    "b.gt       1b                             \n"
+    : "+r"(src_rgb),  // %0
+      "+r"(dst_r),    // %1
+      "+r"(dst_g),    // %2
+      "+r"(dst_b),    // %3
+      "+r"(width)     // %4
+    :                 // Input registers
+    : "cc", "memory", "v0", "v1", "v2"  // Clobber List
+  );
+}
+#endif  // HAS_SPLITRGBROW_NEON
+
+#ifdef HAS_MERGERGBROW_NEON
+// Reads 16 each of R, G and B and writes out 16 packed RGB.
+void MergeRGBRow_NEON(const uint8* src_r, const uint8* src_g,
+                      const uint8* src_b, uint8* dst_rgb, int width) {
+  asm volatile (
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v0.16b}, [%0], #16            \n"  // load R
+    MEMACCESS(1)
+    "ld1        {v1.16b}, [%1], #16            \n"  // load G
+    MEMACCESS(2)
+    "ld1        {v2.16b}, [%2], #16            \n"  // load B
+    "subs       %w4, %w4, #16                  \n"  // 16 processed per loop
+    MEMACCESS(3)
+    "st3        {v0.16b,v1.16b,v2.16b}, [%3], #48 \n"  // store 16 RGB
+    "b.gt       1b                             \n"
+    : "+r"(src_r),    // %0
+      "+r"(src_g),    // %1
+      "+r"(src_b),    // %2
+      "+r"(dst_rgb),  // %3
+      "+r"(width)     // %4
+    :                 // Input registers
+    : "cc", "memory", "v0", "v1", "v2"  // Clobber List
+  );
+}
+#endif  // HAS_MERGERGBROW_NEON
+
+#ifdef HAS_SPLITXRGBROW_NEON
+// Reads 16 ARGB and writes out 16 each of R, G and B.  Alpha is dropped.
+void SplitXRGBRow_NEON(const uint8* src_argb, uint8* dst_r, uint8* dst_g,
+                       uint8* dst_b, int width) {
+  asm volatile (
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld4        {v0.16b,v1.16b,v2.16b,v3.16b}, [%0], #64 \n"  // load 16 ARGB
+    "subs       %w4, %w4, #16                  \n"  // 16 processed per loop
+    MEMACCESS(1)
+    "st1        {v2.16b}, [%1], #16            \n"  // store R
+    MEMACCESS(2)
+    "st1        {v1.16b}, [%2], #16            \n"  // store G
+    MEMACCESS(3)
+    "st1        {v0.16b}, [%3], #16            \n"  // store B
+    "b.gt       1b                             \n"
+    : "+r"(src_argb),  // %0
+      "+r"(dst_r),     // %1
+      "+r"(dst_g),     // %2
+      "+r"(dst_b),     // %3
+      "+r"(width)      // %4
+    :                  // Input registers
+    : "cc", "memory", "v0", "v1", "v2", "v3"  // Clobber List
+  );
+}
+#endif  // HAS_SPLITXRGBROW_NEON
+
+#ifdef HAS_MERGEXRGBROW_NEON
+// Reads 16 each of R, G and B and writes out 16 ARGB with alpha of 255.
+void MergeXRGBRow_NEON(const uint8* src_r, const uint8* src_g,
+                       const uint8* src_b, uint8* dst_argb, int width) {
+  asm volatile (
+    "movi       v3.16b, #255                   \n"  // alpha
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v2.16b}, [%0], #16            \n"  // load R
+    MEMACCESS(1)
+    "ld1        {v1.16b}, [%1], #16            \n"  // load G
+    MEMACCESS(2)
+    "ld1        {v0.16b}, [%2], #16            \n"  // load B
+    "subs       %w4, %w4, #16                  \n"  // 16 processed per loop
+    MEMACCESS(3)
+    "st4        {v0.16b,v1.16b,v2.16b,v3.16b}, [%3], #64 \n"  // store 16 ARGB
+    "b.gt       1b                             \n"
+    : "+r"(src_r),     // %0
+      "+r"(src_g),     // %1
+      "+r"(src_b),     // %2
+      "+r"(dst_argb),  // %3
+      "+r"(width)      // %4
+    :                  // Input registers
+    : "cc", "memory", "v0", "v1", "v2", "v3"  // Clobber List
+  );
+}
+#endif  // HAS_MERGEXRGBROW_NEON
+
 // Copy multiple of 32.  vld4.8  allow unaligned and is fastest on a15.
 #ifdef HAS_COPYROW_NEON
 void CopyRow_NEON(const uint8* src, uint8* dst, int count) {
@@ -792,6 +901,118 @@ void CopyRow_NEON(const uint8* src, uint8* dst, int count) {
 }
 #endif  // HAS_COPYROW_NEON
 
+#ifdef HAS_COPYROW_NT_NEON
+// Multiple of 32.  stnp hints that the stores will not be read again soon.
+void CopyRow_NT_NEON(const uint8* src, uint8* dst, int count) {
+  asm volatile (
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ldp        q0, q1, [%0], #32              \n"  // load 32
+    "subs       %w2, %w2, #32                  \n"  // 32 processed per loop
+    MEMACCESS(1)
+    "stnp       q0, q1, [%1]                   \n"  // store 32
+    "add        %1, %1, #32                    \n"
+    "b.gt       1b                             \n"
+  : "+r"(src),   // %0
+    "+r"(dst),   // %1
+    "+r"(count)  // %2  // Output registers
+  :                     // Input registers
+  : "cc", "memory", "v0", "v1"  // Clobber List
+  );
+}
+#endif  // HAS_COPYROW_NT_NEON
+
+#ifdef HAS_ARGBTOPLANARFLOATROW_NEON
+// 8 ARGB pixels to 8 floats each of R, G and B.
+void ARGBToPlanarFloatRow_NEON(const uint8* src_argb,
+                               float* dst_r, float* dst_g, float* dst_b,
+                               const float* scale_bias, int width) {
+  asm volatile (
+    "ldr        q16, [%5]                      \n"  // scales and R bias
+    "ldr        d17, [%5, #16]                 \n"  // G and B bias
+    "dup        v20.4s, v16.s[3]               \n"
+    "dup        v21.4s, v17.s[0]               \n"
+    "dup        v22.4s, v17.s[1]               \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld4        {v0.8b,v1.8b,v2.8b,v3.8b}, [%0], #32 \n"  // load 8 ARGB pixels.
+    "subs       %w4, %w4, #8                   \n"  // 8 processed per loop.
+    "uxtl       v2.8h, v2.8b                   \n"  // R
+    "uxtl       v1.8h, v1.8b                   \n"  // G
+    "uxtl       v0.8h, v0.8b                   \n"  // B
+    "uxtl       v4.4s, v2.4h                   \n"
+    "uxtl2      v5.4s, v2.8h                   \n"
+    "uxtl       v6.4s, v1.4h                   \n"
+    "uxtl2      v7.4s, v1.8h                   \n"
+    "uxtl       v2.4s, v0.4h                   \n"
+    "uxtl2      v3.4s, v0.8h                   \n"
+    "ucvtf      v4.4s, v4.4s                   \n"
+    "ucvtf      v5.4s, v5.4s                   \n"
+    "ucvtf      v6.4s, v6.4s                   \n"
+    "ucvtf      v7.4s, v7.4s                   \n"
+    "ucvtf      v2.4s, v2.4s                   \n"
+    "ucvtf      v3.4s, v3.4s                   \n"
+    "fmul       v4.4s, v4.4s, v16.s[0]         \n"
+    "fmul       v5.4s, v5.4s, v16.s[0]         \n"
+    "fmul       v6.4s, v6.4s, v16.s[1]         \n"
+    "fmul       v7.4s, v7.4s, v16.s[1]         \n"
+    "fmul       v2.4s, v2.4s, v16.s[2]         \n"
+    "fmul       v3.4s, v3.4s, v16.s[2]         \n"
+    "fadd       v4.4s, v4.4s, v20.4s           \n"
+    "fadd       v5.4s, v5.4s, v20.4s           \n"
+    "fadd       v6.4s, v6.4s, v21.4s           \n"
+    "fadd       v7.4s, v7.4s, v21.4s           \n"
+    "fadd       v2.4s, v2.4s, v22.4s           \n"
+    "fadd       v3.4s, v3.4s, v22.4s           \n"
+    MEMACCESS(1)
+    "st1        {v4.4s, v5.4s}, [%1], #32      \n"  // store 8 R.
+    MEMACCESS(2)
+    "st1        {v6.4s, v7.4s}, [%2], #32      \n"  // store 8 G.
+    MEMACCESS(3)
+    "st1        {v2.4s, v3.4s}, [%3], #32      \n"  // store 8 B.
+    "b.gt       1b                             \n"
+  : "+r"(src_argb),  // %0
+    "+r"(dst_r),     // %1
+    "+r"(dst_g),     // %2
+    "+r"(dst_b),     // %3
+    "+r"(width)      // %4
+  : "r"(scale_bias)  // %5
+  : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7",
+    "v16", "v17", "v20", "v21", "v22"
+  );
+}
+#endif  // HAS_ARGBTOPLANARFLOATROW_NEON
+
+#ifdef HAS_HALFFLOATROW_NEON
+// 8 floats to 8 half floats, rounded to nearest even.
+void HalfFloatRow_NEON(const float* src, uint16* dst, float scale, float bias,
+                       int width) {
+  float scale_bias[2] = { scale, bias };
+  asm volatile (
+    "ldr        d4, [%3]                       \n"  // scale and bias
+    "dup        v5.4s, v4.s[1]                 \n"
+  "1:                                          \n"
+    MEMACCESS(0)
+    "ld1        {v0.4s, v1.4s}, [%0], #32      \n"  // load 8 floats.
+    "subs       %w2, %w2, #8                   \n"  // 8 processed per loop.
+    "fmul       v0.4s, v0.4s, v4.s[0]          \n"
+    "fmul       v1.4s, v1.4s, v4.s[0]          \n"
+    "fadd       v0.4s, v0.4s, v5.4s            \n"
+    "fadd       v1.4s, v1.4s, v5.4s            \n"
+    "fcvtn      v0.4h, v0.4s                   \n"
+    "fcvtn2     v0.8h, v1.4s                   \n"
+    MEMACCESS(1)
+    "st1        {v0.8h}, [%1], #16             \n"  // store 8 half floats.
+    "b.gt       1b                             \n"
+  : "+r"(src),        // %0
+    "+r"(dst),        // %1
+    "+r"(width)       // %2
+  : "r"(scale_bias)   // %3
+  : "cc", "memory", "v0", "v1", "v4", "v5"
+  );
+}
+#endif  // HAS_HALFFLOATROW_NEON
+
 // SetRow writes 'count' bytes using an 8 bit value repeated.
 void SetRow_NEON(uint8* dst, uint8 v8, int count) {
   asm volatile (
@@ -3079,6 +3300,122 @@ void SobelYRow_NEON(const uint8* src_y0, const uint8* src_y1,
   );
 }
 #endif  // HAS_SOBELYROW_NEON
+
+#ifdef HAS_BAYERTOARGBROW_NEON
+// Bilinear demosaic of 16 pixels.  All neighbour averages are computed for
+// every pixel, then selected with the red/blue mask.
+void BayerToARGBRow_NEON(const uint8* src_bayer0, const uint8* src_bayer1,
+                         const uint8* src_bayer2, uint8* dst_argb,
+                         int pattern, int width) {
+  const uint8* src_tmp;
+  asm volatile (
+    "dup        v30.8h, %w6                    \n"  // red/blue mask
+    "dup        v29.16b, %w7                   \n"  // swap red and blue
+    "movi       v31.16b, #255                  \n"  // alpha
+  "1:                                          \n"
+    "sub        %5, %0, #1                     \n"
+    MEMACCESS(5)
+    "ld1        {v0.16b}, [%5]                 \n"  // above left
+    "add        %5, %0, #1                     \n"
+    MEMACCESS(5)
+    "ld1        {v1.16b}, [%5]                 \n"  // above right
+    MEMACCESS(0)
+    "ld1        {v2.16b}, [%0], #16            \n"  // above
+    "sub        %5, %1, #1                     \n"
+    MEMACCESS(5)
+    "ld1        {v3.16b}, [%5]                 \n"  // left
+    "add        %5, %1, #1                     \n"
+    MEMACCESS(5)
+    "ld1        {v4.16b}, [%5]                 \n"  // right
+    MEMACCESS(1)
+    "ld1        {v5.16b}, [%1], #16            \n"  // center
+    "sub        %5, %2, #1                     \n"
+    MEMACCESS(5)
+    "ld1        {v6.16b}, [%5]                 \n"  // below left
+    "add        %5, %2, #1                     \n"
+    MEMACCESS(5)
+    "ld1        {v7.16b}, [%5]                 \n"  // below right
+    MEMACCESS(2)
+    "ld1        {v16.16b}, [%2], #16           \n"  // below
+    "urhadd     v3.16b, v3.16b, v4.16b         \n"  // horizontal
+    "urhadd     v2.16b, v2.16b, v16.16b        \n"  // vertical
+    "urhadd     v0.16b, v0.16b, v1.16b         \n"
+    "urhadd     v6.16b, v6.16b, v7.16b         \n"
+    "urhadd     v0.16b, v0.16b, v6.16b         \n"  // diagonal
+    "urhadd     v4.16b, v3.16b, v2.16b         \n"  // cross
+    "mov        v20.16b, v30.16b               \n"
+    "bsl        v20.16b, v5.16b, v3.16b        \n"  // color of center row
+    "mov        v25.16b, v30.16b               \n"
+    "bsl        v25.16b, v4.16b, v5.16b        \n"  // G
+    "mov        v22.16b, v30.16b               \n"
+    "bsl        v22.16b, v0.16b, v2.16b        \n"  // other color
+    "mov        v24.16b, v29.16b               \n"
+    "bsl        v24.16b, v22.16b, v20.16b      \n"  // B
+    "mov        v26.16b, v29.16b               \n"
+    "bsl        v26.16b, v20.16b, v22.16b      \n"  // R
+    "mov        v27.16b, v31.16b               \n"  // A
+    "subs       %w4, %w4, #16                  \n"
+    MEMACCESS(3)
+    "st4        {v24.16b, v25.16b, v26.16b, v27.16b}, [%3], #64 \n"
+    "b.gt       1b                             \n"
+  : "+r"(src_bayer0),  // %0
+    "+r"(src_bayer1),  // %1
+    "+r"(src_bayer2),  // %2
+    "+r"(dst_argb),    // %3
+    "+r"(width),       // %4
+    "=&r"(src_tmp)     // %5
+  : "r"((pattern & 1) ? 0xff00 : 0x00ff),  // %6
+    "r"((pattern & 2) ? 0xff : 0)          // %7
+  : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v16",
+    "v20", "v22", "v24", "v25", "v26", "v27", "v29", "v30", "v31"
+  );
+}
+#endif  // HAS_BAYERTOARGBROW_NEON
+
+#ifdef HAS_SCANJPEGMARKERROW_NEON
+// Find the first 16 byte block with a marker, then locate it in C.
+int ScanJpegMarkerRow_NEON(const uint8* src, int count) {
+  const uint8* src_start = src;
+  const uint8* src_next;
+  uint32 mask;
+  asm volatile (
+    "movi       v31.16b, #0xff                 \n"
+    "movi       v30.16b, #0xf8                 \n"
+    "movi       v29.16b, #0xd0                 \n"
+  "1:                                          \n"
+    "add        %2, %0, #1                     \n"
+    MEMACCESS(0)
+    "ld1        {v0.16b}, [%0]                 \n"
+    MEMACCESS(2)
+    "ld1        {v1.16b}, [%2]                 \n"
+    "cmeq       v0.16b, v0.16b, v31.16b        \n"  // 0xff
+    "cmeq       v2.16b, v1.16b, #0             \n"  // stuffing 0x00
+    "cmeq       v3.16b, v1.16b, v31.16b        \n"  // fill 0xff
+    "and        v1.16b, v1.16b, v30.16b        \n"
+    "cmeq       v1.16b, v1.16b, v29.16b        \n"  // restart 0xd0-0xd7
+    "orr        v2.16b, v2.16b, v3.16b         \n"
+    "orr        v2.16b, v2.16b, v1.16b         \n"
+    "bic        v0.16b, v0.16b, v2.16b         \n"
+    "umaxv      b0, v0.16b                     \n"
+    "fmov       %w3, s0                        \n"
+    "cbnz       %w3, 2f                        \n"
+    "add        %0, %0, #16                    \n"
+    "subs       %w1, %w1, #16                  \n"
+    "b.gt       1b                             \n"
+  "2:                                          \n"
+  : "+r"(src),        // %0
+    "+r"(count),      // %1
+    "=&r"(src_next),  // %2
+    "=&r"(mask)       // %3
+  :
+  : "cc", "memory", "v0", "v1", "v2", "v3", "v29", "v30", "v31"
+  );
+  if (mask) {
+    return (int)(src - src_start) + ScanJpegMarkerRow_C(src, 16);
+  }
+  return (int)(src - src_start);
+}
+#endif  // HAS_SCANJPEGMARKERROW_NEON
 #endif  // !defined(LIBYUV_DISABLE_NEON) && defined(__aarch64__)
 
 #ifdef __cplusplus
@@ -14,6 +14,7 @@
 #include <string.h>
 
 #include "libyuv/cpu_id.h"
+#include "libyuv/perf_counters.h"
 #include "libyuv/planar_functions.h"  // For CopyPlane
 #include "libyuv/row.h"
 #include "libyuv/scale_row.h"
@@ -51,6 +52,7 @@ static void ScalePlaneDown2(int src_width, int src_height,
 
 #if defined(HAS_SCALEROWDOWN2_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_Any_NEON :
         (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_NEON :
         ScaleRowDown2Box_Any_NEON);
@@ -63,6 +65,7 @@ static void ScalePlaneDown2(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEROWDOWN2_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_Any_SSE2 :
         (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_SSE2 :
         ScaleRowDown2Box_Any_SSE2);
@@ -75,6 +78,7 @@ static void ScalePlaneDown2(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEROWDOWN2_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_Any_AVX2 :
         (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_AVX2 :
         ScaleRowDown2Box_Any_AVX2);
@@ -85,10 +89,24 @@ static void ScalePlaneDown2(int src_width, int src_height,
     }
   }
 #endif
+#if defined(HAS_SCALEROWDOWN2_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX512BW);
+    ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_Any_AVX512BW :
+        (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_AVX512BW :
+        ScaleRowDown2Box_Any_AVX512BW);
+    if (IS_ALIGNED(dst_width, 64)) {
+      ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_AVX512BW :
+          (filtering == kFilterLinear ? ScaleRowDown2Linear_AVX512BW :
+          ScaleRowDown2Box_AVX512BW);
+    }
+  }
+#endif
 #if defined(HAS_SCALEROWDOWN2_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) && IS_ALIGNED(src_ptr, 4) &&
       IS_ALIGNED(src_stride, 4) && IS_ALIGNED(row_stride, 4) &&
       IS_ALIGNED(dst_ptr, 4) && IS_ALIGNED(dst_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     ScaleRowDown2 = filtering ?
         ScaleRowDown2Box_MIPS_DSPR2 : ScaleRowDown2_MIPS_DSPR2;
   }
@@ -124,12 +142,14 @@ static void ScalePlaneDown2_16(int src_width, int src_height,
 
 #if defined(HAS_SCALEROWDOWN2_16_NEON)
   if (TestCpuFlag(kCpuHasNEON) && IS_ALIGNED(dst_width, 16)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleRowDown2 = filtering ? ScaleRowDown2Box_16_NEON :
         ScaleRowDown2_16_NEON;
   }
 #endif
 #if defined(HAS_SCALEROWDOWN2_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 16)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_16_SSE2 :
         (filtering == kFilterLinear ? ScaleRowDown2Linear_16_SSE2 :
         ScaleRowDown2Box_16_SSE2);
@@ -139,6 +159,7 @@ static void ScalePlaneDown2_16(int src_width, int src_height,
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) && IS_ALIGNED(src_ptr, 4) &&
       IS_ALIGNED(src_stride, 4) && IS_ALIGNED(row_stride, 4) &&
       IS_ALIGNED(dst_ptr, 4) && IS_ALIGNED(dst_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     ScaleRowDown2 = filtering ?
         ScaleRowDown2Box_16_MIPS_DSPR2 : ScaleRowDown2_16_MIPS_DSPR2;
   }
@@ -175,6 +196,7 @@ static void ScalePlaneDown4(int src_width, int src_height,
   }
 #if defined(HAS_SCALEROWDOWN4_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleRowDown4 = filtering ?
         ScaleRowDown4Box_Any_NEON : ScaleRowDown4_Any_NEON;
     if (IS_ALIGNED(dst_width, 8)) {
@@ -184,6 +206,7 @@ static void ScalePlaneDown4(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEROWDOWN4_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     ScaleRowDown4 = filtering ?
         ScaleRowDown4Box_Any_SSE2 : ScaleRowDown4_Any_SSE2;
     if (IS_ALIGNED(dst_width, 8)) {
@@ -193,6 +216,7 @@ static void ScalePlaneDown4(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEROWDOWN4_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     ScaleRowDown4 = filtering ?
         ScaleRowDown4Box_Any_AVX2 : ScaleRowDown4_Any_AVX2;
     if (IS_ALIGNED(dst_width, 16)) {
@@ -204,6 +228,7 @@ static void ScalePlaneDown4(int src_width, int src_height,
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) && IS_ALIGNED(row_stride, 4) &&
       IS_ALIGNED(src_ptr, 4) && IS_ALIGNED(src_stride, 4) &&
       IS_ALIGNED(dst_ptr, 4) && IS_ALIGNED(dst_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     ScaleRowDown4 = filtering ?
         ScaleRowDown4Box_MIPS_DSPR2 : ScaleRowDown4_MIPS_DSPR2;
   }
@@ -235,12 +260,14 @@ static void ScalePlaneDown4_16(int src_width, int src_height,
   }
 #if defined(HAS_SCALEROWDOWN4_16_NEON)
   if (TestCpuFlag(kCpuHasNEON) && IS_ALIGNED(dst_width, 8)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleRowDown4 = filtering ? ScaleRowDown4Box_16_NEON :
         ScaleRowDown4_16_NEON;
   }
 #endif
 #if defined(HAS_SCALEROWDOWN4_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     ScaleRowDown4 = filtering ? ScaleRowDown4Box_16_SSE2 :
         ScaleRowDown4_16_SSE2;
   }
@@ -249,6 +276,7 @@ static void ScalePlaneDown4_16(int src_width, int src_height,
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) && IS_ALIGNED(row_stride, 4) &&
       IS_ALIGNED(src_ptr, 4) && IS_ALIGNED(src_stride, 4) &&
       IS_ALIGNED(dst_ptr, 4) && IS_ALIGNED(dst_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     ScaleRowDown4 = filtering ?
         ScaleRowDown4Box_16_MIPS_DSPR2 : ScaleRowDown4_16_MIPS_DSPR2;
   }
@@ -287,6 +315,7 @@ static void ScalePlaneDown34(int src_width, int src_height,
   }
 #if defined(HAS_SCALEROWDOWN34_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     if (!filtering) {
       ScaleRowDown34_0 = ScaleRowDown34_Any_NEON;
       ScaleRowDown34_1 = ScaleRowDown34_Any_NEON;
@@ -307,6 +336,7 @@ static void ScalePlaneDown34(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEROWDOWN34_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     if (!filtering) {
       ScaleRowDown34_0 = ScaleRowDown34_Any_SSSE3;
       ScaleRowDown34_1 = ScaleRowDown34_Any_SSSE3;
@@ -329,6 +359,7 @@ static void ScalePlaneDown34(int src_width, int src_height,
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) && (dst_width % 24 == 0) &&
       IS_ALIGNED(src_ptr, 4) && IS_ALIGNED(src_stride, 4) &&
       IS_ALIGNED(dst_ptr, 4) && IS_ALIGNED(dst_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     if (!filtering) {
       ScaleRowDown34_0 = ScaleRowDown34_MIPS_DSPR2;
       ScaleRowDown34_1 = ScaleRowDown34_MIPS_DSPR2;
@@ -384,6 +415,7 @@ static void ScalePlaneDown34_16(int src_width, int src_height,
   }
 #if defined(HAS_SCALEROWDOWN34_16_NEON)
   if (TestCpuFlag(kCpuHasNEON) && (dst_width % 24 == 0)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     if (!filtering) {
       ScaleRowDown34_0 = ScaleRowDown34_16_NEON;
       ScaleRowDown34_1 = ScaleRowDown34_16_NEON;
@@ -395,6 +427,7 @@ static void ScalePlaneDown34_16(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEROWDOWN34_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && (dst_width % 24 == 0)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     if (!filtering) {
       ScaleRowDown34_0 = ScaleRowDown34_16_SSSE3;
       ScaleRowDown34_1 = ScaleRowDown34_16_SSSE3;
@@ -408,6 +441,7 @@ static void ScalePlaneDown34_16(int src_width, int src_height,
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) && (dst_width % 24 == 0) &&
       IS_ALIGNED(src_ptr, 4) && IS_ALIGNED(src_stride, 4) &&
       IS_ALIGNED(dst_ptr, 4) && IS_ALIGNED(dst_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     if (!filtering) {
       ScaleRowDown34_0 = ScaleRowDown34_16_MIPS_DSPR2;
       ScaleRowDown34_1 = ScaleRowDown34_16_MIPS_DSPR2;
@@ -480,6 +514,7 @@ static void ScalePlaneDown38(int src_width, int src_height,
 
 #if defined(HAS_SCALEROWDOWN38_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     if (!filtering) {
       ScaleRowDown38_3 = ScaleRowDown38_Any_NEON;
       ScaleRowDown38_2 = ScaleRowDown38_Any_NEON;
@@ -500,6 +535,7 @@ static void ScalePlaneDown38(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEROWDOWN38_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     if (!filtering) {
       ScaleRowDown38_3 = ScaleRowDown38_Any_SSSE3;
       ScaleRowDown38_2 = ScaleRowDown38_Any_SSSE3;
@@ -521,6 +557,7 @@ static void ScalePlaneDown38(int src_width, int src_height,
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) && (dst_width % 12 == 0) &&
       IS_ALIGNED(src_ptr, 4) && IS_ALIGNED(src_stride, 4) &&
       IS_ALIGNED(dst_ptr, 4) && IS_ALIGNED(dst_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     if (!filtering) {
       ScaleRowDown38_3 = ScaleRowDown38_MIPS_DSPR2;
       ScaleRowDown38_2 = ScaleRowDown38_MIPS_DSPR2;
@@ -575,6 +612,7 @@ static void ScalePlaneDown38_16(int src_width, int src_height,
   }
 #if defined(HAS_SCALEROWDOWN38_16_NEON)
   if (TestCpuFlag(kCpuHasNEON) && (dst_width % 12 == 0)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     if (!filtering) {
       ScaleRowDown38_3 = ScaleRowDown38_16_NEON;
       ScaleRowDown38_2 = ScaleRowDown38_16_NEON;
@@ -586,6 +624,7 @@ static void ScalePlaneDown38_16(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEROWDOWN38_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && (dst_width % 24 == 0)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     if (!filtering) {
       ScaleRowDown38_3 = ScaleRowDown38_16_SSSE3;
       ScaleRowDown38_2 = ScaleRowDown38_16_SSSE3;
@@ -599,6 +638,7 @@ static void ScalePlaneDown38_16(int src_width, int src_height,
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) && (dst_width % 12 == 0) &&
       IS_ALIGNED(src_ptr, 4) && IS_ALIGNED(src_stride, 4) &&
       IS_ALIGNED(dst_ptr, 4) && IS_ALIGNED(dst_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     if (!filtering) {
       ScaleRowDown38_3 = ScaleRowDown38_16_MIPS_DSPR2;
       ScaleRowDown38_2 = ScaleRowDown38_16_MIPS_DSPR2;
@@ -754,6 +794,7 @@ static void ScalePlaneBox(int src_width, int src_height,
         ScaleAddRow_C;
 #if defined(HAS_SCALEADDROW_SSE2)
     if (TestCpuFlag(kCpuHasSSE2)) {
+      PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
       ScaleAddRow = ScaleAddRow_Any_SSE2;
       if (IS_ALIGNED(src_width, 16)) {
         ScaleAddRow = ScaleAddRow_SSE2;
@@ -762,6 +803,7 @@ static void ScalePlaneBox(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEADDROW_AVX2)
     if (TestCpuFlag(kCpuHasAVX2)) {
+      PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
       ScaleAddRow = ScaleAddRow_Any_AVX2;
       if (IS_ALIGNED(src_width, 32)) {
         ScaleAddRow = ScaleAddRow_AVX2;
@@ -770,6 +812,7 @@ static void ScalePlaneBox(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEADDROW_NEON)
     if (TestCpuFlag(kCpuHasNEON)) {
+      PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
       ScaleAddRow = ScaleAddRow_Any_NEON;
       if (IS_ALIGNED(src_width, 16)) {
         ScaleAddRow = ScaleAddRow_NEON;
@@ -823,6 +866,7 @@ static void ScalePlaneBox_16(int src_width, int src_height,
 
 #if defined(HAS_SCALEADDROW_16_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(src_width, 16)) {
+      PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
       ScaleAddRow = ScaleAddRow_16_SSE2;
     }
 #endif
@@ -877,6 +921,7 @@ void ScalePlaneBilinearDown(int src_width, int src_height,
 
 #if defined(HAS_INTERPOLATEROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     InterpolateRow = InterpolateRow_Any_SSE2;
     if (IS_ALIGNED(src_width, 16)) {
       InterpolateRow = InterpolateRow_SSE2;
@@ -885,6 +930,7 @@ void ScalePlaneBilinearDown(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     InterpolateRow = InterpolateRow_Any_SSSE3;
     if (IS_ALIGNED(src_width, 16)) {
       InterpolateRow = InterpolateRow_SSSE3;
@@ -893,14 +939,25 @@ void ScalePlaneBilinearDown(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     InterpolateRow = InterpolateRow_Any_AVX2;
     if (IS_ALIGNED(src_width, 32)) {
       InterpolateRow = InterpolateRow_AVX2;
     }
   }
 #endif
+#if defined(HAS_INTERPOLATEROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX512BW);
+    InterpolateRow = InterpolateRow_Any_AVX512BW;
+    if (IS_ALIGNED(src_width, 64)) {
+      InterpolateRow = InterpolateRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_INTERPOLATEROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     InterpolateRow = InterpolateRow_Any_NEON;
     if (IS_ALIGNED(src_width, 16)) {
       InterpolateRow = InterpolateRow_NEON;
@@ -909,6 +966,7 @@ void ScalePlaneBilinearDown(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     InterpolateRow = InterpolateRow_Any_MIPS_DSPR2;
     if (IS_ALIGNED(src_width, 4)) {
       InterpolateRow = InterpolateRow_MIPS_DSPR2;
@@ -919,11 +977,13 @@ void ScalePlaneBilinearDown(int src_width, int src_height,
 
 #if defined(HAS_SCALEFILTERCOLS_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     ScaleFilterCols = ScaleFilterCols_SSSE3;
   }
 #endif
 #if defined(HAS_SCALEFILTERCOLS_NEON)
   if (TestCpuFlag(kCpuHasNEON) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleFilterCols = ScaleFilterCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 8)) {
       ScaleFilterCols = ScaleFilterCols_NEON;
@@ -981,6 +1041,7 @@ void ScalePlaneBilinearDown_16(int src_width, int src_height,
 
 #if defined(HAS_INTERPOLATEROW_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     InterpolateRow = InterpolateRow_Any_16_SSE2;
     if (IS_ALIGNED(src_width, 16)) {
       InterpolateRow = InterpolateRow_16_SSE2;
@@ -989,6 +1050,7 @@ void ScalePlaneBilinearDown_16(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     InterpolateRow = InterpolateRow_Any_16_SSSE3;
     if (IS_ALIGNED(src_width, 16)) {
       InterpolateRow = InterpolateRow_16_SSSE3;
@@ -997,6 +1059,7 @@ void ScalePlaneBilinearDown_16(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     InterpolateRow = InterpolateRow_Any_16_AVX2;
     if (IS_ALIGNED(src_width, 32)) {
       InterpolateRow = InterpolateRow_16_AVX2;
@@ -1005,6 +1068,7 @@ void ScalePlaneBilinearDown_16(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     InterpolateRow = InterpolateRow_Any_16_NEON;
     if (IS_ALIGNED(src_width, 16)) {
       InterpolateRow = InterpolateRow_16_NEON;
@@ -1013,6 +1077,7 @@ void ScalePlaneBilinearDown_16(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     InterpolateRow = InterpolateRow_Any_16_MIPS_DSPR2;
     if (IS_ALIGNED(src_width, 4)) {
       InterpolateRow = InterpolateRow_16_MIPS_DSPR2;
@@ -1023,6 +1088,7 @@ void ScalePlaneBilinearDown_16(int src_width, int src_height,
 
 #if defined(HAS_SCALEFILTERCOLS_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     ScaleFilterCols = ScaleFilterCols_16_SSSE3;
   }
 #endif
@@ -1074,6 +1140,7 @@ void ScalePlaneBilinearUp(int src_width, int src_height,
 
 #if defined(HAS_INTERPOLATEROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     InterpolateRow = InterpolateRow_Any_SSE2;
     if (IS_ALIGNED(dst_width, 16)) {
       InterpolateRow = InterpolateRow_SSE2;
@@ -1082,6 +1149,7 @@ void ScalePlaneBilinearUp(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     InterpolateRow = InterpolateRow_Any_SSSE3;
     if (IS_ALIGNED(dst_width, 16)) {
       InterpolateRow = InterpolateRow_SSSE3;
@@ -1090,14 +1158,25 @@ void ScalePlaneBilinearUp(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     InterpolateRow = InterpolateRow_Any_AVX2;
     if (IS_ALIGNED(dst_width, 32)) {
       InterpolateRow = InterpolateRow_AVX2;
     }
   }
 #endif
+#if defined(HAS_INTERPOLATEROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX512BW);
+    InterpolateRow = InterpolateRow_Any_AVX512BW;
+    if (IS_ALIGNED(dst_width, 64)) {
+      InterpolateRow = InterpolateRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_INTERPOLATEROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     InterpolateRow = InterpolateRow_Any_NEON;
     if (IS_ALIGNED(dst_width, 16)) {
       InterpolateRow = InterpolateRow_NEON;
@@ -1106,6 +1185,7 @@ void ScalePlaneBilinearUp(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     InterpolateRow = InterpolateRow_Any_MIPS_DSPR2;
     if (IS_ALIGNED(dst_width, 4)) {
       InterpolateRow = InterpolateRow_MIPS_DSPR2;
@@ -1118,11 +1198,13 @@ void ScalePlaneBilinearUp(int src_width, int src_height,
   }
 #if defined(HAS_SCALEFILTERCOLS_SSSE3)
   if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     ScaleFilterCols = ScaleFilterCols_SSSE3;
   }
 #endif
 #if defined(HAS_SCALEFILTERCOLS_NEON)
   if (filtering && TestCpuFlag(kCpuHasNEON) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleFilterCols = ScaleFilterCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 8)) {
       ScaleFilterCols = ScaleFilterCols_NEON;
@@ -1133,6 +1215,7 @@ void ScalePlaneBilinearUp(int src_width, int src_height,
     ScaleFilterCols = ScaleColsUp2_C;
 #if defined(HAS_SCALECOLS_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
+      PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
       ScaleFilterCols = ScaleColsUp2_SSE2;
     }
 #endif
@@ -1213,6 +1296,7 @@ void ScalePlaneBilinearUp_16(int src_width, int src_height,
 
 #if defined(HAS_INTERPOLATEROW_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     InterpolateRow = InterpolateRow_Any_16_SSE2;
     if (IS_ALIGNED(dst_width, 16)) {
       InterpolateRow = InterpolateRow_16_SSE2;
@@ -1221,6 +1305,7 @@ void ScalePlaneBilinearUp_16(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     InterpolateRow = InterpolateRow_Any_16_SSSE3;
     if (IS_ALIGNED(dst_width, 16)) {
       InterpolateRow = InterpolateRow_16_SSSE3;
@@ -1229,6 +1314,7 @@ void ScalePlaneBilinearUp_16(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     InterpolateRow = InterpolateRow_Any_16_AVX2;
     if (IS_ALIGNED(dst_width, 32)) {
       InterpolateRow = InterpolateRow_16_AVX2;
@@ -1237,6 +1323,7 @@ void ScalePlaneBilinearUp_16(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     InterpolateRow = InterpolateRow_Any_16_NEON;
     if (IS_ALIGNED(dst_width, 16)) {
       InterpolateRow = InterpolateRow_16_NEON;
@@ -1245,6 +1332,7 @@ void ScalePlaneBilinearUp_16(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     InterpolateRow = InterpolateRow_Any_16_MIPS_DSPR2;
     if (IS_ALIGNED(dst_width, 4)) {
       InterpolateRow = InterpolateRow_16_MIPS_DSPR2;
@@ -1257,6 +1345,7 @@ void ScalePlaneBilinearUp_16(int src_width, int src_height,
   }
 #if defined(HAS_SCALEFILTERCOLS_16_SSSE3)
   if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     ScaleFilterCols = ScaleFilterCols_16_SSSE3;
   }
 #endif
@@ -1264,6 +1353,7 @@ void ScalePlaneBilinearUp_16(int src_width, int src_height,
     ScaleFilterCols = ScaleColsUp2_16_C;
 #if defined(HAS_SCALECOLS_16_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
+      PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
       ScaleFilterCols = ScaleColsUp2_16_SSE2;
     }
 #endif
@@ -1345,6 +1435,7 @@ static void ScalePlaneSimple(int src_width, int src_height,
     ScaleCols = ScaleColsUp2_C;
 #if defined(HAS_SCALECOLS_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
+      PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
       ScaleCols = ScaleColsUp2_SSE2;
     }
 #endif
@@ -1377,6 +1468,7 @@ static void ScalePlaneSimple_16(int src_width, int src_height,
     ScaleCols = ScaleColsUp2_16_C;
 #if defined(HAS_SCALECOLS_16_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
+      PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
       ScaleCols = ScaleColsUp2_16_SSE2;
     }
 #endif
@@ -1399,6 +1491,7 @@ void ScalePlane(const uint8* src, int src_stride,
                 uint8* dst, int dst_stride,
                 int dst_width, int dst_height,
                 enum FilterMode filtering) {
+  PERF_COUNTER(kPerfScalePlane, src_width, src_height);
   // Simplify filtering when possible.
   filtering = ScaleFilterReduce(src_width, src_height,
                                 dst_width, dst_height, filtering);
@@ -1572,6 +1665,7 @@ int I420Scale(const uint8* src_y, int src_stride_y,
               uint8* dst_v, int dst_stride_v,
               int dst_width, int dst_height,
               enum FilterMode filtering) {
+  PERF_COUNTER(kPerfI420Scale, src_width, src_height);
   int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
   int src_halfheight = SUBSAMPLE(src_height, 1, 1);
   int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
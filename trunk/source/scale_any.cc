@@ -69,6 +69,14 @@ SDANY(ScaleRowDown2Linear_Any_AVX2, ScaleRowDown2Linear_AVX2,
 SDANY(ScaleRowDown2Box_Any_AVX2, ScaleRowDown2Box_AVX2, ScaleRowDown2Box_C,
       2, 1, 31)
 #endif
+#ifdef HAS_SCALEROWDOWN2_AVX512BW
+SDANY(ScaleRowDown2_Any_AVX512BW, ScaleRowDown2_AVX512BW, ScaleRowDown2_C,
+      2, 1, 63)
+SDANY(ScaleRowDown2Linear_Any_AVX512BW, ScaleRowDown2Linear_AVX512BW,
+      ScaleRowDown2Linear_C, 2, 1, 63)
+SDANY(ScaleRowDown2Box_Any_AVX512BW, ScaleRowDown2Box_AVX512BW,
+      ScaleRowDown2Box_C, 2, 1, 63)
+#endif
 #ifdef HAS_SCALEROWDOWN2_NEON
 SDANY(ScaleRowDown2_Any_NEON, ScaleRowDown2_NEON, ScaleRowDown2_C, 2, 1, 15)
 SDANY(ScaleRowDown2Linear_Any_NEON, ScaleRowDown2Linear_NEON,
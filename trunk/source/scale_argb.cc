@@ -14,6 +14,7 @@
 #include <string.h>
 
 #include "libyuv/cpu_id.h"
+#include "libyuv/perf_counters.h"
 #include "libyuv/planar_functions.h"  // For CopyARGB
 #include "libyuv/row.h"
 #include "libyuv/scale_row.h"
@@ -54,6 +55,7 @@ static void ScaleARGBDown2(int src_width, int src_height,
 
 #if defined(HAS_SCALEARGBROWDOWN2_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     ScaleARGBRowDown2 = filtering == kFilterNone ? ScaleARGBRowDown2_Any_SSE2 :
         (filtering == kFilterLinear ? ScaleARGBRowDown2Linear_Any_SSE2 :
         ScaleARGBRowDown2Box_Any_SSE2);
@@ -66,6 +68,7 @@ static void ScaleARGBDown2(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEARGBROWDOWN2_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleARGBRowDown2 = filtering == kFilterNone ? ScaleARGBRowDown2_Any_NEON :
         (filtering == kFilterLinear ? ScaleARGBRowDown2Linear_Any_NEON :
         ScaleARGBRowDown2Box_Any_NEON);
@@ -108,6 +111,7 @@ static void ScaleARGBDown4Box(int src_width, int src_height,
   assert((dy & 0x3ffff) == 0);  // Test vertical scale is multiple of 4.
 #if defined(HAS_SCALEARGBROWDOWN2_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     ScaleARGBRowDown2 = ScaleARGBRowDown2Box_Any_SSE2;
     if (IS_ALIGNED(dst_width, 4)) {
       ScaleARGBRowDown2 = ScaleARGBRowDown2Box_SSE2;
@@ -116,6 +120,7 @@ static void ScaleARGBDown4Box(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEARGBROWDOWN2_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleARGBRowDown2 = ScaleARGBRowDown2Box_Any_NEON;
     if (IS_ALIGNED(dst_width, 8)) {
       ScaleARGBRowDown2 = ScaleARGBRowDown2Box_NEON;
@@ -154,6 +159,7 @@ static void ScaleARGBDownEven(int src_width, int src_height,
   src_argb += (y >> 16) * src_stride + (x >> 16) * 4;
 #if defined(HAS_SCALEARGBROWDOWNEVEN_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     ScaleARGBRowDownEven = filtering ? ScaleARGBRowDownEvenBox_Any_SSE2 :
         ScaleARGBRowDownEven_Any_SSE2;
     if (IS_ALIGNED(dst_width, 4)) {
@@ -164,6 +170,7 @@ static void ScaleARGBDownEven(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEARGBROWDOWNEVEN_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleARGBRowDownEven = filtering ? ScaleARGBRowDownEvenBox_Any_NEON :
         ScaleARGBRowDownEven_Any_NEON;
     if (IS_ALIGNED(dst_width, 4)) {
@@ -212,6 +219,7 @@ static void ScaleARGBBilinearDown(int src_width, int src_height,
   x -= (int)(xl << 16);
 #if defined(HAS_INTERPOLATEROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     InterpolateRow = InterpolateRow_Any_SSE2;
     if (IS_ALIGNED(clip_src_width, 16)) {
       InterpolateRow = InterpolateRow_SSE2;
@@ -220,6 +228,7 @@ static void ScaleARGBBilinearDown(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     InterpolateRow = InterpolateRow_Any_SSSE3;
     if (IS_ALIGNED(clip_src_width, 16)) {
       InterpolateRow = InterpolateRow_SSSE3;
@@ -228,14 +237,25 @@ static void ScaleARGBBilinearDown(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     InterpolateRow = InterpolateRow_Any_AVX2;
     if (IS_ALIGNED(clip_src_width, 32)) {
       InterpolateRow = InterpolateRow_AVX2;
     }
   }
 #endif
+#if defined(HAS_INTERPOLATEROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX512BW);
+    InterpolateRow = InterpolateRow_Any_AVX512BW;
+    if (IS_ALIGNED(clip_src_width, 64)) {
+      InterpolateRow = InterpolateRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_INTERPOLATEROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     InterpolateRow = InterpolateRow_Any_NEON;
     if (IS_ALIGNED(clip_src_width, 16)) {
       InterpolateRow = InterpolateRow_NEON;
@@ -245,6 +265,7 @@ static void ScaleARGBBilinearDown(int src_width, int src_height,
 #if defined(HAS_INTERPOLATEROW_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) &&
       IS_ALIGNED(src_argb, 4) && IS_ALIGNED(src_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     InterpolateRow = InterpolateRow_Any_MIPS_DSPR2;
     if (IS_ALIGNED(clip_src_width, 4)) {
       InterpolateRow = InterpolateRow_MIPS_DSPR2;
@@ -253,11 +274,13 @@ static void ScaleARGBBilinearDown(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEARGBFILTERCOLS_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     ScaleARGBFilterCols = ScaleARGBFilterCols_SSSE3;
   }
 #endif
 #if defined(HAS_SCALEARGBFILTERCOLS_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleARGBFilterCols = ScaleARGBFilterCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 4)) {
       ScaleARGBFilterCols = ScaleARGBFilterCols_NEON;
@@ -310,6 +333,7 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
   const int max_y = (src_height - 1) << 16;
 #if defined(HAS_INTERPOLATEROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     InterpolateRow = InterpolateRow_Any_SSE2;
     if (IS_ALIGNED(dst_width, 4)) {
       InterpolateRow = InterpolateRow_SSE2;
@@ -318,6 +342,7 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     InterpolateRow = InterpolateRow_Any_SSSE3;
     if (IS_ALIGNED(dst_width, 4)) {
       InterpolateRow = InterpolateRow_SSSE3;
@@ -326,14 +351,25 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     InterpolateRow = InterpolateRow_Any_AVX2;
     if (IS_ALIGNED(dst_width, 8)) {
       InterpolateRow = InterpolateRow_AVX2;
     }
   }
 #endif
+#if defined(HAS_INTERPOLATEROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX512BW);
+    InterpolateRow = InterpolateRow_Any_AVX512BW;
+    if (IS_ALIGNED(dst_width, 16)) {
+      InterpolateRow = InterpolateRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_INTERPOLATEROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     InterpolateRow = InterpolateRow_Any_NEON;
     if (IS_ALIGNED(dst_width, 4)) {
       InterpolateRow = InterpolateRow_NEON;
@@ -343,6 +379,7 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
 #if defined(HAS_INTERPOLATEROW_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) &&
       IS_ALIGNED(dst_argb, 4) && IS_ALIGNED(dst_stride, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     InterpolateRow = InterpolateRow_MIPS_DSPR2;
   }
 #endif
@@ -352,11 +389,13 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
   }
 #if defined(HAS_SCALEARGBFILTERCOLS_SSSE3)
   if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     ScaleARGBFilterCols = ScaleARGBFilterCols_SSSE3;
   }
 #endif
 #if defined(HAS_SCALEARGBFILTERCOLS_NEON)
   if (filtering && TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleARGBFilterCols = ScaleARGBFilterCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 4)) {
       ScaleARGBFilterCols = ScaleARGBFilterCols_NEON;
@@ -365,11 +404,13 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEARGBCOLS_SSE2)
   if (!filtering && TestCpuFlag(kCpuHasSSE2) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     ScaleARGBFilterCols = ScaleARGBCols_SSE2;
   }
 #endif
 #if defined(HAS_SCALEARGBCOLS_NEON)
   if (!filtering && TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleARGBFilterCols = ScaleARGBCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 8)) {
       ScaleARGBFilterCols = ScaleARGBCols_NEON;
@@ -380,6 +421,7 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
     ScaleARGBFilterCols = ScaleARGBColsUp2_C;
 #if defined(HAS_SCALEARGBCOLSUP2_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
+      PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
       ScaleARGBFilterCols = ScaleARGBColsUp2_SSE2;
     }
 #endif
@@ -459,6 +501,7 @@ static void ScaleYUVToARGBBilinearUp(int src_width, int src_height,
                         int width) = I422ToARGBRow_C;
 #if defined(HAS_I422TOARGBROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     I422ToARGBRow = I422ToARGBRow_Any_SSSE3;
     if (IS_ALIGNED(src_width, 8)) {
       I422ToARGBRow = I422ToARGBRow_SSSE3;
@@ -467,14 +510,25 @@ static void ScaleYUVToARGBBilinearUp(int src_width, int src_height,
 #endif
 #if defined(HAS_I422TOARGBROW_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     I422ToARGBRow = I422ToARGBRow_Any_AVX2;
     if (IS_ALIGNED(src_width, 16)) {
       I422ToARGBRow = I422ToARGBRow_AVX2;
     }
   }
 #endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX512BW);
+    I422ToARGBRow = I422ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(src_width, 32)) {
+      I422ToARGBRow = I422ToARGBRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_I422TOARGBROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     I422ToARGBRow = I422ToARGBRow_Any_NEON;
     if (IS_ALIGNED(src_width, 8)) {
       I422ToARGBRow = I422ToARGBRow_NEON;
@@ -487,6 +541,7 @@ static void ScaleYUVToARGBBilinearUp(int src_width, int src_height,
       IS_ALIGNED(src_u, 2) && IS_ALIGNED(src_stride_u, 2) &&
       IS_ALIGNED(src_v, 2) && IS_ALIGNED(src_stride_v, 2) &&
       IS_ALIGNED(dst_argb, 4) && IS_ALIGNED(dst_stride_argb, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     I422ToARGBRow = I422ToARGBRow_MIPS_DSPR2;
   }
 #endif
@@ -496,6 +551,7 @@ static void ScaleYUVToARGBBilinearUp(int src_width, int src_height,
       InterpolateRow_C;
 #if defined(HAS_INTERPOLATEROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     InterpolateRow = InterpolateRow_Any_SSE2;
     if (IS_ALIGNED(dst_width, 4)) {
       InterpolateRow = InterpolateRow_SSE2;
@@ -504,6 +560,7 @@ static void ScaleYUVToARGBBilinearUp(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     InterpolateRow = InterpolateRow_Any_SSSE3;
     if (IS_ALIGNED(dst_width, 4)) {
       InterpolateRow = InterpolateRow_SSSE3;
@@ -512,14 +569,25 @@ static void ScaleYUVToARGBBilinearUp(int src_width, int src_height,
 #endif
 #if defined(HAS_INTERPOLATEROW_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX2);
     InterpolateRow = InterpolateRow_Any_AVX2;
     if (IS_ALIGNED(dst_width, 8)) {
       InterpolateRow = InterpolateRow_AVX2;
     }
   }
 #endif
+#if defined(HAS_INTERPOLATEROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasAVX512BW);
+    InterpolateRow = InterpolateRow_Any_AVX512BW;
+    if (IS_ALIGNED(dst_width, 16)) {
+      InterpolateRow = InterpolateRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_INTERPOLATEROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     InterpolateRow = InterpolateRow_Any_NEON;
     if (IS_ALIGNED(dst_width, 4)) {
       InterpolateRow = InterpolateRow_NEON;
@@ -529,6 +597,7 @@ static void ScaleYUVToARGBBilinearUp(int src_width, int src_height,
 #if defined(HAS_INTERPOLATEROW_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) &&
       IS_ALIGNED(dst_argb, 4) && IS_ALIGNED(dst_stride_argb, 4)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasMIPS_DSPR2);
     InterpolateRow = InterpolateRow_MIPS_DSPR2;
   }
 #endif
@@ -542,11 +611,13 @@ static void ScaleYUVToARGBBilinearUp(int src_width, int src_height,
   }
 #if defined(HAS_SCALEARGBFILTERCOLS_SSSE3)
   if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSSE3);
     ScaleARGBFilterCols = ScaleARGBFilterCols_SSSE3;
   }
 #endif
 #if defined(HAS_SCALEARGBFILTERCOLS_NEON)
   if (filtering && TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleARGBFilterCols = ScaleARGBFilterCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 4)) {
       ScaleARGBFilterCols = ScaleARGBFilterCols_NEON;
@@ -555,11 +626,13 @@ static void ScaleYUVToARGBBilinearUp(int src_width, int src_height,
 #endif
 #if defined(HAS_SCALEARGBCOLS_SSE2)
   if (!filtering && TestCpuFlag(kCpuHasSSE2) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     ScaleARGBFilterCols = ScaleARGBCols_SSE2;
   }
 #endif
 #if defined(HAS_SCALEARGBCOLS_NEON)
   if (!filtering && TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleARGBFilterCols = ScaleARGBCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 8)) {
       ScaleARGBFilterCols = ScaleARGBCols_NEON;
@@ -570,6 +643,7 @@ static void ScaleYUVToARGBBilinearUp(int src_width, int src_height,
     ScaleARGBFilterCols = ScaleARGBColsUp2_C;
 #if defined(HAS_SCALEARGBCOLSUP2_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
+      PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
       ScaleARGBFilterCols = ScaleARGBColsUp2_SSE2;
     }
 #endif
@@ -670,11 +744,13 @@ static void ScaleARGBSimple(int src_width, int src_height,
       (src_width >= 32768) ? ScaleARGBCols64_C : ScaleARGBCols_C;
 #if defined(HAS_SCALEARGBCOLS_SSE2)
   if (TestCpuFlag(kCpuHasSSE2) && src_width < 32768) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
     ScaleARGBCols = ScaleARGBCols_SSE2;
   }
 #endif
 #if defined(HAS_SCALEARGBCOLS_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
+    PERF_COUNTER_CPU_FLAG(kCpuHasNEON);
     ScaleARGBCols = ScaleARGBCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 8)) {
       ScaleARGBCols = ScaleARGBCols_NEON;
@@ -685,6 +761,7 @@ static void ScaleARGBSimple(int src_width, int src_height,
     ScaleARGBCols = ScaleARGBColsUp2_C;
 #if defined(HAS_SCALEARGBCOLSUP2_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
+      PERF_COUNTER_CPU_FLAG(kCpuHasSSE2);
       ScaleARGBCols = ScaleARGBColsUp2_SSE2;
     }
 #endif
@@ -836,6 +913,7 @@ int ARGBScale(const uint8* src_argb, int src_stride_argb,
               uint8* dst_argb, int dst_stride_argb,
               int dst_width, int dst_height,
               enum FilterMode filtering) {
+  PERF_COUNTER(kPerfARGBScale, src_width, src_height);
   if (!src_argb || src_width == 0 || src_height == 0 ||
       src_width > 32768 || src_height > 32768 ||
       !dst_argb || dst_width <= 0 || dst_height <= 0) {
@@ -9,6 +9,7 @@
  */
 
 #include "libyuv/row.h"
+#include "libyuv/scale_row.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -186,6 +187,113 @@ void ScaleRowDown2Box_SSE2(const uint8* src_ptr, ptrdiff_t src_stride,
   );
 }
 
+#ifdef HAS_SCALEROWDOWN2_AVX512BW
+// vpermq for vpackuswb.
+static const uint64 kPermqPack_AVX512[8] = { 0, 2, 4, 6, 1, 3, 5, 7 };
+
+void ScaleRowDown2_AVX512BW(const uint8* src_ptr, ptrdiff_t src_stride,
+                            uint8* dst_ptr, int dst_width) {
+  asm volatile (
+    "vmovdqu64 %3,%%zmm4                       \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu8  " MEMACCESS(0) ",%%zmm0         \n"
+    "vmovdqu8  " MEMACCESS2(0x40,0) ",%%zmm1   \n"
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "vpsrlw    $0x8,%%zmm0,%%zmm0              \n"
+    "vpsrlw    $0x8,%%zmm1,%%zmm1              \n"
+    "vpackuswb %%zmm1,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vmovdqu8  %%zmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "sub       $0x40,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_ptr),    // %0
+    "+r"(dst_ptr),    // %1
+    "+r"(dst_width)   // %2
+  : "m"(kPermqPack_AVX512)  // %3
+  : "memory", "cc", "xmm0", "xmm1", "xmm4"
+  );
+}
+
+void ScaleRowDown2Linear_AVX512BW(const uint8* src_ptr, ptrdiff_t src_stride,
+                                  uint8* dst_ptr, int dst_width) {
+  asm volatile (
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+    "vpsrlw    $0x8,%%zmm5,%%zmm5              \n"
+    "vmovdqu64 %3,%%zmm4                       \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu8  " MEMACCESS(0) ",%%zmm0         \n"
+    "vmovdqu8  " MEMACCESS2(0x40,0) ",%%zmm1   \n"
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "vpsrlw    $0x8,%%zmm0,%%zmm2              \n"
+    "vpsrlw    $0x8,%%zmm1,%%zmm3              \n"
+    "vpandq    %%zmm5,%%zmm0,%%zmm0            \n"
+    "vpandq    %%zmm5,%%zmm1,%%zmm1            \n"
+    "vpavgw    %%zmm2,%%zmm0,%%zmm0            \n"
+    "vpavgw    %%zmm3,%%zmm1,%%zmm1            \n"
+    "vpackuswb %%zmm1,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm0,%%zmm4,%%zmm0            \n"
+    "vmovdqu8  %%zmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "sub       $0x40,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_ptr),    // %0
+    "+r"(dst_ptr),    // %1
+    "+r"(dst_width)   // %2
+  : "m"(kPermqPack_AVX512)  // %3
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  );
+}
+
+// Sums 2x2 pixels with vpmaddubsw so rounding matches the C version.
+void ScaleRowDown2Box_AVX512BW(const uint8* src_ptr, ptrdiff_t src_stride,
+                               uint8* dst_ptr, int dst_width) {
+  asm volatile (
+    "vpternlogd $0xff,%%zmm4,%%zmm4,%%zmm4     \n"
+    "vpabsb    %%zmm4,%%zmm4                   \n"  // 1 for vpmaddubsw.
+    "vpxord    %%zmm5,%%zmm5,%%zmm5            \n"
+    "vmovdqu64 %4,%%zmm6                       \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu8  " MEMACCESS(0) ",%%zmm0         \n"
+    "vmovdqu8  " MEMACCESS2(0x40,0) ",%%zmm1   \n"
+    MEMOPREG(vmovdqu8,0x00,0,3,1,zmm2)         //  vmovdqu8  (%0,%3,1),%%zmm2
+    MEMOPREG(vmovdqu8,0x40,0,3,1,zmm3)         //  vmovdqu8  0x40(%0,%3,1),%%zmm3
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "vpmaddubsw %%zmm4,%%zmm0,%%zmm0           \n"
+    "vpmaddubsw %%zmm4,%%zmm1,%%zmm1           \n"
+    "vpmaddubsw %%zmm4,%%zmm2,%%zmm2           \n"
+    "vpmaddubsw %%zmm4,%%zmm3,%%zmm3           \n"
+    "vpaddw    %%zmm2,%%zmm0,%%zmm0            \n"
+    "vpaddw    %%zmm3,%%zmm1,%%zmm1            \n"
+    "vpsrlw    $0x1,%%zmm0,%%zmm0              \n"  // (sum + 2) >> 2
+    "vpsrlw    $0x1,%%zmm1,%%zmm1              \n"
+    "vpavgw    %%zmm5,%%zmm0,%%zmm0            \n"
+    "vpavgw    %%zmm5,%%zmm1,%%zmm1            \n"
+    "vpackuswb %%zmm1,%%zmm0,%%zmm0            \n"
+    "vpermq    %%zmm0,%%zmm6,%%zmm0            \n"
+    "vmovdqu8  %%zmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "sub       $0x40,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_ptr),    // %0
+    "+r"(dst_ptr),    // %1
+    "+r"(dst_width)   // %2
+  : "r"((intptr_t)(src_stride)),  // %3
+    "m"(kPermqPack_AVX512)  // %4
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6"
+  );
+}
+#endif  // HAS_SCALEROWDOWN2_AVX512BW
+
 void ScaleRowDown4_SSE2(const uint8* src_ptr, ptrdiff_t src_stride,
                         uint8* dst_ptr, int dst_width) {
   asm volatile (
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -116,6 +117,21 @@ TEST_F(libyuvTest, Djb2_Test) {
   free_aligned_buffer_64(src_b);
 }
 
+// Test every length of a few SIMD loops, so the remainder is exercised.
+TEST_F(libyuvTest, Djb2_Lengths) {
+  const int kMaxTest = 128 * 3 + 1;
+  align_buffer_64(src_a, kMaxTest + 1);
+  for (int i = 0; i < kMaxTest + 1; ++i) {
+    src_a[i] = (random() & 0xff);
+  }
+  for (int i = 0; i <= kMaxTest; ++i) {
+    EXPECT_EQ(ReferenceHashDjb2(src_a, i, 5381), HashDjb2(src_a, i, 5381));
+    EXPECT_EQ(ReferenceHashDjb2(src_a + 1, i, 1234),
+              HashDjb2(src_a + 1, i, 1234));
+  }
+  free_aligned_buffer_64(src_a);
+}
+
 TEST_F(libyuvTest, BenchmarkDjb2_Opt) {
   const int kMaxTest = benchmark_width_ * benchmark_height_;
   align_buffer_64(src_a, kMaxTest);
@@ -202,6 +218,399 @@ TEST_F(libyuvTest, BenchmarkARGBDetect_Unaligned) {
 
   free_aligned_buffer_64(src_a);
 }
+// The first pixel with a byte 0 or 3 that is not 255 decides.
+static uint32 ReferenceARGBDetect(const uint8* argb, int stride_argb,
+                                  int width, int height) {
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      if (argb[y * stride_argb + x * 4] != 255) {
+        return libyuv::FOURCC_BGRA;
+      }
+      if (argb[y * stride_argb + x * 4 + 3] != 255) {
+        return libyuv::FOURCC_ARGB;
+      }
+    }
+  }
+  return 0;
+}
+
+TEST_F(libyuvTest, ARGBDetect) {
+  const int kStride = benchmark_width_ * 4;
+  const int kPixels = benchmark_width_ * benchmark_height_;
+  align_buffer_64(src_argb, kPixels * 4);
+  memset(src_argb, 255, kPixels * 4);
+  for (int i = 0; i < 64; ++i) {
+    int pixel = random() % kPixels;
+    int byte = (random() & 1) ? 3 : 0;
+    src_argb[pixel * 4 + byte] = random() & 0x7f;
+    if (random() & 1) {
+      src_argb[pixel * 4 + (byte ^ 3)] = random() & 0x7f;
+    }
+
+    uint32 expected = ReferenceARGBDetect(src_argb, kStride,
+                                          benchmark_width_, benchmark_height_);
+    MaskCpuFlags(disable_cpu_flags_);
+    EXPECT_EQ(expected, ARGBDetect(src_argb, kStride,
+                                   benchmark_width_, benchmark_height_));
+    MaskCpuFlags(-1);
+    EXPECT_EQ(expected, ARGBDetect(src_argb, kStride,
+                                   benchmark_width_, benchmark_height_));
+    // Rows that are not coalesced.
+    EXPECT_EQ(ReferenceARGBDetect(src_argb, kStride,
+                                  benchmark_width_ - 1, benchmark_height_),
+              ARGBDetect(src_argb, kStride,
+                         benchmark_width_ - 1, benchmark_height_));
+    memset(src_argb + pixel * 4, 255, 4);
+  }
+  free_aligned_buffer_64(src_argb);
+}
+
+static int TestARGBDetectAlpha(int width, int height, int byte0, int byte3,
+                               int disable_cpu_flags,
+                               int benchmark_iterations) {
+  const int kStride = width * 4 + 4;
+  align_buffer_64(src_argb, kStride * height);
+  for (int i = 0; i < kStride * height; ++i) {
+    src_argb[i] = (random() & 0xff);
+  }
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      if (byte0 >= 0) {
+        src_argb[y * kStride + x * 4] = byte0;
+      }
+      if (byte3 >= 0) {
+        src_argb[y * kStride + x * 4 + 3] = byte3;
+      }
+    }
+  }
+  MaskCpuFlags(disable_cpu_flags);
+  int flags_c = ARGBDetectAlpha(src_argb, kStride, width, height);
+  MaskCpuFlags(-1);
+  int flags_opt = 0;
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    flags_opt = ARGBDetectAlpha(src_argb, kStride, width, height);
+  }
+  EXPECT_EQ(flags_c, flags_opt);
+  free_aligned_buffer_64(src_argb);
+  return flags_opt;
+}
+
+TEST_F(libyuvTest, ARGBDetectAlpha) {
+  const int kWidth = benchmark_width_ < 16 ? 16 : benchmark_width_;
+  const int kHeight = benchmark_height_;
+  // Random bytes are detected as neither opaque nor zero, unless the image
+  // is tiny.
+  EXPECT_EQ(0, TestARGBDetectAlpha(kWidth, kHeight, -1, -1,
+                                   disable_cpu_flags_, 1));
+  EXPECT_EQ(kAlphaByte3Opaque,
+            TestARGBDetectAlpha(kWidth, kHeight, -1, 255,
+                                disable_cpu_flags_, 1));
+  EXPECT_EQ(kAlphaByte0Opaque,
+            TestARGBDetectAlpha(kWidth, kHeight, 255, -1,
+                                disable_cpu_flags_, 1));
+  EXPECT_EQ(kAlphaByte3Zero,
+            TestARGBDetectAlpha(kWidth, kHeight, -1, 0,
+                                disable_cpu_flags_, 1));
+  EXPECT_EQ(kAlphaByte0Zero | kAlphaByte3Opaque,
+            TestARGBDetectAlpha(kWidth, kHeight, 0, 255,
+                                disable_cpu_flags_, 1));
+  EXPECT_EQ(kAlphaByte0Opaque | kAlphaByte3Opaque,
+            TestARGBDetectAlpha(1, 1, 255, 255, disable_cpu_flags_, 1));
+  EXPECT_EQ(kAlphaByte3Zero,
+            TestARGBDetectAlpha(33, 17, 128, 0, disable_cpu_flags_, 1));
+  EXPECT_EQ(-1, ARGBDetectAlpha(NULL, 0, 1, 1));
+}
+
+TEST_F(libyuvTest, BenchmarkARGBDetectAlpha_Opt) {
+  EXPECT_EQ(kAlphaByte3Opaque,
+            TestARGBDetectAlpha(benchmark_width_, benchmark_height_, -1, 255,
+                                disable_cpu_flags_, benchmark_iterations_));
+}
+
+static void TestDirtyRects(int width, int height, int stride,
+                           int tile_width, int tile_height, int num_changes,
+                           int disable_cpu_flags) {
+  const int kMapWidth = (width + tile_width - 1) / tile_width;
+  const int kMapHeight = (height + tile_height - 1) / tile_height;
+  align_buffer_64(src_a, stride * height);
+  align_buffer_64(src_b, stride * height);
+  align_buffer_64(map_expected, kMapWidth * kMapHeight);
+  align_buffer_64(map_c, kMapWidth * kMapHeight);
+  align_buffer_64(map_opt, kMapWidth * kMapHeight);
+  for (int i = 0; i < stride * height; ++i) {
+    src_a[i] = (random() & 0xff);
+  }
+  memcpy(src_b, src_a, stride * height);
+  memset(map_expected, 0, kMapWidth * kMapHeight);
+  int expected_dirty = 0;
+  for (int i = 0; i < num_changes; ++i) {
+    int x = random() % width;
+    int y = random() % height;
+    src_b[y * stride + x] ^= 1 + (random() & 0x7f);
+    uint8* dirty = &map_expected[(y / tile_height) * kMapWidth +
+                                 x / tile_width];
+    if (!*dirty) {
+      *dirty = 1;
+      ++expected_dirty;
+    }
+  }
+  // Differences in the padding between rows are ignored.
+  if (stride > width) {
+    src_b[stride - 1] ^= 0xff;
+  }
+
+  MaskCpuFlags(disable_cpu_flags);
+  EXPECT_EQ(expected_dirty,
+            PlaneDirtyRects(src_a, stride, src_b, stride, width, height,
+                            tile_width, tile_height, map_c, kMapWidth));
+  MaskCpuFlags(-1);
+  EXPECT_EQ(expected_dirty,
+            PlaneDirtyRects(src_a, stride, src_b, stride, width, height,
+                            tile_width, tile_height, map_opt, kMapWidth));
+  for (int i = 0; i < kMapWidth * kMapHeight; ++i) {
+    EXPECT_EQ(map_expected[i], map_c[i]);
+    EXPECT_EQ(map_expected[i], map_opt[i]);
+  }
+
+  free_aligned_buffer_64(src_a);
+  free_aligned_buffer_64(src_b);
+  free_aligned_buffer_64(map_expected);
+  free_aligned_buffer_64(map_c);
+  free_aligned_buffer_64(map_opt);
+}
+
+TEST_F(libyuvTest, PlaneDirtyRects) {
+  for (int changes = 0; changes <= 64; changes += 16) {
+    TestDirtyRects(benchmark_width_, benchmark_height_, benchmark_width_,
+                   16, 16, changes, disable_cpu_flags_);
+    TestDirtyRects(benchmark_width_, benchmark_height_, benchmark_width_ + 5,
+                   64, 32, changes, disable_cpu_flags_);
+    // A single column of tiles, which is coalesced when the stride is width.
+    TestDirtyRects(benchmark_width_, benchmark_height_, benchmark_width_,
+                   benchmark_width_, 8, changes, disable_cpu_flags_);
+    TestDirtyRects(100, 37, 100, 1000, 1000, changes, disable_cpu_flags_);
+  }
+  TestDirtyRects(1, 1, 1, 1, 1, 1, disable_cpu_flags_);
+  TestDirtyRects(33, 17, 40, 7, 5, 20, disable_cpu_flags_);
+  uint8 map[1];
+  EXPECT_EQ(-1, PlaneDirtyRects(NULL, 0, NULL, 0, 8, 8, 8, 8, map, 1));
+  EXPECT_EQ(-1, PlaneDirtyRects(map, 1, map, 1, 1, 1, 0, 1, map, 1));
+}
+
+static void TestPlaneStats(int width, int height, int stride,
+                           int disable_cpu_flags, int benchmark_iterations) {
+  align_buffer_64(src_y, stride * height);
+  uint64 expected_sum = 0u;
+  uint64 expected_sum_sq = 0u;
+  int expected_min = 255;
+  int expected_max = 0;
+  for (int i = 0; i < stride * height; ++i) {
+    src_y[i] = 16 + (random() % 200);
+  }
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      int v = src_y[y * stride + x];
+      expected_sum += v;
+      expected_sum_sq += v * v;
+      expected_min = v < expected_min ? v : expected_min;
+      expected_max = v > expected_max ? v : expected_max;
+    }
+  }
+  uint64 sum_c, sum_sq_c, sum_opt, sum_sq_opt;
+  int min_c, max_c, min_opt, max_opt;
+  MaskCpuFlags(disable_cpu_flags);
+  EXPECT_EQ(0, PlaneStats(src_y, stride, width, height,
+                          &sum_c, &sum_sq_c, &min_c, &max_c));
+  MaskCpuFlags(-1);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    EXPECT_EQ(0, PlaneStats(src_y, stride, width, height,
+                            &sum_opt, &sum_sq_opt, &min_opt, &max_opt));
+  }
+  EXPECT_EQ(expected_sum, sum_c);
+  EXPECT_EQ(expected_sum_sq, sum_sq_c);
+  EXPECT_EQ(expected_min, min_c);
+  EXPECT_EQ(expected_max, max_c);
+  EXPECT_EQ(expected_sum, sum_opt);
+  EXPECT_EQ(expected_sum_sq, sum_sq_opt);
+  EXPECT_EQ(expected_min, min_opt);
+  EXPECT_EQ(expected_max, max_opt);
+  free_aligned_buffer_64(src_y);
+}
+
+TEST_F(libyuvTest, PlaneStats) {
+  TestPlaneStats(benchmark_width_, benchmark_height_, benchmark_width_,
+                 disable_cpu_flags_, 1);
+  TestPlaneStats(benchmark_width_ > 1 ? benchmark_width_ - 1 : 1,
+                 benchmark_height_, benchmark_width_, disable_cpu_flags_, 1);
+  TestPlaneStats(1, 1, 1, disable_cpu_flags_, 1);
+  // More than 65536 values in a row.
+  TestPlaneStats(70001, 2, 70001, disable_cpu_flags_, 1);
+  uint64 sum;
+  EXPECT_EQ(-1, PlaneStats(NULL, 0, 8, 8, &sum, NULL, NULL, NULL));
+}
+
+TEST_F(libyuvTest, BenchmarkPlaneStats_Opt) {
+  TestPlaneStats(benchmark_width_, benchmark_height_, benchmark_width_,
+                 disable_cpu_flags_, benchmark_iterations_);
+}
+
+TEST_F(libyuvTest, PlaneBlockStats) {
+  const int kWidth = 100;
+  const int kHeight = 70;
+  const int kBlockSize = 16;
+  const int kMapWidth = (kWidth + kBlockSize - 1) / kBlockSize;
+  const int kMapHeight = (kHeight + kBlockSize - 1) / kBlockSize;
+  align_buffer_64(src_y, kWidth * kHeight);
+  uint32 block_sum[kMapWidth * kMapHeight];
+  uint32 block_sum_sq[kMapWidth * kMapHeight];
+  uint8 block_min[kMapWidth * kMapHeight];
+  uint8 block_max[kMapWidth * kMapHeight];
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_y[i] = (random() & 0xff);
+  }
+  EXPECT_EQ(0, PlaneBlockStats(src_y, kWidth, kWidth, kHeight, kBlockSize,
+                               block_sum, block_sum_sq, block_min, block_max,
+                               kMapWidth));
+  for (int by = 0; by < kMapHeight; ++by) {
+    for (int bx = 0; bx < kMapWidth; ++bx) {
+      const int x = bx * kBlockSize;
+      const int y = by * kBlockSize;
+      const int w = kWidth - x < kBlockSize ? kWidth - x : kBlockSize;
+      const int h = kHeight - y < kBlockSize ? kHeight - y : kBlockSize;
+      uint64 sum, sum_sq;
+      int min, max;
+      PlaneStats(src_y + y * kWidth + x, kWidth, w, h,
+                 &sum, &sum_sq, &min, &max);
+      const int block = by * kMapWidth + bx;
+      EXPECT_EQ(sum, block_sum[block]);
+      EXPECT_EQ(sum_sq, block_sum_sq[block]);
+      EXPECT_EQ(min, block_min[block]);
+      EXPECT_EQ(max, block_max[block]);
+    }
+  }
+  // Outputs may be NULL.
+  EXPECT_EQ(0, PlaneBlockStats(src_y, kWidth, kWidth, kHeight, kBlockSize,
+                               NULL, NULL, NULL, block_max, kMapWidth));
+  EXPECT_EQ(-1, PlaneBlockStats(src_y, kWidth, kWidth, kHeight, 12,
+                                block_sum, NULL, NULL, NULL, kMapWidth));
+  free_aligned_buffer_64(src_y);
+}
+
+TEST_F(libyuvTest, PlaneHistogram) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kStride = benchmark_width_ + 3;
+  align_buffer_64(src_y, kStride * kHeight);
+  uint32 expected[256];
+  uint32 hist[256];
+  memset(expected, 0, sizeof(expected));
+  for (int i = 0; i < kStride * kHeight; ++i) {
+    src_y[i] = (random() & 0xff);
+  }
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      ++expected[src_y[y * kStride + x]];
+    }
+  }
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    EXPECT_EQ(0, PlaneHistogram(src_y, kStride, kWidth, kHeight, hist));
+  }
+  for (int i = 0; i < 256; ++i) {
+    EXPECT_EQ(expected[i], hist[i]);
+  }
+  EXPECT_EQ(-1, PlaneHistogram(src_y, kStride, kWidth, kHeight, NULL));
+  free_aligned_buffer_64(src_y);
+}
+
+TEST_F(libyuvTest, PlaneBlockHistogram) {
+  const int kWidth = 100;
+  const int kHeight = 70;
+  const int kBlockSize = 32;
+  const int kMapWidth = (kWidth + kBlockSize - 1) / kBlockSize;
+  const int kMapHeight = (kHeight + kBlockSize - 1) / kBlockSize;
+  align_buffer_64(src_y, kWidth * kHeight);
+  uint32 block_hist[kMapWidth * kMapHeight * 256];
+  uint32 hist[256];
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_y[i] = (random() & 0xff);
+  }
+  EXPECT_EQ(0, PlaneBlockHistogram(src_y, kWidth, kWidth, kHeight, kBlockSize,
+                                   block_hist, kMapWidth));
+  for (int by = 0; by < kMapHeight; ++by) {
+    for (int bx = 0; bx < kMapWidth; ++bx) {
+      const int x = bx * kBlockSize;
+      const int y = by * kBlockSize;
+      const int w = kWidth - x < kBlockSize ? kWidth - x : kBlockSize;
+      const int h = kHeight - y < kBlockSize ? kHeight - y : kBlockSize;
+      PlaneHistogram(src_y + y * kWidth + x, kWidth, w, h, hist);
+      const int block = by * kMapWidth + bx;
+      for (int i = 0; i < 256; ++i) {
+        EXPECT_EQ(hist[i], block_hist[block * 256 + i]);
+      }
+    }
+  }
+  EXPECT_EQ(-1, PlaneBlockHistogram(src_y, kWidth, kWidth, kHeight, 12,
+                                    block_hist, kMapWidth));
+  EXPECT_EQ(-1, PlaneBlockHistogram(src_y, kWidth, kWidth, kHeight,
+                                    kBlockSize, NULL, kMapWidth));
+  free_aligned_buffer_64(src_y);
+}
+
+TEST_F(libyuvTest, ARGBHistogram) {
+  const int kWidth = 33;
+  const int kHeight = 17;
+  align_buffer_64(src_argb, kWidth * kHeight * 4);
+  uint32 expected[256 * 4];
+  uint32 hist[256 * 4];
+  memset(expected, 0, sizeof(expected));
+  for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+    src_argb[i] = (random() & 0xff);
+    ++expected[(i & 3) * 256 + src_argb[i]];
+  }
+  EXPECT_EQ(0, ARGBHistogram(src_argb, kWidth * 4, kWidth, kHeight, hist));
+  for (int i = 0; i < 256 * 4; ++i) {
+    EXPECT_EQ(expected[i], hist[i]);
+  }
+  free_aligned_buffer_64(src_argb);
+}
+
+TEST_F(libyuvTest, BenchmarkARGBDirtyRects_Opt) {
+  const int kTileSize = 32;
+  const int kStride = benchmark_width_ * 4;
+  const int kMapWidth = (benchmark_width_ + kTileSize - 1) / kTileSize;
+  const int kMapHeight = (benchmark_height_ + kTileSize - 1) / kTileSize;
+  align_buffer_64(src_a, kStride * benchmark_height_);
+  align_buffer_64(src_b, kStride * benchmark_height_);
+  align_buffer_64(map, kMapWidth * kMapHeight);
+  for (int i = 0; i < kStride * benchmark_height_; ++i) {
+    src_a[i] = (random() & 0xff);
+  }
+  memcpy(src_b, src_a, kStride * benchmark_height_);
+
+  // A static frame.
+  int num_dirty = -1;
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    num_dirty = ARGBDirtyRects(src_a, kStride, src_b, kStride,
+                               benchmark_width_, benchmark_height_,
+                               kTileSize, kTileSize, map, kMapWidth);
+  }
+  EXPECT_EQ(0, num_dirty);
+  for (int i = 0; i < kMapWidth * kMapHeight; ++i) {
+    EXPECT_EQ(0, map[i]);
+  }
+
+  // Alpha of the last pixel.
+  src_b[kStride * benchmark_height_ - 1] ^= 0xff;
+  EXPECT_EQ(1, ARGBDirtyRects(src_a, kStride, src_b, kStride,
+                              benchmark_width_, benchmark_height_,
+                              kTileSize, kTileSize, map, kMapWidth));
+  EXPECT_EQ(1, map[kMapWidth * kMapHeight - 1]);
+
+  free_aligned_buffer_64(src_a);
+  free_aligned_buffer_64(src_b);
+  free_aligned_buffer_64(map);
+}
+
 TEST_F(libyuvTest, BenchmarkSumSquareError_Opt) {
   const int kMaxWidth = 4096 * 3;
   align_buffer_64(src_a, kMaxWidth);
@@ -275,6 +684,112 @@ TEST_F(libyuvTest, SumSquareError) {
   free_aligned_buffer_64(src_b);
 }
 
+TEST_F(libyuvTest, SumSquareError_Lengths) {
+  const int kMaxTest = 128 * 3 + 1;
+  align_buffer_64(src_a, kMaxTest + 1);
+  align_buffer_64(src_b, kMaxTest + 1);
+  for (int i = 0; i < kMaxTest + 1; ++i) {
+    src_a[i] = (random() & 0xff);
+    src_b[i] = (random() & 0xff);
+  }
+  for (int i = 0; i <= kMaxTest; ++i) {
+    MaskCpuFlags(disable_cpu_flags_);
+    uint64 c_err = ComputeSumSquareError(src_a + 1, src_b, i);
+    MaskCpuFlags(-1);
+    uint64 opt_err = ComputeSumSquareError(src_a + 1, src_b, i);
+    EXPECT_EQ(c_err, opt_err);
+  }
+  free_aligned_buffer_64(src_a);
+  free_aligned_buffer_64(src_b);
+}
+
+TEST_F(libyuvTest, SumSquareError_16) {
+  const int kCount = benchmark_width_ * benchmark_height_;
+  align_buffer_64(src_a, kCount * 2);
+  align_buffer_64(src_b, kCount * 2);
+  uint16* src_a16 = reinterpret_cast<uint16*>(src_a);
+  uint16* src_b16 = reinterpret_cast<uint16*>(src_b);
+
+  // The largest differences, which overflow 32 bit sums.
+  for (int i = 0; i < kCount; ++i) {
+    src_a16[i] = 65535;
+    src_b16[i] = 0;
+  }
+  EXPECT_EQ(static_cast<uint64>(kCount) * 65535u * 65535u,
+            ComputeSumSquareError_16(src_a16, src_b16, kCount));
+
+  for (int bits = 10; bits <= 16; bits += 2) {
+    uint64 expected = 0u;
+    for (int i = 0; i < kCount; ++i) {
+      src_a16[i] = random() & ((1 << bits) - 1);
+      src_b16[i] = random() & ((1 << bits) - 1);
+      int64 diff = src_a16[i] - src_b16[i];
+      expected += diff * diff;
+    }
+    MaskCpuFlags(disable_cpu_flags_);
+    uint64 c_err = ComputeSumSquareError_16(src_a16, src_b16, kCount);
+    MaskCpuFlags(-1);
+    uint64 opt_err = 0u;
+    for (int i = 0; i < benchmark_iterations_; ++i) {
+      opt_err = ComputeSumSquareError_16(src_a16, src_b16, kCount);
+    }
+    EXPECT_EQ(expected, c_err);
+    EXPECT_EQ(expected, opt_err);
+    // Unaligned and not a multiple of the SIMD width.
+    EXPECT_EQ(ComputeSumSquareError_16(src_a16 + 1, src_b16 + 1, kCount - 1),
+              expected - static_cast<int64>(src_a16[0] - src_b16[0]) *
+                         (src_a16[0] - src_b16[0]));
+  }
+
+  free_aligned_buffer_64(src_a);
+  free_aligned_buffer_64(src_b);
+}
+
+TEST_F(libyuvTest, Psnr_16) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kStride = kWidth + 3;
+  const int kSize = kStride * kHeight;
+  align_buffer_64(src_a, kSize);
+  align_buffer_64(src_b, kSize);
+  align_buffer_64(src_a16, kSize * 2);
+  align_buffer_64(src_b16, kSize * 2);
+  uint16* a16 = reinterpret_cast<uint16*>(src_a16);
+  uint16* b16 = reinterpret_cast<uint16*>(src_b16);
+  for (int i = 0; i < kSize; ++i) {
+    src_a[i] = (random() & 0xff);
+    src_b[i] = (random() & 0xff);
+    a16[i] = src_a[i];
+    b16[i] = src_b[i];
+  }
+
+  // 8 bit values give the same PSNR as CalcFramePsnr.
+  EXPECT_EQ(ComputeSumSquareErrorPlane(src_a, kStride, src_b, kStride,
+                                       kWidth, kHeight),
+            ComputeSumSquareErrorPlane_16(a16, kStride, b16, kStride,
+                                          kWidth, kHeight));
+  EXPECT_NEAR(CalcFramePsnr(src_a, kStride, src_b, kStride, kWidth, kHeight),
+              CalcFramePsnr_16(a16, kStride, b16, kStride, kWidth, kHeight,
+                               8), 0.000001);
+  EXPECT_EQ(kMaxPsnr, CalcFramePsnr_16(a16, kStride, a16, kStride,
+                                       kWidth, kHeight, 10));
+
+  // An error of 1 in 10 bits.
+  for (int i = 0; i < kSize; ++i) {
+    a16[i] = (random() & 0x3fe);
+    b16[i] = a16[i] + 1;
+  }
+  EXPECT_NEAR(10.0 * log10(1023.0 * 1023.0),
+              I010Psnr(a16, kStride, a16, kStride, a16, kStride,
+                       b16, kStride, b16, kStride, b16, kStride,
+                       kWidth, kHeight), 0.000001);
+
+  free_aligned_buffer_64(src_a);
+  free_aligned_buffer_64(src_b);
+  free_aligned_buffer_64(src_a16);
+  free_aligned_buffer_64(src_b16);
+}
+
 TEST_F(libyuvTest, BenchmarkPsnr_Opt) {
   align_buffer_64(src_a, benchmark_width_ * benchmark_height_);
   align_buffer_64(src_b, benchmark_width_ * benchmark_height_);
@@ -516,4 +1031,377 @@ TEST_F(libyuvTest, Ssim) {
   free_aligned_buffer_64(src_b);
 }
 
+TEST_F(libyuvTest, Ssim_16) {
+  const int kWidth = benchmark_width_ < 32 ? 32 : benchmark_width_;
+  const int kHeight = benchmark_height_ < 32 ? 32 : benchmark_height_;
+  const int kSize = kWidth * kHeight;
+  align_buffer_64(src_a, kSize);
+  align_buffer_64(src_b, kSize);
+  align_buffer_64(src_a16, kSize * 2);
+  align_buffer_64(src_b16, kSize * 2);
+  uint16* a16 = reinterpret_cast<uint16*>(src_a16);
+  uint16* b16 = reinterpret_cast<uint16*>(src_b16);
+  for (int i = 0; i < kSize; ++i) {
+    src_a[i] = (random() & 0xff);
+    int value = src_a[i] + (random() & 15) - 8;
+    src_b[i] = static_cast<uint8>(value < 0 ? 0 : value > 255 ? 255 : value);
+    a16[i] = src_a[i];
+    b16[i] = src_b[i];
+  }
+
+  // 8 bit values give the same SSIM as CalcFrameSsim.
+  double ssim = CalcFrameSsim(src_a, kWidth, src_b, kWidth, kWidth, kHeight);
+  EXPECT_NEAR(ssim, CalcFrameSsim_16(a16, kWidth, b16, kWidth,
+                                     kWidth, kHeight, 8), 0.000001);
+
+  // 10 bit values of 4 times the 8 bit values are nearly the same.
+  for (int i = 0; i < kSize; ++i) {
+    a16[i] = src_a[i] << 2;
+    b16[i] = src_b[i] << 2;
+  }
+  EXPECT_NEAR(ssim, CalcFrameSsim_16(a16, kWidth, b16, kWidth,
+                                     kWidth, kHeight, 10), 0.01);
+  EXPECT_EQ(1.0, I010Ssim(a16, kWidth, a16, kWidth, a16, kWidth,
+                          a16, kWidth, a16, kWidth, a16, kWidth,
+                          kWidth, kHeight));
+
+  free_aligned_buffer_64(src_a);
+  free_aligned_buffer_64(src_b);
+  free_aligned_buffer_64(src_a16);
+  free_aligned_buffer_64(src_b16);
+}
+
+TEST_F(libyuvTest, MsSsim) {
+  const int kWidth = benchmark_width_ < 16 ? 16 : benchmark_width_;
+  const int kHeight = benchmark_height_ < 16 ? 16 : benchmark_height_;
+  const int kStride = kWidth + 3;
+  const int kSize = kStride * kHeight;
+  align_buffer_64(src_a, kSize);
+  align_buffer_64(src_b, kSize);
+  for (int i = 0; i < kSize; ++i) {
+    src_a[i] = (random() & 0xff);
+  }
+  memcpy(src_b, src_a, kSize);
+  EXPECT_EQ(1.0, CalcFrameMsSsim(src_a, kStride, src_b, kStride,
+                                 kWidth, kHeight));
+
+  // Small noise keeps most of the structure.
+  for (int i = 0; i < kSize; ++i) {
+    int value = src_a[i] + (random() & 7) - 4;
+    src_b[i] = static_cast<uint8>(value < 0 ? 0 : value > 255 ? 255 : value);
+  }
+  MaskCpuFlags(disable_cpu_flags_);
+  double c_ms_ssim = CalcFrameMsSsim(src_a, kStride, src_b, kStride,
+                                     kWidth, kHeight);
+  MaskCpuFlags(-1);
+  double opt_ms_ssim = 0.0;
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    opt_ms_ssim = CalcFrameMsSsim(src_a, kStride, src_b, kStride,
+                                  kWidth, kHeight);
+  }
+  // Box filters round differently in C and SIMD.
+  EXPECT_NEAR(c_ms_ssim, opt_ms_ssim, 0.001);
+  EXPECT_GT(opt_ms_ssim, 0.5);
+  EXPECT_LT(opt_ms_ssim, 1.0);
+
+  // A plane too small for a second level is plain SSIM.
+  MaskCpuFlags(disable_cpu_flags_);
+  c_ms_ssim = CalcFrameMsSsim(src_a, kStride, src_b, kStride, 16, 16);
+  MaskCpuFlags(-1);
+  opt_ms_ssim = CalcFrameMsSsim(src_a, kStride, src_b, kStride, 16, 16);
+  EXPECT_EQ(c_ms_ssim, opt_ms_ssim);
+  EXPECT_NEAR(CalcFrameSsim(src_a, kStride, src_b, kStride, 16, 16),
+              opt_ms_ssim, 0.000001);
+  EXPECT_EQ(0.0, CalcFrameMsSsim(src_a, kStride, src_b, kStride, 8, 8));
+
+  // Unrelated noise has no structure in common.
+  for (int i = 0; i < kSize; ++i) {
+    src_b[i] = (random() & 0xff);
+  }
+  EXPECT_LT(CalcFrameMsSsim(src_a, kStride, src_b, kStride,
+                            kWidth, kHeight), 0.2);
+
+  free_aligned_buffer_64(src_a);
+  free_aligned_buffer_64(src_b);
+}
+
+TEST_F(libyuvTest, Sad) {
+  const int kStride = 64 + 5;
+  const int kSize = kStride * 64;
+  align_buffer_64(src_a, kSize);
+  align_buffer_64(src_b, kSize);
+  for (int i = 0; i < kSize; ++i) {
+    src_a[i] = (random() & 0xff);
+    src_b[i] = (random() & 0xff);
+  }
+  for (int height = 4; height <= 64; height *= 2) {
+    for (int width = 4; width <= 64; width *= 2) {
+      uint32 expected = 0;
+      for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+          expected += abs(src_a[y * kStride + x] - src_b[y * kStride + x]);
+        }
+      }
+      MaskCpuFlags(disable_cpu_flags_);
+      uint32 c_sad = ComputeSad(src_a + 1, kStride, src_b + 1, kStride,
+                                width, height);
+      MaskCpuFlags(-1);
+      uint32 opt_sad = ComputeSad(src_a + 1, kStride, src_b + 1, kStride,
+                                  width, height);
+      EXPECT_EQ(c_sad, opt_sad);
+      EXPECT_EQ(expected, ComputeSad(src_a, kStride, src_b, kStride,
+                                     width, height));
+    }
+  }
+  memset(src_b, 0, kSize);
+  memset(src_a, 255, kSize);
+  EXPECT_EQ(64u * 64u * 255u, ComputeSad(src_a, kStride, src_b, kStride,
+                                         64, 64));
+  free_aligned_buffer_64(src_a);
+  free_aligned_buffer_64(src_b);
+}
+
+TEST_F(libyuvTest, BenchmarkSadCandidates_Opt) {
+  const int kRange = 16;  // Search +/- 16 pixels.
+  const int kStride = 16 + kRange * 2;
+  const int kNumCandidates = (kRange * 2 + 1) * (kRange * 2 + 1);
+  align_buffer_64(src, 16 * 16);
+  align_buffer_64(ref, kStride * kStride);
+  int* positions = new int[kNumCandidates * 2];
+  uint32* sads = new uint32[kNumCandidates];
+  for (int i = 0; i < 16 * 16; ++i) {
+    src[i] = (random() & 0xff);
+  }
+  for (int i = 0; i < kStride * kStride; ++i) {
+    ref[i] = (random() & 0xff);
+  }
+  for (int i = 0; i < kNumCandidates; ++i) {
+    positions[i * 2] = i % (kRange * 2 + 1) - kRange;
+    positions[i * 2 + 1] = i / (kRange * 2 + 1) - kRange;
+  }
+  const uint8* ref_center = ref + kRange * kStride + kRange;
+  int count = benchmark_iterations_ *
+      ((benchmark_width_ * benchmark_height_ + 255) / 256) / kNumCandidates + 1;
+  for (int i = 0; i < count; ++i) {
+    EXPECT_EQ(0, ComputeSadCandidates(src, 16, ref_center, kStride,
+                                      positions, kNumCandidates, 16, 16,
+                                      sads));
+  }
+  for (int i = 0; i < kNumCandidates; ++i) {
+    const uint8* ref_block = ref_center + positions[i * 2 + 1] * kStride +
+                             positions[i * 2];
+    EXPECT_EQ(ComputeSad(src, 16, ref_block, kStride, 16, 16), sads[i]);
+  }
+  delete[] positions;
+  delete[] sads;
+  free_aligned_buffer_64(src);
+  free_aligned_buffer_64(ref);
+}
+
+TEST_F(libyuvTest, Satd) {
+  const int kStride = 64 + 5;
+  const int kSize = kStride * 64;
+  align_buffer_64(src_a, kSize);
+  align_buffer_64(src_b, kSize);
+  memset(src_a, 100, kSize);
+  memset(src_b, 100, kSize);
+  EXPECT_EQ(0u, ComputeSatd(src_a, kStride, src_b, kStride, 16, 16));
+
+  // A constant difference is only the DC term of each 4x4: 16 * 3 / 2.
+  memset(src_b, 97, kSize);
+  EXPECT_EQ(24u * 16u, ComputeSatd(src_a, kStride, src_b, kStride, 16, 16));
+
+  for (int i = 0; i < kSize; ++i) {
+    src_a[i] = (random() & 0xff);
+    src_b[i] = (random() & 0xff);
+  }
+  for (int height = 4; height <= 64; height *= 2) {
+    for (int width = 4; width <= 64; width *= 2) {
+      MaskCpuFlags(disable_cpu_flags_);
+      uint32 c_satd = ComputeSatd(src_a + 1, kStride, src_b + 1, kStride,
+                                  width, height);
+      MaskCpuFlags(-1);
+      uint32 opt_satd = ComputeSatd(src_a + 1, kStride, src_b + 1, kStride,
+                                    width, height);
+      EXPECT_EQ(c_satd, opt_satd);
+      // SATD is at least half the SAD.
+      EXPECT_GE(c_satd * 2 + 1, ComputeSad(src_a + 1, kStride,
+                                            src_b + 1, kStride,
+                                            width, height));
+    }
+  }
+
+  // Largest differences, alternating in sign, for the range of the sums.
+  for (int i = 0; i < kSize; ++i) {
+    src_a[i] = (i & 1) ? 255 : 0;
+    src_b[i] = (i & 1) ? 0 : 255;
+  }
+  MaskCpuFlags(disable_cpu_flags_);
+  uint32 c_satd = ComputeSatd(src_a, kStride, src_b, kStride, 64, 64);
+  MaskCpuFlags(-1);
+  EXPECT_EQ(c_satd, ComputeSatd(src_a, kStride, src_b, kStride, 64, 64));
+  EXPECT_GT(c_satd, 0u);
+
+  EXPECT_EQ(0u, ComputeSatd(NULL, kStride, src_b, kStride, 16, 16));
+  EXPECT_EQ(0u, ComputeSatd(src_a, kStride, NULL, kStride, 16, 16));
+  EXPECT_EQ(0u, ComputeSatd(src_a, kStride, src_b, kStride, 0, 16));
+  EXPECT_EQ(0u, ComputeSatd(src_a, kStride, src_b, kStride, 16, -4));
+  EXPECT_EQ(0u, ComputeSatd(src_a, kStride, src_b, kStride, 6, 16));
+  EXPECT_EQ(0u, ComputeSatd(src_a, kStride, src_b, kStride, 16, 6));
+  free_aligned_buffer_64(src_a);
+  free_aligned_buffer_64(src_b);
+}
+
+static void TestBlockError(int width, int height, int block_size,
+                           int disable_cpu_flags, int benchmark_iterations,
+                           bool sad) {
+  const int kStride = width + 3;
+  const int kMapWidth = (width + block_size - 1) / block_size;
+  const int kMapHeight = (height + block_size - 1) / block_size;
+  align_buffer_64(src_a, kStride * height);
+  align_buffer_64(src_b, kStride * height);
+  uint32* map_c = new uint32[kMapWidth * kMapHeight];
+  uint32* map_opt = new uint32[kMapWidth * kMapHeight];
+  for (int i = 0; i < kStride * height; ++i) {
+    src_a[i] = (random() & 0xff);
+    src_b[i] = (random() & 0xff);
+  }
+
+  MaskCpuFlags(disable_cpu_flags);
+  if (sad) {
+    EXPECT_EQ(0, ComputeBlockSumAbsDiff(src_a, kStride, src_b, kStride,
+                                        width, height, block_size,
+                                        map_c, kMapWidth));
+  } else {
+    EXPECT_EQ(0, ComputeBlockSumSquareError(src_a, kStride, src_b, kStride,
+                                            width, height, block_size,
+                                            map_c, kMapWidth));
+  }
+  MaskCpuFlags(-1);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    if (sad) {
+      ComputeBlockSumAbsDiff(src_a, kStride, src_b, kStride,
+                             width, height, block_size, map_opt, kMapWidth);
+    } else {
+      ComputeBlockSumSquareError(src_a, kStride, src_b, kStride,
+                                 width, height, block_size,
+                                 map_opt, kMapWidth);
+    }
+  }
+
+  for (int by = 0; by < kMapHeight; ++by) {
+    for (int bx = 0; bx < kMapWidth; ++bx) {
+      uint32 expected = 0;
+      for (int y = by * block_size;
+           y < (by + 1) * block_size && y < height; ++y) {
+        for (int x = bx * block_size;
+             x < (bx + 1) * block_size && x < width; ++x) {
+          int diff = src_a[y * kStride + x] - src_b[y * kStride + x];
+          expected += sad ? abs(diff) : diff * diff;
+        }
+      }
+      EXPECT_EQ(expected, map_c[by * kMapWidth + bx]);
+      EXPECT_EQ(expected, map_opt[by * kMapWidth + bx]);
+    }
+  }
+
+  delete[] map_c;
+  delete[] map_opt;
+  free_aligned_buffer_64(src_a);
+  free_aligned_buffer_64(src_b);
+}
+
+TEST_F(libyuvTest, BlockSumSquareError) {
+  for (int block_size = 8; block_size <= 64; block_size *= 2) {
+    TestBlockError(benchmark_width_, benchmark_height_, block_size,
+                   disable_cpu_flags_, benchmark_iterations_, false);
+  }
+  TestBlockError(1, 1, 8, disable_cpu_flags_, 1, false);
+  TestBlockError(33, 17, 16, disable_cpu_flags_, 1, false);
+  EXPECT_EQ(-1, ComputeBlockSumSquareError(NULL, 0, NULL, 0, 8, 8, 12,
+                                           NULL, 0));
+}
+
+TEST_F(libyuvTest, BlockSumAbsDiff) {
+  for (int block_size = 8; block_size <= 64; block_size *= 2) {
+    TestBlockError(benchmark_width_, benchmark_height_, block_size,
+                   disable_cpu_flags_, benchmark_iterations_, true);
+  }
+  TestBlockError(1, 1, 8, disable_cpu_flags_, 1, true);
+  TestBlockError(33, 17, 16, disable_cpu_flags_, 1, true);
+}
+
+TEST_F(libyuvTest, BlockSsim) {
+  const int kWidth = benchmark_width_ < 9 ? 9 : benchmark_width_;
+  const int kHeight = benchmark_height_ < 9 ? 9 : benchmark_height_;
+  const int kMapWidth = (kWidth + 7) / 8;
+  const int kMapHeight = (kHeight + 7) / 8;
+  align_buffer_64(src_a, kWidth * kHeight);
+  align_buffer_64(src_b, kWidth * kHeight);
+  double* map = new double[kMapWidth * kMapHeight];
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_a[i] = (random() & 0xff);
+  }
+  memcpy(src_b, src_a, kWidth * kHeight);
+
+  for (int block_size = 8; block_size <= 64; block_size *= 2) {
+    const int kBlocksWidth = (kWidth + block_size - 1) / block_size;
+    const int kBlocksHeight = (kHeight + block_size - 1) / block_size;
+    EXPECT_EQ(0, CalcBlockSsim(src_a, kWidth, src_b, kWidth, kWidth, kHeight,
+                               block_size, map, kMapWidth));
+    for (int by = 0; by < kBlocksHeight; ++by) {
+      for (int bx = 0; bx < kBlocksWidth; ++bx) {
+        EXPECT_EQ(1.0, map[by * kMapWidth + bx]);
+      }
+    }
+  }
+
+  // The frame SSIM is the mean of the blocks weighted by the number of
+  // frame windows that start in each block.
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_b[i] = (random() & 0xff);
+  }
+  const double frame_ssim = CalcFrameSsim(src_a, kWidth, src_b, kWidth,
+                                          kWidth, kHeight);
+  int* windows = new int[kMapWidth * kMapHeight];
+  for (int block_size = 8; block_size <= 64; block_size *= 2) {
+    const int kBlocksWidth = (kWidth + block_size - 1) / block_size;
+    const int kBlocksHeight = (kHeight + block_size - 1) / block_size;
+    for (int i = 0; i < benchmark_iterations_; ++i) {
+      CalcBlockSsim(src_a, kWidth, src_b, kWidth, kWidth, kHeight,
+                    block_size, map, kMapWidth);
+    }
+    memset(windows, 0, kMapWidth * kMapHeight * sizeof(int));
+    int samples = 0;
+    for (int y = 0; y < kHeight - 8; y += 4) {
+      for (int x = 0; x < kWidth - 8; x += 4) {
+        ++windows[(y / block_size) * kMapWidth + x / block_size];
+        ++samples;
+      }
+    }
+    double ssim_total = 0.0;
+    for (int by = 0; by < kBlocksHeight; ++by) {
+      for (int bx = 0; bx < kBlocksWidth; ++bx) {
+        ssim_total += windows[by * kMapWidth + bx] * map[by * kMapWidth + bx];
+      }
+    }
+    EXPECT_NEAR(frame_ssim, ssim_total / samples, 1e-9);
+  }
+  // Edge blocks with no window start use the last windows of the plane.
+  if (kWidth >= 16 && kHeight >= 16) {
+    EXPECT_EQ(0, CalcBlockSsim(src_a, kWidth, src_b, kWidth, 16, 16, 8,
+                               map, kMapWidth));
+    EXPECT_NEAR(CalcFrameSsim(src_a + 4 * kWidth + 4, kWidth,
+                              src_b + 4 * kWidth + 4, kWidth, 9, 9),
+                map[kMapWidth + 1], 1e-9);
+  }
+  EXPECT_EQ(-1, CalcBlockSsim(src_a, kWidth, src_b, kWidth, 8, 9, 8,
+                              map, kMapWidth));
+  delete[] windows;
+
+  delete[] map;
+  free_aligned_buffer_64(src_a);
+  free_aligned_buffer_64(src_b);
+}
+
 }  // namespace libyuv
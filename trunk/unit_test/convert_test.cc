@@ -19,10 +19,12 @@
 #include "libyuv/cpu_id.h"
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
+#include "libyuv/mjpeg_encoder.h"
 #endif
 #include "libyuv/planar_functions.h"
 #include "libyuv/rotate.h"
 #include "libyuv/row.h"
+#include "libyuv/row_dispatch.h"
 #include "libyuv/video_common.h"
 #include "../unit_test/unit_test.h"
 
@@ -500,6 +502,7 @@ TESTPLANARTOB(I420, 2, 2, RGB24, 3, 3, 1, 2, ARGB, 4)
 TESTPLANARTOB(I420, 2, 2, RGB565, 2, 2, 1, 9, ARGB, 4)
 TESTPLANARTOB(I420, 2, 2, ARGB1555, 2, 2, 1, 9, ARGB, 4)
 TESTPLANARTOB(I420, 2, 2, ARGB4444, 2, 2, 1, 17, ARGB, 4)
+TESTPLANARTOB(I420, 2, 2, AR30, 4, 4, 1, 2, ARGB, 4)
 TESTPLANARTOB(I422, 2, 1, ARGB, 4, 4, 1, 2, ARGB, 4)
 TESTPLANARTOB(J422, 2, 1, ARGB, 4, 4, 1, 2, ARGB, 4)
 TESTPLANARTOB(I422, 2, 1, BGRA, 4, 4, 1, 2, ARGB, 4)
@@ -910,6 +913,7 @@ TESTATOB(ARGB, 4, 4, 1, RGB24, 3, 3, 1, 0)
 TESTATOB(ARGB, 4, 4, 1, RGB565, 2, 2, 1, 0)
 TESTATOB(ARGB, 4, 4, 1, ARGB1555, 2, 2, 1, 0)
 TESTATOB(ARGB, 4, 4, 1, ARGB4444, 2, 2, 1, 0)
+TESTATOB(ARGB, 4, 4, 1, AR30, 4, 4, 1, 0)
 TESTATOB(ARGB, 4, 4, 1, YUY2, 2, 4, 1, 4)
 TESTATOB(ARGB, 4, 4, 1, UYVY, 2, 4, 1, 4)
 TESTATOB(ARGB, 4, 4, 1, I400, 1, 1, 1, 2)
@@ -922,6 +926,7 @@ TESTATOB(RGB24, 3, 3, 1, ARGB, 4, 4, 1, 0)
 TESTATOB(RGB565, 2, 2, 1, ARGB, 4, 4, 1, 0)
 TESTATOB(ARGB1555, 2, 2, 1, ARGB, 4, 4, 1, 0)
 TESTATOB(ARGB4444, 2, 2, 1, ARGB, 4, 4, 1, 0)
+TESTATOB(AR30, 4, 4, 1, ARGB, 4, 4, 1, 0)
 TESTATOB(YUY2, 2, 4, 1, ARGB, 4, 4, 1, 4)
 TESTATOB(UYVY, 2, 4, 1, ARGB, 4, 4, 1, 4)
 TESTATOB(I400, 1, 1, 1, ARGB, 4, 4, 1, 0)
@@ -1108,6 +1113,151 @@ TEST_F(libyuvTest, Test565) {
   EXPECT_EQ(610919429u, checksum);
 }
 
+#define TESTBAYERTOARGBI(FOURCC, W1280, N, NEG)                                \
+TEST_F(libyuvTest, Bayer##FOURCC##ToARGB##N) {                                 \
+  const int kWidth = ((W1280) > 0) ? (W1280) : 1;                              \
+  const int kHeight = benchmark_height_;                                       \
+  const int kStrideB = kWidth * 4;                                             \
+  align_buffer_page_end(src_bayer, kWidth * kHeight);                          \
+  align_buffer_64(dst_argb_c, kStrideB * kHeight);                             \
+  align_buffer_64(dst_argb_opt, kStrideB * kHeight);                           \
+  srandom(time(NULL));                                                         \
+  for (int i = 0; i < kWidth * kHeight; ++i) {                                 \
+    src_bayer[i] = (random() & 0xff);                                          \
+  }                                                                            \
+  memset(dst_argb_c, 1, kStrideB * kHeight);                                   \
+  memset(dst_argb_opt, 101, kStrideB * kHeight);                               \
+  MaskCpuFlags(disable_cpu_flags_);                                            \
+  BayerToARGB(src_bayer, kWidth, dst_argb_c, kStrideB,                         \
+              kWidth, NEG kHeight, FOURCC_##FOURCC);                           \
+  MaskCpuFlags(-1);                                                            \
+  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
+    BayerToARGB(src_bayer, kWidth, dst_argb_opt, kStrideB,                     \
+                kWidth, NEG kHeight, FOURCC_##FOURCC);                         \
+  }                                                                            \
+  for (int i = 0; i < kStrideB * kHeight; ++i) {                               \
+    EXPECT_EQ(dst_argb_c[i], dst_argb_opt[i]);                                 \
+  }                                                                            \
+  free_aligned_buffer_page_end(src_bayer);                                     \
+  free_aligned_buffer_64(dst_argb_c);                                          \
+  free_aligned_buffer_64(dst_argb_opt);                                        \
+}
+
+#define TESTBAYERTOARGB(FOURCC)                                                \
+    TESTBAYERTOARGBI(FOURCC, benchmark_width_ - 3, _Any, +)                    \
+    TESTBAYERTOARGBI(FOURCC, benchmark_width_, _Invert, -)                     \
+    TESTBAYERTOARGBI(FOURCC, benchmark_width_, _Opt, +)
+
+TESTBAYERTOARGB(RGGB)
+TESTBAYERTOARGB(BGGR)
+TESTBAYERTOARGB(GRBG)
+TESTBAYERTOARGB(GBRG)
+
+// Samples an ARGB image with a Bayer color filter.
+static void ARGBToBayerReference(const uint8* src_argb, int width, int height,
+                                 uint8* dst_bayer, uint32 fourcc) {
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      // Color of this position in the fourcc, for B, G, R byte offsets.
+      int c = (fourcc >> (((y & 1) * 2 + (x & 1)) * 8)) & 0xff;
+      int offset = (c == 'B') ? 0 : (c == 'G') ? 1 : 2;
+      dst_bayer[y * width + x] = src_argb[(y * width + x) * 4 + offset];
+    }
+  }
+}
+
+// A solid color demosaics to the same color, including the edges.
+// At least 2 x 2 pixels are needed to sample all colors.
+TEST_F(libyuvTest, BayerToARGBSolid) {
+  static const uint32 kFourCCs[4] = {
+    FOURCC_RGGB, FOURCC_BGGR, FOURCC_GRBG, FOURCC_GBRG
+  };
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  align_buffer_64(src_argb, kWidth * kHeight * 4);
+  align_buffer_64(src_bayer, kWidth * kHeight);
+  align_buffer_64(dst_argb, kWidth * kHeight * 4);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_argb[i * 4 + 0] = 30u;
+    src_argb[i * 4 + 1] = 120u;
+    src_argb[i * 4 + 2] = 200u;
+    src_argb[i * 4 + 3] = 255u;
+  }
+  for (int f = 0; f < 4; ++f) {
+    ARGBToBayerReference(src_argb, kWidth, kHeight, src_bayer, kFourCCs[f]);
+    memset(dst_argb, 0, kWidth * kHeight * 4);
+    EXPECT_EQ(0, BayerToARGB(src_bayer, kWidth, dst_argb, kWidth * 4,
+                             kWidth, kHeight, kFourCCs[f]));
+    if (kWidth < 2 || kHeight < 2) {
+      continue;
+    }
+    for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+      EXPECT_EQ(src_argb[i], dst_argb[i]);
+    }
+    // Odd crop shifts the pattern.
+    if (kWidth > 2 && kHeight > 2) {
+      memset(dst_argb, 0, kWidth * kHeight * 4);
+      EXPECT_EQ(0, ConvertToARGB(src_bayer, kWidth * kHeight,
+                                 dst_argb, (kWidth - 1) * 4, 1, 1,
+                                 kWidth, kHeight, kWidth - 1, kHeight - 1,
+                                 kRotate0, kFourCCs[f]));
+      for (int i = 0; i < (kWidth - 1) * (kHeight - 1) * 4; ++i) {
+        EXPECT_EQ(src_argb[i], dst_argb[i]);
+      }
+    }
+  }
+  EXPECT_EQ(-1, BayerToARGB(src_bayer, kWidth, dst_argb, kWidth * 4,
+                            kWidth, kHeight, FOURCC_I420));
+  free_aligned_buffer_64(src_argb);
+  free_aligned_buffer_64(src_bayer);
+  free_aligned_buffer_64(dst_argb);
+}
+
+// The fused I420 path matches BayerToARGB followed by ARGBToI420.
+TEST_F(libyuvTest, BayerToI420) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kStrideUV = SUBSAMPLE(kWidth, 2);
+  const int kHeightUV = SUBSAMPLE(kHeight, 2);
+  align_buffer_64(src_bayer, kWidth * kHeight);
+  align_buffer_64(tmp_argb, kWidth * kHeight * 4);
+  align_buffer_64(dst_y_c, kWidth * kHeight);
+  align_buffer_64(dst_u_c, kStrideUV * kHeightUV);
+  align_buffer_64(dst_v_c, kStrideUV * kHeightUV);
+  align_buffer_64(dst_y_opt, kWidth * kHeight);
+  align_buffer_64(dst_u_opt, kStrideUV * kHeightUV);
+  align_buffer_64(dst_v_opt, kStrideUV * kHeightUV);
+  srandom(time(NULL));
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_bayer[i] = (random() & 0xff);
+  }
+  BayerToARGB(src_bayer, kWidth, tmp_argb, kWidth * 4,
+              kWidth, kHeight, FOURCC_GRBG);
+  ARGBToI420(tmp_argb, kWidth * 4,
+             dst_y_c, kWidth, dst_u_c, kStrideUV, dst_v_c, kStrideUV,
+             kWidth, kHeight);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    BayerToI420(src_bayer, kWidth,
+                dst_y_opt, kWidth, dst_u_opt, kStrideUV, dst_v_opt, kStrideUV,
+                kWidth, kHeight, FOURCC_GRBG);
+  }
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    EXPECT_EQ(dst_y_c[i], dst_y_opt[i]);
+  }
+  for (int i = 0; i < kStrideUV * kHeightUV; ++i) {
+    EXPECT_EQ(dst_u_c[i], dst_u_opt[i]);
+    EXPECT_EQ(dst_v_c[i], dst_v_opt[i]);
+  }
+  free_aligned_buffer_64(src_bayer);
+  free_aligned_buffer_64(tmp_argb);
+  free_aligned_buffer_64(dst_y_c);
+  free_aligned_buffer_64(dst_u_c);
+  free_aligned_buffer_64(dst_v_c);
+  free_aligned_buffer_64(dst_y_opt);
+  free_aligned_buffer_64(dst_u_opt);
+  free_aligned_buffer_64(dst_v_opt);
+}
+
 #ifdef HAVE_JPEG
 TEST_F(libyuvTest, ValidateJpeg) {
   const int kOff = 10;
@@ -1185,6 +1335,142 @@ TEST_F(libyuvTest, InvalidateJpeg) {
   free_aligned_buffer_page_end(orig_pixels);
 }
 
+TEST_F(libyuvTest, ScanJpegMarker) {
+  const int kSize = 1280 + 1;
+  align_buffer_64(orig_pixels, kSize);
+  // Mostly 0xff, 0x00 and restart codes, to exercise the skipped sequences.
+  static const uint8 kCodes[8] = {
+    0xff, 0xff, 0xff, 0x00, 0xd0, 0xd7, 0xd9, 0x12
+  };
+  srandom(time(NULL));
+  for (int i = 0; i < kSize; ++i) {
+    orig_pixels[i] = kCodes[random() & 7];
+  }
+  for (int off = 0; off < 64; ++off) {
+    for (int size = 0; size < kSize - off; size += 1 + (size >> 3)) {
+      const uint8* src = orig_pixels + off;
+      size_t expected = size;
+      for (int i = 0; i < size - 1; ++i) {
+        if (src[i] == 0xff && src[i + 1] != 0x00 && src[i + 1] != 0xff &&
+            (src[i + 1] & 0xf8) != 0xd0) {
+          expected = i;
+          break;
+        }
+      }
+      MaskCpuFlags(disable_cpu_flags_);
+      size_t c_pos = ScanJpegMarker(src, size);
+      MaskCpuFlags(-1);
+      size_t opt_pos = ScanJpegMarker(src, size);
+      EXPECT_EQ(expected, c_pos);
+      EXPECT_EQ(expected, opt_pos);
+    }
+  }
+
+  // Only skipped sequences. Expect no marker.
+  for (int i = 0; i < kSize; i += 2) {
+    orig_pixels[i] = 0xff;
+    orig_pixels[i + 1] = (i & 2) ? 0x00 : 0xd3;
+  }
+  orig_pixels[kSize - 1] = 0xff;
+  for (int times = 0; times < benchmark_iterations_; ++times) {
+    EXPECT_EQ(static_cast<size_t>(kSize), ScanJpegMarker(orig_pixels, kSize));
+  }
+  free_aligned_buffer_64(orig_pixels);
+}
+
+// Builds a stream of frames with headers, stuffing and restart markers.
+static int MakeMJpegStream(uint8* dst, int num_frames, int* frame_sizes) {
+  static const uint8 kHeader[] = {
+    0xff, 0xd8,                                // SOI
+    0xff, 0xe0, 0x00, 0x06, 0xff, 0xd9, 0xff, 0xd8,  // APP0 with EOI in it.
+    0xff, 0xff, 0xdb, 0x00, 0x03, 0x00,        // Fill byte, DQT.
+    0xff, 0xda, 0x00, 0x02,                    // SOS
+  };
+  static const uint8 kEntropy[] = {
+    0x12, 0xff, 0x00, 0x34, 0xff, 0xd0, 0x56, 0xff, 0xff, 0x00, 0x78,
+  };
+  int pos = 0;
+  for (int f = 0; f < num_frames; ++f) {
+    // Garbage between frames.
+    for (int i = 0; i < f; ++i) {
+      dst[pos++] = 0xff;
+      dst[pos++] = 0x00;
+    }
+    int frame_start = pos;
+    memcpy(dst + pos, kHeader, sizeof(kHeader));
+    pos += sizeof(kHeader);
+    for (int i = 0; i < f * 5; ++i) {
+      memcpy(dst + pos, kEntropy, sizeof(kEntropy));
+      pos += sizeof(kEntropy);
+    }
+    dst[pos++] = 0xff;
+    dst[pos++] = 0xd9;  // EOI
+    frame_sizes[f] = pos - frame_start;
+  }
+  return pos;
+}
+
+TEST_F(libyuvTest, MJpegFrameSplitter) {
+  const int kNumFrames = 8;
+  align_buffer_64(stream, 4096);
+  int frame_sizes[kNumFrames];
+  int stream_size = MakeMJpegStream(stream, kNumFrames, frame_sizes);
+
+  // Feed the stream in chunks of every size from 1 byte up.
+  for (int chunk = 1; chunk <= stream_size; chunk += (chunk < 64) ? 1 : 97) {
+    MJpegFrameSplitter splitter;
+    int starts = 0;
+    int ends = 0;
+    int pos = 0;
+    int frame_start = 0;
+    while (pos < stream_size) {
+      int end = pos + chunk < stream_size ? pos + chunk : stream_size;
+      while (pos < end) {
+        size_t consumed = 0;
+        MJpegFrameSplitter::Result result =
+            splitter.Scan(stream + pos, end - pos, &consumed);
+        pos += static_cast<int>(consumed);
+        if (result == MJpegFrameSplitter::kFrameStart) {
+          EXPECT_EQ(0xff, stream[pos - 2]);
+          EXPECT_EQ(0xd8, stream[pos - 1]);
+          EXPECT_EQ(2u, splitter.GetFrameSize());
+          frame_start = pos - 2;
+          ++starts;
+        } else if (result == MJpegFrameSplitter::kFrameEnd) {
+          ASSERT_LT(ends, kNumFrames);
+          EXPECT_EQ(static_cast<size_t>(frame_sizes[ends]),
+                    splitter.GetFrameSize());
+          EXPECT_EQ(pos - frame_start, frame_sizes[ends]);
+          EXPECT_TRUE(ValidateJpeg(stream + frame_start, pos - frame_start) ||
+                      pos - frame_start < 64);
+          ++ends;
+        } else {
+          EXPECT_EQ(end, pos);
+        }
+      }
+    }
+    EXPECT_EQ(kNumFrames, starts);
+    EXPECT_EQ(kNumFrames, ends);
+  }
+
+  // A corrupt segment length drops the frame; the next frame is found.
+  MJpegFrameSplitter splitter;
+  stream[5] = 0x01;  // APP0 length of 1.
+  stream[9] = 0x00;  // Remove the SOI in the APP0 payload.
+  int ends = 0;
+  int pos = 0;
+  while (pos < stream_size) {
+    size_t consumed = 0;
+    if (splitter.Scan(stream + pos, stream_size - pos, &consumed) ==
+        MJpegFrameSplitter::kFrameEnd) {
+      ++ends;
+    }
+    pos += static_cast<int>(consumed);
+  }
+  EXPECT_EQ(kNumFrames - 1, ends);
+  free_aligned_buffer_64(stream);
+}
+
 TEST_F(libyuvTest, MJPGToI420) {
   const int kOff = 10;
   const int kMinJpeg = 64;
@@ -1253,6 +1539,208 @@ TEST_F(libyuvTest, MJPGToARGB) {
   free_aligned_buffer_page_end(orig_pixels);
 }
 
+// Fill an I420 frame with smooth gradients so JPEG quality is measurable.
+static void FillI420Gradient(uint8* y, uint8* u, uint8* v,
+                             int width, int height) {
+  const int halfwidth = SUBSAMPLE(width, 2);
+  const int halfheight = SUBSAMPLE(height, 2);
+  for (int i = 0; i < height; ++i) {
+    for (int j = 0; j < width; ++j) {
+      y[i * width + j] = (uint8)(16 + (i * 3 + j * 5) % 220);
+    }
+  }
+  for (int i = 0; i < halfheight; ++i) {
+    for (int j = 0; j < halfwidth; ++j) {
+      u[i * halfwidth + j] = (uint8)(64 + (i * 2 + j) % 128);
+      v[i * halfwidth + j] = (uint8)(192 - (i + j * 2) % 128);
+    }
+  }
+}
+
+#define TESTI420TOMJPG(NAME, W1280, H)                                         \
+TEST_F(libyuvTest, I420ToMJPG##NAME) {                                         \
+  const int kWidth = ((W1280) > 0) ? (W1280) : 1;                              \
+  const int kHeight = ((H) > 0) ? (H) : 1;                                     \
+  const int kHalfWidth = SUBSAMPLE(kWidth, 2);                                 \
+  const int kHalfHeight = SUBSAMPLE(kHeight, 2);                               \
+  const int kSizeUV = kHalfWidth * kHalfHeight;                                \
+  const size_t kMaxSize = MJpegEncoder::MaxEncodedSize(kWidth, kHeight);       \
+  align_buffer_64(src_y, kWidth * kHeight);                                    \
+  align_buffer_64(src_u, kSizeUV);                                             \
+  align_buffer_64(src_v, kSizeUV);                                             \
+  align_buffer_64(dst_y, kWidth * kHeight);                                    \
+  align_buffer_64(dst_u, kSizeUV);                                             \
+  align_buffer_64(dst_v, kSizeUV);                                             \
+  align_buffer_64(dst_mjpg, kMaxSize);                                         \
+  FillI420Gradient(src_y, src_u, src_v, kWidth, kHeight);                      \
+  size_t mjpg_size = 0;                                                        \
+  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
+    mjpg_size = kMaxSize;                                                      \
+    EXPECT_EQ(0, I420ToMJPG(src_y, kWidth, src_u, kHalfWidth,                  \
+                            src_v, kHalfWidth, kWidth, kHeight, 90,            \
+                            dst_mjpg, &mjpg_size));                            \
+  }                                                                            \
+  EXPECT_GT(mjpg_size, 0u);                                                    \
+  EXPECT_LT(mjpg_size, kMaxSize);                                              \
+  EXPECT_EQ(0, MJPGToI420(dst_mjpg, mjpg_size,                                 \
+                          dst_y, kWidth, dst_u, kHalfWidth,                    \
+                          dst_v, kHalfWidth,                                   \
+                          kWidth, kHeight, kWidth, kHeight));                  \
+  EXPECT_GT(CalcFramePsnr(src_y, kWidth, dst_y, kWidth, kWidth, kHeight),      \
+            30.0);                                                             \
+  EXPECT_GT(CalcFramePsnr(src_u, kHalfWidth, dst_u, kHalfWidth,                \
+                          kHalfWidth, kHalfHeight), 30.0);                     \
+  EXPECT_GT(CalcFramePsnr(src_v, kHalfWidth, dst_v, kHalfWidth,                \
+                          kHalfWidth, kHalfHeight), 30.0);                     \
+  free_aligned_buffer_64(src_y);                                               \
+  free_aligned_buffer_64(src_u);                                               \
+  free_aligned_buffer_64(src_v);                                               \
+  free_aligned_buffer_64(dst_y);                                               \
+  free_aligned_buffer_64(dst_u);                                               \
+  free_aligned_buffer_64(dst_v);                                               \
+  free_aligned_buffer_64(dst_mjpg);                                            \
+}
+
+TESTI420TOMJPG(_Opt, benchmark_width_, benchmark_height_)
+TESTI420TOMJPG(_Any, benchmark_width_ - 3, benchmark_height_ - 5)
+
+TEST_F(libyuvTest, NV12ToMJPG) {
+  const int kWidth = (benchmark_width_ > 1) ? benchmark_width_ - 1 : 1;
+  const int kHeight = (benchmark_height_ > 1) ? benchmark_height_ - 1 : 1;
+  const int kHalfWidth = SUBSAMPLE(kWidth, 2);
+  const int kSizeUV = kHalfWidth * SUBSAMPLE(kHeight, 2);
+  const size_t kMaxSize = MJpegEncoder::MaxEncodedSize(kWidth, kHeight);
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kSizeUV);
+  align_buffer_64(src_v, kSizeUV);
+  align_buffer_64(src_uv, kSizeUV * 2);
+  align_buffer_64(dst_mjpg_c, kMaxSize);
+  align_buffer_64(dst_mjpg_opt, kMaxSize);
+  FillI420Gradient(src_y, src_u, src_v, kWidth, kHeight);
+  for (int i = 0; i < kSizeUV; ++i) {
+    src_uv[i * 2 + 0] = src_u[i];
+    src_uv[i * 2 + 1] = src_v[i];
+  }
+  size_t size_c = kMaxSize;
+  EXPECT_EQ(0, I420ToMJPG(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                          kWidth, kHeight, 75, dst_mjpg_c, &size_c));
+  // Same image as NV12 must compress to the same bytes.
+  size_t size_opt = 0;
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    size_opt = kMaxSize;
+    EXPECT_EQ(0, NV12ToMJPG(src_y, kWidth, src_uv, kHalfWidth * 2,
+                            kWidth, kHeight, 75, dst_mjpg_opt, &size_opt));
+  }
+  EXPECT_EQ(size_c, size_opt);
+  EXPECT_EQ(0, memcmp(dst_mjpg_c, dst_mjpg_opt, size_c));
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(src_uv);
+  free_aligned_buffer_64(dst_mjpg_c);
+  free_aligned_buffer_64(dst_mjpg_opt);
+}
+
+TEST_F(libyuvTest, I422ToMJPG) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = SUBSAMPLE(kWidth, 2);
+  const size_t kMaxSize = MJpegEncoder::MaxEncodedSize(kWidth, kHeight);
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kHalfWidth * kHeight);
+  align_buffer_64(src_v, kHalfWidth * kHeight);
+  align_buffer_64(dst_mjpg, kMaxSize);
+  FillI420Gradient(src_y, src_u, src_v, kWidth, kHeight);
+  FillI420Gradient(src_y, src_u + kHalfWidth * SUBSAMPLE(kHeight, 2),
+                   src_v + kHalfWidth * SUBSAMPLE(kHeight, 2),
+                   kWidth, kHeight / 2 * 2);
+  size_t mjpg_size = kMaxSize;
+  EXPECT_EQ(0, I422ToMJPG(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                          kWidth, kHeight, 90, dst_mjpg, &mjpg_size));
+
+  MJpegDecoder mjpeg_decoder;
+  EXPECT_TRUE(mjpeg_decoder.LoadFrame(dst_mjpg, mjpg_size));
+  EXPECT_EQ(kWidth, mjpeg_decoder.GetWidth());
+  EXPECT_EQ(kHeight, mjpeg_decoder.GetHeight());
+  EXPECT_EQ(2, mjpeg_decoder.GetHorizSampFactor(0));
+  EXPECT_EQ(1, mjpeg_decoder.GetVertSampFactor(0));
+  mjpeg_decoder.UnloadFrame();
+
+  // Too small a buffer fails rather than overflowing.
+  mjpg_size = 100;
+  EXPECT_EQ(-1, I422ToMJPG(src_y, kWidth, src_u, kHalfWidth,
+                           src_v, kHalfWidth,
+                           kWidth, kHeight, 90, dst_mjpg, &mjpg_size));
+  EXPECT_EQ(100u, mjpg_size);
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_mjpg);
+}
+
+// Noise at quality 100 is the worst case for the encoded size.
+TEST_F(libyuvTest, MJpegEncoderMaxEncodedSize) {
+  const int kWidth = 256;
+  const int kHeight = 256;
+  const int kHalfWidth = SUBSAMPLE(kWidth, 2);
+  const size_t kMaxSize = MJpegEncoder::MaxEncodedSize(kWidth, kHeight);
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kHalfWidth * kHeight);
+  align_buffer_64(src_v, kHalfWidth * kHeight);
+  align_buffer_64(dst_mjpg, kMaxSize);
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_u, kHalfWidth * kHeight);
+  MemRandomize(src_v, kHalfWidth * kHeight);
+
+  MJpegEncoder encoder;
+  encoder.SetQuality(100);
+  size_t size_i420 = encoder.EncodeI420(src_y, kWidth, src_u, kHalfWidth,
+                                        src_v, kHalfWidth, kWidth, kHeight,
+                                        dst_mjpg, kMaxSize);
+  EXPECT_GT(size_i420, 0u);
+  EXPECT_LE(size_i420, kMaxSize);
+  size_t size_i422 = encoder.EncodeI422(src_y, kWidth, src_u, kHalfWidth,
+                                        src_v, kHalfWidth, kWidth, kHeight,
+                                        dst_mjpg, kMaxSize);
+  EXPECT_GT(size_i422, 0u);
+  EXPECT_LE(size_i422, kMaxSize);
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_mjpg);
+}
+
+TEST_F(libyuvTest, ARGBToMJPG) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const size_t kMaxSize = MJpegEncoder::MaxEncodedSize(kWidth, kHeight);
+  align_buffer_64(src_argb, kWidth * kHeight * 4);
+  align_buffer_64(dst_argb, kWidth * kHeight * 4);
+  align_buffer_64(dst_mjpg, kMaxSize);
+  for (int i = 0; i < kHeight; ++i) {
+    for (int j = 0; j < kWidth; ++j) {
+      uint8* p = src_argb + (i * kWidth + j) * 4;
+      p[0] = (uint8)(j * 2);
+      p[1] = (uint8)(i * 3);
+      p[2] = (uint8)(i + j);
+      p[3] = 255;
+    }
+  }
+  size_t mjpg_size = 0;
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    mjpg_size = kMaxSize;
+    EXPECT_EQ(0, ARGBToMJPG(src_argb, kWidth * 4, kWidth, kHeight, 90,
+                            dst_mjpg, &mjpg_size));
+  }
+  EXPECT_EQ(0, MJPGToARGB(dst_mjpg, mjpg_size, dst_argb, kWidth * 4,
+                          kWidth, kHeight, kWidth, kHeight));
+  EXPECT_GT(CalcFramePsnr(src_argb, kWidth * 4, dst_argb, kWidth * 4,
+                          kWidth * 4, kHeight), 25.0);
+  free_aligned_buffer_64(src_argb);
+  free_aligned_buffer_64(dst_argb);
+  free_aligned_buffer_64(dst_mjpg);
+}
+
 #endif  // HAVE_JPEG
 
 TEST_F(libyuvTest, CropNV12) {
@@ -1449,6 +1937,209 @@ TEST_F(libyuvTest, TestDither) {
   free_aligned_buffer_64(dst_argbdither);
 }
 
+// Strips of 64 pixels must match whole rows, including the last strip.
+TEST_F(libyuvTest, TestARGBToI420Strips) {
+  const int kWidth = benchmark_width_ > 3 ? benchmark_width_ - 3 : 1;
+  const int kHeight = benchmark_height_;
+  const int kStrideUV = (kWidth + 1) / 2;
+  const int kHeightUV = (kHeight + 1) / 2;
+  align_buffer_64(src_argb, kWidth * kHeight * 4);
+  align_buffer_64(dst_y_c, kWidth * kHeight);
+  align_buffer_64(dst_u_c, kStrideUV * kHeightUV);
+  align_buffer_64(dst_v_c, kStrideUV * kHeightUV);
+  align_buffer_64(dst_y_opt, kWidth * kHeight);
+  align_buffer_64(dst_u_opt, kStrideUV * kHeightUV);
+  align_buffer_64(dst_v_opt, kStrideUV * kHeightUV);
+  MemRandomize(src_argb, kWidth * kHeight * 4);
+  memset(dst_y_c, 1, kWidth * kHeight);
+  memset(dst_u_c, 2, kStrideUV * kHeightUV);
+  memset(dst_v_c, 3, kStrideUV * kHeightUV);
+  memset(dst_y_opt, 101, kWidth * kHeight);
+  memset(dst_u_opt, 102, kStrideUV * kHeightUV);
+  memset(dst_v_opt, 103, kStrideUV * kHeightUV);
+  SetRowStripBytes(1 << 30);
+  EXPECT_EQ(kWidth, GetRowStripWidth(kWidth, 11));
+  ARGBToI420(src_argb, kWidth * 4,
+             dst_y_c, kWidth, dst_u_c, kStrideUV, dst_v_c, kStrideUV,
+             kWidth, kHeight);
+  SetRowStripBytes(64 * 11);
+  EXPECT_EQ(kWidth > 64 ? 64 : kWidth, GetRowStripWidth(kWidth, 11));
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    ARGBToI420(src_argb, kWidth * 4,
+               dst_y_opt, kWidth, dst_u_opt, kStrideUV, dst_v_opt, kStrideUV,
+               kWidth, kHeight);
+  }
+  SetRowStripBytes(0);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    EXPECT_EQ(dst_y_c[i], dst_y_opt[i]);
+  }
+  for (int i = 0; i < kStrideUV * kHeightUV; ++i) {
+    EXPECT_EQ(dst_u_c[i], dst_u_opt[i]);
+    EXPECT_EQ(dst_v_c[i], dst_v_opt[i]);
+  }
+  free_aligned_buffer_64(src_argb);
+  free_aligned_buffer_64(dst_y_c);
+  free_aligned_buffer_64(dst_u_c);
+  free_aligned_buffer_64(dst_v_c);
+  free_aligned_buffer_64(dst_y_opt);
+  free_aligned_buffer_64(dst_u_opt);
+  free_aligned_buffer_64(dst_v_opt);
+}
+
+// Streaming stores must write the same pixels as normal stores.
+TEST_F(libyuvTest, TestStreamingStores) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kStrideUV = (kWidth + 1) / 2;
+  const int kSizeUV = kStrideUV * ((kHeight + 1) / 2);
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kSizeUV);
+  align_buffer_64(src_v, kSizeUV);
+  align_buffer_64(dst_argb_c, kWidth * kHeight * 4);
+  align_buffer_64(dst_argb_opt, kWidth * kHeight * 4);
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_u, kSizeUV);
+  MemRandomize(src_v, kSizeUV);
+  memset(dst_argb_c, 1, kWidth * kHeight * 4);
+  memset(dst_argb_opt, 101, kWidth * kHeight * 4);
+
+  SetStreamingStores(kStreamingStoresOff);
+  EXPECT_EQ(0, UseStreamingStores(1));
+  I420ToARGB(src_y, kWidth, src_u, kStrideUV, src_v, kStrideUV,
+             dst_argb_c, kWidth * 4, kWidth, kHeight);
+  SetStreamingStores(kStreamingStoresLarge);
+  EXPECT_EQ(0, UseStreamingStores(1));
+  EXPECT_EQ(1, UseStreamingStores(1LL << 40));
+  SetStreamingStores(kStreamingStoresOn);
+  EXPECT_EQ(1, UseStreamingStores(1));
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    I420ToARGB(src_y, kWidth, src_u, kStrideUV, src_v, kStrideUV,
+               dst_argb_opt, kWidth * 4, kWidth, kHeight);
+  }
+  for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+    EXPECT_EQ(dst_argb_c[i], dst_argb_opt[i]);
+  }
+  memset(dst_argb_opt, 101, kWidth * kHeight * 4);
+  CopyPlane(dst_argb_c, kWidth * 4, dst_argb_opt, kWidth * 4,
+            kWidth * 4, kHeight);
+  SetStreamingStores(kStreamingStoresOff);
+  for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+    EXPECT_EQ(dst_argb_c[i], dst_argb_opt[i]);
+  }
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_argb_c);
+  free_aligned_buffer_64(dst_argb_opt);
+}
+
+// AR30 keeps 8 bits of color, so ARGB round trips with alpha quantized.
+TEST_F(libyuvTest, TestAR30RoundTrip) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  align_buffer_64(src_argb, kWidth * kHeight * 4);
+  align_buffer_64(dst_ar30, kWidth * kHeight * 4);
+  align_buffer_64(dst_argb, kWidth * kHeight * 4);
+  MemRandomize(src_argb, kWidth * kHeight * 4);
+  memset(dst_argb, 101, kWidth * kHeight * 4);
+
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    ARGBToAR30(src_argb, kWidth * 4, dst_ar30, kWidth * 4, kWidth, kHeight);
+  }
+  AR30ToARGB(dst_ar30, kWidth * 4, dst_argb, kWidth * 4, kWidth, kHeight);
+  for (int i = 0; i < kWidth * kHeight * 4; i += 4) {
+    EXPECT_EQ(src_argb[i + 0], dst_argb[i + 0]);
+    EXPECT_EQ(src_argb[i + 1], dst_argb[i + 1]);
+    EXPECT_EQ(src_argb[i + 2], dst_argb[i + 2]);
+    EXPECT_EQ((src_argb[i + 3] >> 6) * 0x55, dst_argb[i + 3]);
+  }
+  free_aligned_buffer_64(src_argb);
+  free_aligned_buffer_64(dst_ar30);
+  free_aligned_buffer_64(dst_argb);
+}
+
+TEST_F(libyuvTest, I010ToAR30) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kStrideUV = (kWidth + 1) / 2;
+  const int kSizeUV = kStrideUV * ((kHeight + 1) / 2);
+  align_buffer_64(src_y, kWidth * kHeight * 2);
+  align_buffer_64(src_u, kSizeUV * 2);
+  align_buffer_64(src_v, kSizeUV * 2);
+  align_buffer_64(dst_ar30_c, kWidth * kHeight * 4);
+  align_buffer_64(dst_ar30_opt, kWidth * kHeight * 4);
+  uint16* src_y16 = reinterpret_cast<uint16*>(src_y);
+  uint16* src_u16 = reinterpret_cast<uint16*>(src_u);
+  uint16* src_v16 = reinterpret_cast<uint16*>(src_v);
+  srandom(time(NULL));
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_y16[i] = random() & 0x3ff;
+  }
+  for (int i = 0; i < kSizeUV; ++i) {
+    src_u16[i] = random() & 0x3ff;
+    src_v16[i] = random() & 0x3ff;
+  }
+  memset(dst_ar30_c, 1, kWidth * kHeight * 4);
+  memset(dst_ar30_opt, 101, kWidth * kHeight * 4);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  I010ToAR30(src_y16, kWidth, src_u16, kStrideUV, src_v16, kStrideUV,
+             dst_ar30_c, kWidth * 4, kWidth, kHeight);
+  MaskCpuFlags(-1);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    I010ToAR30(src_y16, kWidth, src_u16, kStrideUV, src_v16, kStrideUV,
+               dst_ar30_opt, kWidth * 4, kWidth, kHeight);
+  }
+  for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+    EXPECT_EQ(dst_ar30_c[i], dst_ar30_opt[i]);
+  }
+
+  // UV above 10 bits is clamped to 1023.
+  for (int i = 0; i < kSizeUV; ++i) {
+    src_u16[i] = random() & 0xffff;
+    src_v16[i] = random() & 0xffff;
+  }
+  MaskCpuFlags(disable_cpu_flags_);
+  I010ToAR30(src_y16, kWidth, src_u16, kStrideUV, src_v16, kStrideUV,
+             dst_ar30_c, kWidth * 4, kWidth, kHeight);
+  MaskCpuFlags(-1);
+  I010ToAR30(src_y16, kWidth, src_u16, kStrideUV, src_v16, kStrideUV,
+             dst_ar30_opt, kWidth * 4, kWidth, kHeight);
+  for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+    EXPECT_EQ(dst_ar30_c[i], dst_ar30_opt[i]);
+  }
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_ar30_c);
+  free_aligned_buffer_64(dst_ar30_opt);
+}
+
+// The low 2 bits of 10 bit U move B by 2 steps of 10 bit RGB.
+TEST_F(libyuvTest, I010ToAR30FullPrecisionUV) {
+  const int kWidth = 16;
+  uint16 src_y[kWidth * 2];
+  uint16 src_u[kWidth];
+  uint16 src_v[kWidth];
+  uint32 dst_ar30[kWidth * 2];
+  for (int i = 0; i < kWidth * 2; ++i) {
+    src_y[i] = 512;
+  }
+  for (int i = 0; i < kWidth; ++i) {
+    src_u[i] = 508 + (i & 7);
+    src_v[i] = 512;
+  }
+  for (int cpu = 0; cpu < 2; ++cpu) {
+    MaskCpuFlags(cpu ? -1 : disable_cpu_flags_);
+    I010ToAR30(src_y, kWidth * 2, src_u, kWidth, src_v, kWidth,
+               reinterpret_cast<uint8*>(dst_ar30), kWidth * 2 * 4,
+               kWidth * 2, 1);
+    for (int i = 1; i < 8; ++i) {
+      EXPECT_EQ((dst_ar30[(i - 1) * 2] & 1023) + 2, dst_ar30[i * 2] & 1023);
+    }
+  }
+}
+
 #define TESTPLANARTOBID(FMT_PLANAR, SUBSAMP_X, SUBSAMP_Y, FMT_B, BPP_B, ALIGN, \
                        YALIGN, W1280, DIFF, N, NEG, OFF, FMT_C, BPP_C)         \
 TEST_F(libyuvTest, FMT_PLANAR##To##FMT_B##Dither##N) {                         \
@@ -1529,4 +2220,128 @@ TEST_F(libyuvTest, FMT_PLANAR##To##FMT_B##Dither##N) {                         \
 
 TESTPLANARTOBD(I420, 2, 2, RGB565, 2, 2, 1, 9, ARGB, 4)
 
+// The AVX512BW rows must match the rows they follow in the dispatch, for
+// widths of whole vectors and for the _Any_ remainder.  The remainder is
+// done by the C row, which may round differently, from a different column.
+#define TESTATOPLANAR_AVX512BW(FMT_A, BPP_A, FMT_PLANAR, SUBSAMP_Y, DIFF)     \
+TEST_F(libyuvTest, FMT_A##To##FMT_PLANAR##_AVX512BW) {                         \
+  const int kHeight = benchmark_height_;                                       \
+  for (int n = 0; n < 2; ++n) {                                                \
+    const int kWidth = ((benchmark_width_ + 127) & ~127) - n;                  \
+    const int kHalfWidth = SUBSAMPLE(kWidth, 2);                               \
+    const int kSizeUV = kHalfWidth * SUBSAMPLE(kHeight, SUBSAMP_Y);            \
+    align_buffer_64(src_a, kWidth * kHeight * BPP_A);                          \
+    align_buffer_64(dst_y_c, kWidth * kHeight);                                \
+    align_buffer_64(dst_u_c, kSizeUV);                                         \
+    align_buffer_64(dst_v_c, kSizeUV);                                         \
+    align_buffer_64(dst_y_opt, kWidth * kHeight);                              \
+    align_buffer_64(dst_u_opt, kSizeUV);                                       \
+    align_buffer_64(dst_v_opt, kSizeUV);                                       \
+    MemRandomize(src_a, kWidth * kHeight * BPP_A);                             \
+    MaskCpuFlags(~kCpuHasAVX512BW);                                            \
+    FMT_A##To##FMT_PLANAR(src_a, kWidth * BPP_A, dst_y_c, kWidth,              \
+                          dst_u_c, kHalfWidth, dst_v_c, kHalfWidth,            \
+                          kWidth, kHeight);                                    \
+    MaskCpuFlags(-1);                                                          \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      FMT_A##To##FMT_PLANAR(src_a, kWidth * BPP_A, dst_y_opt, kWidth,          \
+                            dst_u_opt, kHalfWidth, dst_v_opt, kHalfWidth,      \
+                            kWidth, kHeight);                                  \
+    }                                                                          \
+    int max_diff = 0;                                                          \
+    for (int i = 0; i < kWidth * kHeight; ++i) {                               \
+      int abs_diff = abs(static_cast<int>(dst_y_c[i]) -                        \
+                         static_cast<int>(dst_y_opt[i]));                      \
+      if (abs_diff > max_diff) {                                               \
+        max_diff = abs_diff;                                                   \
+      }                                                                        \
+    }                                                                          \
+    for (int i = 0; i < kSizeUV; ++i) {                                        \
+      int abs_diff_u = abs(static_cast<int>(dst_u_c[i]) -                      \
+                           static_cast<int>(dst_u_opt[i]));                    \
+      int abs_diff_v = abs(static_cast<int>(dst_v_c[i]) -                      \
+                           static_cast<int>(dst_v_opt[i]));                    \
+      if (abs_diff_u > max_diff) {                                             \
+        max_diff = abs_diff_u;                                                 \
+      }                                                                        \
+      if (abs_diff_v > max_diff) {                                             \
+        max_diff = abs_diff_v;                                                 \
+      }                                                                        \
+    }                                                                          \
+    EXPECT_LE(max_diff, n ? DIFF : 0);                                         \
+    free_aligned_buffer_64(src_a);                                             \
+    free_aligned_buffer_64(dst_y_c);                                           \
+    free_aligned_buffer_64(dst_u_c);                                           \
+    free_aligned_buffer_64(dst_v_c);                                           \
+    free_aligned_buffer_64(dst_y_opt);                                         \
+    free_aligned_buffer_64(dst_u_opt);                                         \
+    free_aligned_buffer_64(dst_v_opt);                                         \
+  }                                                                            \
+}
+
+TESTATOPLANAR_AVX512BW(ARGB, 4, I420, 2, 2)
+TESTATOPLANAR_AVX512BW(YUY2, 2, I420, 2, 0)
+TESTATOPLANAR_AVX512BW(UYVY, 2, I420, 2, 0)
+TESTATOPLANAR_AVX512BW(YUY2, 2, I422, 1, 0)
+TESTATOPLANAR_AVX512BW(UYVY, 2, I422, 1, 0)
+
+TEST_F(libyuvTest, I420ToARGB_AVX512BW) {
+  const int kHeight = benchmark_height_;
+  for (int n = 0; n < 2; ++n) {
+    const int kWidth = ((benchmark_width_ + 127) & ~127) - n;
+    const int kHalfWidth = SUBSAMPLE(kWidth, 2);
+    const int kSizeUV = kHalfWidth * SUBSAMPLE(kHeight, 2);
+    align_buffer_64(src_y, kWidth * kHeight);
+    align_buffer_64(src_u, kSizeUV);
+    align_buffer_64(src_v, kSizeUV);
+    align_buffer_64(dst_argb_c, kWidth * kHeight * 4);
+    align_buffer_64(dst_argb_opt, kWidth * kHeight * 4);
+    MemRandomize(src_y, kWidth * kHeight);
+    MemRandomize(src_u, kSizeUV);
+    MemRandomize(src_v, kSizeUV);
+    MaskCpuFlags(~kCpuHasAVX512BW);
+    I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+               dst_argb_c, kWidth * 4, kWidth, kHeight);
+    MaskCpuFlags(-1);
+    for (int i = 0; i < benchmark_iterations_; ++i) {
+      I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                 dst_argb_opt, kWidth * 4, kWidth, kHeight);
+    }
+    EXPECT_EQ(0, memcmp(dst_argb_c, dst_argb_opt, kWidth * kHeight * 4));
+    free_aligned_buffer_64(src_y);
+    free_aligned_buffer_64(src_u);
+    free_aligned_buffer_64(src_v);
+    free_aligned_buffer_64(dst_argb_c);
+    free_aligned_buffer_64(dst_argb_opt);
+  }
+}
+
+TEST_F(libyuvTest, NV12ToARGB_AVX512BW) {
+  const int kHeight = benchmark_height_;
+  for (int n = 0; n < 2; ++n) {
+    const int kWidth = ((benchmark_width_ + 127) & ~127) - n;
+    const int kStrideUV = SUBSAMPLE(kWidth, 2) * 2;
+    const int kSizeUV = kStrideUV * SUBSAMPLE(kHeight, 2);
+    align_buffer_64(src_y, kWidth * kHeight);
+    align_buffer_64(src_uv, kSizeUV);
+    align_buffer_64(dst_argb_c, kWidth * kHeight * 4);
+    align_buffer_64(dst_argb_opt, kWidth * kHeight * 4);
+    MemRandomize(src_y, kWidth * kHeight);
+    MemRandomize(src_uv, kSizeUV);
+    MaskCpuFlags(~kCpuHasAVX512BW);
+    NV12ToARGB(src_y, kWidth, src_uv, kStrideUV,
+               dst_argb_c, kWidth * 4, kWidth, kHeight);
+    MaskCpuFlags(-1);
+    for (int i = 0; i < benchmark_iterations_; ++i) {
+      NV12ToARGB(src_y, kWidth, src_uv, kStrideUV,
+                 dst_argb_opt, kWidth * 4, kWidth, kHeight);
+    }
+    EXPECT_EQ(0, memcmp(dst_argb_c, dst_argb_opt, kWidth * kHeight * 4));
+    free_aligned_buffer_64(src_y);
+    free_aligned_buffer_64(src_uv);
+    free_aligned_buffer_64(dst_argb_c);
+    free_aligned_buffer_64(dst_argb_opt);
+  }
+}
+
 }  // namespace libyuv
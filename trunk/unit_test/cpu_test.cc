@@ -12,8 +12,12 @@
 #include <string.h>
 
 #include "libyuv/basic_types.h"
+#include "libyuv/convert.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/perf_counters.h"
+#include "libyuv/planar_functions.h"
 #include "libyuv/row.h"  // For HAS_ARGBSHUFFLEROW_AVX2.
+#include "libyuv/row_dispatch.h"
 #include "libyuv/version.h"
 #include "../unit_test/unit_test.h"
 
@@ -26,6 +30,8 @@ TEST_F(libyuvTest, TestCpuHas) {
   printf("Has ARM %x\n", has_arm);
   int has_neon = TestCpuFlag(kCpuHasNEON);
   printf("Has NEON %x\n", has_neon);
+  int has_neon_dotprod = TestCpuFlag(kCpuHasNEON_DOTPROD);
+  printf("Has NEON DOTPROD %x\n", has_neon_dotprod);
   int has_x86 = TestCpuFlag(kCpuHasX86);
   printf("Has X86 %x\n", has_x86);
   int has_sse2 = TestCpuFlag(kCpuHasSSE2);
@@ -40,10 +46,18 @@ TEST_F(libyuvTest, TestCpuHas) {
   printf("Has AVX %x\n", has_avx);
   int has_avx2 = TestCpuFlag(kCpuHasAVX2);
   printf("Has AVX2 %x\n", has_avx2);
+  int has_avx512bw = TestCpuFlag(kCpuHasAVX512BW);
+  printf("Has AVX512BW %x\n", has_avx512bw);
+  int has_avx512vl = TestCpuFlag(kCpuHasAVX512VL);
+  printf("Has AVX512VL %x\n", has_avx512vl);
+  int has_avx512vnni = TestCpuFlag(kCpuHasAVX512VNNI);
+  printf("Has AVX512VNNI %x\n", has_avx512vnni);
   int has_erms = TestCpuFlag(kCpuHasERMS);
   printf("Has ERMS %x\n", has_erms);
   int has_fma3 = TestCpuFlag(kCpuHasFMA3);
   printf("Has FMA3 %x\n", has_fma3);
+  int has_f16c = TestCpuFlag(kCpuHasF16C);
+  printf("Has F16C %x\n", has_f16c);
   int has_mips = TestCpuFlag(kCpuHasMIPS);
   printf("Has MIPS %x\n", has_mips);
   int has_mips_dsp = TestCpuFlag(kCpuHasMIPS_DSP);
@@ -127,6 +141,8 @@ TEST_F(libyuvTest, TestLinuxNeon) {
     EXPECT_EQ(0, ArmCpuCaps("../../unit_test/testdata/arm_v7.txt"));
     EXPECT_EQ(kCpuHasNEON, ArmCpuCaps("../../unit_test/testdata/tegra3.txt"));
     EXPECT_EQ(kCpuHasNEON, ArmCpuCaps("../../unit_test/testdata/juno.txt"));
+    EXPECT_EQ(kCpuHasNEON | kCpuHasNEON_DOTPROD,
+              ArmCpuCaps("../../unit_test/testdata/cortex_a76.txt"));
   } else {
     printf("WARNING: unable to load \"../../unit_test/testdata/arm_v7.txt\"\n");
   }
@@ -135,4 +151,172 @@ TEST_F(libyuvTest, TestLinuxNeon) {
 #endif
 }
 
+TEST_F(libyuvTest, TestCpuCacheInfo) {
+  int l1_data_size, l2_size, l3_size, line_size;
+  int ret = GetCpuCacheInfo(&l1_data_size, &l2_size, &l3_size, &line_size);
+  printf("Cache L1 data %d, L2 %d, L3 %d, line %d\n", l1_data_size, l2_size,
+         l3_size, line_size);
+  if (ret == 0) {
+    EXPECT_GE(l1_data_size, 0);
+    EXPECT_GE(l2_size, l1_data_size);
+    EXPECT_GE(line_size, 0);
+  } else {
+    EXPECT_EQ(0, l1_data_size | l2_size | l3_size);
+  }
+
+  int logical_cores, physical_cores;
+  ret = GetCpuTopology(&logical_cores, &physical_cores);
+  printf("Cores logical %d, physical %d\n", logical_cores, physical_cores);
+  if (ret == 0) {
+    EXPECT_GE(logical_cores, physical_cores);
+    EXPECT_GE(physical_cores, 1);
+  }
+#if defined(__linux__)
+  EXPECT_EQ(0, ret);
+#endif
+}
+
+static int copy_row_count = 0;
+static void CountCopyRow(const uint8* src, uint8* dst, int count) {
+  ++copy_row_count;
+  memcpy(dst, src, count);
+}
+
+TEST_F(libyuvTest, TestRowDispatch) {
+  MaskCpuFlags(0);
+  EXPECT_EQ((RowFunction)(CopyRow_C), GetRowFunction(kRowCopy, 64));
+  EXPECT_EQ((RowFunction)(I422ToARGBRow_C),
+            GetRowFunction(kRowI422ToARGB, 64));
+  MaskCpuFlags(-1);
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    // The table is resolved again for new flags.
+    MaskCpuFlags(kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3);
+    EXPECT_EQ((RowFunction)(I422ToARGBRow_SSSE3),
+              GetRowFunction(kRowI422ToARGB, 64));
+    EXPECT_EQ((RowFunction)(I422ToARGBRow_Any_SSSE3),
+              GetRowFunction(kRowI422ToARGB, 63));
+    MaskCpuFlags(-1);
+  }
+#endif
+  EXPECT_TRUE(NULL == GetRowFunction(kRowFunctionCount, 64));
+  EXPECT_EQ(-1, SetRowFunction(-1, NULL, NULL, 0));
+
+  // More masks than the pool of resolved tables.  Each mask still copies
+  // an unaligned width without writing past it.
+  RowFunction copy_any = GetRowFunction(kRowCopy, 63);
+  for (int i = 0; i < 64; ++i) {
+    uint8 row_src[64];
+    uint8 row_dst[64];
+    memset(row_src, i, sizeof(row_src));
+    memset(row_dst, 255, sizeof(row_dst));
+    MaskCpuFlags(~(((i & 7) * kCpuHasX86) | ((i >> 3) * kCpuHasAVX)));
+    CopyPlane(row_src, 63, row_dst, 63, 63, 1);
+    EXPECT_EQ(i, row_dst[62]);
+    EXPECT_EQ(255, row_dst[63]);
+  }
+  MaskCpuFlags(-1);
+  EXPECT_EQ(copy_any, GetRowFunction(kRowCopy, 63));
+
+  // Override a function and check conversions use it.
+  uint8 src[16 * 4];
+  uint8 dst[16 * 4];
+  memset(src, 7, sizeof(src));
+  memset(dst, 0, sizeof(dst));
+  EXPECT_EQ(0, SetRowFunction(kRowCopy, (RowFunction)(CountCopyRow),
+                              NULL, 0));
+  copy_row_count = 0;
+  CopyPlane(src, 16, dst, 16, 15, 4);
+  EXPECT_EQ(4, copy_row_count);
+  EXPECT_EQ(7, dst[16 * 3 + 14]);
+  EXPECT_EQ(0, dst[15]);
+  EXPECT_EQ(0, SetRowFunction(kRowCopy, NULL, NULL, 0));
+  EXPECT_NE((RowFunction)(CountCopyRow), GetRowFunction(kRowCopy, 16));
+}
+
+TEST_F(libyuvTest, TestRowFunctionName) {
+  MaskCpuFlags(0);
+  EXPECT_STREQ("CopyRow_C", GetRowFunctionName(kRowCopy, 64));
+  EXPECT_STREQ("ARGBToYRow_C", GetRowFunctionName(kRowARGBToY, 64));
+  MaskCpuFlags(-1);
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    MaskCpuFlags(kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3);
+    EXPECT_STREQ("I422ToARGBRow_SSSE3",
+                 GetRowFunctionName(kRowI422ToARGB, 64));
+    EXPECT_STREQ("I422ToARGBRow_Any_SSSE3",
+                 GetRowFunctionName(kRowI422ToARGB, 63));
+    EXPECT_EQ(kCpuHasSSSE3, GetRowFunctionCpuFlag(kRowI422ToARGB));
+    MaskCpuFlags(-1);
+  }
+#endif
+  for (int i = 0; i < kRowFunctionCount; ++i) {
+    printf("%s\n", GetRowFunctionName(i, benchmark_width_));
+  }
+  EXPECT_TRUE(NULL == GetRowFunctionName(kRowFunctionCount, 64));
+  EXPECT_TRUE(NULL == GetRowFunctionName(-1, 64));
+  EXPECT_EQ(0, GetRowFunctionCpuFlag(kRowFunctionCount));
+  MaskCpuFlags(0);
+  EXPECT_EQ(0, GetRowFunctionCpuFlag(kRowI422ToARGB));
+  MaskCpuFlags(-1);
+
+  EXPECT_EQ(0, SetRowFunction(kRowCopy, (RowFunction)(CountCopyRow),
+                              NULL, 0));
+  EXPECT_STREQ("override", GetRowFunctionName(kRowCopy, 64));
+  EXPECT_EQ(0, GetRowFunctionCpuFlag(kRowCopy));
+  EXPECT_EQ(0, SetRowFunction(kRowCopy, NULL, NULL, 0));
+}
+
+TEST_F(libyuvTest, TestPerfCounters) {
+  struct PerfCounter counters[kPerfCounterCount + 1];
+  uint8 src[16 * 4];
+  uint8 dst[16 * 4];
+  memset(src, 7, sizeof(src));
+  ResetPerfCounters();
+  SetPerfCountersEnabled(1);
+  CopyPlane(src, 16, dst, 16, 15, 4);
+  CopyPlane(src, 16, dst, 16, 16, 4);
+  SetPerfCountersEnabled(0);
+  CopyPlane(src, 16, dst, 16, 16, 4);  // Not counted.
+
+  EXPECT_EQ(kPerfCounterCount, GetPerfCounters(counters,
+                                               kPerfCounterCount + 1));
+  EXPECT_EQ(1, GetPerfCounters(counters, 1));
+  EXPECT_EQ(0, GetPerfCounters(NULL, 1));
+  EXPECT_EQ(kPerfCounterCount, GetPerfCounters(counters, kPerfCounterCount));
+  EXPECT_STREQ("I420ToARGB", counters[kPerfI420ToARGB].name);
+  EXPECT_STREQ("CopyPlane", counters[kPerfCopyPlane].name);
+#if defined(LIBYUV_PERF_COUNTERS)
+  EXPECT_EQ(2u, counters[kPerfCopyPlane].calls);
+  EXPECT_EQ(15u * 4 + 16 * 4, counters[kPerfCopyPlane].pixels);
+  EXPECT_EQ(GetRowFunctionCpuFlag(kRowCopy),
+            counters[kPerfCopyPlane].cpu_flags);
+#else
+  EXPECT_EQ(0u, counters[kPerfCopyPlane].calls);
+  EXPECT_EQ(0u, counters[kPerfCopyPlane].pixels);
+#endif
+  EXPECT_EQ(0u, counters[kPerfI420ToARGB].calls);
+
+  ResetPerfCounters();
+  GetPerfCounters(counters, kPerfCounterCount);
+  EXPECT_EQ(0u, counters[kPerfCopyPlane].calls);
+  EXPECT_EQ(0u, counters[kPerfCopyPlane].nanoseconds);
+
+  // I420Copy records the row functions of the CopyPlane calls it makes, and
+  // C only when the cpu flags are masked off.
+  SetPerfCountersEnabled(1);
+  I420Copy(src, 16, src, 8, src, 8, dst, 16, dst + 32, 8, dst + 48, 8, 16, 2);
+  MaskCpuFlags(0);
+  CopyPlane(src, 16, dst, 16, 16, 4);
+  MaskCpuFlags(-1);
+  SetPerfCountersEnabled(0);
+  GetPerfCounters(counters, kPerfCounterCount);
+#if defined(LIBYUV_PERF_COUNTERS)
+  EXPECT_EQ(1u, counters[kPerfI420Copy].calls);
+  EXPECT_EQ(GetRowFunctionCpuFlag(kRowCopy), counters[kPerfI420Copy].cpu_flags);
+  EXPECT_EQ(0, counters[kPerfCopyPlane].cpu_flags);
+#endif
+  EXPECT_EQ(0, counters[kPerfI420ToARGB].cpu_flags);
+}
+
 }  // namespace libyuv
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <math.h>
 #include <stdlib.h>
 #include <time.h>
 
@@ -2198,4 +2199,363 @@ TEST_F(libyuvTest, SetPlane_Opt) {
   EXPECT_EQ(0, max_diff);
 }
 
+// x * scale + bias in double, and the most a float computation of it can be
+// off by.  The multiply and the add each round by at most half an epsilon of
+// |x * scale| + |bias|, or not at all for the multiply if the compiler fuses
+// them, so the C and SIMD rows need not give the same bits.
+static double ScaleBiasRef(double x, float scale, float bias) {
+  return x * static_cast<double>(scale) + static_cast<double>(bias);
+}
+
+static double ScaleBiasTolerance(double x, float scale, float bias) {
+  return (fabs(x * scale) + fabs(static_cast<double>(bias))) *
+      (1.0 / 8388608.0);  // 2^-23 is the float epsilon.
+}
+
+static double HalfToDouble(uint16 h) {
+  int exp = (h >> 10) & 0x1f;
+  int mant = h & 0x3ff;
+  double value = exp ? ldexp(static_cast<double>(mant | 0x400), exp - 25) :
+      ldexp(static_cast<double>(mant), -24);
+  return (h & 0x8000) ? -value : value;
+}
+
+TEST_F(libyuvTest, TestARGBToPlanarFloat) {
+  // Any width, so the remainder of the SIMD rows is exercised.
+  const int kWidth = benchmark_width_ > 1 ? benchmark_width_ - 1 : 1;
+  const int kPixels = kWidth * benchmark_height_;
+  const float kScale[3] = { 1.f / 255.f, 2.f / 255.f, 0.5f };
+  const float kBias[3] = { -0.485f, -0.456f, 3.f };
+  align_buffer_64(orig_pixels, kPixels * 4);
+  align_buffer_64(dst_c, kPixels * 4 * 3);
+  align_buffer_64(dst_opt, kPixels * 4 * 3);
+  float* dst_c_f = reinterpret_cast<float*>(dst_c);
+  float* dst_opt_f = reinterpret_cast<float*>(dst_opt);
+
+  MemRandomize(orig_pixels, kPixels * 4);
+  memset(dst_c, 1, kPixels * 4 * 3);
+  memset(dst_opt, 101, kPixels * 4 * 3);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  ARGBToPlanarFloat(orig_pixels, kWidth * 4,
+                    dst_c_f, kWidth,
+                    dst_c_f + kPixels, kWidth,
+                    dst_c_f + kPixels * 2, kWidth,
+                    kScale, kBias, kWidth, benchmark_height_);
+  MaskCpuFlags(-1);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    ARGBToPlanarFloat(orig_pixels, kWidth * 4,
+                      dst_opt_f, kWidth,
+                      dst_opt_f + kPixels, kWidth,
+                      dst_opt_f + kPixels * 2, kWidth,
+                      kScale, kBias, kWidth, benchmark_height_);
+  }
+  for (int i = 0; i < kPixels; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      const double x = orig_pixels[i * 4 + 2 - j];
+      const double ref = ScaleBiasRef(x, kScale[j], kBias[j]);
+      const double tolerance = ScaleBiasTolerance(x, kScale[j], kBias[j]);
+      EXPECT_NEAR(ref, dst_c_f[i + kPixels * j], tolerance);
+      EXPECT_NEAR(ref, dst_opt_f[i + kPixels * j], tolerance);
+    }
+  }
+
+  free_aligned_buffer_64(orig_pixels);
+  free_aligned_buffer_64(dst_c);
+  free_aligned_buffer_64(dst_opt);
+}
+
+// NV12 to planar float matches NV12ToARGB followed by ARGBToPlanarFloat, to
+// within float rounding.
+TEST_F(libyuvTest, TestNV12ToPlanarRGBFloat) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kStrideUV = (kWidth + 1) / 2 * 2;
+  const int kSizeUV = kStrideUV * ((kHeight + 1) / 2);
+  const int kPixels = kWidth * kHeight;
+  const float kScale[3] = { 1.f / 58.395f, 1.f / 57.12f, 1.f / 57.375f };
+  const float kBias[3] = { -123.675f / 58.395f, -116.28f / 57.12f,
+                           -103.53f / 57.375f };
+  align_buffer_64(src_y, kPixels);
+  align_buffer_64(src_uv, kSizeUV);
+  align_buffer_64(argb, kPixels * 4);
+  align_buffer_64(dst_c, kPixels * 4 * 3);
+  align_buffer_64(dst_opt, kPixels * 4 * 3);
+  float* dst_c_f = reinterpret_cast<float*>(dst_c);
+  float* dst_opt_f = reinterpret_cast<float*>(dst_opt);
+
+  MemRandomize(src_y, kPixels);
+  MemRandomize(src_uv, kSizeUV);
+  memset(dst_c, 1, kPixels * 4 * 3);
+  memset(dst_opt, 101, kPixels * 4 * 3);
+
+  NV12ToARGB(src_y, kWidth, src_uv, kStrideUV, argb, kWidth * 4,
+             kWidth, kHeight);
+  ARGBToPlanarFloat(argb, kWidth * 4,
+                    dst_c_f, kWidth,
+                    dst_c_f + kPixels, kWidth,
+                    dst_c_f + kPixels * 2, kWidth,
+                    kScale, kBias, kWidth, kHeight);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    NV12ToPlanarRGBFloat(src_y, kWidth, src_uv, kStrideUV,
+                         dst_opt_f, kWidth,
+                         dst_opt_f + kPixels, kWidth,
+                         dst_opt_f + kPixels * 2, kWidth,
+                         kScale, kBias, kWidth, kHeight);
+  }
+  // The two paths may finish a row with different row functions.
+  for (int i = 0; i < kPixels; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      const double x = argb[i * 4 + 2 - j];
+      const double ref = ScaleBiasRef(x, kScale[j], kBias[j]);
+      const double tolerance = ScaleBiasTolerance(x, kScale[j], kBias[j]);
+      EXPECT_NEAR(ref, dst_c_f[i + kPixels * j], tolerance);
+      EXPECT_NEAR(ref, dst_opt_f[i + kPixels * j], tolerance);
+    }
+  }
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_uv);
+  free_aligned_buffer_64(argb);
+  free_aligned_buffer_64(dst_c);
+  free_aligned_buffer_64(dst_opt);
+}
+
+TEST_F(libyuvTest, TestHalfFloatPlane) {
+  const int kWidth = benchmark_width_ > 1 ? benchmark_width_ - 1 : 1;
+  const int kPixels = kWidth * benchmark_height_;
+  align_buffer_64(orig_pixels, kPixels * 4);
+  align_buffer_64(dst_c, kPixels * 2);
+  align_buffer_64(dst_opt, kPixels * 2);
+  float* orig_f = reinterpret_cast<float*>(orig_pixels);
+  uint16* dst_c_16 = reinterpret_cast<uint16*>(dst_c);
+  uint16* dst_opt_16 = reinterpret_cast<uint16*>(dst_opt);
+
+  // Random bits cover denormals, overflow, Inf and NaN.  x * 1 + 0 is exact
+  // whether or not the multiply and add are fused, so all paths match.
+  MemRandomize(orig_pixels, kPixels * 4);
+  MaskCpuFlags(disable_cpu_flags_);
+  HalfFloatPlane(orig_f, kWidth, dst_c_16, kWidth, 1.f, 0.f,
+                 kWidth, benchmark_height_);
+  MaskCpuFlags(-1);
+  HalfFloatPlane(orig_f, kWidth, dst_opt_16, kWidth, 1.f, 0.f,
+                 kWidth, benchmark_height_);
+  for (int i = 0; i < kPixels; ++i) {
+    EXPECT_EQ(dst_c_16[i], dst_opt_16[i]);
+  }
+
+  for (int i = 0; i < kPixels; ++i) {
+    orig_f[i] = static_cast<float>(i & 1023);
+  }
+  MaskCpuFlags(disable_cpu_flags_);
+  HalfFloatPlane(orig_f, kWidth, dst_c_16, kWidth, 1.f / 1023.f, -0.5f,
+                 kWidth, benchmark_height_);
+  MaskCpuFlags(-1);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    HalfFloatPlane(orig_f, kWidth, dst_opt_16, kWidth, 1.f / 1023.f, -0.5f,
+                   kWidth, benchmark_height_);
+  }
+  // Rounding to half adds up to 1 half ulp, which is 2^-10 of the value.
+  for (int i = 0; i < kPixels; ++i) {
+    const double x = orig_f[i];
+    const double ref = ScaleBiasRef(x, 1.f / 1023.f, -0.5f);
+    const double tolerance = ScaleBiasTolerance(x, 1.f / 1023.f, -0.5f) +
+        fabs(ref) * (1.0 / 1024.0) + 1.0 / 16777216.0;
+    EXPECT_NEAR(ref, HalfToDouble(dst_c_16[i]), tolerance);
+    EXPECT_NEAR(ref, HalfToDouble(dst_opt_16[i]), tolerance);
+  }
+  orig_f[0] = 1.f;
+  orig_f[1] = 65504.f;
+  orig_f[2] = -2.f;
+  orig_f[3] = 1.f / 16777216.f;  // Smallest half denormal.
+  HalfFloatPlane(orig_f, 4, dst_c_16, 4, 1.f, 0.f, 4, 1);
+  EXPECT_EQ(0x3c00, dst_c_16[0]);
+  EXPECT_EQ(0x7bff, dst_c_16[1]);
+  EXPECT_EQ(0xc000, dst_c_16[2]);
+  EXPECT_EQ(0x0001, dst_c_16[3]);
+
+  free_aligned_buffer_64(orig_pixels);
+  free_aligned_buffer_64(dst_c);
+  free_aligned_buffer_64(dst_opt);
+}
+
+TEST_F(libyuvTest, TestSplitRGBPlane) {
+  const int kWidth = benchmark_width_ > 1 ? benchmark_width_ - 1 : 1;
+  const int kPixels = kWidth * benchmark_height_;
+  align_buffer_64(src_pixels, kPixels * 3);
+  align_buffer_64(tmp_pixels_r, kPixels);
+  align_buffer_64(tmp_pixels_g, kPixels);
+  align_buffer_64(tmp_pixels_b, kPixels);
+  align_buffer_64(dst_pixels_opt, kPixels * 3);
+  align_buffer_64(dst_pixels_c, kPixels * 3);
+
+  MemRandomize(src_pixels, kPixels * 3);
+  memset(dst_pixels_opt, 0, kPixels * 3);
+  memset(dst_pixels_c, 1, kPixels * 3);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  SplitRGBPlane(src_pixels, kWidth * 3,
+                tmp_pixels_r, kWidth, tmp_pixels_g, kWidth,
+                tmp_pixels_b, kWidth, kWidth, benchmark_height_);
+  MergeRGBPlane(tmp_pixels_r, kWidth, tmp_pixels_g, kWidth,
+                tmp_pixels_b, kWidth, dst_pixels_c, kWidth * 3,
+                kWidth, benchmark_height_);
+  MaskCpuFlags(-1);
+
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    SplitRGBPlane(src_pixels, kWidth * 3,
+                  tmp_pixels_r, kWidth, tmp_pixels_g, kWidth,
+                  tmp_pixels_b, kWidth, kWidth, benchmark_height_);
+  }
+  for (int i = 0; i < kPixels; ++i) {
+    EXPECT_EQ(src_pixels[i * 3 + 0], tmp_pixels_r[i]);
+    EXPECT_EQ(src_pixels[i * 3 + 1], tmp_pixels_g[i]);
+    EXPECT_EQ(src_pixels[i * 3 + 2], tmp_pixels_b[i]);
+  }
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    MergeRGBPlane(tmp_pixels_r, kWidth, tmp_pixels_g, kWidth,
+                  tmp_pixels_b, kWidth, dst_pixels_opt, kWidth * 3,
+                  kWidth, benchmark_height_);
+  }
+  for (int i = 0; i < kPixels * 3; ++i) {
+    EXPECT_EQ(src_pixels[i], dst_pixels_opt[i]);
+    EXPECT_EQ(dst_pixels_c[i], dst_pixels_opt[i]);
+  }
+
+  free_aligned_buffer_64(src_pixels);
+  free_aligned_buffer_64(tmp_pixels_r);
+  free_aligned_buffer_64(tmp_pixels_g);
+  free_aligned_buffer_64(tmp_pixels_b);
+  free_aligned_buffer_64(dst_pixels_opt);
+  free_aligned_buffer_64(dst_pixels_c);
+}
+
+TEST_F(libyuvTest, TestARGBToGBRP) {
+  const int kWidth = benchmark_width_ > 1 ? benchmark_width_ - 1 : 1;
+  const int kPixels = kWidth * benchmark_height_;
+  align_buffer_64(src_pixels, kPixels * 4);
+  align_buffer_64(tmp_pixels_g, kPixels);
+  align_buffer_64(tmp_pixels_b, kPixels);
+  align_buffer_64(tmp_pixels_r, kPixels);
+  align_buffer_64(dst_pixels_opt, kPixels * 4);
+  align_buffer_64(dst_pixels_c, kPixels * 4);
+
+  MemRandomize(src_pixels, kPixels * 4);
+  memset(dst_pixels_opt, 0, kPixels * 4);
+  memset(dst_pixels_c, 1, kPixels * 4);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  ARGBToGBRP(src_pixels, kWidth * 4,
+             tmp_pixels_g, kWidth, tmp_pixels_b, kWidth,
+             tmp_pixels_r, kWidth, kWidth, benchmark_height_);
+  GBRPToARGB(tmp_pixels_g, kWidth, tmp_pixels_b, kWidth,
+             tmp_pixels_r, kWidth, dst_pixels_c, kWidth * 4,
+             kWidth, benchmark_height_);
+  MaskCpuFlags(-1);
+
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    ARGBToGBRP(src_pixels, kWidth * 4,
+               tmp_pixels_g, kWidth, tmp_pixels_b, kWidth,
+               tmp_pixels_r, kWidth, kWidth, benchmark_height_);
+  }
+  for (int i = 0; i < kPixels; ++i) {
+    EXPECT_EQ(src_pixels[i * 4 + 0], tmp_pixels_b[i]);
+    EXPECT_EQ(src_pixels[i * 4 + 1], tmp_pixels_g[i]);
+    EXPECT_EQ(src_pixels[i * 4 + 2], tmp_pixels_r[i]);
+  }
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    GBRPToARGB(tmp_pixels_g, kWidth, tmp_pixels_b, kWidth,
+               tmp_pixels_r, kWidth, dst_pixels_opt, kWidth * 4,
+               kWidth, benchmark_height_);
+  }
+  for (int i = 0; i < kPixels; ++i) {
+    EXPECT_EQ(src_pixels[i * 4 + 0], dst_pixels_opt[i * 4 + 0]);
+    EXPECT_EQ(src_pixels[i * 4 + 1], dst_pixels_opt[i * 4 + 1]);
+    EXPECT_EQ(src_pixels[i * 4 + 2], dst_pixels_opt[i * 4 + 2]);
+    EXPECT_EQ(255, dst_pixels_opt[i * 4 + 3]);
+  }
+  for (int i = 0; i < kPixels * 4; ++i) {
+    EXPECT_EQ(dst_pixels_c[i], dst_pixels_opt[i]);
+  }
+
+  free_aligned_buffer_64(src_pixels);
+  free_aligned_buffer_64(tmp_pixels_g);
+  free_aligned_buffer_64(tmp_pixels_b);
+  free_aligned_buffer_64(tmp_pixels_r);
+  free_aligned_buffer_64(dst_pixels_opt);
+  free_aligned_buffer_64(dst_pixels_c);
+}
+
+// ARGBBlend and ARGBInterpolate with the AVX512BW rows must match the rows
+// they follow in the dispatch, for whole vectors and for the remainder.  An
+// interpolated remainder is done by the C row, which may round differently,
+// from a different column.
+TEST_F(libyuvTest, ARGBBlend_AVX512BW) {
+  const int kHeight = benchmark_height_;
+  for (int n = 0; n < 2; ++n) {
+    const int kWidth = ((benchmark_width_ + 63) & ~63) - n;
+    const int kSize = kWidth * kHeight * 4;
+    align_buffer_64(src_argb_a, kSize);
+    align_buffer_64(src_argb_b, kSize);
+    align_buffer_64(dst_argb_c, kSize);
+    align_buffer_64(dst_argb_opt, kSize);
+    MemRandomize(src_argb_a, kSize);
+    MemRandomize(src_argb_b, kSize);
+    ARGBAttenuate(src_argb_a, kWidth * 4, src_argb_a, kWidth * 4,
+                  kWidth, kHeight);
+    MaskCpuFlags(~kCpuHasAVX512BW);
+    ARGBBlend(src_argb_a, kWidth * 4, src_argb_b, kWidth * 4,
+              dst_argb_c, kWidth * 4, kWidth, kHeight);
+    MaskCpuFlags(-1);
+    for (int i = 0; i < benchmark_iterations_; ++i) {
+      ARGBBlend(src_argb_a, kWidth * 4, src_argb_b, kWidth * 4,
+                dst_argb_opt, kWidth * 4, kWidth, kHeight);
+    }
+    EXPECT_EQ(0, memcmp(dst_argb_c, dst_argb_opt, kSize));
+    free_aligned_buffer_64(src_argb_a);
+    free_aligned_buffer_64(src_argb_b);
+    free_aligned_buffer_64(dst_argb_c);
+    free_aligned_buffer_64(dst_argb_opt);
+  }
+}
+
+TEST_F(libyuvTest, ARGBInterpolate_AVX512BW) {
+  const int kHeight = benchmark_height_;
+  for (int n = 0; n < 2; ++n) {
+    const int kWidth = ((benchmark_width_ + 63) & ~63) - n;
+    const int kSize = kWidth * kHeight * 4;
+    align_buffer_64(src_argb_a, kSize);
+    align_buffer_64(src_argb_b, kSize);
+    align_buffer_64(dst_argb_c, kSize);
+    align_buffer_64(dst_argb_opt, kSize);
+    MemRandomize(src_argb_a, kSize);
+    MemRandomize(src_argb_b, kSize);
+    static const int kFractions[] = { 0, 1, 64, 128, 255 };
+    for (int f = 0; f < 5; ++f) {
+      const int kFraction = kFractions[f];
+      MaskCpuFlags(~kCpuHasAVX512BW);
+      ARGBInterpolate(src_argb_a, kWidth * 4, src_argb_b, kWidth * 4,
+                      dst_argb_c, kWidth * 4, kWidth, kHeight, kFraction);
+      MaskCpuFlags(-1);
+      for (int i = 0; i < benchmark_iterations_; ++i) {
+        ARGBInterpolate(src_argb_a, kWidth * 4, src_argb_b, kWidth * 4,
+                        dst_argb_opt, kWidth * 4, kWidth, kHeight, kFraction);
+      }
+      int max_diff = 0;
+      for (int i = 0; i < kSize; ++i) {
+        int abs_diff = abs(static_cast<int>(dst_argb_c[i]) -
+                           static_cast<int>(dst_argb_opt[i]));
+        if (abs_diff > max_diff) {
+          max_diff = abs_diff;
+        }
+      }
+      EXPECT_LE(max_diff, n ? 1 : 0);
+    }
+    free_aligned_buffer_64(src_argb_a);
+    free_aligned_buffer_64(src_argb_b);
+    free_aligned_buffer_64(dst_argb_c);
+    free_aligned_buffer_64(dst_argb_opt);
+  }
+}
+
 }  // namespace libyuv
@@ -363,4 +363,43 @@ TEST_SCALETO(Scale, 1280, 720)
 #undef TEST_SCALETO1
 #undef TEST_SCALETO
 
+// Halving with the AVX512BW ScaleRowDown2 rows must match the rows they
+// follow in the dispatch to within 1, for whole vectors and for the
+// remainder.  The SSE2 box filter averages pairs twice, so it can round up
+// by 1 where the C and AVX512BW box filters do not.
+TEST_F(libyuvTest, ScaleDownBy2_AVX512BW) {
+  const int kSrcHeight = benchmark_height_ * 2;
+  for (int n = 0; n < 2; ++n) {
+    const int kDstWidth = ((benchmark_width_ + 63) & ~63) - n;
+    const int kSrcWidth = kDstWidth * 2;
+    const int kDstHeight = benchmark_height_;
+    align_buffer_page_end(src, kSrcWidth * kSrcHeight)
+    align_buffer_page_end(dst_c, kDstWidth * kDstHeight)
+    align_buffer_page_end(dst_opt, kDstWidth * kDstHeight)
+    MemRandomize(src, kSrcWidth * kSrcHeight);
+    for (int f = 0; f < 4; ++f) {
+      FilterMode filter = static_cast<FilterMode>(f);
+      MaskCpuFlags(~kCpuHasAVX512BW);
+      ScalePlane(src, kSrcWidth, kSrcWidth, kSrcHeight,
+                 dst_c, kDstWidth, kDstWidth, kDstHeight, filter);
+      MaskCpuFlags(-1);
+      for (int i = 0; i < benchmark_iterations_; ++i) {
+        ScalePlane(src, kSrcWidth, kSrcWidth, kSrcHeight,
+                   dst_opt, kDstWidth, kDstWidth, kDstHeight, filter);
+      }
+      int max_diff = 0;
+      for (int i = 0; i < kDstWidth * kDstHeight; ++i) {
+        int abs_diff = Abs(dst_c[i] - dst_opt[i]);
+        if (abs_diff > max_diff) {
+          max_diff = abs_diff;
+        }
+      }
+      EXPECT_LE(max_diff, 1);
+    }
+    free_aligned_buffer_page_end(src)
+    free_aligned_buffer_page_end(dst_c)
+    free_aligned_buffer_page_end(dst_opt)
+  }
+}
+
 }  // namespace libyuv
@@ -0,0 +1,497 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Micro benchmark of row kernels and public functions.
+// Each benchmark is timed for each instruction set the cpu has, selected
+// with MaskCpuFlags, at sizes that fit in L1, L2, L3 and DRAM, and at an
+// odd width (_Any_ kernels) and unaligned pointers.  Results are written as
+// JSON with ns/pixel, cycles/pixel and GB/s.  Cycles are time stamp counter
+// cycles, which run at the nominal frequency of the cpu.
+//
+// -roofline measures copy bandwidth of DRAM sized frames as a roofline and
+// reports each public function as a fraction of it, for the bytes the
+// function reads and writes.  A fraction near 1 is bandwidth bound, where
+// only touching fewer bytes, ie fusing passes or non-temporal stores, helps.
+// A low fraction is compute bound.
+//
+// Usage: libyuv_benchmark [-time <sec>] [-filter <name>] [-json <file>]
+//                         [-roofline]
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>  // For __rdtsc()
+#define HAS_RDTSC
+#elif defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>  // For __rdtsc()
+#define HAS_RDTSC
+#endif
+
+#include "libyuv.h"
+#include "libyuv/row_dispatch.h"
+
+using namespace libyuv;  // NOLINT
+
+// options
+double min_time = 0.05;  // Seconds to run each benchmark.
+const char* name_filter = NULL;
+const char* json_filename = NULL;
+bool do_roofline = false;
+
+#ifdef _WIN32
+static double get_time() {
+  LARGE_INTEGER t, f;
+  QueryPerformanceCounter(&t);
+  QueryPerformanceFrequency(&f);
+  return static_cast<double>(t.QuadPart) / static_cast<double>(f.QuadPart);
+}
+#else
+static double get_time() {
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec * 1e-6;
+}
+#endif
+
+static uint64 get_cycles() {
+#ifdef HAS_RDTSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// Source and destination buffers large enough for 4 bytes per pixel.
+// I420 planes and ARGB images start at the same address.
+struct Buffers {
+  uint8* src;
+  uint8* dst;
+};
+
+typedef void (*BenchmarkFunction)(const Buffers& b, int width, int height);
+
+struct Benchmark {
+  const char* name;
+  BenchmarkFunction function;
+  int row_function_id;  // Reports the kernel name.  -1 for none.
+  double bytes_per_pixel;  // Bytes read and written.
+};
+
+// Row kernels, called directly through the dispatch table.
+static void BenchI422ToARGBRow(const Buffers& b, int width, int height) {
+  I422ToARGBRowFunction I422ToARGBRow =
+      (I422ToARGBRowFunction)(GetRowFunction(kRowI422ToARGB, width));
+  const uint8* src_u = b.src + width * height;
+  const uint8* src_v = src_u + width * height / 2;
+  for (int y = 0; y < height; ++y) {
+    I422ToARGBRow(b.src + y * width, src_u + y * (width / 2),
+                  src_v + y * (width / 2), b.dst + y * width * 4, width);
+  }
+}
+
+static void BenchARGBToYRow(const Buffers& b, int width, int height) {
+  ARGBToYRowFunction ARGBToYRow =
+      (ARGBToYRowFunction)(GetRowFunction(kRowARGBToY, width));
+  for (int y = 0; y < height; ++y) {
+    ARGBToYRow(b.src + y * width * 4, b.dst + y * width, width);
+  }
+}
+
+static void BenchARGBToUVRow(const Buffers& b, int width, int height) {
+  ARGBToUVRowFunction ARGBToUVRow =
+      (ARGBToUVRowFunction)(GetRowFunction(kRowARGBToUV, width));
+  uint8* dst_v = b.dst + width * height / 4;
+  for (int y = 0; y < height - 1; y += 2) {
+    ARGBToUVRow(b.src + y * width * 4, width * 4,
+                b.dst + y / 2 * (width / 2), dst_v + y / 2 * (width / 2),
+                width);
+  }
+}
+
+static void BenchCopyRow(const Buffers& b, int width, int height) {
+  CopyRowFunction CopyRow = (CopyRowFunction)(GetRowFunction(kRowCopy, width));
+  for (int y = 0; y < height; ++y) {
+    CopyRow(b.src + y * width, b.dst + y * width, width);
+  }
+}
+
+// Public functions.  Pixels are counted at the larger of source and
+// destination size.
+#define PLANES(buf)                                                            \
+    uint8* buf##_y = buf;                                                      \
+    uint8* buf##_u = buf##_y + width * height;                                 \
+    uint8* buf##_v = buf##_u + halfwidth * halfheight;                         \
+    (void)buf##_v
+
+#define I420_BENCHMARK(NAME, CALL)                                             \
+static void Bench##NAME(const Buffers& b, int width, int height) {             \
+  int halfwidth = (width + 1) >> 1;                                            \
+  int halfheight = (height + 1) >> 1;                                          \
+  uint8* src = b.src;                                                          \
+  uint8* dst = b.dst;                                                          \
+  PLANES(src);                                                                 \
+  PLANES(dst);                                                                 \
+  CALL;                                                                        \
+}
+
+I420_BENCHMARK(I420ToARGB,
+    I420ToARGB(src_y, width, src_u, halfwidth, src_v, halfwidth,
+               dst, width * 4, width, height))
+I420_BENCHMARK(I422ToARGB,
+    I422ToARGB(src_y, width, src_u, halfwidth, src_v, halfwidth,
+               dst, width * 4, width, height))
+I420_BENCHMARK(NV12ToARGB,
+    NV12ToARGB(src_y, width, src_u, halfwidth * 2,
+               dst, width * 4, width, height))
+I420_BENCHMARK(ARGBToI420,
+    ARGBToI420(src, width * 4, dst_y, width, dst_u, halfwidth,
+               dst_v, halfwidth, width, height))
+I420_BENCHMARK(I420ToNV12,
+    I420ToNV12(src_y, width, src_u, halfwidth, src_v, halfwidth,
+               dst_y, width, dst_u, halfwidth * 2, width, height))
+I420_BENCHMARK(I420Copy,
+    I420Copy(src_y, width, src_u, halfwidth, src_v, halfwidth,
+             dst_y, width, dst_u, halfwidth, dst_v, halfwidth,
+             width, height))
+I420_BENCHMARK(CopyPlane,
+    CopyPlane(src, width, dst, width, width, height))
+I420_BENCHMARK(I420Rotate90,
+    I420Rotate(src_y, width, src_u, halfwidth, src_v, halfwidth,
+               dst_y, height, dst_u, halfheight, dst_v, halfheight,
+               width, height, kRotate90))
+I420_BENCHMARK(ARGBAttenuate,
+    ARGBAttenuate(src, width * 4, dst, width * 4, width, height))
+I420_BENCHMARK(ARGBBlend,
+    ARGBBlend(src, width * 4, dst, width * 4, dst, width * 4,
+              width, height))
+I420_BENCHMARK(ARGBScaleDown2Bilinear,
+    ARGBScale(src, width * 4, width, height, dst, halfwidth * 4,
+              halfwidth, halfheight, kFilterBilinear))
+
+// Scale kernels, selected by ratio and filter of ScalePlane.
+I420_BENCHMARK(ScaleDown2None,
+    ScalePlane(src, width, width, height, dst, halfwidth,
+               halfwidth, halfheight, kFilterNone))
+I420_BENCHMARK(ScaleDown2Box,
+    ScalePlane(src, width, width, height, dst, halfwidth,
+               halfwidth, halfheight, kFilterBox))
+I420_BENCHMARK(ScaleDown4Box,
+    ScalePlane(src, width, width, height, dst, width / 4,
+               width / 4, height / 4, kFilterBox))
+I420_BENCHMARK(ScaleDown34Bilinear,
+    ScalePlane(src, width, width, height, dst, width * 3 / 4,
+               width * 3 / 4, height * 3 / 4, kFilterBilinear))
+I420_BENCHMARK(ScaleDown38Box,
+    ScalePlane(src, width, width, height, dst, width * 3 / 8,
+               width * 3 / 8, height * 3 / 8, kFilterBox))
+I420_BENCHMARK(ScaleUp2Bilinear,
+    ScalePlane(src, halfwidth, halfwidth, halfheight, dst, width,
+               width, height, kFilterBilinear))
+
+static const Benchmark kBenchmarks[] = {
+  { "I422ToARGBRow", BenchI422ToARGBRow, kRowI422ToARGB, 2 + 4 },
+  { "ARGBToYRow", BenchARGBToYRow, kRowARGBToY, 4 + 1 },
+  { "ARGBToUVRow", BenchARGBToUVRow, kRowARGBToUV, 4 + 0.5 },
+  { "CopyRow", BenchCopyRow, kRowCopy, 1 + 1 },
+  { "I420ToARGB", BenchI420ToARGB, -1, 1.5 + 4 },
+  { "I422ToARGB", BenchI422ToARGB, -1, 2 + 4 },
+  { "NV12ToARGB", BenchNV12ToARGB, -1, 1.5 + 4 },
+  { "ARGBToI420", BenchARGBToI420, -1, 4 + 1.5 },
+  { "I420ToNV12", BenchI420ToNV12, -1, 1.5 + 1.5 },
+  { "I420Copy", BenchI420Copy, -1, 1.5 + 1.5 },
+  { "CopyPlane", BenchCopyPlane, -1, 1 + 1 },
+  { "I420Rotate90", BenchI420Rotate90, -1, 1.5 + 1.5 },
+  { "ARGBAttenuate", BenchARGBAttenuate, -1, 4 + 4 },
+  { "ARGBBlend", BenchARGBBlend, -1, 4 + 4 + 4 },
+  { "ARGBScaleDown2Bilinear", BenchARGBScaleDown2Bilinear, -1, 4 + 1 },
+  // Point sampling reads every other row.
+  { "ScaleDown2None", BenchScaleDown2None, -1, 0.5 + 0.25 },
+  { "ScaleDown2Box", BenchScaleDown2Box, -1, 1 + 0.25 },
+  { "ScaleDown4Box", BenchScaleDown4Box, -1, 1 + 0.0625 },
+  { "ScaleDown34Bilinear", BenchScaleDown34Bilinear, -1, 1 + 0.5625 },
+  { "ScaleDown38Box", BenchScaleDown38Box, -1, 1 + 0.140625 },
+  { "ScaleUp2Bilinear", BenchScaleUp2Bilinear, -1, 0.25 + 1 },
+};
+
+// Sizes are chosen so an ARGB source and I420 destination stay resident in
+// each level of cache.  offset misaligns source and destination.
+struct BenchmarkSize {
+  const char* name;
+  int width;
+  int height;
+  int offset;
+};
+
+static const BenchmarkSize kSizes[] = {
+  { "l1", 256, 8, 0 },
+  { "l2", 512, 64, 0 },
+  { "l3", 1280, 360, 0 },
+  { "dram", 3840, 2160, 0 },
+  { "any", 1279, 360, 0 },
+  { "unaligned", 1280, 360, 1 },
+};
+static const int kRooflineSize = 3;  // dram
+
+struct BenchmarkIsa {
+  const char* name;
+  int cpu_flags;  // Flags passed to MaskCpuFlags.
+  int test_flag;  // Cpu flag required to run.
+};
+
+static const BenchmarkIsa kIsas[] = {
+  { "C", 0, 0 },
+  { "SSE2", kCpuHasX86 | kCpuHasSSE2, kCpuHasSSE2 },
+  { "SSSE3", kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3, kCpuHasSSSE3 },
+  { "SSE4.1", kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3 | kCpuHasSSE41 |
+    kCpuHasSSE42, kCpuHasSSE41 },
+  { "AVX", kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3 | kCpuHasSSE41 |
+    kCpuHasSSE42 | kCpuHasAVX, kCpuHasAVX },
+  { "AVX2", kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3 | kCpuHasSSE41 |
+    kCpuHasSSE42 | kCpuHasAVX | kCpuHasAVX2 | kCpuHasERMS | kCpuHasFMA3,
+    kCpuHasAVX2 },
+  { "AVX512BW", -1, kCpuHasAVX512BW },
+  { "NEON", kCpuHasARM | kCpuHasNEON, kCpuHasNEON },
+  { "MIPS_DSPR2", kCpuHasMIPS | kCpuHasMIPS_DSP | kCpuHasMIPS_DSPR2,
+    kCpuHasMIPS_DSPR2 },
+};
+
+void PrintHelp(const char * program) {
+  printf("%s [-options]\n", program);
+  printf("options:\n");
+  printf(" -time <sec> ............ Seconds to run each benchmark (%g)\n",
+         min_time);
+  printf(" -filter <name> ......... Only run benchmarks containing name\n");
+  printf(" -json <file> ........... Write results to file instead of stdout\n");
+  printf(" -roofline .............. Report functions against copy bandwidth\n");
+  printf(" -h ..................... this help\n");
+  exit(0);
+}
+
+void ParseOptions(int argc, const char* argv[]) {
+  for (int c = 1; c < argc; ++c) {
+    if (!strcmp(argv[c], "-h") || !strcmp(argv[c], "-help")) {
+      PrintHelp(argv[0]);
+    } else if (!strcmp(argv[c], "-time") && c + 1 < argc) {
+      min_time = atof(argv[++c]);  // NOLINT
+    } else if (!strcmp(argv[c], "-filter") && c + 1 < argc) {
+      name_filter = argv[++c];
+    } else if (!strcmp(argv[c], "-json") && c + 1 < argc) {
+      json_filename = argv[++c];
+    } else if (!strcmp(argv[c], "-roofline")) {
+      do_roofline = true;
+    } else {
+      fprintf(stderr, "Unknown option. %s\n", argv[c]);
+      PrintHelp(argv[0]);
+    }
+  }
+}
+
+struct Timing {
+  int iterations;
+  double elapsed;  // Seconds.
+  uint64 cycles;
+};
+
+// Runs a benchmark for at least min_time.
+static Timing RunBenchmark(BenchmarkFunction function, const Buffers& b,
+                           int width, int height) {
+  function(b, width, height);  // Warm up.
+  Timing timing = { 0, 0., 0 };
+  double start_time = get_time();
+  uint64 start_cycles = get_cycles();
+  do {
+    function(b, width, height);
+    ++timing.iterations;
+    timing.elapsed = get_time() - start_time;
+  } while (timing.elapsed < min_time);
+  timing.cycles = get_cycles() - start_cycles;
+  return timing;
+}
+
+static void PrintTiming(FILE* file_json, const Timing& timing, double pixels) {
+  fprintf(file_json, "\"iterations\": %d, \"ns_per_pixel\": %.4f, ",
+          timing.iterations, timing.elapsed * 1e9 / pixels);
+#ifdef HAS_RDTSC
+  fprintf(file_json, "\"cycles_per_pixel\": %.4f, ", timing.cycles / pixels);
+#else
+  fprintf(file_json, "\"cycles_per_pixel\": null, ");
+#endif
+}
+
+// Each benchmark for each instruction set and size.
+static void RunSweep(FILE* file_json, uint8* src, uint8* dst) {
+  int cpu_flags = TestCpuFlag(-1);
+  fprintf(file_json, "  \"results\": [");
+  bool first_result = true;
+  for (size_t n = 0; n < sizeof(kBenchmarks) / sizeof(kBenchmarks[0]); ++n) {
+    const Benchmark& bench = kBenchmarks[n];
+    if (name_filter && !strstr(bench.name, name_filter)) {
+      continue;
+    }
+    for (size_t i = 0; i < sizeof(kIsas) / sizeof(kIsas[0]); ++i) {
+      if (kIsas[i].test_flag && !(cpu_flags & kIsas[i].test_flag)) {
+        continue;
+      }
+      MaskCpuFlags(kIsas[i].cpu_flags);
+      for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); ++s) {
+        const BenchmarkSize& size = kSizes[s];
+        Buffers b = { src + size.offset, dst + size.offset };
+        Timing timing = RunBenchmark(bench.function, b,
+                                     size.width, size.height);
+        double pixels = (double)(size.width) * size.height *
+            timing.iterations;
+
+        fprintf(file_json, "%s\n    {\"name\": \"%s\", \"isa\": \"%s\", ",
+                first_result ? "" : ",", bench.name, kIsas[i].name);
+        if (bench.row_function_id >= 0) {
+          fprintf(file_json, "\"kernel\": \"%s\", ",
+                  GetRowFunctionName(bench.row_function_id, size.width));
+        }
+        fprintf(file_json, "\"size\": \"%s\", \"width\": %d, "
+                "\"height\": %d, ", size.name, size.width, size.height);
+        PrintTiming(file_json, timing, pixels);
+        fprintf(file_json, "\"gb_per_sec\": %.3f}",
+                pixels * bench.bytes_per_pixel / timing.elapsed * 1e-9);
+        first_result = false;
+      }
+    }
+    MaskCpuFlags(-1);
+  }
+  fprintf(file_json, "\n  ]\n");
+}
+
+// Copy bandwidth of each copy kernel and CopyPlane at the DRAM size, and
+// each public function as a fraction of the fastest copy.
+static void RunRoofline(FILE* file_json, uint8* src, uint8* dst) {
+  const BenchmarkSize& size = kSizes[kRooflineSize];
+  const Buffers b = { src, dst };
+  const double frame_pixels = (double)(size.width) * size.height;
+  const double kCopyBytesPerPixel = 1 + 1;
+  int cpu_flags = TestCpuFlag(-1);
+  double roofline = 0.;
+  const char* last_kernel = NULL;
+  fprintf(file_json, "  \"roofline\": {\n    \"size\": \"%s\", "
+          "\"width\": %d, \"height\": %d,\n    \"copy\": [",
+          size.name, size.width, size.height);
+  for (size_t i = 0; i < sizeof(kIsas) / sizeof(kIsas[0]); ++i) {
+    if (kIsas[i].test_flag && !(cpu_flags & kIsas[i].test_flag)) {
+      continue;
+    }
+    MaskCpuFlags(kIsas[i].cpu_flags);
+    const char* kernel = GetRowFunctionName(kRowCopy, size.width);
+    if (last_kernel && !strcmp(kernel, last_kernel)) {
+      continue;
+    }
+    Timing timing = RunBenchmark(BenchCopyRow, b, size.width, size.height);
+    double gb_per_sec = frame_pixels * timing.iterations *
+        kCopyBytesPerPixel / timing.elapsed * 1e-9;
+    if (gb_per_sec > roofline) {
+      roofline = gb_per_sec;
+    }
+    fprintf(file_json, "%s\n      {\"name\": \"CopyRow\", \"isa\": \"%s\", "
+            "\"kernel\": \"%s\", \"gb_per_sec\": %.3f}",
+            last_kernel ? "," : "", kIsas[i].name, kernel, gb_per_sec);
+    last_kernel = kernel;
+  }
+  MaskCpuFlags(-1);
+  Timing timing = RunBenchmark(BenchCopyPlane, b, size.width, size.height);
+  double gb_per_sec = frame_pixels * timing.iterations *
+      kCopyBytesPerPixel / timing.elapsed * 1e-9;
+  if (gb_per_sec > roofline) {
+    roofline = gb_per_sec;
+  }
+  fprintf(file_json, "%s\n      {\"name\": \"CopyPlane\", "
+          "\"gb_per_sec\": %.3f}\n    ],\n    \"gb_per_sec\": %.3f\n  },\n",
+          last_kernel ? "," : "", gb_per_sec, roofline);
+
+  fprintf(file_json, "  \"results\": [");
+  bool first_result = true;
+  for (size_t n = 0; n < sizeof(kBenchmarks) / sizeof(kBenchmarks[0]); ++n) {
+    const Benchmark& bench = kBenchmarks[n];
+    if (bench.row_function_id >= 0 ||
+        (name_filter && !strstr(bench.name, name_filter))) {
+      continue;
+    }
+    timing = RunBenchmark(bench.function, b, size.width, size.height);
+    double pixels = frame_pixels * timing.iterations;
+    gb_per_sec = pixels * bench.bytes_per_pixel / timing.elapsed * 1e-9;
+    fprintf(file_json, "%s\n    {\"name\": \"%s\", "
+            "\"bytes_per_pixel\": %.4f, ", first_result ? "" : ",",
+            bench.name, bench.bytes_per_pixel);
+    PrintTiming(file_json, timing, pixels);
+    fprintf(file_json, "\"roofline_ns_per_pixel\": %.4f, "
+            "\"gb_per_sec\": %.3f, \"roofline_fraction\": %.3f}",
+            bench.bytes_per_pixel / roofline, gb_per_sec,
+            gb_per_sec / roofline);
+    first_result = false;
+  }
+  fprintf(file_json, "\n  ]\n");
+}
+
+int main(int argc, const char* argv[]) {
+  ParseOptions(argc, argv);
+  FILE* file_json = stdout;
+  if (json_filename) {
+    file_json = fopen(json_filename, "w");
+    if (!file_json) {
+      fprintf(stderr, "Cannot open %s\n", json_filename);
+      exit(1);
+    }
+  }
+
+  int max_size = 0;
+  for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); ++s) {
+    int size = kSizes[s].width * kSizes[s].height * 4 + kSizes[s].offset;
+    if (size > max_size) {
+      max_size = size;
+    }
+  }
+  const int kAlign = 64;
+  uint8* src_alloc = new uint8[max_size + kAlign];
+  uint8* dst_alloc = new uint8[max_size + kAlign];
+  uint8* src_aligned = (uint8*)(((uintptr_t)(src_alloc) + kAlign - 1) &
+                                ~(uintptr_t)(kAlign - 1));
+  uint8* dst_aligned = (uint8*)(((uintptr_t)(dst_alloc) + kAlign - 1) &
+                                ~(uintptr_t)(kAlign - 1));
+  for (int i = 0; i < max_size; ++i) {
+    src_aligned[i] = (uint8)(rand());  // NOLINT
+  }
+  memset(dst_aligned, 0, max_size);
+
+  fprintf(file_json, "{\n  \"version\": %d,\n  \"cpu_flags\": %d,\n"
+          "  \"tsc\": %s,\n", LIBYUV_VERSION, TestCpuFlag(-1),
+#ifdef HAS_RDTSC
+          "true");
+#else
+          "false");
+#endif
+  if (do_roofline) {
+    RunRoofline(file_json, src_aligned, dst_aligned);
+  } else {
+    RunSweep(file_json, src_aligned, dst_aligned);
+  }
+  fprintf(file_json, "}\n");
+  if (json_filename) {
+    fclose(file_json);
+  }
+  delete[] src_alloc;
+  delete[] dst_alloc;
+  return 0;
+}
@@ -10,6 +10,7 @@
 
 // Convert an ARGB image to YUV.
 // Usage: convert src_argb.raw dst_yuv.raw
+// Y4M (.y4m) files are read and written as I420 with the size in the header.
 
 #ifndef _CRT_SECURE_NO_WARNINGS
 #define _CRT_SECURE_NO_WARNINGS
@@ -23,6 +24,7 @@
 #include "libyuv/convert.h"
 #include "libyuv/planar_functions.h"
 #include "libyuv/scale_argb.h"
+#include "./y4m.h"
 
 // options
 bool verbose = false;
@@ -41,10 +43,25 @@ static __inline uint32 Abs(int32 v) {
   return v >= 0 ? v : -v;
 }
 
+static bool IsY4mFilename(const char* name) {
+  size_t length = strlen(name);
+  return length > 4 && !strcmp(name + length - 4, ".y4m");
+}
+
 // Parse PYUV format. ie name.1920x800_24Hz_P420.yuv
+// or the header of a .y4m file.
 bool ExtractResolutionFromFilename(const char* name,
                                    int* width_ptr,
                                    int* height_ptr) {
+  if (IsY4mFilename(name)) {
+    Y4mReader reader;
+    if (reader.Open(name) && reader.is_y4m()) {
+      *width_ptr = reader.info().width;
+      *height_ptr = reader.info().height;
+      return true;
+    }
+    return false;
+  }
   // Isolate the .width_height. section of the filename by searching for a
   // dot or underscore followed by a digit.
   for (int i = 0; name[i]; ++i) {
@@ -61,6 +78,7 @@ bool ExtractResolutionFromFilename(const char* name,
 
 void PrintHelp(const char * program) {
   printf("%s [-options] src_argb.raw dst_yuv.raw\n", program);
+  printf("Files named _ARGB. are ARGB, _P420. or .y4m are I420.\n");
   printf(" -s <width> <height> .... specify source resolution.  "
          "Optional if name contains\n"
          "                          resolution (ie. "
@@ -189,35 +207,27 @@ static int TileARGBScale(const uint8* src_argb, int src_stride_argb,
 int main(int argc, const char* argv[]) {
   ParseOptions(argc, argv);
 
-  // Open original file (first file argument)
-  FILE* const file_org = fopen(argv[fileindex_org], "rb");
-  if (file_org == NULL) {
+  // Open original file (first file argument). Frames are mapped in place.
+  Y4mReader reader_org;
+  if (!reader_org.Open(argv[fileindex_org])) {
     fprintf(stderr, "Cannot open %s\n", argv[fileindex_org]);
     exit(1);
   }
 
-  // Open all files to convert to
-  FILE** file_rec = new FILE* [num_rec];
-  memset(file_rec, 0, num_rec * sizeof(FILE*)); // NOLINT
-  for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
-    file_rec[cur_rec] = fopen(argv[fileindex_rec + cur_rec], "wb");
-    if (file_rec[cur_rec] == NULL) {
-      fprintf(stderr, "Cannot open %s\n", argv[fileindex_rec + cur_rec]);
-      fclose(file_org);
-      for (int i = 0; i < cur_rec; ++i) {
-        fclose(file_rec[i]);
-      }
-      delete[] file_rec;
-      exit(1);
-    }
-  }
-
-  bool org_is_yuv = strstr(argv[fileindex_org], "_P420.") != NULL;
+  bool org_is_y4m = reader_org.is_y4m();
+  bool org_is_yuv = org_is_y4m ||
+      strstr(argv[fileindex_org], "_P420.") != NULL;
   bool org_is_argb = strstr(argv[fileindex_org], "_ARGB.") != NULL;
   if (!org_is_yuv && !org_is_argb) {
     fprintf(stderr, "Original format unknown %s\n", argv[fileindex_org]);
     exit(1);
   }
+  if (org_is_y4m && (reader_org.info().chroma != kY4mChroma420 ||
+                     reader_org.info().bit_depth != 8)) {
+    fprintf(stderr, "Only 8 bit 4:2:0 Y4M is supported %s\n",
+            argv[fileindex_org]);
+    exit(1);
+  }
   int org_size = Abs(image_width) * Abs(image_height) * 4;  // ARGB
   // Input is YUV
   if (org_is_yuv) {
@@ -226,32 +236,66 @@ int main(int argc, const char* argv[]) {
         ((Abs(image_height) + 1) / 2);
     org_size = y_size + 2 * uv_size;  // YUV original.
   }
+  if (org_is_y4m && static_cast<size_t>(org_size) != reader_org.frame_size()) {
+    fprintf(stderr, "Size does not match Y4M header %s\n",
+            argv[fileindex_org]);
+    exit(1);
+  }
+  reader_org.SetRawFrameSize(org_size);
 
   const int dst_size = dst_width * dst_height * 4;  // ARGB scaled
   const int y_size = dst_width * dst_height;
   const int uv_size = ((dst_width + 1) / 2) * ((dst_height + 1) / 2);
   const size_t total_size = y_size + 2 * uv_size;
-#if defined(_MSC_VER)
-  _fseeki64(file_org,
-            static_cast<__int64>(num_skip_org) *
-            static_cast<__int64>(org_size), SEEK_SET);
-#else
-  fseek(file_org, num_skip_org * total_size, SEEK_SET);
-#endif
+
+  // Open all files to convert to
+  FILE** file_rec = new FILE* [num_rec];
+  Y4mWriter* y4m_rec = new Y4mWriter[num_rec];
+  memset(file_rec, 0, num_rec * sizeof(FILE*)); // NOLINT
+  for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
+    const char* name = argv[fileindex_rec + cur_rec];
+    bool opened;
+    if (IsY4mFilename(name)) {
+      Y4mInfo info;
+      Y4mInitInfo(&info, dst_width, dst_height);
+      if (org_is_y4m) {
+        info.fps_num = reader_org.info().fps_num;
+        info.fps_den = reader_org.info().fps_den;
+        info.full_range = reader_org.info().full_range;
+      }
+      opened = y4m_rec[cur_rec].Open(name, info);
+    } else {
+      file_rec[cur_rec] = fopen(name, "wb");
+      opened = file_rec[cur_rec] != NULL;
+    }
+    if (!opened) {
+      fprintf(stderr, "Cannot open %s\n", name);
+      for (int i = 0; i < cur_rec; ++i) {
+        if (file_rec[i]) {
+          fclose(file_rec[i]);
+        }
+      }
+      delete[] file_rec;
+      delete[] y4m_rec;
+      exit(1);
+    }
+  }
 
   uint8* const ch_org = new uint8[org_size];
   uint8* const ch_dst = new uint8[dst_size];
   uint8* const ch_rec = new uint8[total_size];
   if (ch_org == NULL || ch_rec == NULL) {
     fprintf(stderr, "No memory available\n");
-    fclose(file_org);
     for (int i = 0; i < num_rec; ++i) {
-      fclose(file_rec[i]);
+      if (file_rec[i]) {
+        fclose(file_rec[i]);
+      }
     }
     delete[] ch_org;
     delete[] ch_dst;
     delete[] ch_rec;
     delete[] file_rec;
+    delete[] y4m_rec;
     exit(1);
   }
 
@@ -266,19 +310,21 @@ int main(int argc, const char* argv[]) {
       break;
 
     // Load original YUV or ARGB frame.
-    size_t bytes_org = fread(ch_org, sizeof(uint8),
-                             static_cast<size_t>(org_size), file_org);
-    if (bytes_org < static_cast<size_t>(org_size))
+    const uint8* frame_org =
+        reader_org.GetFrame(num_skip_org + number_of_frames);
+    if (!frame_org)
       break;
 
     // TODO(fbarchard): Attenuate doesnt need to know dimensions.
     // ARGB attenuate frame
     if (org_is_argb && attenuate) {
-      libyuv::ARGBAttenuate(ch_org, 0, ch_org, 0, org_size / 4, 1);
+      libyuv::ARGBAttenuate(frame_org, 0, ch_org, 0, org_size / 4, 1);
+      frame_org = ch_org;
     }
     // ARGB unattenuate frame
     if (org_is_argb && unattenuate) {
-      libyuv::ARGBUnattenuate(ch_org, 0, ch_org, 0, org_size / 4, 1);
+      libyuv::ARGBUnattenuate(frame_org, 0, ch_org, 0, org_size / 4, 1);
+      frame_org = ch_org;
     }
 
     for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
@@ -290,9 +336,9 @@ int main(int argc, const char* argv[]) {
         int half_src_height = (src_height + 1) / 2;
         int half_dst_width = (dst_width + 1) / 2;
         int half_dst_height = (dst_height + 1) / 2;
-        I420Scale(ch_org, src_width,
-                  ch_org + src_width * src_height, half_src_width,
-                  ch_org + src_width * src_height +
+        I420Scale(frame_org, src_width,
+                  frame_org + src_width * src_height, half_src_width,
+                  frame_org + src_width * src_height +
                       half_src_width * half_src_height,  half_src_width,
                   image_width, image_height,
                   ch_rec, dst_width,
@@ -302,13 +348,15 @@ int main(int argc, const char* argv[]) {
                   dst_width, dst_height,
                       static_cast<libyuv::FilterMode>(filter));
       } else {
-        TileARGBScale(ch_org, Abs(image_width) * 4,
+        TileARGBScale(frame_org, Abs(image_width) * 4,
                       image_width, image_height,
                       ch_dst, dst_width * 4,
                       dst_width, dst_height,
                       static_cast<libyuv::FilterMode>(filter));
       }
-      bool rec_is_yuv = strstr(argv[fileindex_rec + cur_rec], "_P420.") != NULL;
+      bool rec_is_y4m = IsY4mFilename(argv[fileindex_rec + cur_rec]);
+      bool rec_is_yuv = rec_is_y4m ||
+          strstr(argv[fileindex_rec + cur_rec], "_P420.") != NULL;
       bool rec_is_argb =
           strstr(argv[fileindex_rec + cur_rec], "_ARGB.") != NULL;
       if (!rec_is_yuv && !rec_is_argb) {
@@ -330,7 +378,10 @@ int main(int argc, const char* argv[]) {
       }
 
       // Output YUV or ARGB frame.
-      if (rec_is_yuv) {
+      if (rec_is_y4m) {
+        if (!y4m_rec[cur_rec].WriteFrame(ch_rec))
+          break;
+      } else if (rec_is_yuv) {
         size_t bytes_rec = fwrite(ch_rec, sizeof(uint8),
                                   static_cast<size_t>(total_size),
                                   file_rec[cur_rec]);
@@ -353,13 +404,15 @@ int main(int argc, const char* argv[]) {
     }
   }
 
-  fclose(file_org);
   for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
-    fclose(file_rec[cur_rec]);
+    if (file_rec[cur_rec]) {
+      fclose(file_rec[cur_rec]);
+    }
   }
   delete[] ch_org;
   delete[] ch_dst;
   delete[] ch_rec;
   delete[] file_rec;
+  delete[] y4m_rec;
   return 0;
 }
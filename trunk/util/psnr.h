@@ -26,13 +26,8 @@ typedef unsigned char uint8;
 
 static const double kMaxPSNR = 128.0;
 
-// libyuv provides this function when linking library for jpeg support.
-// TODO(fbarchard): make psnr lib compatible subset of libyuv.
-#if !defined(HAVE_JPEG)
-// Computer Sum of Squared Error (SSE).
-// Pass this to ComputePSNR for final result.
-double ComputeSumSquareError(const uint8* org, const uint8* rec, int size);
-#endif
+// The sum square error (SSE) passed to ComputePSNR comes from libyuv's
+// ComputeSumSquareError and ComputeSumSquareErrorPlane.
 
 // PSNR formula: psnr = 10 * log10 (Peak Signal^2 * size / sse)
 // Returns 128.0 (kMaxPSNR) if sse is 0 (perfect match).
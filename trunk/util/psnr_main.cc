@@ -9,14 +9,18 @@
  */
 
 // Get PSNR or SSIM for video sequence. Assuming RAW 4:2:0 Y:Cb:Cr format
-// To build: g++ -O3 -o psnr psnr.cc ssim.cc psnr_main.cc
-// or VisualC: cl /Ox psnr.cc ssim.cc psnr_main.cc
+// or Y4M with 8 bit 4:2:0, 4:2:2 or 4:4:4.
+// To build: g++ -O3 -o psnr psnr.cc ssim.cc psnr_main.cc y4m.cc
+// or VisualC: cl /Ox psnr.cc ssim.cc psnr_main.cc y4m.cc
 //
 // To enable OpenMP and SSE2
-// gcc: g++ -msse2 -O3 -fopenmp -o psnr psnr.cc ssim.cc psnr_main.cc
-// vc:  cl /arch:SSE2 /Ox /openmp psnr.cc ssim.cc psnr_main.cc
+// gcc: g++ -msse2 -O3 -fopenmp -o psnr psnr.cc ssim.cc psnr_main.cc y4m.cc
+// vc:  cl /arch:SSE2 /Ox /openmp psnr.cc ssim.cc psnr_main.cc y4m.cc
 //
 // Usage: psnr org_seq rec_seq -s width height [-skip skip_org skip_rec]
+//
+// Files are memory mapped and, with OpenMP, frames are scored in parallel
+// with one frame per task.  Per frame scores can be written as CSV or JSON.
 
 #ifndef _CRT_SECURE_NO_WARNINGS
 #define _CRT_SECURE_NO_WARNINGS
@@ -32,8 +36,9 @@
 
 #include "./psnr.h"
 #include "./ssim.h"
-#ifdef HAVE_JPEG
+#include "./y4m.h"
 #include "libyuv/compare.h"
+#ifdef HAVE_JPEG
 #include "libyuv/convert.h"
 #endif
 
@@ -54,20 +59,32 @@ bool do_ssim = false;
 bool do_mse = false;
 bool do_lssim = false;
 int image_width = 0, image_height = 0;
+int uv_width = 0, uv_height = 0;  // Chroma plane size. 4:2:0 unless Y4M.
 int fileindex_org = 0;  // argv argument contains the source file name.
 int fileindex_rec = 0;  // argv argument contains the destination file name.
 int num_rec = 0;
 int num_skip_org = 0;
 int num_skip_rec = 0;
 int num_frames = 0;
+const char* csv_filename = NULL;   // Per frame report.
+const char* json_filename = NULL;
 #ifdef _OPENMP
 int num_threads = 0;
 #endif
 
 // Parse PYUV format. ie name.1920x800_24Hz_P420.yuv
+// or the header of a Y4M file.
 bool ExtractResolutionFromFilename(const char* name,
                                    int* width_ptr,
                                    int* height_ptr) {
+  {
+    Y4mReader reader;
+    if (reader.Open(name) && reader.is_y4m()) {
+      *width_ptr = reader.info().width;
+      *height_ptr = reader.info().height;
+      return true;
+    }
+  }
   // Isolate the .width_height. section of the filename by searching for a
   // dot or underscore followed by a digit.
   for (int i = 0; name[i]; ++i) {
@@ -122,7 +139,9 @@ double GetMSE(double sse, double size) {
 void PrintHelp(const char * program) {
   printf("%s [-options] org_seq rec_seq [rec_seq2.. etc]\n", program);
 #ifdef HAVE_JPEG
-  printf("jpeg or raw YUV 420 supported.\n");
+  printf("jpeg, y4m or raw YUV 420 supported.\n");
+#else
+  printf("y4m or raw YUV 420 supported.\n");
 #endif
   printf("options:\n");
   printf(" -s <width> <height> .... specify YUV size, mandatory if none of the "
@@ -135,6 +154,8 @@ void PrintHelp(const char * program) {
   printf(" -swap .................. Swap U and V plane\n");
   printf(" -skip <org> <rec> ...... Number of frame to skip of org and rec\n");
   printf(" -frames <num> .......... Number of frames to compare\n");
+  printf(" -csv <file> ............ Write per frame scores as CSV\n");
+  printf(" -json <file> ........... Write per frame scores as JSON\n");
 #ifdef _OPENMP
   printf(" -t <num> ............... Number of threads\n");
 #endif
@@ -175,6 +196,10 @@ void ParseOptions(int argc, const char* argv[]) {
       num_skip_rec = atoi(argv[++c]);   // NOLINT
     } else if (!strcmp(argv[c], "-frames") && c + 1 < argc) {
       num_frames = atoi(argv[++c]);     // NOLINT
+    } else if (!strcmp(argv[c], "-csv") && c + 1 < argc) {
+      csv_filename = argv[++c];
+    } else if (!strcmp(argv[c], "-json") && c + 1 < argc) {
+      json_filename = argv[++c];
 #ifdef _OPENMP
     } else if (!strcmp(argv[c], "-t") && c + 1 < argc) {
       num_threads = atoi(argv[++c]);    // NOLINT
@@ -234,34 +259,33 @@ void ParseOptions(int argc, const char* argv[]) {
   }
 }
 
-bool UpdateMetrics(uint8* ch_org, uint8* ch_rec,
-                   const int y_size, const int uv_size, const size_t total_size,
-                   int number_of_frames,
-                   metric* cur_distortion_psnr,
-                   metric* distorted_frame, bool do_psnr) {
+// Computes the scores of one frame.  For PSNR the global_ fields are set to
+// the sum square error of the frame.  Safe to call from multiple threads.
+void ComputeMetrics(const uint8* ch_org, const uint8* ch_rec,
+                    const int y_size, const int uv_size,
+                    const size_t total_size,
+                    metric* distorted_frame, bool do_psnr) {
   const int uv_offset = (do_swap_uv ? uv_size : 0);
   const uint8* const u_org = ch_org + y_size + uv_offset;
   const uint8* const u_rec = ch_rec + y_size;
   const uint8* const v_org = ch_org + y_size + (uv_size - uv_offset);
   const uint8* const v_rec = ch_rec + y_size + uv_size;
   if (do_psnr) {
-#ifdef HAVE_JPEG
     double y_err = static_cast<double>(
-      libyuv::ComputeSumSquareError(ch_org, ch_rec, y_size));
+      libyuv::ComputeSumSquareErrorPlane(ch_org, image_width,
+                                         ch_rec, image_width,
+                                         image_width, image_height));
     double u_err = static_cast<double>(
-      libyuv::ComputeSumSquareError(u_org, u_rec, uv_size));
+      libyuv::ComputeSumSquareErrorPlane(u_org, uv_width, u_rec, uv_width,
+                                         uv_width, uv_height));
     double v_err = static_cast<double>(
-      libyuv::ComputeSumSquareError(v_org, v_rec, uv_size));
-#else
-    double y_err = ComputeSumSquareError(ch_org, ch_rec, y_size);
-    double u_err = ComputeSumSquareError(u_org, u_rec, uv_size);
-    double v_err = ComputeSumSquareError(v_org, v_rec, uv_size);
-#endif
+      libyuv::ComputeSumSquareErrorPlane(v_org, uv_width, v_rec, uv_width,
+                                         uv_width, uv_height));
     const double total_err = y_err + u_err + v_err;
-    cur_distortion_psnr->global_y += y_err;
-    cur_distortion_psnr->global_u += u_err;
-    cur_distortion_psnr->global_v += v_err;
-    cur_distortion_psnr->global_all += total_err;
+    distorted_frame->global_y = y_err;
+    distorted_frame->global_u = u_err;
+    distorted_frame->global_v = v_err;
+    distorted_frame->global_all = total_err;
     distorted_frame->y = ComputePSNR(y_err, static_cast<double>(y_size));
     distorted_frame->u = ComputePSNR(u_err, static_cast<double>(uv_size));
     distorted_frame->v = ComputePSNR(v_err, static_cast<double>(uv_size));
@@ -269,10 +293,8 @@ bool UpdateMetrics(uint8* ch_org, uint8* ch_rec,
                                        static_cast<double>(total_size));
   } else {
     distorted_frame->y = CalcSSIM(ch_org, ch_rec, image_width, image_height);
-    distorted_frame->u = CalcSSIM(u_org, u_rec, (image_width + 1) / 2,
-                                 (image_height + 1) / 2);
-    distorted_frame->v = CalcSSIM(v_org, v_rec, (image_width + 1) / 2,
-                                 (image_height + 1) / 2);
+    distorted_frame->u = CalcSSIM(u_org, u_rec, uv_width, uv_height);
+    distorted_frame->v = CalcSSIM(v_org, v_rec, uv_width, uv_height);
     distorted_frame->all =
       (distorted_frame->y + distorted_frame->u + distorted_frame->v)
         / total_size;
@@ -286,28 +308,111 @@ bool UpdateMetrics(uint8* ch_org, uint8* ch_rec,
       distorted_frame->u = CalcLSSIM(distorted_frame->u);
       distorted_frame->v = CalcLSSIM(distorted_frame->v);
     }
+    distorted_frame->global_y = 0.0;
+    distorted_frame->global_u = 0.0;
+    distorted_frame->global_v = 0.0;
+    distorted_frame->global_all = 0.0;
   }
+}
+
+// Adds the scores of a frame to the totals of a sequence.
+// Returns true if the frame is the new minimum.
+bool UpdateMetrics(const metric& distorted_frame, int number_of_frames,
+                   metric* cur_distortion_psnr) {
+  cur_distortion_psnr->global_y += distorted_frame.global_y;
+  cur_distortion_psnr->global_u += distorted_frame.global_u;
+  cur_distortion_psnr->global_v += distorted_frame.global_v;
+  cur_distortion_psnr->global_all += distorted_frame.global_all;
 
-  cur_distortion_psnr->y += distorted_frame->y;
-  cur_distortion_psnr->u += distorted_frame->u;
-  cur_distortion_psnr->v += distorted_frame->v;
-  cur_distortion_psnr->all += distorted_frame->all;
+  cur_distortion_psnr->y += distorted_frame.y;
+  cur_distortion_psnr->u += distorted_frame.u;
+  cur_distortion_psnr->v += distorted_frame.v;
+  cur_distortion_psnr->all += distorted_frame.all;
 
   bool ismin = false;
-  if (distorted_frame->y < cur_distortion_psnr->min_y)
-    cur_distortion_psnr->min_y = distorted_frame->y;
-  if (distorted_frame->u < cur_distortion_psnr->min_u)
-    cur_distortion_psnr->min_u = distorted_frame->u;
-  if (distorted_frame->v < cur_distortion_psnr->min_v)
-    cur_distortion_psnr->min_v = distorted_frame->v;
-  if (distorted_frame->all < cur_distortion_psnr->min_all) {
-    cur_distortion_psnr->min_all = distorted_frame->all;
+  if (distorted_frame.y < cur_distortion_psnr->min_y)
+    cur_distortion_psnr->min_y = distorted_frame.y;
+  if (distorted_frame.u < cur_distortion_psnr->min_u)
+    cur_distortion_psnr->min_u = distorted_frame.u;
+  if (distorted_frame.v < cur_distortion_psnr->min_v)
+    cur_distortion_psnr->min_v = distorted_frame.v;
+  if (distorted_frame.all < cur_distortion_psnr->min_all) {
+    cur_distortion_psnr->min_all = distorted_frame.all;
     cur_distortion_psnr->min_frame = number_of_frames;
     ismin = true;
   }
   return ismin;
 }
 
+// Writes the JSON string for a file name.
+void PrintJsonString(FILE* file, const char* str) {
+  fputc('"', file);
+  for (; *str; ++str) {
+    if (*str == '"' || *str == '\\') {
+      fputc('\\', file);
+    }
+    if (static_cast<unsigned char>(*str) >= 0x20) {
+      fputc(*str, file);
+    }
+  }
+  fputc('"', file);
+}
+
+// Writes the CSV field for a file name.  Quotes are doubled.
+void PrintCsvString(FILE* file, const char* str) {
+  fputc('"', file);
+  for (; *str; ++str) {
+    if (*str == '"') {
+      fputc('"', file);
+    }
+    fputc(*str, file);
+  }
+  fputc('"', file);
+}
+
+// Returns a frame of a raw or Y4M sequence, mapped in place when possible.
+// Frames that are read instead of mapped are copied to ch_frame so they
+// remain valid while other frames are read.
+// A raw file too small for one frame is decoded as a jpeg into ch_frame.
+const uint8* GetFrame(Y4mReader* reader, int index, uint8* ch_frame,
+                      const int y_size, const int uv_size) {
+  const uint8* frame = reader->GetFrame(index);
+  if (frame && !reader->mapped_data()) {
+    memcpy(ch_frame, frame, y_size + 2 * uv_size);
+    frame = ch_frame;
+  }
+#ifdef HAVE_JPEG
+  const size_t total_size = y_size + 2 * uv_size;
+  if (!frame && index == 0 && !reader->is_y4m() &&
+      reader->file_size() > 0 && reader->file_size() < total_size) {
+    // Try parsing file as a jpeg.
+    size_t jpeg_size = reader->file_size();
+    reader->SetRawFrameSize(jpeg_size);
+    const uint8* ch_jpeg = reader->GetFrame(0);
+    memset(ch_frame, 0, total_size);
+    if (ch_jpeg && 0 == libyuv::MJPGToI420(ch_jpeg, jpeg_size,
+                                           ch_frame,
+                                           image_width,
+                                           ch_frame + y_size,
+                                           uv_width,
+                                           ch_frame + y_size + uv_size,
+                                           uv_width,
+                                           image_width,
+                                           image_height,
+                                           image_width,
+                                           image_height)) {
+      frame = ch_frame;
+    }
+    reader->SetRawFrameSize(total_size);
+  }
+#else
+  (void)ch_frame;
+  (void)y_size;
+  (void)uv_size;
+#endif  // HAVE_JPEG
+  return frame;
+}
+
 int main(int argc, const char* argv[]) {
   ParseOptions(argc, argv);
   if (!do_psnr && !do_ssim) {
@@ -323,62 +428,109 @@ int main(int argc, const char* argv[]) {
   }
 #endif
   // Open original file (first file argument)
-  FILE* const file_org = fopen(argv[fileindex_org], "rb");
-  if (file_org == NULL) {
+  Y4mReader reader_org;
+  if (!reader_org.Open(argv[fileindex_org])) {
     fprintf(stderr, "Cannot open %s\n", argv[fileindex_org]);
     exit(1);
   }
 
   // Open all files to compare to
-  FILE** file_rec = new FILE* [num_rec];
-  memset(file_rec, 0, num_rec * sizeof(FILE*)); // NOLINT
+  Y4mReader* reader_rec = new Y4mReader[num_rec];
   for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
-    file_rec[cur_rec] = fopen(argv[fileindex_rec + cur_rec], "rb");
-    if (file_rec[cur_rec] == NULL) {
+    if (!reader_rec[cur_rec].Open(argv[fileindex_rec + cur_rec])) {
       fprintf(stderr, "Cannot open %s\n", argv[fileindex_rec + cur_rec]);
-      fclose(file_org);
-      for (int i = 0; i < cur_rec; ++i) {
-        fclose(file_rec[i]);
-      }
-      delete[] file_rec;
+      delete[] reader_rec;
       exit(1);
     }
   }
 
+  // Chroma size is from the first Y4M sequence, or 4:2:0 for raw files.
+  uv_width = (image_width + 1) / 2;
+  uv_height = (image_height + 1) / 2;
+  for (int i = -1; i < num_rec; ++i) {
+    const Y4mReader& reader = i < 0 ? reader_org : reader_rec[i];
+    if (reader.is_y4m()) {
+      if (reader.info().chroma == kY4mChromaMono ||
+          reader.info().bit_depth != 8) {
+        fprintf(stderr, "Only 8 bit YUV is supported %s\n",
+                argv[i < 0 ? fileindex_org : fileindex_rec + i]);
+        delete[] reader_rec;
+        exit(1);
+      }
+      uv_width = Y4mChromaWidth(reader.info());
+      uv_height = Y4mChromaHeight(reader.info());
+      break;
+    }
+  }
+
   const int y_size = image_width * image_height;
-  const int uv_size = ((image_width + 1) / 2) * ((image_height + 1) / 2);
+  const int uv_size = uv_width * uv_height;
   const size_t total_size = y_size + 2 * uv_size;    // NOLINT
-#if defined(_MSC_VER)
-  _fseeki64(file_org,
-            static_cast<__int64>(num_skip_org) *
-            static_cast<__int64>(total_size), SEEK_SET);
-#else
-  fseek(file_org, num_skip_org * total_size, SEEK_SET);
+  for (int i = -1; i < num_rec; ++i) {
+    Y4mReader* reader = i < 0 ? &reader_org : &reader_rec[i];
+    if (reader->is_y4m() && reader->frame_size() != total_size) {
+      fprintf(stderr, "Sequences have different formats %s\n",
+              argv[i < 0 ? fileindex_org : fileindex_rec + i]);
+      delete[] reader_rec;
+      exit(1);
+    }
+    reader->SetRawFrameSize(total_size);
+  }
+
+  // Frames are scored in batches of several frames per thread.  Buffers are
+  // needed for each frame of a batch unless the file is mapped.
+  int batch_frames = 1;
+#ifdef _OPENMP
+  batch_frames = omp_get_max_threads() * 4;
 #endif
+  const int org_frames = reader_org.mapped_data() ? 1 : batch_frames;
+  int rec_frames = 1;
   for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
-#if defined(_MSC_VER)
-    _fseeki64(file_rec[cur_rec],
-              static_cast<__int64>(num_skip_rec) *
-              static_cast<__int64>(total_size),
-              SEEK_SET);
-#else
-    fseek(file_rec[cur_rec], num_skip_rec * total_size, SEEK_SET);
-#endif
+    if (!reader_rec[cur_rec].mapped_data()) {
+      rec_frames = batch_frames;
+    }
   }
-
-  uint8* const ch_org = new uint8[total_size];
-  uint8* const ch_rec = new uint8[total_size];
+  uint8* const ch_org = new uint8[total_size * org_frames];
+  uint8* const ch_rec = new uint8[total_size * rec_frames * num_rec];
   if (ch_org == NULL || ch_rec == NULL) {
     fprintf(stderr, "No memory available\n");
-    fclose(file_org);
-    for (int i = 0; i < num_rec; ++i) {
-      fclose(file_rec[i]);
-    }
     delete[] ch_org;
     delete[] ch_rec;
-    delete[] file_rec;
+    delete[] reader_rec;
     exit(1);
   }
+  const uint8** const frames_org = new const uint8*[batch_frames];
+  const uint8** const frames_rec = new const uint8*[batch_frames * num_rec];
+  metric* const frames_psnr = new metric[batch_frames * num_rec];
+  metric* const frames_ssim = new metric[batch_frames * num_rec];
+
+  FILE* file_csv = NULL;
+  FILE* file_json = NULL;
+  if (csv_filename) {
+    file_csv = fopen(csv_filename, "w");
+    if (!file_csv) {
+      fprintf(stderr, "Cannot open %s\n", csv_filename);
+      exit(1);
+    }
+    fprintf(file_csv, "frame,name");
+    if (do_psnr) {
+      fprintf(file_csv, ",psnr_y,psnr_u,psnr_v,psnr_all");
+    }
+    if (do_ssim) {
+      fprintf(file_csv, ",ssim_y,ssim_u,ssim_v,ssim_all");
+    }
+    fprintf(file_csv, "\n");
+  }
+  if (json_filename) {
+    file_json = fopen(json_filename, "w");
+    if (!file_json) {
+      fprintf(stderr, "Cannot open %s\n", json_filename);
+      exit(1);
+    }
+    fprintf(file_json, "{\n  \"width\": %d,\n  \"height\": %d,\n"
+            "  \"frames\": [", image_width, image_height);
+  }
+  bool first_json_frame = true;
 
   metric* const distortion_psnr = new metric[num_rec];
   metric* const distortion_ssim = new metric[num_rec];
@@ -397,7 +549,7 @@ int main(int argc, const char* argv[]) {
     cur_distortion_psnr->global_u = 0.0;
     cur_distortion_psnr->global_v = 0.0;
     cur_distortion_psnr->global_all = 0.0;
-    distortion_ssim[cur_rec] = cur_distortion_psnr[cur_rec];
+    distortion_ssim[cur_rec] = *cur_distortion_psnr;
   }
 
   if (verbose) {
@@ -419,80 +571,70 @@ int main(int argc, const char* argv[]) {
     }
   }
 
-  int number_of_frames;
-  for (number_of_frames = 0; ; ++number_of_frames) {
-    if (num_frames && number_of_frames >= num_frames)
-      break;
-
-    size_t bytes_org = fread(ch_org, sizeof(uint8), total_size, file_org);
-    if (bytes_org < total_size) {
-#ifdef HAVE_JPEG
-      // Try parsing file as a jpeg.
-      uint8* const ch_jpeg = new uint8[bytes_org];
-      memcpy(ch_jpeg, ch_org, bytes_org);
-      memset(ch_org, 0, total_size);
-
-      if (0 != libyuv::MJPGToI420(ch_jpeg, bytes_org,
-                                  ch_org,
-                                  image_width,
-                                  ch_org + y_size,
-                                  (image_width + 1) / 2,
-                                  ch_org + y_size + uv_size,
-                                  (image_width + 1) / 2,
-                                  image_width,
-                                  image_height,
-                                  image_width,
-                                  image_height)) {
-        delete[] ch_jpeg;
+  int number_of_frames = 0;
+  for (bool done = false; !done; ) {
+    // Find the frames of a batch.  Readers are not thread safe.
+    int batch_count;
+    for (batch_count = 0; batch_count < batch_frames; ++batch_count) {
+      const int frame = number_of_frames + batch_count;
+      if (num_frames && frame >= num_frames) {
+        done = true;
         break;
       }
-      delete[] ch_jpeg;
-#else
-      break;
-#endif  // HAVE_JPEG
-    }
-
-    for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
-      size_t bytes_rec = fread(ch_rec, sizeof(uint8),
-                               total_size, file_rec[cur_rec]);
-      if (bytes_rec < total_size) {
-#ifdef HAVE_JPEG
-        // Try parsing file as a jpeg.
-        uint8* const ch_jpeg = new uint8[bytes_rec];
-        memcpy(ch_jpeg, ch_rec, bytes_rec);
-        memset(ch_rec, 0, total_size);
-
-        if (0 != libyuv::MJPGToI420(ch_jpeg, bytes_rec,
-                                    ch_rec,
-                                    image_width,
-                                    ch_rec + y_size,
-                                    (image_width + 1) / 2,
-                                    ch_rec + y_size + uv_size,
-                                    (image_width + 1) / 2,
-                                    image_width,
-                                    image_height,
-                                    image_width,
-                                    image_height)) {
-          delete[] ch_jpeg;
+      frames_org[batch_count] =
+          GetFrame(&reader_org, num_skip_org + frame,
+                   ch_org + (batch_count % org_frames) * total_size,
+                   y_size, uv_size);
+      if (!frames_org[batch_count]) {
+        done = true;
+        break;
+      }
+      int cur_rec;
+      for (cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
+        const int i = batch_count * num_rec + cur_rec;
+        frames_rec[i] = GetFrame(&reader_rec[cur_rec], num_skip_rec + frame,
+                                 ch_rec + ((batch_count % rec_frames) *
+                                     num_rec + cur_rec) * total_size,
+                                 y_size, uv_size);
+        if (!frames_rec[i]) {
           break;
         }
-        delete[] ch_jpeg;
-#else
+      }
+      if (cur_rec < num_rec) {
+        done = true;
         break;
-#endif  // HAVE_JPEG
       }
+    }
+
+    // Score each frame of the batch on its own thread.
+    const int num_tasks = batch_count * num_rec;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < num_tasks; ++i) {
+      const uint8* frame_org = frames_org[i / num_rec];
+      if (do_psnr) {
+        ComputeMetrics(frame_org, frames_rec[i], y_size, uv_size, total_size,
+                       &frames_psnr[i], true);
+      }
+      if (do_ssim) {
+        ComputeMetrics(frame_org, frames_rec[i], y_size, uv_size, total_size,
+                       &frames_ssim[i], false);
+      }
+    }
 
+    // Report the batch in frame order.
+    for (int i = 0; i < num_tasks; ++i) {
+      const int frame = number_of_frames + i / num_rec;
+      const int cur_rec = i % num_rec;
+      const char* name = argv[fileindex_rec + cur_rec];
       if (verbose) {
-        printf("%5d", number_of_frames);
+        printf("%5d", frame);
       }
       if (do_psnr) {
-        metric distorted_frame;
-        metric* cur_distortion_psnr = &distortion_psnr[cur_rec];
-        bool ismin = UpdateMetrics(ch_org, ch_rec,
-                                   y_size, uv_size, total_size,
-                                   number_of_frames,
-                                   cur_distortion_psnr,
-                                   &distorted_frame, true);
+        const metric& distorted_frame = frames_psnr[i];
+        bool ismin = UpdateMetrics(distorted_frame, frame,
+                                   &distortion_psnr[cur_rec]);
         if (verbose) {
           printf("\t%10.6f", distorted_frame.y);
           printf("\t%10.6f", distorted_frame.u);
@@ -502,13 +644,9 @@ int main(int argc, const char* argv[]) {
         }
       }
       if (do_ssim) {
-        metric distorted_frame;
-        metric* cur_distortion_ssim = &distortion_ssim[cur_rec];
-        bool ismin = UpdateMetrics(ch_org, ch_rec,
-                                   y_size, uv_size, total_size,
-                                   number_of_frames,
-                                   cur_distortion_ssim,
-                                   &distorted_frame, false);
+        const metric& distorted_frame = frames_ssim[i];
+        bool ismin = UpdateMetrics(distorted_frame, frame,
+                                   &distortion_ssim[cur_rec]);
         if (verbose) {
           printf("\t%10.6f", distorted_frame.y);
           printf("\t%10.6f", distorted_frame.u);
@@ -519,11 +657,55 @@ int main(int argc, const char* argv[]) {
       }
       if (verbose) {
         if (show_name) {
-          printf("\t%s", argv[fileindex_rec + cur_rec]);
+          printf("\t%s", name);
         }
         printf("\n");
       }
+      if (file_csv) {
+        fprintf(file_csv, "%d,", frame);
+        PrintCsvString(file_csv, name);
+        if (do_psnr) {
+          fprintf(file_csv, ",%.6f,%.6f,%.6f,%.6f",
+                  frames_psnr[i].y, frames_psnr[i].u,
+                  frames_psnr[i].v, frames_psnr[i].all);
+        }
+        if (do_ssim) {
+          fprintf(file_csv, ",%.6f,%.6f,%.6f,%.6f",
+                  frames_ssim[i].y, frames_ssim[i].u,
+                  frames_ssim[i].v, frames_ssim[i].all);
+        }
+        fprintf(file_csv, "\n");
+      }
+      if (file_json) {
+        fprintf(file_json, "%s\n    {\"frame\": %d, \"name\": ",
+                first_json_frame ? "" : ",", frame);
+        PrintJsonString(file_json, name);
+        if (do_psnr) {
+          fprintf(file_json, ", \"psnr\": {\"y\": %.6f, \"u\": %.6f, "
+                  "\"v\": %.6f, \"all\": %.6f}",
+                  frames_psnr[i].y, frames_psnr[i].u,
+                  frames_psnr[i].v, frames_psnr[i].all);
+        }
+        if (do_ssim) {
+          fprintf(file_json, ", \"ssim\": {\"y\": %.6f, \"u\": %.6f, "
+                  "\"v\": %.6f, \"all\": %.6f}",
+                  frames_ssim[i].y, frames_ssim[i].u,
+                  frames_ssim[i].v, frames_ssim[i].all);
+        }
+        fprintf(file_json, "}");
+        first_json_frame = false;
+      }
     }
+    number_of_frames += batch_count;
+  }
+
+  if (file_csv) {
+    fclose(file_csv);
+  }
+  if (file_json) {
+    fprintf(file_json, "\n  ],\n  \"frame_count\": %d\n}\n",
+            number_of_frames);
+    fclose(file_json);
   }
 
   // Final PSNR computation.
@@ -635,14 +817,14 @@ int main(int argc, const char* argv[]) {
       printf("\n");
     }
   }
-  fclose(file_org);
-  for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
-    fclose(file_rec[cur_rec]);
-  }
   delete[] distortion_psnr;
   delete[] distortion_ssim;
+  delete[] frames_org;
+  delete[] frames_rec;
+  delete[] frames_psnr;
+  delete[] frames_ssim;
   delete[] ch_org;
   delete[] ch_rec;
-  delete[] file_rec;
+  delete[] reader_rec;
   return 0;
 }
@@ -0,0 +1,420 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "./y4m.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char kY4mSignature[] = "YUV4MPEG2 ";
+static const char kY4mFrame[] = "FRAME";
+// Longest stream or frame header line accepted.
+static const size_t kMaxHeaderSize = 1024;
+
+void Y4mInitInfo(Y4mInfo* info, int width, int height) {
+  memset(info, 0, sizeof(*info));
+  info->width = width;
+  info->height = height;
+  info->fps_num = 30;
+  info->fps_den = 1;
+  info->par_num = 1;
+  info->par_den = 1;
+  info->interlace = 'p';
+  info->chroma = kY4mChroma420;
+  info->bit_depth = 8;
+  info->full_range = false;
+  strcpy(info->colorspace, "420jpeg");  // NOLINT
+}
+
+int Y4mChromaWidth(const Y4mInfo& info) {
+  switch (info.chroma) {
+    case kY4mChroma420:
+    case kY4mChroma422:
+      return (info.width + 1) / 2;
+    case kY4mChroma444:
+      return info.width;
+    default:
+      return 0;
+  }
+}
+
+int Y4mChromaHeight(const Y4mInfo& info) {
+  switch (info.chroma) {
+    case kY4mChroma420:
+      return (info.height + 1) / 2;
+    case kY4mChroma422:
+    case kY4mChroma444:
+      return info.height;
+    default:
+      return 0;
+  }
+}
+
+size_t Y4mFrameSize(const Y4mInfo& info) {
+  size_t bytes_per_sample = info.bit_depth > 8 ? 2 : 1;
+  size_t y_size = static_cast<size_t>(info.width) * info.height;
+  size_t uv_size = static_cast<size_t>(Y4mChromaWidth(info)) *
+      Y4mChromaHeight(info);
+  return (y_size + 2 * uv_size) * bytes_per_sample;
+}
+
+// Parses a C tag, ie 420jpeg, 422, 444p10 or mono.
+static bool ParseColorspace(const char* tag, Y4mInfo* info) {
+  const char* depth = tag + 3;
+  if (!strncmp(tag, "420", 3)) {
+    info->chroma = kY4mChroma420;
+  } else if (!strncmp(tag, "422", 3)) {
+    info->chroma = kY4mChroma422;
+  } else if (!strncmp(tag, "444", 3)) {
+    info->chroma = kY4mChroma444;
+    if (!strcmp(tag, "444alpha")) {
+      return false;  // Alpha plane is not supported.
+    }
+  } else if (!strncmp(tag, "mono", 4)) {
+    info->chroma = kY4mChromaMono;
+    depth = tag + 4;
+  } else {
+    return false;
+  }
+  info->bit_depth = 8;
+  if (depth[0] == 'p' && depth[1] >= '0' && depth[1] <= '9') {
+    info->bit_depth = atoi(depth + 1);  // NOLINT
+  } else if (info->chroma == kY4mChromaMono && depth[0] >= '0' &&
+             depth[0] <= '9') {
+    info->bit_depth = atoi(depth);  // NOLINT
+  }
+  if (info->bit_depth < 8 || info->bit_depth > 16) {
+    return false;
+  }
+  strncpy(info->colorspace, tag, sizeof(info->colorspace) - 1);
+  info->colorspace[sizeof(info->colorspace) - 1] = '\0';
+  return true;
+}
+
+Y4mReader::Y4mReader()
+    : file_(NULL),
+      map_data_(NULL),
+      file_size_(0),
+#if defined(_WIN32)
+      map_handle_(NULL),
+#endif
+      is_y4m_(false),
+      frame_size_(0),
+      header_size_(0) {
+  Y4mInitInfo(&info_, 0, 0);
+}
+
+Y4mReader::~Y4mReader() {
+  Close();
+}
+
+bool Y4mReader::Open(const char* filename) {
+  Close();
+  file_ = fopen(filename, "rb");
+  if (!file_) {
+    return false;
+  }
+#if defined(_WIN32)
+  _fseeki64(file_, 0, SEEK_END);
+  file_size_ = static_cast<size_t>(_ftelli64(file_));
+  HANDLE file_handle = reinterpret_cast<HANDLE>(
+      _get_osfhandle(_fileno(file_)));
+  if (file_size_ > 0) {
+    map_handle_ = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0,
+                                    NULL);
+    if (map_handle_) {
+      map_data_ = static_cast<const uint8*>(
+          MapViewOfFile(map_handle_, FILE_MAP_READ, 0, 0, 0));
+    }
+  }
+#else
+  struct stat file_stat;
+  if (fstat(fileno(file_), &file_stat) == 0 && S_ISREG(file_stat.st_mode)) {
+    file_size_ = static_cast<size_t>(file_stat.st_size);
+    if (file_size_ > 0 &&
+        static_cast<off_t>(file_size_) == file_stat.st_size) {
+      void* data = mmap(NULL, file_size_, PROT_READ, MAP_PRIVATE,
+                        fileno(file_), 0);
+      if (data != MAP_FAILED) {
+        map_data_ = static_cast<const uint8*>(data);
+#if defined(MADV_SEQUENTIAL)
+        madvise(data, file_size_, MADV_SEQUENTIAL);
+#endif
+      }
+    }
+  }
+#endif
+
+  char header[kMaxHeaderSize];
+  size_t header_size = ReadLine(0, header, sizeof(header));
+  is_y4m_ = header_size > 0 &&
+      !strncmp(header, kY4mSignature, sizeof(kY4mSignature) - 1);
+  if (is_y4m_) {
+    if (!ParseHeader(header)) {
+      Close();
+      return false;
+    }
+    header_size_ = header_size;
+    frame_size_ = Y4mFrameSize(info_);
+  }
+  return true;
+}
+
+void Y4mReader::Close() {
+#if defined(_WIN32)
+  if (map_data_) {
+    UnmapViewOfFile(map_data_);
+  }
+  if (map_handle_) {
+    CloseHandle(map_handle_);
+    map_handle_ = NULL;
+  }
+#else
+  if (map_data_) {
+    munmap(const_cast<uint8*>(map_data_), file_size_);
+  }
+#endif
+  map_data_ = NULL;
+  if (file_) {
+    fclose(file_);
+    file_ = NULL;
+  }
+  file_size_ = 0;
+  is_y4m_ = false;
+  frame_size_ = 0;
+  header_size_ = 0;
+  frame_offsets_.clear();
+  Y4mInitInfo(&info_, 0, 0);
+}
+
+bool Y4mReader::ParseHeader(const char* header) {
+  bool has_colorspace = false;
+  Y4mInitInfo(&info_, 0, 0);
+  const char* tag = header + sizeof(kY4mSignature) - 1;
+  while (*tag) {
+    while (*tag == ' ') {
+      ++tag;
+    }
+    if (!*tag) {
+      break;
+    }
+    char value[kMaxHeaderSize];
+    size_t length = strcspn(tag + 1, " ");
+    memcpy(value, tag + 1, length);
+    value[length] = '\0';
+    switch (tag[0]) {
+      case 'W':
+        info_.width = atoi(value);  // NOLINT
+        break;
+      case 'H':
+        info_.height = atoi(value);  // NOLINT
+        break;
+      case 'F':
+        sscanf(value, "%d:%d", &info_.fps_num, &info_.fps_den);  // NOLINT
+        break;
+      case 'A':
+        sscanf(value, "%d:%d", &info_.par_num, &info_.par_den);  // NOLINT
+        break;
+      case 'I':
+        info_.interlace = value[0];
+        break;
+      case 'C':
+        if (!ParseColorspace(value, &info_)) {
+          fprintf(stderr, "Unsupported Y4M colorspace C%s\n", value);
+          return false;
+        }
+        has_colorspace = true;
+        break;
+      case 'X':
+        if (!strcmp(value, "COLORRANGE=FULL")) {
+          info_.full_range = true;
+        } else if (!has_colorspace && !strncmp(value, "YSCSS=", 6)) {
+          // Older mjpegtools write the chroma format here, ie 420JPEG.
+          char colorspace[16];
+          size_t i;
+          for (i = 0; i < sizeof(colorspace) - 1 && value[6 + i]; ++i) {
+            colorspace[i] = static_cast<char>(tolower(value[6 + i]));
+          }
+          colorspace[i] = '\0';
+          ParseColorspace(colorspace, &info_);
+        }
+        break;
+      default:
+        break;  // Unknown tags are ignored.
+    }
+    tag += 1 + length;
+  }
+  if (info_.width <= 0 || info_.height <= 0) {
+    fprintf(stderr, "Invalid Y4M size %dx%d\n", info_.width, info_.height);
+    return false;
+  }
+  return true;
+}
+
+bool Y4mReader::ReadAt(size_t offset, void* dst, size_t size) {
+  if (offset > file_size_ || size > file_size_ - offset) {
+    return false;
+  }
+  if (map_data_) {
+    memcpy(dst, map_data_ + offset, size);
+    return true;
+  }
+#if defined(_MSC_VER)
+  _fseeki64(file_, static_cast<__int64>(offset), SEEK_SET);
+#else
+  fseeko(file_, static_cast<off_t>(offset), SEEK_SET);
+#endif
+  return fread(dst, 1, size, file_) == size;
+}
+
+// Reads a header line at offset into line, with the '\n' replaced by '\0'.
+// Returns the size of the line including the '\n', or 0 if there is none.
+size_t Y4mReader::ReadLine(size_t offset, char* line, size_t max_size) {
+  size_t size = max_size - 1;
+  if (offset >= file_size_) {
+    return 0;
+  }
+  if (size > file_size_ - offset) {
+    size = file_size_ - offset;
+  }
+  if (!ReadAt(offset, line, size)) {
+    return 0;
+  }
+  line[size] = '\0';
+  char* end = static_cast<char*>(memchr(line, '\n', size));
+  if (!end) {
+    return 0;
+  }
+  *end = '\0';
+  return end - line + 1;
+}
+
+// Finds the data of a Y4M frame by walking the frame headers from the last
+// frame found.
+bool Y4mReader::FindFrame(int index, size_t* data_offset) {
+  while (static_cast<int>(frame_offsets_.size()) <= index) {
+    size_t offset = frame_offsets_.empty() ? header_size_ :
+        frame_offsets_.back() + frame_size_;
+    char line[kMaxHeaderSize];
+    size_t line_size = ReadLine(offset, line, sizeof(line));
+    if (line_size == 0 ||
+        strncmp(line, kY4mFrame, sizeof(kY4mFrame) - 1)) {
+      return false;
+    }
+    offset += line_size;
+    if (offset > file_size_ || frame_size_ > file_size_ - offset) {
+      return false;  // Truncated frame.
+    }
+    frame_offsets_.push_back(offset);
+  }
+  *data_offset = frame_offsets_[index];
+  return true;
+}
+
+void Y4mReader::SetRawFrameSize(size_t frame_size) {
+  if (!is_y4m_) {
+    frame_size_ = frame_size;
+  }
+}
+
+int Y4mReader::GetFrameCount() {
+  if (frame_size_ == 0) {
+    return 0;
+  }
+  if (!is_y4m_) {
+    return static_cast<int>(file_size_ / frame_size_);
+  }
+  size_t data_offset;
+  while (FindFrame(static_cast<int>(frame_offsets_.size()), &data_offset)) {
+  }
+  return static_cast<int>(frame_offsets_.size());
+}
+
+const uint8* Y4mReader::GetFrame(int index) {
+  size_t offset;
+  if (index < 0 || frame_size_ == 0) {
+    return NULL;
+  }
+  if (is_y4m_) {
+    if (!FindFrame(index, &offset)) {
+      return NULL;
+    }
+  } else {
+    offset = static_cast<size_t>(index) * frame_size_;
+    if (offset / frame_size_ != static_cast<size_t>(index) ||
+        offset > file_size_ || frame_size_ > file_size_ - offset) {
+      return NULL;
+    }
+  }
+  if (map_data_) {
+    return map_data_ + offset;
+  }
+  buffer_.resize(frame_size_);
+  if (!ReadAt(offset, &buffer_[0], frame_size_)) {
+    return NULL;
+  }
+  return &buffer_[0];
+}
+
+Y4mWriter::Y4mWriter() : file_(NULL) {
+  Y4mInitInfo(&info_, 0, 0);
+}
+
+Y4mWriter::~Y4mWriter() {
+  Close();
+}
+
+bool Y4mWriter::Open(const char* filename, const Y4mInfo& info) {
+  Close();
+  file_ = fopen(filename, "wb");
+  if (!file_) {
+    return false;
+  }
+  info_ = info;
+  fprintf(file_, "%sW%d H%d F%d:%d I%c A%d:%d C%s", kY4mSignature,
+          info.width, info.height, info.fps_num, info.fps_den,
+          info.interlace ? info.interlace : 'p',
+          info.par_num, info.par_den, info.colorspace);
+  if (info.full_range) {
+    fprintf(file_, " XCOLORRANGE=FULL");
+  }
+  return fputc('\n', file_) != EOF;
+}
+
+void Y4mWriter::Close() {
+  if (file_) {
+    fclose(file_);
+    file_ = NULL;
+  }
+}
+
+bool Y4mWriter::WriteFrame(const uint8* data) {
+  size_t frame_size = Y4mFrameSize(info_);
+  if (!file_) {
+    return false;
+  }
+  fprintf(file_, "%s\n", kY4mFrame);
+  return fwrite(data, 1, frame_size, file_) == frame_size;
+}
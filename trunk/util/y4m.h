@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Y4M (YUV4MPEG2) file reading and writing for the command line tools.
+// Files are memory mapped when possible, so frames are accessed in place
+// without copying. Headerless raw files (.yuv) are read the same way.
+
+#ifndef UTIL_Y4M_H_  // NOLINT
+#define UTIL_Y4M_H_
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <vector>
+
+#if !defined(INT_TYPES_DEFINED) && !defined(UINT8_TYPE_DEFINED)
+typedef unsigned char uint8;
+#define UINT8_TYPE_DEFINED
+#endif
+
+enum Y4mChroma {
+  kY4mChroma420,
+  kY4mChroma422,
+  kY4mChroma444,
+  kY4mChromaMono
+};
+
+// Stream parameters from the Y4M header.
+struct Y4mInfo {
+  int width;
+  int height;
+  int fps_num;  // Frame rate, F tag.
+  int fps_den;
+  int par_num;  // Pixel aspect ratio, A tag.
+  int par_den;
+  char interlace;  // I tag: 'p', 't', 'b', 'm' or '?'.
+  Y4mChroma chroma;
+  int bit_depth;  // 8, or 9 to 16 for 'C420p10' style tags.
+  bool full_range;  // XCOLORRANGE=FULL.
+  char colorspace[16];  // C tag as written, ie '420jpeg'.
+};
+
+// Sets info to 8 bit 4:2:0 progressive at 30 fps.
+void Y4mInitInfo(Y4mInfo* info, int width, int height);
+
+// Bytes of planar Y, U and V data in one frame.
+size_t Y4mFrameSize(const Y4mInfo& info);
+
+// Width and height of the U and V planes.
+int Y4mChromaWidth(const Y4mInfo& info);
+int Y4mChromaHeight(const Y4mInfo& info);
+
+class Y4mReader {
+ public:
+  Y4mReader();
+  ~Y4mReader();
+
+  // Opens a file and parses the Y4M header if it has one.
+  // Returns false if the file can not be opened or the header is invalid.
+  bool Open(const char* filename);
+  void Close();
+
+  // True if the file has a YUV4MPEG2 header. Otherwise the file is raw and
+  // SetRawFrameSize must be called before reading frames.
+  bool is_y4m() const { return is_y4m_; }
+  const Y4mInfo& info() const { return info_; }
+
+  void SetRawFrameSize(size_t frame_size);
+  size_t frame_size() const { return frame_size_; }
+
+  // Returns the number of complete frames, which for Y4M requires parsing
+  // every frame header.
+  int GetFrameCount();
+
+  // Returns the planar data of a frame, or NULL if the file has no such
+  // complete frame. Mapped frames point into the file; otherwise the frame
+  // is read into a buffer that is reused by the next call.
+  const uint8* GetFrame(int index);
+
+  // Returns the whole file when it is mapped, otherwise NULL.
+  const uint8* mapped_data() const { return map_data_; }
+  size_t file_size() const { return file_size_; }
+
+ private:
+  bool ParseHeader(const char* header);
+  bool ReadAt(size_t offset, void* dst, size_t size);
+  size_t ReadLine(size_t offset, char* line, size_t max_size);
+  bool FindFrame(int index, size_t* data_offset);
+
+  FILE* file_;
+  const uint8* map_data_;
+  size_t file_size_;
+#if defined(_WIN32)
+  void* map_handle_;
+#endif
+  bool is_y4m_;
+  Y4mInfo info_;
+  size_t frame_size_;
+  size_t header_size_;
+  // Offsets of the data of each Y4M frame, found so far.
+  std::vector<size_t> frame_offsets_;
+  std::vector<uint8> buffer_;
+};
+
+class Y4mWriter {
+ public:
+  Y4mWriter();
+  ~Y4mWriter();
+
+  // Creates a file and writes the stream header for info.
+  bool Open(const char* filename, const Y4mInfo& info);
+  void Close();
+
+  // Writes a frame header followed by Y4mFrameSize(info) bytes of data.
+  bool WriteFrame(const uint8* data);
+
+ private:
+  FILE* file_;
+  Y4mInfo info_;
+};
+
+#endif  // UTIL_Y4M_H_  // NOLINT